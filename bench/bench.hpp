@@ -0,0 +1,246 @@
+#pragma once
+#ifndef JCLIB_OPENGL_BENCH_BENCH_HPP
+#define JCLIB_OPENGL_BENCH_BENCH_HPP
+
+/*
+	Minimal benchmark harness for comparing the wrappers against hand written OpenGL calls
+*/
+
+#include <chrono>
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <ostream>
+#include <cstddef>
+#include <algorithm>
+#include <functional>
+#include <string_view>
+
+namespace jc::gl::bench
+{
+	/**
+	 * @brief Keeps the compiler from optimizing away a value.
+	*/
+	template <typename T>
+	inline void do_not_optimize(const T& _value) noexcept
+	{
+#if defined(__GNUC__) || defined(__clang__)
+		asm volatile("" : : "r,m"(_value) : "memory");
+#else
+		static volatile const void* _sink{};
+		_sink = &_value;
+#endif
+	};
+
+	/**
+	 * @brief Which GL implementation a benchmark ran against.
+	*/
+	enum class backend_type
+	{
+		/**
+		 * @brief Function pointers replaced with no-op stubs, isolates the cost of the wrapper itself.
+		*/
+		null,
+
+		/**
+		 * @brief Whatever driver the headless context loaded, llvmpipe on machines without a GPU.
+		*/
+		driver,
+	};
+
+	constexpr inline std::string_view to_string(backend_type _backend) noexcept
+	{
+		return (_backend == backend_type::null) ? "null" : "driver";
+	};
+
+	/**
+	 * @brief A single benchmark case.
+	 *
+	 * The run function performs the measured operation the given number of times.
+	*/
+	struct benchmark
+	{
+		std::string_view name;
+
+		/**
+		 * @brief "wrapper" for the jcopengl path, "raw" for the hand written GL baseline.
+		*/
+		std::string_view variant;
+
+		std::function<void(size_t _iterations)> run;
+	};
+
+	/**
+	 * @brief Timing of one benchmark on one backend.
+	*/
+	struct result
+	{
+		std::string name;
+		std::string variant;
+		backend_type backend;
+		size_t iterations;
+		double ns_per_op;
+	};
+
+	/**
+	 * @brief Settings for run().
+	*/
+	struct settings
+	{
+		/**
+		 * @brief Minimum time spent in each repetition.
+		*/
+		std::chrono::nanoseconds min_time = std::chrono::milliseconds{ 20 };
+
+		/**
+		 * @brief Number of repetitions, the median is reported.
+		*/
+		size_t repetitions = 5;
+
+		/**
+		 * @brief Only benchmarks whose name contains this are run.
+		*/
+		std::string filter{};
+	};
+
+	/**
+	 * @brief Times a benchmark, scaling the iteration count until each repetition lasts at least min_time.
+	 * @param _benchmark Benchmark to time.
+	 * @param _backend Backend the benchmark is running against, only recorded in the result.
+	 * @param _settings Timing settings.
+	 * @return Median time per operation.
+	*/
+	inline result run(const benchmark& _benchmark, backend_type _backend, const settings& _settings)
+	{
+		using clock = std::chrono::steady_clock;
+
+		const auto _time = [&_benchmark](size_t _iterations)
+		{
+			const auto _start = clock::now();
+			_benchmark.run(_iterations);
+			return std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - _start);
+		};
+
+		// Warm up and find an iteration count that fills min_time
+		size_t _iterations = 1;
+		while (true)
+		{
+			const auto _elapsed = _time(_iterations);
+			if (_elapsed >= _settings.min_time)
+			{
+				break;
+			};
+			if (_elapsed.count() < 1000)
+			{
+				_iterations *= 10;
+			}
+			else
+			{
+				const auto _scale = static_cast<double>(_settings.min_time.count()) / static_cast<double>(_elapsed.count());
+				_iterations = static_cast<size_t>(static_cast<double>(_iterations) * _scale * 1.2) + 1;
+			};
+		};
+
+		std::vector<double> _samples{};
+		_samples.reserve(_settings.repetitions);
+		for (size_t n = 0; n != _settings.repetitions; ++n)
+		{
+			const auto _elapsed = _time(_iterations);
+			_samples.push_back(static_cast<double>(_elapsed.count()) / static_cast<double>(_iterations));
+		};
+		std::ranges::sort(_samples);
+
+		return result
+		{
+			std::string{ _benchmark.name },
+			std::string{ _benchmark.variant },
+			_backend,
+			_iterations,
+			_samples[_samples.size() / 2]
+		};
+	};
+
+	/**
+	 * @brief Runs every benchmark matching the settings filter.
+	*/
+	inline void run_all(const std::vector<benchmark>& _benchmarks, backend_type _backend, const settings& _settings,
+		std::vector<result>& _results)
+	{
+		for (auto& _benchmark : _benchmarks)
+		{
+			if (!_settings.filter.empty() && _benchmark.name.find(_settings.filter) == std::string_view::npos)
+			{
+				continue;
+			};
+			_results.push_back(run(_benchmark, _backend, _settings));
+		};
+	};
+
+	/**
+	 * @brief Finds the raw baseline timing for a wrapper result.
+	 * @return Baseline result or null if the benchmark has no baseline.
+	*/
+	inline const result* find_baseline(const std::vector<result>& _results, const result& _result)
+	{
+		const auto it = std::ranges::find_if(_results, [&_result](const result& r)
+		{
+			return r.name == _result.name && r.backend == _result.backend && r.variant == "raw";
+		});
+		return (it != _results.end()) ? &*it : nullptr;
+	};
+
+	/**
+	 * @brief Gets the time of a result relative to its raw baseline, 1.0 when equal or when there is no baseline.
+	*/
+	inline double relative_to_baseline(const std::vector<result>& _results, const result& _result)
+	{
+		const auto _baseline = find_baseline(_results, _result);
+		return (_baseline && _baseline->ns_per_op > 0.0) ? _result.ns_per_op / _baseline->ns_per_op : 1.0;
+	};
+
+	/**
+	 * @brief Writes results as a human readable table.
+	*/
+	inline void write_table(std::FILE* _file, const std::vector<result>& _results)
+	{
+		std::fprintf(_file, "%-32s %-8s %-8s %12s %12s %8s\n", "benchmark", "variant", "backend", "iterations", "ns/op", "vs raw");
+		for (auto& r : _results)
+		{
+			std::fprintf(_file, "%-32s %-8s %-8s %12zu %12.2f %7.2fx\n", r.name.c_str(), r.variant.c_str(),
+				to_string(r.backend).data(), r.iterations, r.ns_per_op, relative_to_baseline(_results, r));
+		};
+	};
+
+	/**
+	 * @brief Writes results as a JSON document.
+	*/
+	inline void write_json(std::ostream& _out, const std::vector<result>& _results)
+	{
+		_out << "{\n\t\"results\": [\n";
+		for (size_t n = 0; n != _results.size(); ++n)
+		{
+			const auto& r = _results[n];
+			_out << "\t\t{ \"name\": \"" << r.name << "\", \"variant\": \"" << r.variant
+				<< "\", \"backend\": \"" << to_string(r.backend) << "\", \"iterations\": " << r.iterations
+				<< ", \"ns_per_op\": " << r.ns_per_op << ", \"relative_to_raw\": " << relative_to_baseline(_results, r) << " }"
+				<< ((n + 1 != _results.size()) ? ",\n" : "\n");
+		};
+		_out << "\t]\n}\n";
+	};
+
+	/**
+	 * @brief Writes results as CSV with a header row.
+	*/
+	inline void write_csv(std::ostream& _out, const std::vector<result>& _results)
+	{
+		_out << "name,variant,backend,iterations,ns_per_op,relative_to_raw\n";
+		for (auto& r : _results)
+		{
+			_out << r.name << ',' << r.variant << ',' << to_string(r.backend) << ',' << r.iterations << ','
+				<< r.ns_per_op << ',' << relative_to_baseline(_results, r) << '\n';
+		};
+	};
+
+};
+
+#endif // JCLIB_OPENGL_BENCH_BENCH_HPP
@@ -0,0 +1,447 @@
+/*
+	Measures the overhead of the jcopengl wrappers against hand written OpenGL calls.
+
+	Every benchmark has a "wrapper" and a "raw" variant and is run twice, once with glad's function
+	pointers swapped for no-op stubs (isolates the wrapper's own cost) and once against the driver
+	of a headless context (llvmpipe when there is no GPU).
+
+	usage: jcopengl_bench [--backend null|driver|all] [--filter TEXT] [--min-time-ms N]
+		[--repetitions N] [--json PATH] [--csv PATH]
+*/
+
+#include "bench.hpp"
+#include "null_dispatch.hpp"
+
+#include <jclib/gl/gl.hpp>
+#include <jclib/gl/glheadless.hpp>
+
+#include <span>
+#include <array>
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <utility>
+#include <string_view>
+
+namespace gl = jc::gl;
+namespace bench = jc::gl::bench;
+
+namespace
+{
+	/**
+	 * @brief Matrix type only settable through the uniform_traits customization point.
+	*/
+	struct bench_mat4
+	{
+		std::array<gl::gl_float, 16> values{};
+	};
+};
+
+template <>
+struct jc::gl::uniform_traits<bench_mat4>
+{
+	using type = bench_mat4;
+	static void set(const program_id& _program, const uniform_location& _uniform, const type& _value)
+	{
+		glProgramUniformMatrix4fv(_program.get(), _uniform.get(), 1, GL_FALSE, _value.values.data());
+	};
+};
+
+namespace
+{
+	constexpr std::string_view vertex_source = R"(#version 450 core
+layout(location = 0) in vec3 a_position;
+uniform float u_value;
+uniform vec4 u_color;
+uniform mat4 u_matrix;
+out vec4 v_color;
+void main()
+{
+	gl_Position = u_matrix * vec4(a_position * u_value, 1.0);
+	v_color = u_color;
+}
+)";
+
+	constexpr std::string_view fragment_source = R"(#version 450 core
+in vec4 v_color;
+out vec4 f_color;
+void main()
+{
+	f_color = v_color;
+}
+)";
+
+	/**
+	 * @brief Objects shared by the benchmarks, created on the real driver before any stubs are installed.
+	*/
+	struct fixture
+	{
+		gl::unique_program program{};
+		gl::uniform_location u_value{};
+		gl::uniform_location u_color{};
+		gl::uniform_location u_matrix{};
+		gl::unique_vbo vbo{};
+		gl::unique_vao vao{};
+		std::vector<gl::gl_float> data{};
+		bench_mat4 matrix{};
+
+		bool init()
+		{
+			this->program = gl::new_program();
+			std::array<gl::unique_shader, 2> _shaders
+			{
+				gl::new_shader(gl::shader_type::vertex),
+				gl::new_shader(gl::shader_type::fragment)
+			};
+			if (!gl::compile(_shaders[0], vertex_source) || !gl::compile(_shaders[1], fragment_source))
+			{
+				std::fprintf(stderr, "shader compile failed\n%s%s", gl::get_info_log(_shaders[0]).c_str(),
+					gl::get_info_log(_shaders[1]).c_str());
+				return false;
+			};
+			if (!gl::link(this->program, _shaders))
+			{
+				std::fprintf(stderr, "program link failed\n%s", gl::get_info_log(this->program).c_str());
+				return false;
+			};
+
+			const auto _value = gl::get_uniform_location(this->program, "u_value");
+			const auto _color = gl::get_uniform_location(this->program, "u_color");
+			const auto _matrix = gl::get_uniform_location(this->program, "u_matrix");
+			if (!_value || !_color || !_matrix)
+			{
+				std::fprintf(stderr, "missing benchmark uniforms\n");
+				return false;
+			};
+			this->u_value = *_value;
+			this->u_color = *_color;
+			this->u_matrix = *_matrix;
+
+			this->vbo = gl::new_vbo();
+			this->vao = gl::new_vao();
+			this->data.resize(1024, 1.0f);
+			this->matrix.values = { 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1 };
+			gl::buffer_data(this->vbo, this->data, gl::vbo_usage::dynamic_draw);
+			return true;
+		};
+	};
+
+	std::vector<bench::benchmark> make_benchmarks(const fixture& f)
+	{
+		std::vector<bench::benchmark> _out{};
+		const auto _add = [&_out](std::string_view _name, auto&& _wrapper, auto&& _raw)
+		{
+			_out.push_back(bench::benchmark{ _name, "wrapper", std::forward<decltype(_wrapper)>(_wrapper) });
+			_out.push_back(bench::benchmark{ _name, "raw", std::forward<decltype(_raw)>(_raw) });
+		};
+
+		const gl::program_id _program = f.program;
+		const GLuint _rawProgram = f.program.get();
+		const gl::vbo_id _vbo = f.vbo;
+		const GLuint _rawVbo = f.vbo.get();
+		const gl::vao_id _vao = f.vao;
+		const GLuint _rawVao = f.vao.get();
+		const auto _data = std::span<const gl::gl_float>{ f.data };
+
+		_add("set_uniform_float",
+			[=, &f](size_t _count)
+			{
+				for (size_t n = 0; n != _count; ++n)
+				{
+					gl::set_uniform(_program, f.u_value, 0.5f);
+				};
+			},
+			[=, &f](size_t _count)
+			{
+				const auto _location = static_cast<GLint>(f.u_value.get());
+				for (size_t n = 0; n != _count; ++n)
+				{
+					glProgramUniform1f(_rawProgram, _location, 0.5f);
+				};
+			});
+
+		_add("set_uniform_vec4",
+			[=, &f](size_t _count)
+			{
+				for (size_t n = 0; n != _count; ++n)
+				{
+					gl::set_uniform(_program, f.u_color, 0.25f, 0.5f, 0.75f, 1.0f);
+				};
+			},
+			[=, &f](size_t _count)
+			{
+				const auto _location = static_cast<GLint>(f.u_color.get());
+				for (size_t n = 0; n != _count; ++n)
+				{
+					glProgramUniform4f(_rawProgram, _location, 0.25f, 0.5f, 0.75f, 1.0f);
+				};
+			});
+
+		_add("set_uniform_traits_mat4",
+			[=, &f](size_t _count)
+			{
+				for (size_t n = 0; n != _count; ++n)
+				{
+					gl::set_uniform(_program, f.u_matrix, f.matrix);
+				};
+			},
+			[=, &f](size_t _count)
+			{
+				const auto _location = static_cast<GLint>(f.u_matrix.get());
+				for (size_t n = 0; n != _count; ++n)
+				{
+					glProgramUniformMatrix4fv(_rawProgram, _location, 1, GL_FALSE, f.matrix.values.data());
+				};
+			});
+
+		_add("buffer_data_range",
+			[=](size_t _count)
+			{
+				for (size_t n = 0; n != _count; ++n)
+				{
+					gl::buffer_data(_vbo, _data, gl::vbo_usage::dynamic_draw);
+				};
+			},
+			[=](size_t _count)
+			{
+				for (size_t n = 0; n != _count; ++n)
+				{
+					glNamedBufferData(_rawVbo, static_cast<GLsizeiptr>(_data.size_bytes()), _data.data(), GL_DYNAMIC_DRAW);
+				};
+			});
+
+		_add("buffer_data_target",
+			[=](size_t _count)
+			{
+				gl::bind(_vbo, gl::vbo_target::array);
+				for (size_t n = 0; n != _count; ++n)
+				{
+					gl::buffer_data(gl::vbo_target::array, _data, gl::vbo_usage::dynamic_draw);
+				};
+			},
+			[=](size_t _count)
+			{
+				glBindBuffer(GL_ARRAY_BUFFER, _rawVbo);
+				for (size_t n = 0; n != _count; ++n)
+				{
+					glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(_data.size_bytes()), _data.data(), GL_DYNAMIC_DRAW);
+				};
+			});
+
+		_add("buffer_subdata_range",
+			[=](size_t _count)
+			{
+				const auto _part = _data.first(64);
+				for (size_t n = 0; n != _count; ++n)
+				{
+					gl::buffer_subdata(_vbo, _part, 64);
+				};
+			},
+			[=](size_t _count)
+			{
+				const auto _part = _data.first(64);
+				for (size_t n = 0; n != _count; ++n)
+				{
+					glNamedBufferSubData(_rawVbo, 64 * sizeof(gl::gl_float), static_cast<GLsizeiptr>(_part.size_bytes()), _part.data());
+				};
+			});
+
+		_add("get_resource_location",
+			[=](size_t _count)
+			{
+				for (size_t n = 0; n != _count; ++n)
+				{
+					const auto _location = gl::get_resource_location(_program, gl::resource_type::uniform, "u_color");
+					bench::do_not_optimize(_location);
+				};
+			},
+			[=](size_t _count)
+			{
+				for (size_t n = 0; n != _count; ++n)
+				{
+					const auto _location = glGetProgramResourceLocation(_rawProgram, GL_UNIFORM, "u_color");
+					bench::do_not_optimize(_location);
+				};
+			});
+
+		_add("unique_vbo_create_move_destroy",
+			[](size_t _count)
+			{
+				for (size_t n = 0; n != _count; ++n)
+				{
+					auto _first = gl::new_vbo();
+					auto _second = std::move(_first);
+					bench::do_not_optimize(_second.get());
+				};
+			},
+			[](size_t _count)
+			{
+				for (size_t n = 0; n != _count; ++n)
+				{
+					GLuint _first{};
+					glCreateBuffers(1, &_first);
+					const auto _second = std::exchange(_first, 0);
+					bench::do_not_optimize(_second);
+					glDeleteBuffers(1, &_second);
+				};
+			});
+
+		_add("bind_vbo",
+			[=](size_t _count)
+			{
+				for (size_t n = 0; n != _count; ++n)
+				{
+					gl::bind(_vbo, gl::vbo_target::array);
+				};
+			},
+			[=](size_t _count)
+			{
+				for (size_t n = 0; n != _count; ++n)
+				{
+					glBindBuffer(GL_ARRAY_BUFFER, _rawVbo);
+				};
+			});
+
+		_add("bind_vao",
+			[=](size_t _count)
+			{
+				for (size_t n = 0; n != _count; ++n)
+				{
+					gl::bind(_vao);
+				};
+			},
+			[=](size_t _count)
+			{
+				for (size_t n = 0; n != _count; ++n)
+				{
+					glBindVertexArray(_rawVao);
+				};
+			});
+
+		_add("bind_program",
+			[=](size_t _count)
+			{
+				for (size_t n = 0; n != _count; ++n)
+				{
+					gl::bind(_program);
+				};
+			},
+			[=](size_t _count)
+			{
+				for (size_t n = 0; n != _count; ++n)
+				{
+					glUseProgram(_rawProgram);
+				};
+			});
+
+		return _out;
+	};
+
+	struct options
+	{
+		bench::settings settings{};
+		bool run_null = true;
+		bool run_driver = true;
+		std::string json_path{};
+		std::string csv_path{};
+	};
+
+	bool parse_options(int _nargs, char* _vargs[], options& _options)
+	{
+		for (int n = 1; n < _nargs; ++n)
+		{
+			const auto _arg = std::string_view{ _vargs[n] };
+			const auto _value = (n + 1 < _nargs) ? std::string_view{ _vargs[n + 1] } : std::string_view{};
+			if (_value.empty() && _arg.starts_with("--"))
+			{
+				std::fprintf(stderr, "missing value for %s\n", _vargs[n]);
+				return false;
+			};
+
+			if (_arg == "--backend")
+			{
+				_options.run_null = (_value == "null" || _value == "all");
+				_options.run_driver = (_value == "driver" || _value == "all");
+			}
+			else if (_arg == "--filter")
+			{
+				_options.settings.filter = _value;
+			}
+			else if (_arg == "--min-time-ms")
+			{
+				_options.settings.min_time = std::chrono::milliseconds{ std::atoi(_value.data()) };
+			}
+			else if (_arg == "--repetitions")
+			{
+				_options.settings.repetitions = static_cast<size_t>(std::max(1, std::atoi(_value.data())));
+			}
+			else if (_arg == "--json")
+			{
+				_options.json_path = _value;
+			}
+			else if (_arg == "--csv")
+			{
+				_options.csv_path = _value;
+			}
+			else
+			{
+				std::fprintf(stderr, "unknown argument %s\n", _vargs[n]);
+				return false;
+			};
+			++n;
+		};
+		return true;
+	};
+};
+
+int main(int _nargs, char* _vargs[])
+{
+	options _options{};
+	if (!parse_options(_nargs, _vargs, _options))
+	{
+		return 2;
+	};
+
+	gl::headless_context _context{};
+	if (!_context)
+	{
+		std::fprintf(stderr, "failed to create headless context: %s\n", _context.error().c_str());
+		return 1;
+	};
+	std::fprintf(stderr, "renderer: %s\n", reinterpret_cast<const char*>(glGetString(GL_RENDERER)));
+
+	fixture _fixture{};
+	if (!_fixture.init())
+	{
+		return 1;
+	};
+	const auto _benchmarks = make_benchmarks(_fixture);
+
+	std::vector<bench::result> _results{};
+	if (_options.run_null)
+	{
+		bench::null_dispatch _null{};
+		_null.install();
+		bench::run_all(_benchmarks, bench::backend_type::null, _options.settings, _results);
+	};
+	if (_options.run_driver)
+	{
+		bench::run_all(_benchmarks, bench::backend_type::driver, _options.settings, _results);
+		glFinish();
+	};
+
+	bench::write_table(stdout, _results);
+	if (!_options.json_path.empty())
+	{
+		auto _file = std::ofstream{ _options.json_path };
+		bench::write_json(_file, _results);
+	};
+	if (!_options.csv_path.empty())
+	{
+		auto _file = std::ofstream{ _options.csv_path };
+		bench::write_csv(_file, _results);
+	};
+	return 0;
+};
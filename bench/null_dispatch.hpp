@@ -0,0 +1,144 @@
+#pragma once
+#ifndef JCLIB_OPENGL_BENCH_NULL_DISPATCH_HPP
+#define JCLIB_OPENGL_BENCH_NULL_DISPATCH_HPP
+
+/*
+	Swaps glad's function pointers for no-op stubs so benchmarks measure only the wrapper code
+*/
+
+#include <jclib/gl/gllib.hpp>
+
+#include <glad/glad.h>
+
+#include <type_traits>
+
+/**
+ * @brief The OpenGL functions replaced by null_dispatch, X(name) per function.
+*/
+#define JCLIB_OPENGL_BENCH_NULL_FUNCTIONS(X) \
+	X(glProgramUniform1f) \
+	X(glProgramUniform4f) \
+	X(glProgramUniform4fv) \
+	X(glProgramUniformMatrix4fv) \
+	X(glBufferData) \
+	X(glBufferSubData) \
+	X(glNamedBufferData) \
+	X(glNamedBufferSubData) \
+	X(glGetProgramResourceLocation) \
+	X(glCreateBuffers) \
+	X(glDeleteBuffers) \
+	X(glIsBuffer) \
+	X(glCreateVertexArrays) \
+	X(glDeleteVertexArrays) \
+	X(glIsVertexArray) \
+	X(glBindBuffer) \
+	X(glBindVertexArray) \
+	X(glUseProgram)
+
+namespace jc::gl::bench
+{
+	/**
+	 * @brief Generates a stub with the signature of an OpenGL function pointer type that returns a default value.
+	*/
+	template <typename FnT>
+	struct null_function;
+
+	template <typename RetT, typename... ArgTs>
+	struct null_function<RetT(APIENTRY*)(ArgTs...)>
+	{
+		static RetT APIENTRY invoke(ArgTs...)
+		{
+			if constexpr (!std::is_void_v<RetT>)
+			{
+				return RetT{};
+			};
+		};
+	};
+
+	/**
+	 * @brief Stub for glCreate* functions, hands out increasing non-zero names so handles look valid.
+	*/
+	inline void APIENTRY null_create(GLsizei _count, GLuint* _names)
+	{
+		static GLuint _next = 1;
+		for (GLsizei n = 0; n != _count; ++n)
+		{
+			_names[n] = _next++;
+		};
+	};
+
+	/**
+	 * @brief Stub for glIs* functions, reports every name as a valid object.
+	*/
+	inline GLboolean APIENTRY null_is(GLuint)
+	{
+		return GL_TRUE;
+	};
+
+	/**
+	 * @brief Replaces glad's function pointers with no-op stubs for as long as it is installed.
+	 *
+	 * Objects that the stubs can't fake (such as linked programs) should be created before installing.
+	*/
+	class null_dispatch
+	{
+	public:
+
+		/**
+		 * @brief Installs the stubs, saving the current function pointers.
+		*/
+		void install()
+		{
+			if (this->installed_)
+			{
+				return;
+			};
+#define JCLIB_OPENGL_BENCH_INSTALL(_name) \
+			this->_name##_ = glad_##_name; \
+			glad_##_name = &null_function<decltype(glad_##_name)>::invoke;
+			JCLIB_OPENGL_BENCH_NULL_FUNCTIONS(JCLIB_OPENGL_BENCH_INSTALL)
+#undef JCLIB_OPENGL_BENCH_INSTALL
+
+			glad_glCreateBuffers = &null_create;
+			glad_glCreateVertexArrays = &null_create;
+			glad_glIsBuffer = &null_is;
+			glad_glIsVertexArray = &null_is;
+			this->installed_ = true;
+		};
+
+		/**
+		 * @brief Restores the function pointers saved by install().
+		*/
+		void uninstall()
+		{
+			if (!this->installed_)
+			{
+				return;
+			};
+#define JCLIB_OPENGL_BENCH_UNINSTALL(_name) \
+			glad_##_name = this->_name##_;
+			JCLIB_OPENGL_BENCH_NULL_FUNCTIONS(JCLIB_OPENGL_BENCH_UNINSTALL)
+#undef JCLIB_OPENGL_BENCH_UNINSTALL
+			this->installed_ = false;
+		};
+
+		null_dispatch() = default;
+		~null_dispatch()
+		{
+			this->uninstall();
+		};
+
+	private:
+#define JCLIB_OPENGL_BENCH_SAVED(_name) \
+		decltype(glad_##_name) _name##_ = nullptr;
+		JCLIB_OPENGL_BENCH_NULL_FUNCTIONS(JCLIB_OPENGL_BENCH_SAVED)
+#undef JCLIB_OPENGL_BENCH_SAVED
+
+		bool installed_ = false;
+
+		null_dispatch(const null_dispatch&) = delete;
+		null_dispatch& operator=(const null_dispatch&) = delete;
+	};
+};
+
+#endif // JCLIB_OPENGL_BENCH_NULL_DISPATCH_HPP
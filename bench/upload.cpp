@@ -0,0 +1,628 @@
+/*
+	Compares buffer upload strategies across payload sizes against the headless context's driver.
+
+	Each iteration uploads one payload and then issues a small copy out of the uploaded range, standing
+	in for a draw that reads it, so the driver has to honour the dependency the same way it would for
+	real work. Ring based strategies cycle through ring_depth segments guarded by fences.
+
+	Reported per strategy and size:
+		throughput	payload bytes uploaded per second of wall time
+		cpu			thread CPU time per upload
+		stall		time per upload spent waiting on fences plus the closing glFinish
+
+	Iteration counts are fixed per size (not time scaled) and the median of the repetitions is reported,
+	so runs on the same machine are directly comparable.
+
+	usage: jcopengl_bench_upload [--filter TEXT] [--min-bytes N] [--max-bytes N] [--target-bytes N]
+		[--repetitions N] [--json PATH] [--csv PATH]
+*/
+
+#include <jclib/gl/gl.hpp>
+#include <jclib/gl/glheadless.hpp>
+
+#include <span>
+#include <array>
+#include <ctime>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <ostream>
+#include <algorithm>
+#include <functional>
+#include <string_view>
+
+namespace gl = jc::gl;
+
+namespace
+{
+	/**
+	 * @brief Number of segments used by the ring based strategies.
+	*/
+	constexpr size_t ring_depth = 3;
+
+	/**
+	 * @brief Bytes copied out of each upload into the sink buffer.
+	*/
+	constexpr size_t consume_bytes = 16;
+
+	using clock = std::chrono::steady_clock;
+
+	/**
+	 * @brief Gets the CPU time consumed by the calling thread.
+	*/
+	inline std::chrono::nanoseconds thread_cpu_time()
+	{
+#if defined(CLOCK_THREAD_CPUTIME_ID)
+		timespec _time{};
+		clock_gettime(CLOCK_THREAD_CPUTIME_ID, &_time);
+		return std::chrono::seconds{ _time.tv_sec } + std::chrono::nanoseconds{ _time.tv_nsec };
+#else
+		return std::chrono::nanoseconds{ (static_cast<long long>(std::clock()) * 1'000'000'000) / CLOCKS_PER_SEC };
+#endif
+	};
+
+	/**
+	 * @brief Accumulates time spent blocked on the GPU.
+	*/
+	struct stall_timer
+	{
+		std::chrono::nanoseconds total{};
+
+		void wait(const gl::sync_id& _sync)
+		{
+			const auto _start = clock::now();
+			while (gl::client_wait(_sync, 1'000'000'000) == gl::sync_status::timeout_expired) {};
+			this->total += clock::now() - _start;
+		};
+		void finish()
+		{
+			const auto _start = clock::now();
+			glFinish();
+			this->total += clock::now() - _start;
+		};
+	};
+
+	/**
+	 * @brief Where an upload ended up.
+	*/
+	struct upload_target
+	{
+		gl::vbo_id vbo;
+		size_t offset;
+	};
+
+	/**
+	 * @brief One upload strategy, created for a single payload size.
+	*/
+	class uploader
+	{
+	public:
+
+		/**
+		 * @brief Uploads a payload, waiting on fences through the stall timer when needed.
+		*/
+		virtual upload_target upload(std::span<const std::byte> _data, stall_timer& _stall) = 0;
+
+		/**
+		 * @brief Called once the consuming copy for the last upload has been issued.
+		*/
+		virtual void consumed() {};
+
+		virtual ~uploader() = default;
+	};
+
+	/**
+	 * @brief Keeps one fence per ring segment and waits on a segment's fence before reusing it.
+	*/
+	struct fence_ring
+	{
+		std::array<gl::unique_sync, ring_depth> fences{};
+		size_t segment = 0;
+
+		size_t acquire(stall_timer& _stall)
+		{
+			this->segment = (this->segment + 1) % ring_depth;
+			auto& _fence = this->fences[this->segment];
+			if (_fence)
+			{
+				_stall.wait(_fence);
+				_fence.reset();
+			};
+			return this->segment;
+		};
+		void release()
+		{
+			this->fences[this->segment] = gl::new_fence();
+		};
+	};
+
+	/**
+	 * @brief Re-specifies the whole buffer with buffer_data every upload.
+	*/
+	class buffer_data_uploader final : public uploader
+	{
+	public:
+		upload_target upload(std::span<const std::byte> _data, stall_timer&) final
+		{
+			gl::buffer_data(this->vbo_, _data, gl::vbo_usage::stream_draw);
+			return { this->vbo_, 0 };
+		};
+		explicit buffer_data_uploader(size_t) :
+			vbo_{ gl::new_vbo() }
+		{};
+	private:
+		gl::unique_vbo vbo_;
+	};
+
+	/**
+	 * @brief Orphans the storage with resize_buffer, then fills it with buffer_subdata.
+	*/
+	class orphan_subdata_uploader final : public uploader
+	{
+	public:
+		upload_target upload(std::span<const std::byte> _data, stall_timer&) final
+		{
+			gl::resize_buffer(this->vbo_, _data.size(), gl::vbo_usage::stream_draw);
+			gl::buffer_subdata(this->vbo_, _data);
+			return { this->vbo_, 0 };
+		};
+		explicit orphan_subdata_uploader(size_t _size) :
+			vbo_{ gl::new_vbo() }
+		{
+			gl::resize_buffer(this->vbo_, _size, gl::vbo_usage::stream_draw);
+		};
+	private:
+		gl::unique_vbo vbo_;
+	};
+
+	/**
+	 * @brief Overwrites the same storage with buffer_subdata, relying on the driver to synchronize.
+	*/
+	class subdata_uploader final : public uploader
+	{
+	public:
+		upload_target upload(std::span<const std::byte> _data, stall_timer&) final
+		{
+			gl::buffer_subdata(this->vbo_, _data);
+			return { this->vbo_, 0 };
+		};
+		explicit subdata_uploader(size_t _size) :
+			vbo_{ gl::new_vbo() }
+		{
+			gl::resize_buffer(this->vbo_, _size, gl::vbo_usage::stream_draw);
+		};
+	private:
+		gl::unique_vbo vbo_;
+	};
+
+	/**
+	 * @brief Maps the whole buffer with invalidate_buffer, copies and unmaps.
+	*/
+	class map_invalidate_uploader final : public uploader
+	{
+	public:
+		upload_target upload(std::span<const std::byte> _data, stall_timer&) final
+		{
+			const auto _mapped = gl::map_buffer_range(this->vbo_, 0, _data.size(),
+				gl::map_access_bit::write | gl::map_access_bit::invalidate_buffer);
+			std::memcpy(_mapped.data(), _data.data(), _data.size());
+			gl::unmap_buffer(this->vbo_);
+			return { this->vbo_, 0 };
+		};
+		explicit map_invalidate_uploader(size_t _size) :
+			vbo_{ gl::new_vbo() }
+		{
+			gl::resize_buffer(this->vbo_, _size, gl::vbo_usage::stream_draw);
+		};
+	private:
+		gl::unique_vbo vbo_;
+	};
+
+	/**
+	 * @brief Maps one ring segment unsynchronized per upload, fences keep segments from being overwritten in use.
+	*/
+	class map_unsynchronized_uploader final : public uploader
+	{
+	public:
+		upload_target upload(std::span<const std::byte> _data, stall_timer& _stall) final
+		{
+			const auto _offset = this->ring_.acquire(_stall) * this->size_;
+			const auto _mapped = gl::map_buffer_range(this->vbo_, _offset, _data.size(),
+				gl::map_access_bit::write | gl::map_access_bit::unsynchronized | gl::map_access_bit::invalidate_range);
+			std::memcpy(_mapped.data(), _data.data(), _data.size());
+			gl::unmap_buffer(this->vbo_);
+			return { this->vbo_, _offset };
+		};
+		void consumed() final
+		{
+			this->ring_.release();
+		};
+		explicit map_unsynchronized_uploader(size_t _size) :
+			vbo_{ gl::new_vbo() },
+			size_{ _size }
+		{
+			gl::resize_buffer(this->vbo_, _size * ring_depth, gl::vbo_usage::stream_draw);
+		};
+	private:
+		gl::unique_vbo vbo_;
+		fence_ring ring_{};
+		size_t size_;
+	};
+
+	/**
+	 * @brief Writes into a persistently mapped ring, coherent or flushed explicitly after each write.
+	*/
+	class persistent_uploader final : public uploader
+	{
+	public:
+		upload_target upload(std::span<const std::byte> _data, stall_timer& _stall) final
+		{
+			const auto _offset = this->ring_.acquire(_stall) * this->size_;
+			std::memcpy(this->mapped_.data() + _offset, _data.data(), _data.size());
+			if (!this->coherent_)
+			{
+				gl::flush_mapped_buffer_range(this->vbo_, _offset, _data.size());
+			};
+			return { this->vbo_, _offset };
+		};
+		void consumed() final
+		{
+			this->ring_.release();
+		};
+
+		persistent_uploader(size_t _size, bool _coherent) :
+			vbo_{ gl::new_vbo() },
+			size_{ _size },
+			coherent_{ _coherent }
+		{
+			auto _storage = gl::buffer_storage_bit::map_write | gl::buffer_storage_bit::map_persistent;
+			auto _access = gl::map_access_bit::write | gl::map_access_bit::persistent;
+			if (_coherent)
+			{
+				_storage |= gl::buffer_storage_bit::map_coherent;
+				_access |= gl::map_access_bit::coherent;
+			}
+			else
+			{
+				_access |= gl::map_access_bit::flush_explicit;
+			};
+			gl::set_buffer_storage(this->vbo_, _size * ring_depth, _storage);
+			this->mapped_ = gl::map_buffer_range(this->vbo_, 0, _size * ring_depth, _access);
+		};
+		~persistent_uploader()
+		{
+			gl::unmap_buffer(this->vbo_);
+		};
+	private:
+		gl::unique_vbo vbo_;
+		std::span<std::byte> mapped_{};
+		fence_ring ring_{};
+		size_t size_;
+		bool coherent_;
+	};
+
+	/**
+	 * @brief Writes into a persistently mapped staging ring and copies into storage the CPU can't map.
+	*/
+	class staging_copy_uploader final : public uploader
+	{
+	public:
+		upload_target upload(std::span<const std::byte> _data, stall_timer& _stall) final
+		{
+			const auto _offset = this->ring_.acquire(_stall) * this->size_;
+			std::memcpy(this->mapped_.data() + _offset, _data.data(), _data.size());
+			gl::copy_buffer_sub_data(this->staging_, this->vbo_, _offset, 0, _data.size());
+			return { this->vbo_, 0 };
+		};
+		void consumed() final
+		{
+			this->ring_.release();
+		};
+
+		explicit staging_copy_uploader(size_t _size) :
+			staging_{ gl::new_vbo() },
+			vbo_{ gl::new_vbo() },
+			size_{ _size }
+		{
+			const auto _storage = gl::buffer_storage_bit::map_write | gl::buffer_storage_bit::map_persistent |
+				gl::buffer_storage_bit::map_coherent;
+			gl::set_buffer_storage(this->staging_, _size * ring_depth, _storage);
+			this->mapped_ = gl::map_buffer_range(this->staging_, 0, _size * ring_depth,
+				gl::map_access_bit::write | gl::map_access_bit::persistent | gl::map_access_bit::coherent);
+			gl::set_buffer_storage(this->vbo_, _size, gl::buffer_storage_bit::none);
+		};
+		~staging_copy_uploader()
+		{
+			gl::unmap_buffer(this->staging_);
+		};
+	private:
+		gl::unique_vbo staging_;
+		gl::unique_vbo vbo_;
+		std::span<std::byte> mapped_{};
+		fence_ring ring_{};
+		size_t size_;
+	};
+
+	struct strategy
+	{
+		std::string_view name;
+		std::function<std::unique_ptr<uploader>(size_t _size)> make;
+	};
+
+	std::vector<strategy> make_strategies()
+	{
+		const auto _make = []<typename T>(std::in_place_type_t<T>)
+		{
+			return [](size_t _size) -> std::unique_ptr<uploader> { return std::make_unique<T>(_size); };
+		};
+		return
+		{
+			{ "buffer_data", _make(std::in_place_type<buffer_data_uploader>) },
+			{ "orphan_subdata", _make(std::in_place_type<orphan_subdata_uploader>) },
+			{ "subdata", _make(std::in_place_type<subdata_uploader>) },
+			{ "map_invalidate", _make(std::in_place_type<map_invalidate_uploader>) },
+			{ "map_unsynchronized", _make(std::in_place_type<map_unsynchronized_uploader>) },
+			{ "persistent_coherent", [](size_t _size) -> std::unique_ptr<uploader>
+				{ return std::make_unique<persistent_uploader>(_size, true); } },
+			{ "persistent_flush", [](size_t _size) -> std::unique_ptr<uploader>
+				{ return std::make_unique<persistent_uploader>(_size, false); } },
+			{ "staging_copy", _make(std::in_place_type<staging_copy_uploader>) },
+		};
+	};
+
+	/**
+	 * @brief Timing of one strategy at one payload size, medians over the repetitions.
+	*/
+	struct upload_result
+	{
+		std::string name;
+		size_t bytes;
+		size_t iterations;
+		double bytes_per_second;
+		double cpu_ns_per_upload;
+		double stall_ns_per_upload;
+		bool verified;
+	};
+
+	struct options
+	{
+		std::string filter{};
+		size_t min_bytes = 64;
+		size_t max_bytes = size_t{ 256 } << 20;
+
+		/**
+		 * @brief Payload bytes uploaded per repetition, sets the iteration count for each size.
+		*/
+		size_t target_bytes = size_t{ 64 } << 20;
+		size_t repetitions = 5;
+		std::string json_path{};
+		std::string csv_path{};
+	};
+
+	/**
+	 * @brief Number of uploads per repetition for a payload size.
+	*/
+	inline size_t iterations_for(const options& _options, size_t _bytes)
+	{
+		return std::clamp<size_t>(_options.target_bytes / _bytes, 4, 2048);
+	};
+
+	inline double median(std::vector<double> _samples)
+	{
+		std::ranges::sort(_samples);
+		return _samples[_samples.size() / 2];
+	};
+
+	/**
+	 * @brief Runs one strategy at one size, checking that the last upload arrived intact.
+	*/
+	upload_result run(const strategy& _strategy, std::span<const std::byte> _data, const options& _options)
+	{
+		const auto _iterations = iterations_for(_options, _data.size());
+
+		auto _uploader = _strategy.make(_data.size());
+		auto _sink = gl::new_vbo();
+		gl::resize_buffer(_sink, consume_bytes, gl::vbo_usage::stream_copy);
+		const auto _consumed = std::min(consume_bytes, _data.size());
+
+		upload_target _last{};
+		const auto _repetition = [&]()
+		{
+			stall_timer _stall{};
+			const auto _cpuStart = thread_cpu_time();
+			const auto _start = clock::now();
+			for (size_t n = 0; n != _iterations; ++n)
+			{
+				_last = _uploader->upload(_data, _stall);
+				gl::copy_buffer_sub_data(_last.vbo, _sink, _last.offset, 0, _consumed);
+				_uploader->consumed();
+			};
+			_stall.finish();
+			const auto _wall = std::chrono::duration<double, std::nano>(clock::now() - _start).count();
+			const auto _cpu = std::chrono::duration<double, std::nano>(thread_cpu_time() - _cpuStart).count();
+			return std::array<double, 3>
+			{
+				static_cast<double>(_data.size() * _iterations) / (_wall * 1e-9),
+				_cpu / static_cast<double>(_iterations),
+				std::chrono::duration<double, std::nano>(_stall.total).count() / static_cast<double>(_iterations)
+			};
+		};
+
+		// Warm up, first use of a buffer pays for allocation and driver side setup
+		_repetition();
+
+		std::array<std::vector<double>, 3> _samples{};
+		for (size_t n = 0; n != _options.repetitions; ++n)
+		{
+			const auto _sample = _repetition();
+			for (size_t i = 0; i != _sample.size(); ++i)
+			{
+				_samples[i].push_back(_sample[i]);
+			};
+		};
+
+		const auto _checked = std::min<size_t>(_data.size(), 64);
+		std::array<std::byte, 64> _readback{};
+		glGetNamedBufferSubData(_last.vbo.get(), static_cast<GLintptr>(_last.offset), static_cast<GLsizeiptr>(_checked),
+			_readback.data());
+
+		return upload_result
+		{
+			std::string{ _strategy.name },
+			_data.size(),
+			_iterations,
+			median(_samples[0]),
+			median(_samples[1]),
+			median(_samples[2]),
+			std::memcmp(_readback.data(), _data.data(), _checked) == 0
+		};
+	};
+
+	void write_table(std::FILE* _file, const std::vector<upload_result>& _results)
+	{
+		std::fprintf(_file, "%-20s %12s %10s %12s %14s %14s %6s\n", "strategy", "bytes", "iterations", "MB/s",
+			"cpu ns/upload", "stall ns/upload", "ok");
+		for (auto& r : _results)
+		{
+			std::fprintf(_file, "%-20s %12zu %10zu %12.1f %14.0f %14.0f %6s\n", r.name.c_str(), r.bytes, r.iterations,
+				r.bytes_per_second / 1e6, r.cpu_ns_per_upload, r.stall_ns_per_upload, r.verified ? "yes" : "NO");
+		};
+	};
+
+	void write_json(std::ostream& _out, const std::vector<upload_result>& _results, std::string_view _renderer)
+	{
+		_out << "{\n\t\"renderer\": \"" << _renderer << "\",\n\t\"results\": [\n";
+		for (size_t n = 0; n != _results.size(); ++n)
+		{
+			const auto& r = _results[n];
+			_out << "\t\t{ \"strategy\": \"" << r.name << "\", \"bytes\": " << r.bytes << ", \"iterations\": " << r.iterations
+				<< ", \"bytes_per_second\": " << r.bytes_per_second << ", \"cpu_ns_per_upload\": " << r.cpu_ns_per_upload
+				<< ", \"stall_ns_per_upload\": " << r.stall_ns_per_upload << ", \"verified\": " << (r.verified ? "true" : "false")
+				<< " }" << ((n + 1 != _results.size()) ? ",\n" : "\n");
+		};
+		_out << "\t]\n}\n";
+	};
+
+	void write_csv(std::ostream& _out, const std::vector<upload_result>& _results)
+	{
+		_out << "strategy,bytes,iterations,bytes_per_second,cpu_ns_per_upload,stall_ns_per_upload,verified\n";
+		for (auto& r : _results)
+		{
+			_out << r.name << ',' << r.bytes << ',' << r.iterations << ',' << r.bytes_per_second << ','
+				<< r.cpu_ns_per_upload << ',' << r.stall_ns_per_upload << ',' << (r.verified ? 1 : 0) << '\n';
+		};
+	};
+
+	bool parse_options(int _nargs, char* _vargs[], options& _options)
+	{
+		for (int n = 1; n < _nargs; ++n)
+		{
+			const auto _arg = std::string_view{ _vargs[n] };
+			const auto _value = (n + 1 < _nargs) ? std::string_view{ _vargs[n + 1] } : std::string_view{};
+			if (_value.empty() && _arg.starts_with("--"))
+			{
+				std::fprintf(stderr, "missing value for %s\n", _vargs[n]);
+				return false;
+			};
+
+			const auto _bytes = [&_value]()
+			{
+				return static_cast<size_t>(std::max(1LL, std::atoll(_value.data())));
+			};
+			if (_arg == "--filter")
+			{
+				_options.filter = _value;
+			}
+			else if (_arg == "--min-bytes")
+			{
+				_options.min_bytes = _bytes();
+			}
+			else if (_arg == "--max-bytes")
+			{
+				_options.max_bytes = _bytes();
+			}
+			else if (_arg == "--target-bytes")
+			{
+				_options.target_bytes = _bytes();
+			}
+			else if (_arg == "--repetitions")
+			{
+				_options.repetitions = static_cast<size_t>(std::max(1, std::atoi(_value.data())));
+			}
+			else if (_arg == "--json")
+			{
+				_options.json_path = _value;
+			}
+			else if (_arg == "--csv")
+			{
+				_options.csv_path = _value;
+			}
+			else
+			{
+				std::fprintf(stderr, "unknown argument %s\n", _vargs[n]);
+				return false;
+			};
+			++n;
+		};
+		return true;
+	};
+};
+
+int main(int _nargs, char* _vargs[])
+{
+	options _options{};
+	if (!parse_options(_nargs, _vargs, _options))
+	{
+		return 2;
+	};
+
+	gl::headless_context _context{};
+	if (!_context)
+	{
+		std::fprintf(stderr, "failed to create headless context: %s\n", _context.error().c_str());
+		return 1;
+	};
+	const auto _renderer = std::string{ reinterpret_cast<const char*>(glGetString(GL_RENDERER)) };
+	std::fprintf(stderr, "renderer: %s\n", _renderer.c_str());
+
+	// Deterministic payload so every run uploads the same bytes
+	std::vector<std::byte> _data(_options.max_bytes);
+	for (size_t n = 0; n != _data.size(); ++n)
+	{
+		_data[n] = static_cast<std::byte>((n * 2654435761u) >> 24);
+	};
+
+	std::vector<upload_result> _results{};
+	for (auto& _strategy : make_strategies())
+	{
+		if (!_options.filter.empty() && _strategy.name.find(_options.filter) == std::string_view::npos)
+		{
+			continue;
+		};
+		for (size_t _bytes = _options.min_bytes; _bytes <= _options.max_bytes; _bytes *= 4)
+		{
+			_results.push_back(run(_strategy, std::span<const std::byte>{ _data }.first(_bytes), _options));
+			std::fprintf(stderr, "%s %zu\n", _results.back().name.c_str(), _bytes);
+		};
+	};
+
+	write_table(stdout, _results);
+	if (!_options.json_path.empty())
+	{
+		auto _file = std::ofstream{ _options.json_path };
+		write_json(_file, _results, _renderer);
+	};
+	if (!_options.csv_path.empty())
+	{
+		auto _file = std::ofstream{ _options.csv_path };
+		write_csv(_file, _results);
+	};
+
+	const auto _failed = std::ranges::any_of(_results, [](const upload_result& r) { return !r.verified; });
+	return (_failed) ? 1 : 0;
+};
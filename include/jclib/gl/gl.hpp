@@ -20,6 +20,7 @@
 #include <span>
 #include <tuple>
 #include <array>
+#include <chrono>
 #include <string>
 #include <compare>
 #include <iostream>
@@ -90,6 +91,21 @@ namespace jc::gl
 	*/
 	using texture_id = object_id<object_type::texture>;
 
+	/**
+	 * @brief Invariant for storing OpenGL framebuffer object IDs
+	*/
+	using framebuffer_id = object_id<object_type::framebuffer>;
+
+	/**
+	 * @brief Invariant for storing OpenGL renderbuffer object IDs
+	*/
+	using renderbuffer_id = object_id<object_type::renderbuffer>;
+
+	/**
+	 * @brief Invariant for storing OpenGL sync object handles
+	*/
+	using sync_id = object_id<object_type::sync>;
+
 
 	namespace gl_impl
 	{
@@ -283,6 +299,18 @@ namespace jc::gl
 
 
 
+	/**
+	 * @brief Default destroy policy for unique_object, deletes the object immediately on the calling thread.
+	*/
+	struct immediate_destroy
+	{
+		template <object_type Type>
+		static void destroy(object_id<Type>& _id)
+		{
+			gl::destroy(_id);
+		};
+	};
+
 	/**
 	 * @brief Owning RAII OpenGL object id wrapper.
 	 *
@@ -296,17 +324,23 @@ namespace jc::gl
 	 *
 	 * 			bool object_traits<Type>::check(typename object_traits<Type>::value_type);
 	 *
+	 * DestroyPolicyT decides how the object is deleted when the owner is reset or destroyed, it must provide
+	 * "static void destroy(object_id<Type>&)" which nulls the id. See immediate_destroy and, from
+	 * glreclaim.hpp, reclaim_destroy.
+	 *
 	*/
-	template <object_type Type> requires requires (typename object_traits<Type>::value_type _value)
+	template <object_type Type, typename DestroyPolicyT = immediate_destroy> requires requires (typename object_traits<Type>::value_type _value)
 	{
 		{ object_traits<Type>::destroy(_value) } -> jc::cx_same_as<void>;
 		{ object_traits<Type>::check(_value) } -> jc::cx_convertible_to<bool>;
 	}
 	struct unique_object :
-		gl_impl::object_interface<Type, unique_object<Type>>
+		gl_impl::object_interface<Type, unique_object<Type, DestroyPolicyT>>
 	{
 	public:
 
+		using destroy_policy = DestroyPolicyT;
+
 		using id_type = object_id<Type>;
 
 		using value_type = typename id_type::value_type;
@@ -365,7 +399,10 @@ namespace jc::gl
 
 		void reset() noexcept
 		{
-			gl::destroy(this->id_);
+			if (this->good())
+			{
+				DestroyPolicyT::destroy(this->id_);
+			};
 			JCLIB_ASSERT(!this->good());
 		};
 
@@ -397,6 +434,19 @@ namespace jc::gl
 			return *this;
 		};
 
+		/**
+		 * @brief Takes ownership from an owner with a different destroy policy.
+		*/
+		template <typename OtherPolicyT>
+		constexpr explicit unique_object(unique_object<Type, OtherPolicyT>&& _other) noexcept :
+			id_{ _other.extract() }
+		{};
+
+		~unique_object()
+		{
+			this->reset();
+		};
+
 	private:
 		id_type id_{};
 
@@ -417,6 +467,21 @@ namespace jc::gl
 	*/
 	using unique_texture = unique_object<object_type::texture>;
 
+	/**
+	 * @brief Owning RAII handle to an OpenGL framebuffer object
+	*/
+	using unique_framebuffer = unique_object<object_type::framebuffer>;
+
+	/**
+	 * @brief Owning RAII handle to an OpenGL renderbuffer object
+	*/
+	using unique_renderbuffer = unique_object<object_type::renderbuffer>;
+
+	/**
+	 * @brief Owning RAII handle to an OpenGL sync object
+	*/
+	using unique_sync = unique_object<object_type::sync>;
+
 
 	// Helper functions for ease of use
 
@@ -440,11 +505,27 @@ namespace jc::gl
 	{
 		return unique_texture{ create<object_type::texture>(_target) };
 	};
+	inline unique_framebuffer new_framebuffer()
+	{
+		return unique_framebuffer{ create<object_type::framebuffer>() };
+	};
+	inline unique_renderbuffer new_renderbuffer()
+	{
+		return unique_renderbuffer{ create<object_type::renderbuffer>() };
+	};
+
+	/**
+	 * @brief Inserts a fence into the command stream, signaled once all previously issued commands complete
+	*/
+	inline unique_sync new_fence()
+	{
+		return unique_sync{ create<object_type::sync>() };
+	};
 
 
 
-	template <object_type Type>
-	inline void destroy(unique_object<Type>& _value)
+	template <object_type Type, typename DestroyPolicyT>
+	inline void destroy(unique_object<Type, DestroyPolicyT>& _value)
 	{
 		_value.reset();
 	};
@@ -460,8 +541,8 @@ namespace jc::gl
 		object_id<Type>::traits_type::bind(_id.get(), std::forward<ArgTs>(_args)...);
 	};
 
-	template <object_type Type, typename... ArgTs>
-	inline auto bind(const unique_object<Type>& _obj, ArgTs&&... _args) ->
+	template <object_type Type, typename DestroyPolicyT, typename... ArgTs>
+	inline auto bind(const unique_object<Type, DestroyPolicyT>& _obj, ArgTs&&... _args) ->
 		decltype(bind(_obj.id(), std::forward<ArgTs>(_args)...))
 	{
 		return bind(_obj.id(), std::forward<ArgTs>(_args)...);
@@ -639,6 +720,8 @@ namespace jc::gl
 			return "byte";
 		case typecode::gl_unsigned_byte:
 			return "unsigned_byte";
+		case typecode::gl_half_float:
+			return "half_float";
 		case typecode::gl_int_vec2:
 			return "int_vec2";
 		case typecode::gl_int_vec3:
@@ -755,6 +838,9 @@ namespace jc::gl
 	template <> struct opengl_type<typecode::gl_unsigned_byte> { using type = GLubyte; };
 	using gl_unsigned_byte = opengl_type_t<typecode::gl_unsigned_byte>;
 
+	template <> struct opengl_type<typecode::gl_half_float> { using type = GLhalf; };
+	using gl_half_float = opengl_type_t<typecode::gl_half_float>;
+
 	using gl_sizei = GLsizei;
 	using gl_sizeiptr = GLsizeiptr;
 	
@@ -825,6 +911,85 @@ namespace jc::gl
 	{
 		return draw_elements_instanced(primitive::triangles, _instanceCount, _indiceType, _count, _first);
 	};
+
+	/**
+	 * @brief Indirect indexed draw parameters, matches the layout OpenGL reads from a draw_indirect buffer.
+	 *
+	 * https://www.khronos.org/registry/OpenGL-Refpages/gl4/html/glDrawElementsIndirect.xhtml
+	*/
+	struct draw_elements_command
+	{
+		gl_unsigned_int count;
+		gl_unsigned_int instance_count;
+		gl_unsigned_int first_index;
+		gl_int base_vertex;
+		gl_unsigned_int base_instance;
+	};
+
+	/**
+	 * @brief Indirect non-indexed draw parameters, matches the layout OpenGL reads from a draw_indirect buffer.
+	 *
+	 * https://www.khronos.org/registry/OpenGL-Refpages/gl4/html/glDrawArraysIndirect.xhtml
+	*/
+	struct draw_arrays_command
+	{
+		gl_unsigned_int count;
+		gl_unsigned_int instance_count;
+		gl_unsigned_int first;
+		gl_unsigned_int base_instance;
+	};
+
+	/**
+	 * @brief Draws using a draw_elements_command read from the vbo bound to vbo_target::draw_indirect.
+	 *
+	 * https://www.khronos.org/registry/OpenGL-Refpages/gl4/html/glDrawElementsIndirect.xhtml
+	 *
+	 * @param _mode Primitive type to draw.
+	 * @param _indiceType Index typecode of the bound element array.
+	 * @param _offsetBytes Offset of the command in the indirect buffer.
+	*/
+	inline void draw_elements_indirect(primitive _mode, typecode _indiceType, size_t _offsetBytes = 0)
+	{
+		glDrawElementsIndirect(jc::to_underlying(_mode), jc::to_underlying(_indiceType), reinterpret_cast<const void*>(_offsetBytes));
+	};
+
+	/**
+	 * @brief Draws using a packed array of draw_elements_command read from the vbo bound to vbo_target::draw_indirect.
+	 *
+	 * https://www.khronos.org/registry/OpenGL-Refpages/gl4/html/glMultiDrawElementsIndirect.xhtml
+	 *
+	 * @param _mode Primitive type to draw.
+	 * @param _indiceType Index typecode of the bound element array.
+	 * @param _drawCount Number of commands to draw.
+	 * @param _offsetBytes Offset of the first command in the indirect buffer.
+	 * @param _strideBytes Distance between commands, 0 for tightly packed.
+	*/
+	inline void multi_draw_elements_indirect(primitive _mode, typecode _indiceType, size_t _drawCount,
+		size_t _offsetBytes = 0, size_t _strideBytes = 0)
+	{
+		glMultiDrawElementsIndirect(jc::to_underlying(_mode), jc::to_underlying(_indiceType), reinterpret_cast<const void*>(_offsetBytes),
+			static_cast<GLsizei>(_drawCount), static_cast<GLsizei>(_strideBytes));
+	};
+	inline void multi_draw_elements_indirect(typecode _indiceType, size_t _drawCount, size_t _offsetBytes = 0, size_t _strideBytes = 0)
+	{
+		return multi_draw_elements_indirect(primitive::triangles, _indiceType, _drawCount, _offsetBytes, _strideBytes);
+	};
+
+	/**
+	 * @brief Draws using a packed array of draw_arrays_command read from the vbo bound to vbo_target::draw_indirect.
+	 *
+	 * https://www.khronos.org/registry/OpenGL-Refpages/gl4/html/glMultiDrawArraysIndirect.xhtml
+	 *
+	 * @param _mode Primitive type to draw.
+	 * @param _drawCount Number of commands to draw.
+	 * @param _offsetBytes Offset of the first command in the indirect buffer.
+	 * @param _strideBytes Distance between commands, 0 for tightly packed.
+	*/
+	inline void multi_draw_arrays_indirect(primitive _mode, size_t _drawCount, size_t _offsetBytes = 0, size_t _strideBytes = 0)
+	{
+		glMultiDrawArraysIndirect(jc::to_underlying(_mode), reinterpret_cast<const void*>(_offsetBytes),
+			static_cast<GLsizei>(_drawCount), static_cast<GLsizei>(_strideBytes));
+	};
 };
 #pragma endregion
 
@@ -906,13 +1071,15 @@ namespace jc::gl
 	inline void buffer_data(const vbo_id& _vbo, const RangeT& _data, vbo_usage _usage = vbo_usage::static_draw)
 	{
 		JCLIB_ASSERT(_vbo);
+		const auto _bytes = std::ranges::size(_data) * sizeof(jc::ranges::value_t<RangeT>);
 		glNamedBufferData
 		(
 			_vbo.get(),
-			std::ranges::size(_data) * sizeof(jc::ranges::value_t<RangeT>),
+			_bytes,
 			std::ranges::data(_data),
 			jc::to_underlying(_usage)
 		);
+		gl_impl::track_allocation(memory_category::buffer, _vbo.get(), _bytes);
 	};
 
 	/**
@@ -931,6 +1098,7 @@ namespace jc::gl
 	{
 		JCLIB_ASSERT(_vbo);
 		glNamedBufferData(_vbo.get(), _elementCount * sizeof(ElementT), nullptr, jc::to_underlying(_usage));
+		gl_impl::track_allocation(memory_category::buffer, _vbo.get(), _elementCount * sizeof(ElementT));
 	};
 
 	/**
@@ -955,8 +1123,164 @@ namespace jc::gl
 		);
 	};
 
+	/**
+	 * @brief Maps a range of a vbo's data into client memory.
+	 *
+	 * https://www.khronos.org/registry/OpenGL-Refpages/gl4/html/glMapBufferRange.xhtml
+	 *
+	 * @tparam ElementT Element type to view the mapped memory as.
+	 * @param _vbo The vbo to map.
+	 * @param _offset Offset of the range in elements.
+	 * @param _count Number of elements to map.
+	 * @param _access How the mapped memory will be accessed.
+	 * @return The mapped memory, empty if mapping failed.
+	*/
+	template <typename ElementT = std::byte>
+	inline std::span<ElementT> map_buffer_range(const vbo_id& _vbo, size_t _offset, size_t _count, map_access_bit _access)
+	{
+		JCLIB_ASSERT(_vbo);
+		const auto _ptr = glMapNamedBufferRange(_vbo.get(), static_cast<GLintptr>(_offset * sizeof(ElementT)),
+			static_cast<GLsizeiptr>(_count * sizeof(ElementT)), jc::to_underlying(_access));
+		if (!_ptr)
+		{
+			return {};
+		};
+		return std::span<ElementT>{ static_cast<ElementT*>(_ptr), _count };
+	};
+
+	/**
+	 * @brief Flushes writes to part of a range mapped with map_access_bit::flush_explicit.
+	 *
+	 * https://www.khronos.org/registry/OpenGL-Refpages/gl4/html/glFlushMappedBufferRange.xhtml
+	 *
+	 * @tparam ElementT Element type the mapped memory is viewed as.
+	 * @param _vbo The mapped vbo.
+	 * @param _offset Offset in elements relative to the start of the mapped range.
+	 * @param _count Number of elements to flush.
+	*/
+	template <typename ElementT = std::byte>
+	inline void flush_mapped_buffer_range(const vbo_id& _vbo, size_t _offset, size_t _count)
+	{
+		JCLIB_ASSERT(_vbo);
+		glFlushMappedNamedBufferRange(_vbo.get(), static_cast<GLintptr>(_offset * sizeof(ElementT)),
+			static_cast<GLsizeiptr>(_count * sizeof(ElementT)));
+	};
+
+	/**
+	 * @brief Unmaps a mapped vbo.
+	 *
+	 * https://www.khronos.org/registry/OpenGL-Refpages/gl4/html/glUnmapBuffer.xhtml
+	 *
+	 * @param _vbo The mapped vbo.
+	 * @return False if the data store was corrupted while mapped and must be respecified.
+	*/
+	inline bool unmap_buffer(const vbo_id& _vbo)
+	{
+		JCLIB_ASSERT(_vbo);
+		return glUnmapNamedBuffer(_vbo.get()) == GL_TRUE;
+	};
+
+	/**
+	 * @brief Creates the immutable storage for a vbo and fills it with data.
+	 *
+	 * https://www.khronos.org/registry/OpenGL-Refpages/gl4/html/glBufferStorage.xhtml
+	 *
+	 * @param _vbo The vbo to create storage for, must not already have immutable storage.
+	 * @param _data The data to assign to the vbo.
+	 * @param _flags How the storage may be used.
+	*/
+	template <std::ranges::contiguous_range RangeT>
+	inline void buffer_storage(const vbo_id& _vbo, const RangeT& _data, buffer_storage_bit _flags = buffer_storage_bit::none)
+	{
+		JCLIB_ASSERT(_vbo);
+		const auto _bytes = std::ranges::size(_data) * sizeof(jc::ranges::value_t<RangeT>);
+		glNamedBufferStorage
+		(
+			_vbo.get(),
+			_bytes,
+			std::ranges::data(_data),
+			jc::to_underlying(_flags)
+		);
+		gl_impl::track_allocation(memory_category::buffer, _vbo.get(), _bytes);
+	};
+
+	/**
+	 * @brief Creates uninitialized immutable storage for a vbo.
+	 *
+	 * https://www.khronos.org/registry/OpenGL-Refpages/gl4/html/glBufferStorage.xhtml
+	 *
+	 * @tparam ElementT Element type to size the storage with.
+	 * @param _vbo The vbo to create storage for, must not already have immutable storage.
+	 * @param _elementCount Number of elements to allocate space for.
+	 * @param _flags How the storage may be used.
+	*/
+	template <typename ElementT = std::byte>
+	inline void set_buffer_storage(const vbo_id& _vbo, size_t _elementCount, buffer_storage_bit _flags)
+	{
+		JCLIB_ASSERT(_vbo);
+		glNamedBufferStorage(_vbo.get(), _elementCount * sizeof(ElementT), nullptr, jc::to_underlying(_flags));
+		gl_impl::track_allocation(memory_category::buffer, _vbo.get(), _elementCount * sizeof(ElementT));
+	};
+
+	/**
+	 * @brief Copies part of one vbo's data into another (or the same) vbo on the GPU.
+	 *
+	 * https://www.khronos.org/registry/OpenGL-Refpages/gl4/html/glCopyBufferSubData.xhtml
+	 *
+	 * @param _source The vbo to read from.
+	 * @param _destination The vbo to write to.
+	 * @param _sourceOffsetBytes Where to start reading.
+	 * @param _destinationOffsetBytes Where to start writing.
+	 * @param _sizeBytes Number of bytes to copy.
+	*/
+	inline void copy_buffer_sub_data(const vbo_id& _source, const vbo_id& _destination,
+		size_t _sourceOffsetBytes, size_t _destinationOffsetBytes, size_t _sizeBytes)
+	{
+		JCLIB_ASSERT(_source);
+		JCLIB_ASSERT(_destination);
+		glCopyNamedBufferSubData(_source.get(), _destination.get(), static_cast<GLintptr>(_sourceOffsetBytes),
+			static_cast<GLintptr>(_destinationOffsetBytes), static_cast<GLsizeiptr>(_sizeBytes));
+	};
+
 #endif
 
+	/**
+	 * @brief Binds a vbo to an indexed binding point of a target.
+	 *
+	 * https://www.khronos.org/registry/OpenGL-Refpages/gl4/html/glBindBufferBase.xhtml
+	 *
+	 * @param _target Target with the indexed binding point.
+	 * @param _index Index of the binding point.
+	 * @param _vbo The vbo to bind, may be null to unbind.
+	*/
+	inline void bind_buffer_base(indexed_vbo_target _target, gl_unsigned_int _index, const vbo_id& _vbo)
+	{
+		glBindBufferBase(jc::to_underlying(_target), _index, _vbo.get());
+	};
+
+	/**
+	 * @brief Binds a range of a vbo to an indexed binding point of a target.
+	 *
+	 * The offset must be a multiple of the target's offset alignment, see get_uniform_buffer_offset_alignment()
+	 * and get_shader_storage_buffer_offset_alignment().
+	 *
+	 * https://www.khronos.org/registry/OpenGL-Refpages/gl4/html/glBindBufferRange.xhtml
+	 *
+	 * @param _target Target with the indexed binding point.
+	 * @param _index Index of the binding point.
+	 * @param _vbo The vbo to bind, MUST NOT BE NULL.
+	 * @param _offsetBytes Offset of the range in bytes.
+	 * @param _sizeBytes Size of the range in bytes, must be greater than 0.
+	*/
+	inline void bind_buffer_range(indexed_vbo_target _target, gl_unsigned_int _index, const vbo_id& _vbo,
+		size_t _offsetBytes, size_t _sizeBytes)
+	{
+		JCLIB_ASSERT(_vbo);
+		JCLIB_ASSERT(_sizeBytes != 0);
+		glBindBufferRange(jc::to_underlying(_target), _index, _vbo.get(),
+			static_cast<GLintptr>(_offsetBytes), static_cast<GLsizeiptr>(_sizeBytes));
+	};
+
 };
 #pragma endregion
 
@@ -1195,6 +1519,47 @@ namespace jc::gl
 		using parent_type::operator=;
 	};
 
+	/**
+	 * @brief Integer invariant for holding program shader storage block indices
+	*/
+	struct storage_block_location : public gl_impl::integer_invariant<GLuint, struct storage_block_location_tag>
+	{
+	private:
+		using parent_type = gl_impl::integer_invariant<GLuint, struct storage_block_location_tag>;
+	public:
+
+		/**
+		 * @brief Constructs the storage block location using a program resource location
+		 * @param _location Storage block location as a program resource
+		*/
+		constexpr storage_block_location(const resource_location _location) :
+			parent_type{ _location.get() }
+		{};
+
+		using parent_type::parent_type;
+		using parent_type::operator=;
+	};
+
+	/**
+	 * @brief Integer invariant for holding shader storage buffer binding points
+	*/
+	struct storage_binding_point : public gl_impl::integer_invariant<GLuint, struct storage_binding_point_tag>
+	{
+	private:
+		using parent_type = gl_impl::integer_invariant<GLuint, struct storage_binding_point_tag>;
+	public:
+
+		/**
+		 * @brief Constructs the storage binding point from its index
+		 * @param _index Binding point index
+		*/
+		constexpr storage_binding_point(const GLuint _index) :
+			parent_type{ _index }
+		{};
+
+		using parent_type::operator=;
+	};
+
 	/**
 	 * @brief Gets the location of a program uniform block.
 	 * 
@@ -1235,6 +1600,104 @@ namespace jc::gl
 		glUniformBlockBinding(_program.get(), _index.get(), _binding.get());
 	};
 
+	/**
+	 * @brief Binds a vbo to a uniform buffer binding point.
+	 *
+	 * See https://www.khronos.org/registry/OpenGL-Refpages/gl4/html/glBindBufferBase.xhtml
+	 *
+	 * @param _binding The binding point to bind to.
+	 * @param _vbo The vbo to bind, may be null to unbind.
+	*/
+	inline void bind_buffer_base(const uniform_binding_point& _binding, const vbo_id& _vbo)
+	{
+		bind_buffer_base(indexed_vbo_target::uniform, _binding.get(), _vbo);
+	};
+
+	/**
+	 * @brief Binds a range of a vbo to a uniform buffer binding point.
+	 *
+	 * See https://www.khronos.org/registry/OpenGL-Refpages/gl4/html/glBindBufferRange.xhtml
+	 *
+	 * @param _binding The binding point to bind to.
+	 * @param _vbo The vbo to bind, MUST NOT BE NULL.
+	 * @param _offsetBytes Offset of the range in bytes, must be a multiple of get_uniform_buffer_offset_alignment().
+	 * @param _sizeBytes Size of the range in bytes.
+	*/
+	inline void bind_buffer_range(const uniform_binding_point& _binding, const vbo_id& _vbo, size_t _offsetBytes, size_t _sizeBytes)
+	{
+		bind_buffer_range(indexed_vbo_target::uniform, _binding.get(), _vbo, _offsetBytes, _sizeBytes);
+	};
+
+#if GL_VERSION_4_3
+	/**
+	 * @brief Gets the location of a program shader storage block.
+	 *
+	 * See https://www.khronos.org/registry/OpenGL-Refpages/gl4/html/glGetProgramResourceIndex.xhtml
+	 *
+	 * @param _program Program ID, must not be null.
+	 * @param _name Name of the shader storage block, must not be null.
+	 *
+	 * @return The storage block's location, or null if not found.
+	*/
+	inline jc::optional<storage_block_location> get_shader_storage_block_index(const program_id& _program, const GLchar* _name)
+	{
+		JCLIB_ASSERT(_program);
+		JCLIB_ASSERT(_name);
+
+		if (const auto _location = glGetProgramResourceIndex(_program.get(), GL_SHADER_STORAGE_BLOCK, _name); _location != GL_INVALID_INDEX)
+		{
+			return storage_block_location{ static_cast<GLuint>(_location) };
+		}
+		else
+		{
+			return nullopt;
+		};
+	};
+
+	/**
+	 * @brief Sets the buffer binding point that a shader storage block uses for its storage.
+	 *
+	 * See https://www.khronos.org/registry/OpenGL-Refpages/gl4/html/glShaderStorageBlockBinding.xhtml
+	 *
+	 * @param _program The program the storage block is in. Must not be null.
+	 * @param _index The index of the storage block. See get_shader_storage_block_index.
+	 * @param _binding The binding point to assign the storage block to use.
+	*/
+	inline void shader_storage_block_binding(const program_id& _program, const storage_block_location& _index, const storage_binding_point& _binding)
+	{
+		JCLIB_ASSERT(_program);
+		glShaderStorageBlockBinding(_program.get(), _index.get(), _binding.get());
+	};
+
+	/**
+	 * @brief Binds a vbo to a shader storage buffer binding point.
+	 *
+	 * See https://www.khronos.org/registry/OpenGL-Refpages/gl4/html/glBindBufferBase.xhtml
+	 *
+	 * @param _binding The binding point to bind to.
+	 * @param _vbo The vbo to bind, may be null to unbind.
+	*/
+	inline void bind_buffer_base(const storage_binding_point& _binding, const vbo_id& _vbo)
+	{
+		bind_buffer_base(indexed_vbo_target::shader_storage, _binding.get(), _vbo);
+	};
+
+	/**
+	 * @brief Binds a range of a vbo to a shader storage buffer binding point.
+	 *
+	 * See https://www.khronos.org/registry/OpenGL-Refpages/gl4/html/glBindBufferRange.xhtml
+	 *
+	 * @param _binding The binding point to bind to.
+	 * @param _vbo The vbo to bind, MUST NOT BE NULL.
+	 * @param _offsetBytes Offset of the range in bytes, must be a multiple of get_shader_storage_buffer_offset_alignment().
+	 * @param _sizeBytes Size of the range in bytes.
+	*/
+	inline void bind_buffer_range(const storage_binding_point& _binding, const vbo_id& _vbo, size_t _offsetBytes, size_t _sizeBytes)
+	{
+		bind_buffer_range(indexed_vbo_target::shader_storage, _binding.get(), _vbo, _offsetBytes, _sizeBytes);
+	};
+#endif
+
 
 	/**
 	 * @brief Gets the location of a program input resource.
@@ -1601,6 +2064,121 @@ namespace jc::gl
 };
 #pragma endregion
 
+#pragma region COMPUTE
+namespace jc::gl
+{
+#if GL_VERSION_4_3
+	/**
+	 * @brief Layout of a single indirect dispatch command as read by dispatch_compute_indirect().
+	*/
+	struct dispatch_indirect_command
+	{
+		gl_unsigned_int num_groups_x;
+		gl_unsigned_int num_groups_y;
+		gl_unsigned_int num_groups_z;
+	};
+
+	/**
+	 * @brief Gets the number of work groups needed to cover a number of work items.
+	 * @param _count Number of work items.
+	 * @param _groupSize Local size of the work group along the same axis.
+	 * @return Work group count, rounded up.
+	*/
+	constexpr inline gl_unsigned_int dispatch_group_count(size_t _count, size_t _groupSize) noexcept
+	{
+		return static_cast<gl_unsigned_int>((_count + _groupSize - 1) / _groupSize);
+	};
+
+	/**
+	 * @brief Launches work groups using the compute program in use.
+	 *
+	 * https://www.khronos.org/registry/OpenGL-Refpages/gl4/html/glDispatchCompute.xhtml
+	 *
+	 * @param _groupsX Number of work groups in the X dimension.
+	 * @param _groupsY Number of work groups in the Y dimension.
+	 * @param _groupsZ Number of work groups in the Z dimension.
+	*/
+	inline void dispatch_compute(gl_unsigned_int _groupsX, gl_unsigned_int _groupsY = 1, gl_unsigned_int _groupsZ = 1)
+	{
+		glDispatchCompute(_groupsX, _groupsY, _groupsZ);
+	};
+
+	/**
+	 * @brief Launches work groups using a dispatch_indirect_command read from the vbo bound to vbo_target::dispatch_indirect.
+	 *
+	 * https://www.khronos.org/registry/OpenGL-Refpages/gl4/html/glDispatchComputeIndirect.xhtml
+	 *
+	 * @param _offsetBytes Offset of the command in the indirect buffer, must be a multiple of 4.
+	*/
+	inline void dispatch_compute_indirect(size_t _offsetBytes = 0)
+	{
+		JCLIB_ASSERT(_offsetBytes % 4 == 0);
+		glDispatchComputeIndirect(static_cast<GLintptr>(_offsetBytes));
+	};
+
+	/**
+	 * @brief Binds a vbo to vbo_target::dispatch_indirect and launches work groups using a dispatch_indirect_command read from it.
+	 *
+	 * https://www.khronos.org/registry/OpenGL-Refpages/gl4/html/glDispatchComputeIndirect.xhtml
+	 *
+	 * @param _vbo Vbo holding the command, remains bound on return.
+	 * @param _offsetBytes Offset of the command in the vbo, must be a multiple of 4.
+	*/
+	inline void dispatch_compute_indirect(const vbo_id& _vbo, size_t _offsetBytes = 0)
+	{
+		JCLIB_ASSERT(_vbo);
+		bind(_vbo, vbo_target::dispatch_indirect);
+		dispatch_compute_indirect(_offsetBytes);
+	};
+
+	/**
+	 * @brief Gets the local work group size a linked compute program was compiled with.
+	 *
+	 * https://www.khronos.org/registry/OpenGL-Refpages/gl4/html/glGetProgram.xhtml
+	 *
+	 * @param _program Linked program containing a compute shader.
+	 * @return Local size in the X, Y and Z dimensions.
+	*/
+	inline std::array<GLint, 3> get_compute_work_group_size(const program_id& _program)
+	{
+		JCLIB_ASSERT(_program);
+		std::array<GLint, 3> _size{};
+		get(_program, program_parameter::compute_work_group_size, std::span<GLint, 3>{ _size });
+		return _size;
+	};
+#endif
+
+#if GL_VERSION_4_2
+	/**
+	 * @brief Orders memory transactions issued before the barrier against those issued after it.
+	 *
+	 * https://www.khronos.org/registry/OpenGL-Refpages/gl4/html/glMemoryBarrier.xhtml
+	 *
+	 * @param _barriers How the written memory will be accessed after the barrier.
+	*/
+	inline void memory_barrier(memory_barrier_bit _barriers)
+	{
+		glMemoryBarrier(jc::to_underlying(_barriers));
+	};
+#endif
+
+#if GL_VERSION_4_5
+	/**
+	 * @brief Same as memory_barrier() but only orders accesses within the same framebuffer region.
+	 *
+	 * https://www.khronos.org/registry/OpenGL-Refpages/gl4/html/glMemoryBarrier.xhtml
+	 *
+	 * @param _barriers How the written memory will be accessed after the barrier, only fragment shader related bits are allowed.
+	*/
+	inline void memory_barrier_by_region(memory_barrier_bit _barriers)
+	{
+		glMemoryBarrierByRegion(jc::to_underlying(_barriers));
+	};
+#endif
+
+};
+#pragma endregion
+
 #pragma region TEXTURE
 
 namespace jc::gl
@@ -1633,6 +2211,7 @@ namespace jc::gl
 	inline void set_storage_1D(texture_id _texture, internal_format _format, GLsizei _width, GLsizei _levels = 1)
 	{
 		glTextureStorage1D(_texture.get(), _levels, jc::to_underlying(_format), _width);
+		gl_impl::track_allocation(memory_category::texture, _texture.get(), texture_storage_bytes(_format, _width, 1, 1, 1, _levels));
 	};
 
 	/**
@@ -1648,6 +2227,7 @@ namespace jc::gl
 	inline void set_storage_2D(texture_id _texture, internal_format _format, GLsizei _width, GLsizei _height, GLsizei _levels = 1)
 	{
 		glTextureStorage2D(_texture.get(), _levels, jc::to_underlying(_format), _width, _height);
+		gl_impl::track_texture_storage(_texture.get(), _format, _width, _height, 1, _levels);
 	};
 
 	/**
@@ -1664,6 +2244,7 @@ namespace jc::gl
 	inline void set_storage_3D(texture_id _texture, internal_format _format, GLsizei _width, GLsizei _height, GLsizei _depth, GLsizei _levels = 1)
 	{
 		glTextureStorage3D(_texture.get(), _levels, jc::to_underlying(_format), _width, _height, _depth);
+		gl_impl::track_texture_storage(_texture.get(), _format, _width, _height, _depth, _levels);
 	};
 
 
@@ -1826,6 +2407,337 @@ namespace jc::gl
 
 #pragma endregion
 
+#pragma region SYNC
+namespace jc::gl
+{
+	/**
+	 * @brief Blocks the calling thread until a sync object is signaled or the timeout expires.
+	 *
+	 * https://www.khronos.org/registry/OpenGL-Refpages/gl4/html/glClientWaitSync.xhtml
+	 *
+	 * @param _sync Sync object to wait on.
+	 * @param _timeoutNs How long to wait in nanoseconds, 0 polls the status.
+	 * @param _flush Flushes the command stream first so the wait can't deadlock on unsubmitted commands.
+	 * @return Why the wait ended.
+	*/
+	inline sync_status client_wait(const sync_id& _sync, GLuint64 _timeoutNs, bool _flush = true)
+	{
+		JCLIB_ASSERT(_sync);
+		return static_cast<sync_status>(glClientWaitSync(_sync.get(), (_flush) ? GL_SYNC_FLUSH_COMMANDS_BIT : 0, _timeoutNs));
+	};
+
+	/**
+	 * @brief Makes the server wait for a sync object before executing further commands, returns immediately.
+	 *
+	 * https://www.khronos.org/registry/OpenGL-Refpages/gl4/html/glWaitSync.xhtml
+	 *
+	 * @param _sync Sync object to wait on, usually a fence from another context.
+	*/
+	inline void server_wait(const sync_id& _sync)
+	{
+		JCLIB_ASSERT(_sync);
+		glWaitSync(_sync.get(), 0, GL_TIMEOUT_IGNORED);
+	};
+
+	/**
+	 * @brief Result of wait_signaled().
+	*/
+	struct sync_wait_result
+	{
+		/**
+		 * @brief already_signaled if the wait didn't block, condition_satisfied if it did, wait_failed if the
+		 * sync could not be waited on and glFinish() was used instead.
+		*/
+		sync_status status = sync_status::already_signaled;
+
+		/**
+		 * @brief Time spent blocked, 0 if the sync was already signaled.
+		*/
+		std::chrono::nanoseconds waited{ 0 };
+
+		/**
+		 * @brief Checks if the calling thread had to wait for the GPU.
+		*/
+		constexpr bool stalled() const noexcept
+		{
+			return this->status != sync_status::already_signaled;
+		};
+	};
+
+	/**
+	 * @brief Blocks until a sync object is signaled, however long that takes.
+	 *
+	 * Polls first so an already signaled sync costs one call, then flushes and waits in one second slices. If
+	 * the wait fails the whole pipeline is drained with glFinish() so the caller can still rely on the GPU
+	 * being done with everything before the sync.
+	 *
+	 * @param _sync Sync object to wait on.
+	 * @return How the wait ended and how long it blocked.
+	*/
+	inline sync_wait_result wait_signaled(const sync_id& _sync)
+	{
+		sync_wait_result _out{};
+		auto _status = client_wait(_sync, 0);
+		if (_status == sync_status::already_signaled || _status == sync_status::condition_satisfied)
+		{
+			return _out;
+		};
+
+		const auto _start = std::chrono::steady_clock::now();
+		while (_status == sync_status::timeout_expired)
+		{
+			_status = client_wait(_sync, 1'000'000'000, false);
+		};
+		if (_status == sync_status::wait_failed)
+		{
+			glFinish();
+		};
+
+		_out.status = (_status == sync_status::wait_failed) ? sync_status::wait_failed : sync_status::condition_satisfied;
+		_out.waited = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - _start);
+		return _out;
+	};
+
+	/**
+	 * @brief Checks if a sync object has been signaled without waiting.
+	 *
+	 * https://www.khronos.org/registry/OpenGL-Refpages/gl4/html/glGetSync.xhtml
+	 *
+	 * @param _sync Sync object to check.
+	 * @return True if signaled, false otherwise.
+	*/
+	inline bool is_signaled(const sync_id& _sync)
+	{
+		JCLIB_ASSERT(_sync);
+		GLint _status = GL_UNSIGNALED;
+		glGetSynciv(_sync.get(), GL_SYNC_STATUS, 1, nullptr, &_status);
+		return _status == GL_SIGNALED;
+	};
+
+};
+#pragma endregion
+
+#pragma region FRAMEBUFFER
+namespace jc::gl
+{
+#if GL_VERSION_4_5
+	/**
+	 * @brief Specifies the storage for a renderbuffer
+	 * https://www.khronos.org/registry/OpenGL-Refpages/gl4/html/glRenderbufferStorage.xhtml
+	 *
+	 * @param _renderbuffer Renderbuffer to allocate
+	 * @param _format Internal data format
+	 * @param _width Width in pixels
+	 * @param _height Height in pixels
+	*/
+	inline void set_renderbuffer_storage(const renderbuffer_id& _renderbuffer, internal_format _format, GLsizei _width, GLsizei _height)
+	{
+		JCLIB_ASSERT(_renderbuffer);
+		glNamedRenderbufferStorage(_renderbuffer.get(), jc::to_underlying(_format), _width, _height);
+		gl_impl::track_allocation(memory_category::renderbuffer, _renderbuffer.get(), texture_storage_bytes(_format, _width, _height, 1, 1, 1));
+	};
+
+	/**
+	 * @brief Specifies the storage for a multisampled renderbuffer
+	 * https://www.khronos.org/registry/OpenGL-Refpages/gl4/html/glRenderbufferStorageMultisample.xhtml
+	 *
+	 * @param _renderbuffer Renderbuffer to allocate
+	 * @param _samples Number of samples per pixel
+	 * @param _format Internal data format
+	 * @param _width Width in pixels
+	 * @param _height Height in pixels
+	*/
+	inline void set_renderbuffer_storage_multisample(const renderbuffer_id& _renderbuffer, GLsizei _samples, internal_format _format,
+		GLsizei _width, GLsizei _height)
+	{
+		JCLIB_ASSERT(_renderbuffer);
+		glNamedRenderbufferStorageMultisample(_renderbuffer.get(), _samples, jc::to_underlying(_format), _width, _height);
+		gl_impl::track_allocation(memory_category::renderbuffer, _renderbuffer.get(),
+			texture_storage_bytes(_format, _width, _height, 1, (_samples > 0) ? _samples : 1, 1));
+	};
+
+	/**
+	 * @brief Attaches a texture level to a framebuffer attachment point
+	 * https://www.khronos.org/registry/OpenGL-Refpages/gl4/html/glFramebufferTexture.xhtml
+	 *
+	 * @param _framebuffer Framebuffer to attach to, must not be the default framebuffer
+	 * @param _attachment Attachment point
+	 * @param _texture Texture to attach, may be null to detach
+	 * @param _level Mipmap level of the texture to attach
+	*/
+	inline void attach_texture(const framebuffer_id& _framebuffer, framebuffer_attachment _attachment, const texture_id& _texture, GLint _level = 0)
+	{
+		JCLIB_ASSERT(_framebuffer);
+		glNamedFramebufferTexture(_framebuffer.get(), jc::to_underlying(_attachment), _texture.get(), _level);
+	};
+
+	/**
+	 * @brief Attaches a single layer of an array, cube map or 3D texture to a framebuffer attachment point
+	 * https://www.khronos.org/registry/OpenGL-Refpages/gl4/html/glFramebufferTextureLayer.xhtml
+	 *
+	 * @param _framebuffer Framebuffer to attach to, must not be the default framebuffer
+	 * @param _attachment Attachment point
+	 * @param _texture Texture to attach, may be null to detach
+	 * @param _level Mipmap level of the texture to attach
+	 * @param _layer Layer of the texture to attach
+	*/
+	inline void attach_texture_layer(const framebuffer_id& _framebuffer, framebuffer_attachment _attachment, const texture_id& _texture,
+		GLint _level, GLint _layer)
+	{
+		JCLIB_ASSERT(_framebuffer);
+		glNamedFramebufferTextureLayer(_framebuffer.get(), jc::to_underlying(_attachment), _texture.get(), _level, _layer);
+	};
+
+	/**
+	 * @brief Attaches a renderbuffer to a framebuffer attachment point
+	 * https://www.khronos.org/registry/OpenGL-Refpages/gl4/html/glFramebufferRenderbuffer.xhtml
+	 *
+	 * @param _framebuffer Framebuffer to attach to, must not be the default framebuffer
+	 * @param _attachment Attachment point
+	 * @param _renderbuffer Renderbuffer to attach, may be null to detach
+	*/
+	inline void attach_renderbuffer(const framebuffer_id& _framebuffer, framebuffer_attachment _attachment, const renderbuffer_id& _renderbuffer)
+	{
+		JCLIB_ASSERT(_framebuffer);
+		glNamedFramebufferRenderbuffer(_framebuffer.get(), jc::to_underlying(_attachment), GL_RENDERBUFFER, _renderbuffer.get());
+	};
+
+	/**
+	 * @brief Sets the color attachments that fragment shader outputs are written to
+	 * https://www.khronos.org/registry/OpenGL-Refpages/gl4/html/glDrawBuffers.xhtml
+	 *
+	 * @param _framebuffer Framebuffer to modify
+	 * @param _attachments Color attachment for each fragment output location
+	*/
+	inline void set_draw_buffers(const framebuffer_id& _framebuffer, std::span<const framebuffer_attachment> _attachments)
+	{
+		glNamedFramebufferDrawBuffers(_framebuffer.get(), static_cast<GLsizei>(_attachments.size()),
+			reinterpret_cast<const GLenum*>(_attachments.data()));
+	};
+
+	/**
+	 * @brief Sets the color attachment that reads and blits source from
+	 * https://www.khronos.org/registry/OpenGL-Refpages/gl4/html/glReadBuffer.xhtml
+	 *
+	 * @param _framebuffer Framebuffer to modify
+	 * @param _attachment Color attachment to read from
+	*/
+	inline void set_read_buffer(const framebuffer_id& _framebuffer, framebuffer_attachment _attachment)
+	{
+		glNamedFramebufferReadBuffer(_framebuffer.get(), jc::to_underlying(_attachment));
+	};
+
+	/**
+	 * @brief Checks the completeness status of a framebuffer
+	 * https://www.khronos.org/registry/OpenGL-Refpages/gl4/html/glCheckFramebufferStatus.xhtml
+	 *
+	 * @param _framebuffer Framebuffer to check, null checks the default framebuffer
+	 * @param _target Target the framebuffer would be bound to
+	 * @return Completeness status
+	*/
+	inline framebuffer_status check_framebuffer_status(const framebuffer_id& _framebuffer, framebuffer_target _target = framebuffer_target::framebuffer)
+	{
+		return static_cast<framebuffer_status>(glCheckNamedFramebufferStatus(_framebuffer.get(), jc::to_underlying(_target)));
+	};
+
+	/**
+	 * @brief Checks if a framebuffer is complete and can be rendered to
+	 * @param _framebuffer Framebuffer to check, null checks the default framebuffer
+	 * @return True if complete, false otherwise
+	*/
+	inline bool is_framebuffer_complete(const framebuffer_id& _framebuffer)
+	{
+		return check_framebuffer_status(_framebuffer) == framebuffer_status::complete;
+	};
+
+	/**
+	 * @brief Rectangle of pixels in a framebuffer, x1 and y1 are exclusive
+	*/
+	struct framebuffer_region
+	{
+		GLint x0;
+		GLint y0;
+		GLint x1;
+		GLint y1;
+	};
+
+	/**
+	 * @brief Copies a region of pixels from one framebuffer to another, resolving multisampled sources
+	 * https://www.khronos.org/registry/OpenGL-Refpages/gl4/html/glBlitFramebuffer.xhtml
+	 *
+	 * @param _source Framebuffer to read from, null for the default framebuffer
+	 * @param _destination Framebuffer to write to, null for the default framebuffer
+	 * @param _sourceRegion Region to read from
+	 * @param _destinationRegion Region to write to
+	 * @param _mask Buffers to copy
+	 * @param _filter Filter to use when the regions differ in size, must be nearest when copying depth or stencil
+	*/
+	inline void blit(const framebuffer_id& _source, const framebuffer_id& _destination,
+		framebuffer_region _sourceRegion, framebuffer_region _destinationRegion,
+		buffer_bit _mask = buffer_bit::color, blit_filter _filter = blit_filter::nearest)
+	{
+		glBlitNamedFramebuffer
+		(
+			_source.get(), _destination.get(),
+			_sourceRegion.x0, _sourceRegion.y0, _sourceRegion.x1, _sourceRegion.y1,
+			_destinationRegion.x0, _destinationRegion.y0, _destinationRegion.x1, _destinationRegion.y1,
+			jc::to_underlying(_mask), jc::to_underlying(_filter)
+		);
+	};
+
+	/**
+	 * @brief Copies the same sized region of pixels from one framebuffer to another
+	 * @param _source Framebuffer to read from, null for the default framebuffer
+	 * @param _destination Framebuffer to write to, null for the default framebuffer
+	 * @param _width Width of the region in pixels
+	 * @param _height Height of the region in pixels
+	 * @param _mask Buffers to copy
+	*/
+	inline void blit(const framebuffer_id& _source, const framebuffer_id& _destination, GLint _width, GLint _height,
+		buffer_bit _mask = buffer_bit::color)
+	{
+		const auto _region = framebuffer_region{ 0, 0, _width, _height };
+		blit(_source, _destination, _region, _region, _mask, blit_filter::nearest);
+	};
+
+	/**
+	 * @brief Tells the implementation the contents of framebuffer attachments are no longer needed
+	 *
+	 * Lets the driver skip storing transient depth or multisample contents and skip loading them back.
+	 *
+	 * https://www.khronos.org/registry/OpenGL-Refpages/gl4/html/glInvalidateFramebuffer.xhtml
+	 *
+	 * @param _framebuffer Framebuffer to invalidate, null for the default framebuffer
+	 * @param _attachments Attachments to invalidate, use the default_* values for the default framebuffer
+	*/
+	inline void invalidate_framebuffer(const framebuffer_id& _framebuffer, std::span<const framebuffer_attachment> _attachments)
+	{
+		glInvalidateNamedFramebufferData(_framebuffer.get(), static_cast<GLsizei>(_attachments.size()),
+			reinterpret_cast<const GLenum*>(_attachments.data()));
+	};
+
+	/**
+	 * @brief Tells the implementation the contents of a region of framebuffer attachments are no longer needed
+	 * https://www.khronos.org/registry/OpenGL-Refpages/gl4/html/glInvalidateSubFramebuffer.xhtml
+	 *
+	 * @param _framebuffer Framebuffer to invalidate, null for the default framebuffer
+	 * @param _attachments Attachments to invalidate, use the default_* values for the default framebuffer
+	 * @param _x Left edge of the region in pixels
+	 * @param _y Bottom edge of the region in pixels
+	 * @param _width Width of the region in pixels
+	 * @param _height Height of the region in pixels
+	*/
+	inline void invalidate_sub_framebuffer(const framebuffer_id& _framebuffer, std::span<const framebuffer_attachment> _attachments,
+		GLint _x, GLint _y, GLsizei _width, GLsizei _height)
+	{
+		glInvalidateNamedFramebufferSubData(_framebuffer.get(), static_cast<GLsizei>(_attachments.size()),
+			reinterpret_cast<const GLenum*>(_attachments.data()), _x, _y, _width, _height);
+	};
+#endif
+
+};
+#pragma endregion
+
 
 namespace jc::gl
 {
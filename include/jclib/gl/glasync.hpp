@@ -0,0 +1,485 @@
+#pragma once
+#ifndef JCLIB_OPENGL_GLASYNC_HPP
+#define JCLIB_OPENGL_GLASYNC_HPP
+
+/*
+	Coroutines that wait on fences, readbacks and program links without blocking the context's thread
+*/
+
+#include "gl.hpp"
+#include "glcaps.hpp"
+
+#include <jclib/type.h>
+
+#include <span>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include <exception>
+#include <coroutine>
+#include <string_view>
+#include <type_traits>
+
+#define _JCLIB_OPENGL_GLASYNC_
+
+#pragma region GL_SCHEDULER
+namespace jc::gl
+{
+	class gl_scheduler;
+
+	/**
+	 * @brief Coroutine type for work scheduled on a gl_scheduler.
+	 *
+	 * A gl_task does nothing until handed to gl_scheduler::spawn(), which runs it up to its first co_await. The
+	 * scheduler owns spawned tasks, their frames are freed when they return or when the scheduler is destroyed.
+	 *
+	 * ```
+	 * gl::gl_task load_mesh(gl::vbo_id _vbo)
+	 * {
+	 *     auto _fence = gl::new_fence();
+	 *     co_await gl::fence_signaled(_fence);
+	 *     auto _bytes = co_await gl::readback(_vbo, 0, 256);
+	 *     co_await gl::next_frame();
+	 * };
+	 * ```
+	*/
+	class gl_task
+	{
+	public:
+
+		struct promise_type
+		{
+			/**
+			 * @brief Scheduler the task was spawned on, awaitables register with it.
+			*/
+			gl_scheduler* scheduler = nullptr;
+
+			gl_task get_return_object() noexcept
+			{
+				return gl_task{ std::coroutine_handle<promise_type>::from_promise(*this) };
+			};
+			std::suspend_always initial_suspend() noexcept { return {}; };
+			std::suspend_never final_suspend() noexcept { return {}; };
+			void return_void() noexcept {};
+			void unhandled_exception() noexcept { std::terminate(); };
+		};
+
+		gl_task(gl_task&& other) noexcept :
+			handle_{ std::exchange(other.handle_, nullptr) }
+		{};
+		gl_task& operator=(gl_task&& other) noexcept
+		{
+			if (this != &other)
+			{
+				this->reset();
+				this->handle_ = std::exchange(other.handle_, nullptr);
+			};
+			return *this;
+		};
+
+		/**
+		 * @brief Frees the coroutine if it was never spawned.
+		*/
+		~gl_task()
+		{
+			this->reset();
+		};
+
+	private:
+		friend gl_scheduler;
+
+		explicit gl_task(std::coroutine_handle<promise_type> _handle) noexcept :
+			handle_{ _handle }
+		{};
+
+		void reset() noexcept
+		{
+			if (this->handle_)
+			{
+				this->handle_.destroy();
+				this->handle_ = nullptr;
+			};
+		};
+
+		std::coroutine_handle<promise_type> handle_{};
+	};
+
+	/**
+	 * @brief Resumes coroutines on the context's thread once what they wait on is ready.
+	 *
+	 * Call poll() once per frame at the point where resumed work should run, ie. right before rendering.
+	 * Conditions are only checked there, so nothing ever blocks on the GPU. Must only be used on the thread
+	 * owning the context.
+	*/
+	class gl_scheduler
+	{
+	public:
+
+		/**
+		 * @brief Starts a task, running it up to its first suspension.
+		 * @param _task Task to run, the scheduler takes ownership of it.
+		*/
+		void spawn(gl_task _task)
+		{
+			JCLIB_ASSERT(_task.handle_);
+			const auto _handle = std::exchange(_task.handle_, nullptr);
+			_handle.promise().scheduler = this;
+			_handle.resume();
+		};
+
+		/**
+		 * @brief Checks every suspended coroutine and resumes those that are ready, then starts a new frame.
+		 *
+		 * Coroutines suspending while this runs are first checked on the next call.
+		 *
+		 * @return Number of coroutines resumed.
+		*/
+		size_t poll()
+		{
+			auto _checking = std::move(this->waiting_);
+			this->waiting_.clear();
+			++this->frame_;
+
+			size_t _resumed = 0;
+			for (size_t n = 0; n != _checking.size(); ++n)
+			{
+				const auto& _waiter = _checking[n];
+				if (_waiter.ready(_waiter.awaiter, *this))
+				{
+					_waiter.handle.resume();
+					++_resumed;
+				}
+				else
+				{
+					this->waiting_.push_back(_waiter);
+				};
+			};
+			return _resumed;
+		};
+
+		/**
+		 * @brief Gets the number of suspended coroutines.
+		*/
+		size_t pending() const noexcept { return this->waiting_.size(); };
+
+		/**
+		 * @brief Gets the number of times poll() has been called.
+		*/
+		uint64_t frame() const noexcept { return this->frame_; };
+
+		/**
+		 * @brief Checks if program links complete in the background, from GL_KHR/ARB_parallel_shader_compile.
+		*/
+		bool parallel_shader_compile() const noexcept { return this->parallel_compile_; };
+
+		/**
+		 * @brief Registers a suspended coroutine, used by the awaitables.
+		 * @param _handle Coroutine to resume.
+		 * @param _awaiter Awaiter living in the coroutine's frame.
+		 * @param _ready Checks if the awaiter is ready to resume.
+		*/
+		void wait(std::coroutine_handle<> _handle, void* _awaiter, bool(*_ready)(void*, gl_scheduler&))
+		{
+			this->waiting_.push_back(waiter{ _handle, _awaiter, _ready });
+		};
+
+		/**
+		 * @brief Creates the scheduler, the context must be current.
+		*/
+		gl_scheduler() :
+			parallel_compile_{ has_extension(extension::KHR_parallel_shader_compile) ||
+				has_extension(extension::ARB_parallel_shader_compile) }
+		{};
+
+		/**
+		 * @brief Destroys coroutines that are still suspended without resuming them.
+		*/
+		~gl_scheduler()
+		{
+			for (auto& _waiter : this->waiting_)
+			{
+				_waiter.handle.destroy();
+			};
+		};
+
+		gl_scheduler(const gl_scheduler&) = delete;
+		gl_scheduler& operator=(const gl_scheduler&) = delete;
+
+	private:
+
+		struct waiter
+		{
+			std::coroutine_handle<> handle;
+			void* awaiter;
+			bool(*ready)(void*, gl_scheduler&);
+		};
+
+		std::vector<waiter> waiting_{};
+		uint64_t frame_ = 0;
+		bool parallel_compile_ = false;
+	};
+
+	namespace gl_impl
+	{
+		template <typename PromiseT>
+		concept scheduled_promise = requires(PromiseT& _promise)
+		{
+			{ _promise.scheduler } -> std::convertible_to<gl_scheduler*>;
+		};
+
+		/**
+		 * @brief Base for awaitables resumed by a gl_scheduler.
+		 *
+		 * DerivedT provides "bool ready(gl_scheduler&)" which is checked once when awaited and then at every poll
+		 * until it returns true.
+		*/
+		template <typename DerivedT>
+		struct scheduled_awaiter
+		{
+			bool await_ready() const noexcept { return false; };
+
+			template <scheduled_promise PromiseT>
+			bool await_suspend(std::coroutine_handle<PromiseT> _handle)
+			{
+				auto& _scheduler = *_handle.promise().scheduler;
+				auto& _self = static_cast<DerivedT&>(*this);
+				if (_self.ready(_scheduler))
+				{
+					return false;
+				};
+				_scheduler.wait(_handle, &_self, [](void* _awaiter, gl_scheduler& _scheduler)
+				{
+					return static_cast<DerivedT*>(_awaiter)->ready(_scheduler);
+				});
+				return true;
+			};
+		};
+	};
+
+};
+#pragma endregion
+
+#pragma region AWAITABLES
+namespace jc::gl
+{
+	/**
+	 * @brief Awaitable resuming on the next gl_scheduler::poll().
+	*/
+	class next_frame : public gl_impl::scheduled_awaiter<next_frame>
+	{
+	public:
+		bool ready(gl_scheduler& _scheduler) noexcept
+		{
+			if (!this->armed_)
+			{
+				this->frame_ = _scheduler.frame();
+				this->armed_ = true;
+				return false;
+			};
+			return _scheduler.frame() != this->frame_;
+		};
+		void await_resume() const noexcept {};
+
+	private:
+		uint64_t frame_ = 0;
+		bool armed_ = false;
+	};
+
+	/**
+	 * @brief Awaitable resuming once a sync object is signaled.
+	 *
+	 * The command stream is flushed on the first check so the fence is guaranteed to signal eventually.
+	*/
+	class fence_signaled : public gl_impl::scheduled_awaiter<fence_signaled>
+	{
+	public:
+		bool ready(gl_scheduler&)
+		{
+			const auto _status = client_wait(this->sync_, 0, !this->flushed_);
+			this->flushed_ = true;
+			return _status == sync_status::already_signaled || _status == sync_status::condition_satisfied ||
+				_status == sync_status::wait_failed;
+		};
+		void await_resume() const noexcept {};
+
+		/**
+		 * @param _sync Sync object to wait on, must stay alive until resumed.
+		*/
+		explicit fence_signaled(sync_id _sync) noexcept :
+			sync_{ _sync }
+		{};
+
+	private:
+		sync_id sync_;
+		bool flushed_ = false;
+	};
+
+#if GL_VERSION_4_5
+	/**
+	 * @brief Awaitable reading back part of a buffer without stalling, created by readback().
+	 *
+	 * The range is copied into a staging buffer followed by a fence when the awaitable is created, the data is
+	 * read out of the staging buffer once that fence signals.
+	*/
+	template <typename ElementT>
+	class readback_awaiter : public gl_impl::scheduled_awaiter<readback_awaiter<ElementT>>
+	{
+	public:
+		bool ready(gl_scheduler& _scheduler)
+		{
+			return this->fence_.ready(_scheduler);
+		};
+
+		/**
+		 * @return The elements that were in the buffer's range when the readback was started.
+		*/
+		std::vector<ElementT> await_resume()
+		{
+			std::vector<ElementT> _out(this->count_);
+			if (this->count_ != 0)
+			{
+				glGetNamedBufferSubData(this->staging_.get(), 0, static_cast<GLsizeiptr>(this->count_ * sizeof(ElementT)), _out.data());
+			};
+			this->staging_.reset();
+			this->sync_.reset();
+			return _out;
+		};
+
+		readback_awaiter(const vbo_id& _vbo, size_t _offset, size_t _count) :
+			staging_{ new_vbo() },
+			count_{ _count }
+		{
+			const auto _bytes = _count * sizeof(ElementT);
+			set_buffer_storage(this->staging_, _bytes, buffer_storage_bit::client_storage);
+			if (_bytes != 0)
+			{
+				copy_buffer_sub_data(_vbo, this->staging_, _offset * sizeof(ElementT), 0, _bytes);
+			};
+			this->sync_ = new_fence();
+			this->fence_ = fence_signaled{ this->sync_ };
+		};
+
+	private:
+		unique_vbo staging_;
+		unique_sync sync_{};
+		fence_signaled fence_{ sync_id{} };
+		size_t count_;
+	};
+
+	/**
+	 * @brief Starts reading back part of a buffer, co_await the result for the data.
+	 * @tparam ElementT Element type to read the range as.
+	 * @param _vbo Buffer to read from.
+	 * @param _offset Offset of the range in elements.
+	 * @param _count Number of elements to read.
+	 * @return Awaitable giving a std::vector<ElementT> with the range's contents.
+	*/
+	template <typename ElementT = std::byte>
+	inline readback_awaiter<ElementT> readback(const vbo_id& _vbo, size_t _offset, size_t _count)
+	{
+		static_assert(std::is_trivially_copyable_v<ElementT>);
+		return readback_awaiter<ElementT>{ _vbo, _offset, _count };
+	};
+#endif
+
+	namespace gl_impl
+	{
+		/**
+		 * @brief GL_COMPLETION_STATUS_KHR from GL_KHR_parallel_shader_compile.
+		*/
+		constexpr GLenum completion_status = 0x91B1;
+	};
+
+	/**
+	 * @brief Program whose link was started with link_async() and may still be in progress.
+	*/
+	struct pending_program
+	{
+		program_id program;
+
+		/**
+		 * @brief Shaders attached for the link, detached once it completes.
+		*/
+		std::vector<shader_id> shaders{};
+	};
+
+	/**
+	 * @brief Starts compiling a shader without waiting for the result.
+	 * @param _shader Shader to compile.
+	 * @param _source Shader source code.
+	*/
+	inline void compile_async(const shader_id& _shader, std::string_view _source)
+	{
+		set_shader_source(_shader, _source);
+		glCompileShader(_shader.get());
+	};
+
+	/**
+	 * @brief Attaches shaders and starts linking a program without waiting for the result.
+	 *
+	 * Shaders may still be compiling from compile_async(), compile errors show up as a failed link.
+	 *
+	 * @param _program Program to link.
+	 * @param _shaders Shaders to link into the program.
+	 * @return Pending link, co_await program_ready() on it for the result.
+	*/
+	inline pending_program link_async(const program_id& _program, std::span<const shader_id> _shaders)
+	{
+		for (auto& _shader : _shaders)
+		{
+			attach(_program, _shader);
+		};
+		glLinkProgram(_program.get());
+		return pending_program{ _program, std::vector<shader_id>(_shaders.begin(), _shaders.end()) };
+	};
+
+	/**
+	 * @brief Awaitable resuming once a program link started by link_async() has completed.
+	 *
+	 * Without GL_KHR_parallel_shader_compile the link is treated as complete straight away.
+	*/
+	class program_ready : public gl_impl::scheduled_awaiter<program_ready>
+	{
+	public:
+		bool ready(gl_scheduler& _scheduler)
+		{
+			if (!_scheduler.parallel_shader_compile())
+			{
+				return true;
+			};
+			GLint _done = GL_FALSE;
+			glGetProgramiv(this->pending_.program.get(), gl_impl::completion_status, &_done);
+			return _done == GL_TRUE;
+		};
+
+		/**
+		 * @brief Detaches the shaders from the program.
+		 * @return True on good link, false otherwise.
+		*/
+		bool await_resume()
+		{
+			for (auto& _shader : this->pending_.shaders)
+			{
+				detach(this->pending_.program, _shader);
+			};
+			this->pending_.shaders.clear();
+			return get_link_status(this->pending_.program);
+		};
+
+		/**
+		 * @param _pending Pending link, must stay alive until resumed.
+		*/
+		explicit program_ready(pending_program& _pending) noexcept :
+			pending_{ _pending }
+		{};
+
+	private:
+		pending_program& pending_;
+	};
+
+};
+#pragma endregion
+
+#endif // JCLIB_OPENGL_GLASYNC_HPP
@@ -0,0 +1,354 @@
+#pragma once
+#ifndef JCLIB_OPENGL_GLCAPS_HPP
+#define JCLIB_OPENGL_GLCAPS_HPP
+
+/*
+	Snapshot of the current context's limits, alignments, extensions and version taken once at startup
+*/
+
+#include "gllib.hpp"
+
+#include <jclib/type.h>
+
+#include <array>
+#include <bitset>
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#define _JCLIB_OPENGL_GLCAPS_
+
+namespace jc::gl
+{
+	/**
+	 * @brief Extensions tracked by context_caps, named without the "GL_" prefix.
+	*/
+	enum class extension : uint8_t
+	{
+		ARB_bindless_texture,
+		ARB_buffer_storage,
+		ARB_direct_state_access,
+		ARB_gl_spirv,
+		ARB_indirect_parameters,
+		ARB_multi_draw_indirect,
+		ARB_parallel_shader_compile,
+		ARB_seamless_cubemap_per_texture,
+		ARB_shader_draw_parameters,
+		ARB_sparse_buffer,
+		ARB_sparse_texture,
+		ARB_texture_compression_bptc,
+		ARB_texture_filter_anisotropic,
+		EXT_texture_compression_s3tc,
+		EXT_texture_filter_anisotropic,
+		KHR_debug,
+		KHR_parallel_shader_compile,
+		KHR_texture_compression_astc_ldr,
+		NV_mesh_shader,
+		count_
+	};
+
+	/**
+	 * @brief Gets the name of an extension as reported by glGetStringi(GL_EXTENSIONS, n).
+	*/
+	constexpr std::string_view to_string(extension _extension) noexcept
+	{
+		constexpr std::array<std::string_view, static_cast<size_t>(extension::count_)> _names
+		{
+			"GL_ARB_bindless_texture",
+			"GL_ARB_buffer_storage",
+			"GL_ARB_direct_state_access",
+			"GL_ARB_gl_spirv",
+			"GL_ARB_indirect_parameters",
+			"GL_ARB_multi_draw_indirect",
+			"GL_ARB_parallel_shader_compile",
+			"GL_ARB_seamless_cubemap_per_texture",
+			"GL_ARB_shader_draw_parameters",
+			"GL_ARB_sparse_buffer",
+			"GL_ARB_sparse_texture",
+			"GL_ARB_texture_compression_bptc",
+			"GL_ARB_texture_filter_anisotropic",
+			"GL_EXT_texture_compression_s3tc",
+			"GL_EXT_texture_filter_anisotropic",
+			"GL_KHR_debug",
+			"GL_KHR_parallel_shader_compile",
+			"GL_KHR_texture_compression_astc_ldr",
+			"GL_NV_mesh_shader",
+		};
+		return _names[static_cast<size_t>(_extension)];
+	};
+
+#if defined(GL_MAX_TEXTURE_MAX_ANISOTROPY) || defined(GL_MAX_TEXTURE_MAX_ANISOTROPY_EXT)
+	namespace gl_impl
+	{
+		/**
+		 * @brief Anisotropy limit query, core in 4.6 and shared with the ARB and EXT extensions.
+		*/
+#if defined(GL_MAX_TEXTURE_MAX_ANISOTROPY)
+		constexpr GLenum max_texture_max_anisotropy = GL_MAX_TEXTURE_MAX_ANISOTROPY;
+#else
+		constexpr GLenum max_texture_max_anisotropy = GL_MAX_TEXTURE_MAX_ANISOTROPY_EXT;
+#endif
+	};
+#endif
+
+	/**
+	 * @brief Snapshot of the capabilities of a context.
+	 *
+	 * Built with query() in one pass, after which every field is a plain read. Call load_context_caps() once the
+	 * context is created so the rest of the library (ie. glparam.hpp) reads limits from here instead of the driver.
+	*/
+	struct context_caps
+	{
+		/**
+		 * @brief Context version from GL_MAJOR_VERSION and GL_MINOR_VERSION.
+		*/
+		GLint major_version = 0;
+		GLint minor_version = 0;
+
+		std::string vendor{};
+		std::string renderer{};
+		std::string version{};
+		std::string glsl_version{};
+
+		// Limits
+
+		GLint max_texture_size = 0;
+		GLint max_3d_texture_size = 0;
+		GLint max_cube_map_texture_size = 0;
+		GLint max_array_texture_layers = 0;
+		GLint max_renderbuffer_size = 0;
+		GLint max_samples = 0;
+		GLint max_color_attachments = 0;
+		GLint max_draw_buffers = 0;
+		GLint max_vertex_attribs = 0;
+		GLint max_vertex_attrib_bindings = 0;
+		GLint max_texture_image_units = 0;
+		GLint max_combined_texture_image_units = 0;
+		GLint max_uniform_locations = 0;
+		GLint max_uniform_block_size = 0;
+		GLint max_uniform_buffer_bindings = 0;
+		GLint max_shader_storage_buffer_bindings = 0;
+		GLint64 max_shader_storage_block_size = 0;
+		GLint max_compute_work_group_invocations = 0;
+		GLint max_compute_shared_memory_size = 0;
+		std::array<GLint, 3> max_compute_work_group_count{};
+		std::array<GLint, 3> max_compute_work_group_size{};
+
+		/**
+		 * @brief Stays 1 if the loader defines neither the core nor the EXT anisotropy enum.
+		*/
+		GLfloat max_texture_max_anisotropy = 1.0f;
+
+		// Alignments
+
+		GLint uniform_buffer_offset_alignment = 0;
+		GLint shader_storage_buffer_offset_alignment = 0;
+		GLint min_map_buffer_alignment = 0;
+
+		/**
+		 * @brief Formats accepted by glProgramBinary.
+		*/
+		std::vector<GLint> program_binary_formats{};
+
+		/**
+		 * @brief Formats accepted by glShaderBinary.
+		*/
+		std::vector<GLint> shader_binary_formats{};
+
+		/**
+		 * @brief Bit n is set if extension n is supported.
+		*/
+		std::bitset<static_cast<size_t>(extension::count_)> extensions{};
+
+		/**
+		 * @brief Checks if an extension is supported.
+		*/
+		bool has(extension _extension) const noexcept
+		{
+			return this->extensions.test(static_cast<size_t>(_extension));
+		};
+
+		/**
+		 * @brief Checks if the context version is at least major.minor.
+		*/
+		constexpr bool version_at_least(GLint _major, GLint _minor) const noexcept
+		{
+			return this->major_version > _major || (this->major_version == _major && this->minor_version >= _minor);
+		};
+
+		/**
+		 * @brief Queries the capabilities of the current context.
+		*/
+		static context_caps query()
+		{
+			context_caps _caps{};
+
+			glGetIntegerv(GL_MAJOR_VERSION, &_caps.major_version);
+			glGetIntegerv(GL_MINOR_VERSION, &_caps.minor_version);
+
+			const auto _string = [](GLenum _name) -> std::string
+			{
+				const auto _value = reinterpret_cast<const char*>(glGetString(_name));
+				return (_value) ? std::string{ _value } : std::string{};
+			};
+			_caps.vendor = _string(GL_VENDOR);
+			_caps.renderer = _string(GL_RENDERER);
+			_caps.version = _string(GL_VERSION);
+			_caps.glsl_version = _string(GL_SHADING_LANGUAGE_VERSION);
+
+			GLint _extensionCount = 0;
+			glGetIntegerv(GL_NUM_EXTENSIONS, &_extensionCount);
+			for (GLint n = 0; n != _extensionCount; ++n)
+			{
+				const auto _name = reinterpret_cast<const char*>(glGetStringi(GL_EXTENSIONS, static_cast<GLuint>(n)));
+				if (!_name)
+				{
+					continue;
+				};
+				const auto _view = std::string_view{ _name };
+				for (size_t e = 0; e != _caps.extensions.size(); ++e)
+				{
+					if (to_string(static_cast<extension>(e)) == _view)
+					{
+						_caps.extensions.set(e);
+						break;
+					};
+				};
+			};
+
+			glGetIntegerv(GL_MAX_TEXTURE_SIZE, &_caps.max_texture_size);
+			glGetIntegerv(GL_MAX_3D_TEXTURE_SIZE, &_caps.max_3d_texture_size);
+			glGetIntegerv(GL_MAX_CUBE_MAP_TEXTURE_SIZE, &_caps.max_cube_map_texture_size);
+			glGetIntegerv(GL_MAX_ARRAY_TEXTURE_LAYERS, &_caps.max_array_texture_layers);
+			glGetIntegerv(GL_MAX_RENDERBUFFER_SIZE, &_caps.max_renderbuffer_size);
+			glGetIntegerv(GL_MAX_SAMPLES, &_caps.max_samples);
+			glGetIntegerv(GL_MAX_COLOR_ATTACHMENTS, &_caps.max_color_attachments);
+			glGetIntegerv(GL_MAX_DRAW_BUFFERS, &_caps.max_draw_buffers);
+			glGetIntegerv(GL_MAX_VERTEX_ATTRIBS, &_caps.max_vertex_attribs);
+			glGetIntegerv(GL_MAX_TEXTURE_IMAGE_UNITS, &_caps.max_texture_image_units);
+			glGetIntegerv(GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS, &_caps.max_combined_texture_image_units);
+			glGetIntegerv(GL_MAX_UNIFORM_BLOCK_SIZE, &_caps.max_uniform_block_size);
+			glGetIntegerv(GL_MAX_UNIFORM_BUFFER_BINDINGS, &_caps.max_uniform_buffer_bindings);
+			glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &_caps.uniform_buffer_offset_alignment);
+
+#if GL_VERSION_4_1
+			GLint _formatCount = 0;
+			glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &_formatCount);
+			_caps.program_binary_formats.resize(static_cast<size_t>(_formatCount));
+			if (_formatCount > 0)
+			{
+				glGetIntegerv(GL_PROGRAM_BINARY_FORMATS, _caps.program_binary_formats.data());
+			};
+
+			_formatCount = 0;
+			glGetIntegerv(GL_NUM_SHADER_BINARY_FORMATS, &_formatCount);
+			_caps.shader_binary_formats.resize(static_cast<size_t>(_formatCount));
+			if (_formatCount > 0)
+			{
+				glGetIntegerv(GL_SHADER_BINARY_FORMATS, _caps.shader_binary_formats.data());
+			};
+#endif
+
+#if GL_VERSION_4_2
+			glGetIntegerv(GL_MIN_MAP_BUFFER_ALIGNMENT, &_caps.min_map_buffer_alignment);
+#endif
+
+#if GL_VERSION_4_3
+			glGetIntegerv(GL_MAX_UNIFORM_LOCATIONS, &_caps.max_uniform_locations);
+			glGetIntegerv(GL_MAX_VERTEX_ATTRIB_BINDINGS, &_caps.max_vertex_attrib_bindings);
+			glGetIntegerv(GL_MAX_SHADER_STORAGE_BUFFER_BINDINGS, &_caps.max_shader_storage_buffer_bindings);
+			glGetInteger64v(GL_MAX_SHADER_STORAGE_BLOCK_SIZE, &_caps.max_shader_storage_block_size);
+			glGetIntegerv(GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT, &_caps.shader_storage_buffer_offset_alignment);
+			glGetIntegerv(GL_MAX_COMPUTE_WORK_GROUP_INVOCATIONS, &_caps.max_compute_work_group_invocations);
+			glGetIntegerv(GL_MAX_COMPUTE_SHARED_MEMORY_SIZE, &_caps.max_compute_shared_memory_size);
+			for (GLuint n = 0; n != 3; ++n)
+			{
+				glGetIntegeri_v(GL_MAX_COMPUTE_WORK_GROUP_COUNT, n, &_caps.max_compute_work_group_count[n]);
+				glGetIntegeri_v(GL_MAX_COMPUTE_WORK_GROUP_SIZE, n, &_caps.max_compute_work_group_size[n]);
+			};
+#endif
+
+#if defined(GL_MAX_TEXTURE_MAX_ANISOTROPY) || defined(GL_MAX_TEXTURE_MAX_ANISOTROPY_EXT)
+			if (_caps.version_at_least(4, 6) || _caps.has(extension::ARB_texture_filter_anisotropic) ||
+				_caps.has(extension::EXT_texture_filter_anisotropic))
+			{
+				glGetFloatv(gl_impl::max_texture_max_anisotropy, &_caps.max_texture_max_anisotropy);
+			};
+#endif
+
+			return _caps;
+		};
+	};
+
+	namespace gl_impl
+	{
+		/**
+		 * @brief Snapshot set by load_context_caps(), null until then.
+		*/
+		inline const context_caps* loaded_caps = nullptr;
+	};
+
+	/**
+	 * @brief Queries the current context's capabilities and makes them available through context_caps_loaded().
+	 *
+	 * Call once on the context's thread after creating it. Calling again refreshes the snapshot, which invalidates
+	 * references to the previous one.
+	 *
+	 * @return The snapshot.
+	*/
+	inline const context_caps& load_context_caps()
+	{
+		static context_caps _caps{};
+		_caps = context_caps::query();
+		gl_impl::loaded_caps = &_caps;
+		return _caps;
+	};
+
+	/**
+	 * @brief Gets the snapshot taken by load_context_caps().
+	 * @return The snapshot, or null if not yet loaded.
+	*/
+	inline const context_caps* context_caps_loaded() noexcept
+	{
+		return gl_impl::loaded_caps;
+	};
+
+	/**
+	 * @brief Gets the snapshot taken by load_context_caps(), which must have been called.
+	*/
+	inline const context_caps& caps() noexcept
+	{
+		JCLIB_ASSERT(gl_impl::loaded_caps);
+		return *gl_impl::loaded_caps;
+	};
+
+	/**
+	 * @brief Checks if the current context supports an extension.
+	 *
+	 * Reads the loaded snapshot when there is one, scans GL_EXTENSIONS otherwise.
+	*/
+	inline bool has_extension(extension _extension)
+	{
+		if (const auto _caps = context_caps_loaded())
+		{
+			return _caps->has(_extension);
+		};
+
+		GLint _count = 0;
+		glGetIntegerv(GL_NUM_EXTENSIONS, &_count);
+		for (GLint n = 0; n != _count; ++n)
+		{
+			const auto _name = reinterpret_cast<const char*>(glGetStringi(GL_EXTENSIONS, static_cast<GLuint>(n)));
+			if (_name && to_string(_extension) == std::string_view{ _name })
+			{
+				return true;
+			};
+		};
+		return false;
+	};
+
+};
+
+#endif // JCLIB_OPENGL_GLCAPS_HPP
@@ -0,0 +1,2229 @@
+#pragma once
+#ifndef JCLIB_OPENGL_GLCAPTURE_HPP
+#define JCLIB_OPENGL_GLCAPTURE_HPP
+
+/*
+	Frame capture into a compact binary trace and replay of traces on another context
+*/
+
+#include "glrecord.hpp"
+
+#include <span>
+#include <array>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <ostream>
+#include <utility>
+#include <optional>
+#include <algorithm>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+
+#define _JCLIB_OPENGL_GLCAPTURE_
+
+#pragma region TRACE
+namespace jc::gl
+{
+	/**
+	 * @brief Entry id written between frames by capture_layer::mark_frame().
+	*/
+	constexpr inline uint16_t trace_frame_marker = 0xFFFF;
+
+	/**
+	 * @brief Payload id for a pointer argument that was null or not captured.
+	*/
+	constexpr inline uint32_t trace_null_payload = 0xFFFFFFFF;
+
+	/**
+	 * @brief Layout of one entry point's calls in a trace.
+	 *
+	 * Traces store these by name so a trace stays readable when the recorded function list changes.
+	*/
+	struct trace_entry_info
+	{
+		std::string name;
+		uint32_t arg_bytes;
+		uint32_t result_bytes;
+		uint32_t payload_slots;
+
+		/**
+		 * @brief Size of a call record for this entry, including its entry id.
+		*/
+		size_t record_bytes() const noexcept
+		{
+			return sizeof(uint16_t) + this->arg_bytes + this->result_bytes + this->payload_slots * sizeof(uint32_t);
+		};
+	};
+
+	/**
+	 * @brief A captured sequence of OpenGL calls.
+	 *
+	 * Each call is its entry id, the packed arguments, the packed result and one payload id per payload
+	 * slot. Payloads hold the memory pointer arguments referred to (buffer data, pixels, shader source,
+	 * uniform arrays) and are deduplicated by content, so re-uploading the same data costs 4 bytes.
+	*/
+	struct trace
+	{
+		std::vector<trace_entry_info> entries{};
+		std::vector<std::vector<std::byte>> payloads{};
+		std::vector<std::byte> calls{};
+	};
+
+	/**
+	 * @brief One call read from a trace.
+	*/
+	struct trace_call
+	{
+		/**
+		 * @brief Index into trace::entries, or trace_frame_marker.
+		*/
+		uint16_t id;
+
+		std::span<const std::byte> args;
+		std::span<const std::byte> result;
+
+		/**
+		 * @brief Packed payload ids, read with payload().
+		*/
+		std::span<const std::byte> payload_ids;
+
+		/**
+		 * @brief Checks if this is a frame boundary rather than a call.
+		*/
+		bool is_frame_marker() const noexcept { return this->id == trace_frame_marker; };
+
+		/**
+		 * @brief Gets the number of payload slots.
+		*/
+		size_t payload_count() const noexcept { return this->payload_ids.size() / sizeof(uint32_t); };
+
+		/**
+		 * @brief Gets the payload id in a slot, trace_null_payload if nothing was captured.
+		*/
+		uint32_t payload(size_t _slot) const noexcept
+		{
+			JCLIB_ASSERT(_slot < this->payload_count());
+			uint32_t _id{};
+			std::memcpy(&_id, this->payload_ids.data() + _slot * sizeof(uint32_t), sizeof(_id));
+			return _id;
+		};
+	};
+
+	/**
+	 * @brief Walks the calls of a trace.
+	*/
+	class trace_reader
+	{
+	public:
+
+		/**
+		 * @brief Reads the next call.
+		 * @param _out Set to the call.
+		 * @return True if a call was read, false at the end of the trace or on malformed data.
+		*/
+		bool next(trace_call& _out)
+		{
+			if (this->data_.size() < sizeof(uint16_t))
+			{
+				return false;
+			};
+
+			uint16_t _id{};
+			std::memcpy(&_id, this->data_.data(), sizeof(_id));
+			if (_id == trace_frame_marker)
+			{
+				_out = trace_call{ _id, {}, {}, {} };
+				this->data_ = this->data_.subspan(sizeof(_id));
+				return true;
+			};
+			if (_id >= this->trace_->entries.size())
+			{
+				return false;
+			};
+
+			const auto& _info = this->trace_->entries[_id];
+			if (this->data_.size() < _info.record_bytes())
+			{
+				return false;
+			};
+
+			auto _at = this->data_.subspan(sizeof(_id));
+			_out.id = _id;
+			_out.args = _at.first(_info.arg_bytes);
+			_at = _at.subspan(_info.arg_bytes);
+			_out.result = _at.first(_info.result_bytes);
+			_at = _at.subspan(_info.result_bytes);
+			_out.payload_ids = _at.first(_info.payload_slots * sizeof(uint32_t));
+			this->data_ = this->data_.subspan(_info.record_bytes());
+			return true;
+		};
+
+		explicit trace_reader(const trace& _trace) noexcept :
+			trace_{ &_trace },
+			data_{ _trace.calls }
+		{};
+
+	private:
+		const trace* trace_;
+		std::span<const std::byte> data_;
+	};
+
+	namespace gl_impl
+	{
+		constexpr inline std::array<char, 8> trace_magic{ 'J', 'C', 'G', 'L', 'T', 'R', 'C', '1' };
+
+		template <typename T>
+		inline void write_pod(std::ostream& _out, const T& _value)
+		{
+			_out.write(reinterpret_cast<const char*>(&_value), sizeof(T));
+		};
+
+		template <typename T>
+		inline bool read_pod(std::istream& _in, T& _value)
+		{
+			return static_cast<bool>(_in.read(reinterpret_cast<char*>(&_value), sizeof(T)));
+		};
+
+		inline bool read_bytes(std::istream& _in, std::vector<std::byte>& _out, uint64_t _size)
+		{
+			_out.resize(static_cast<size_t>(_size));
+			return static_cast<bool>(_in.read(reinterpret_cast<char*>(_out.data()), static_cast<std::streamsize>(_size)));
+		};
+	};
+
+	/**
+	 * @brief Writes a trace in its binary file format.
+	 *
+	 * The file is the magic "JCGLTRC1", the entry table, the payloads and then the calls. Values are
+	 * stored in host byte order.
+	 *
+	 * @return True if everything was written.
+	*/
+	inline bool write_trace(std::ostream& _out, const trace& _trace)
+	{
+		_out.write(gl_impl::trace_magic.data(), gl_impl::trace_magic.size());
+
+		gl_impl::write_pod(_out, static_cast<uint32_t>(_trace.entries.size()));
+		for (auto& e : _trace.entries)
+		{
+			gl_impl::write_pod(_out, static_cast<uint16_t>(e.name.size()));
+			_out.write(e.name.data(), static_cast<std::streamsize>(e.name.size()));
+			gl_impl::write_pod(_out, e.arg_bytes);
+			gl_impl::write_pod(_out, e.result_bytes);
+			gl_impl::write_pod(_out, e.payload_slots);
+		};
+
+		gl_impl::write_pod(_out, static_cast<uint32_t>(_trace.payloads.size()));
+		for (auto& p : _trace.payloads)
+		{
+			gl_impl::write_pod(_out, static_cast<uint64_t>(p.size()));
+			_out.write(reinterpret_cast<const char*>(p.data()), static_cast<std::streamsize>(p.size()));
+		};
+
+		gl_impl::write_pod(_out, static_cast<uint64_t>(_trace.calls.size()));
+		_out.write(reinterpret_cast<const char*>(_trace.calls.data()), static_cast<std::streamsize>(_trace.calls.size()));
+		return static_cast<bool>(_out);
+	};
+
+	/**
+	 * @brief Reads a trace written by write_trace().
+	 * @return The trace or nullopt if the data is not a trace or is truncated.
+	*/
+	inline std::optional<trace> read_trace(std::istream& _in)
+	{
+		std::array<char, 8> _magic{};
+		if (!_in.read(_magic.data(), _magic.size()) || _magic != gl_impl::trace_magic)
+		{
+			return std::nullopt;
+		};
+
+		trace _trace{};
+		uint32_t _entryCount{};
+		if (!gl_impl::read_pod(_in, _entryCount))
+		{
+			return std::nullopt;
+		};
+		_trace.entries.resize(_entryCount);
+		for (auto& e : _trace.entries)
+		{
+			uint16_t _nameSize{};
+			if (!gl_impl::read_pod(_in, _nameSize))
+			{
+				return std::nullopt;
+			};
+			e.name.resize(_nameSize);
+			if (!_in.read(e.name.data(), _nameSize) || !gl_impl::read_pod(_in, e.arg_bytes) ||
+				!gl_impl::read_pod(_in, e.result_bytes) || !gl_impl::read_pod(_in, e.payload_slots))
+			{
+				return std::nullopt;
+			};
+		};
+
+		uint32_t _payloadCount{};
+		if (!gl_impl::read_pod(_in, _payloadCount))
+		{
+			return std::nullopt;
+		};
+		_trace.payloads.resize(_payloadCount);
+		for (auto& p : _trace.payloads)
+		{
+			uint64_t _size{};
+			if (!gl_impl::read_pod(_in, _size) || !gl_impl::read_bytes(_in, p, _size))
+			{
+				return std::nullopt;
+			};
+		};
+
+		uint64_t _callBytes{};
+		if (!gl_impl::read_pod(_in, _callBytes) || !gl_impl::read_bytes(_in, _trace.calls, _callBytes))
+		{
+			return std::nullopt;
+		};
+		return _trace;
+	};
+
+};
+#pragma endregion
+
+#pragma region CAPTURE_LAYER
+namespace jc::gl
+{
+	namespace gl_impl
+	{
+		/**
+		 * @brief Hashes payload contents for deduplication.
+		*/
+		inline uint64_t capture_hash(std::span<const std::byte> _data) noexcept
+		{
+			uint64_t _hash = 0xCBF29CE484222325ull ^ (_data.size() * 0x9E3779B97F4A7C15ull);
+			size_t n = 0;
+			for (; n + sizeof(uint64_t) <= _data.size(); n += sizeof(uint64_t))
+			{
+				uint64_t _word{};
+				std::memcpy(&_word, _data.data() + n, sizeof(_word));
+				_hash = (_hash ^ _word) * 0x100000001B3ull;
+				_hash ^= _hash >> 29;
+			};
+			for (; n != _data.size(); ++n)
+			{
+				_hash = (_hash ^ static_cast<uint64_t>(_data[n])) * 0x100000001B3ull;
+			};
+			return _hash;
+		};
+	};
+
+	/**
+	 * @brief A buffer range mapped while capturing.
+	*/
+	struct capture_mapping
+	{
+		std::byte* data;
+		GLintptr offset;
+		GLsizeiptr length;
+		GLbitfield access;
+	};
+
+	/**
+	 * @brief Wraps glad's function pointers to serialize every call into a trace while forwarding it to the driver.
+	 *
+	 * Install before creating the objects the captured frames use, replaying needs to see them created.
+	 * Call mark_frame() at each frame boundary (such as buffer swaps) so replays can time frames.
+	 *
+	 * Writes through mapped pointers are captured when the range is flushed or unmapped, writes into
+	 * persistent coherent mappings that are never flushed or unmapped are not seen by the trace.
+	 *
+	 * Only one layer may be installed at a time, and it must only be called from one thread.
+	*/
+	class capture_layer
+	{
+	public:
+
+		/**
+		 * @brief Gets the installed layer, null if none is installed.
+		*/
+		static capture_layer* active() noexcept { return active_; };
+
+		/**
+		 * @brief Installs the layer over whatever functions glad currently has loaded.
+		*/
+		void install();
+
+		/**
+		 * @brief Restores the function pointers saved by install().
+		*/
+		void uninstall();
+
+		/**
+		 * @brief Checks if this layer is installed.
+		*/
+		bool installed() const noexcept { return active_ == this; };
+
+		/**
+		 * @brief Marks the end of a frame in the trace.
+		*/
+		void mark_frame()
+		{
+			const auto _offset = this->calls_.size();
+			this->calls_.resize(_offset + sizeof(trace_frame_marker));
+			std::memcpy(this->calls_.data() + _offset, &trace_frame_marker, sizeof(trace_frame_marker));
+			++this->frames_;
+		};
+
+		/**
+		 * @brief Gets the number of frames marked.
+		*/
+		size_t frame_count() const noexcept { return this->frames_; };
+
+		/**
+		 * @brief Gets the number of calls captured.
+		*/
+		size_t call_count() const noexcept { return this->call_count_; };
+
+		/**
+		 * @brief Gets the size of the unique payloads captured.
+		*/
+		size_t payload_bytes() const noexcept { return this->payload_bytes_; };
+
+		/**
+		 * @brief Gets the size of the payloads before deduplication.
+		*/
+		size_t referenced_payload_bytes() const noexcept { return this->referenced_payload_bytes_; };
+
+		/**
+		 * @brief Adds payload memory to the trace, reusing an identical earlier payload if there is one.
+		 * @return The payload id, trace_null_payload for null or empty data.
+		*/
+		uint32_t payload(const void* _data, size_t _sizeBytes)
+		{
+			if (!_data || _sizeBytes == 0)
+			{
+				return trace_null_payload;
+			};
+
+			const auto _bytes = std::span<const std::byte>{ static_cast<const std::byte*>(_data), _sizeBytes };
+			const auto _hash = gl_impl::capture_hash(_bytes);
+			this->referenced_payload_bytes_ += _sizeBytes;
+
+			const auto [_first, _last] = this->payload_ids_.equal_range(_hash);
+			for (auto it = _first; it != _last; ++it)
+			{
+				const auto& _existing = this->payloads_[it->second];
+				if (_existing.size() == _sizeBytes && std::memcmp(_existing.data(), _data, _sizeBytes) == 0)
+				{
+					return it->second;
+				};
+			};
+
+			const auto _id = static_cast<uint32_t>(this->payloads_.size());
+			this->payloads_.emplace_back(_bytes.begin(), _bytes.end());
+			this->payload_ids_.emplace(_hash, _id);
+			this->payload_bytes_ += _sizeBytes;
+			return _id;
+		};
+
+		/**
+		 * @brief Appends a call, used by the installed functions.
+		 * @param _entry Entry point called.
+		 * @param _payloads Payload id of each payload slot.
+		 * @param _values Arguments followed by the result, if any.
+		*/
+		template <typename... ValueTs>
+		void append(record_entry _entry, std::span<const uint32_t> _payloads, const ValueTs&... _values)
+		{
+			const auto _id = jc::to_underlying(_entry);
+			const auto _offset = this->calls_.size();
+			this->calls_.resize(_offset + sizeof(_id) + (size_t{ 0 } + ... + sizeof(ValueTs)) + _payloads.size_bytes());
+
+			auto _out = this->calls_.data() + _offset;
+			std::memcpy(_out, &_id, sizeof(_id));
+			_out += sizeof(_id);
+			((std::memcpy(_out, &_values, sizeof(_values)), _out += sizeof(_values)), ...);
+			if (!_payloads.empty())
+			{
+				std::memcpy(_out, _payloads.data(), _payloads.size_bytes());
+			};
+			++this->call_count_;
+		};
+
+		/**
+		 * @brief Moves the captured calls and payloads out into a trace, leaving the layer empty.
+		*/
+		trace take_trace();
+
+		/**
+		 * @brief Tracks a generic buffer binding, needed to resolve target based buffer calls.
+		*/
+		void bind_buffer(GLenum _target, GLuint _buffer)
+		{
+			this->bindings_[_target] = _buffer;
+		};
+
+		/**
+		 * @brief Gets the buffer bound to a target, 0 if none.
+		*/
+		GLuint bound_buffer(GLenum _target) const
+		{
+			const auto it = this->bindings_.find(_target);
+			return (it != this->bindings_.end()) ? it->second : 0;
+		};
+
+		/**
+		 * @brief Tracks the pixel unpack parameters that change the size of pixel transfers.
+		*/
+		void set_unpack(GLenum _parameter, GLint _value) noexcept
+		{
+			if (_parameter == GL_UNPACK_ALIGNMENT)
+			{
+				this->unpack_alignment_ = _value;
+			}
+			else if (_parameter == GL_UNPACK_ROW_LENGTH)
+			{
+				this->unpack_row_length_ = _value;
+			};
+		};
+		GLint unpack_alignment() const noexcept { return this->unpack_alignment_; };
+		GLint unpack_row_length() const noexcept { return this->unpack_row_length_; };
+
+		/**
+		 * @brief Remembers where a buffer is mapped.
+		*/
+		void map_buffer(GLuint _buffer, const capture_mapping& _mapping)
+		{
+			this->mappings_[_buffer] = _mapping;
+		};
+
+		/**
+		 * @brief Gets where a buffer is mapped, null if it isn't.
+		*/
+		const capture_mapping* mapping(GLuint _buffer) const
+		{
+			const auto it = this->mappings_.find(_buffer);
+			return (it != this->mappings_.end()) ? &it->second : nullptr;
+		};
+
+		/**
+		 * @brief Forgets a buffer's mapping.
+		*/
+		void unmap_buffer(GLuint _buffer)
+		{
+			this->mappings_.erase(_buffer);
+		};
+
+		capture_layer() = default;
+		~capture_layer()
+		{
+			this->uninstall();
+		};
+
+	private:
+
+#define JCLIB_OPENGL_CAPTURE_SAVED(_name) \
+		decltype(glad_##_name) _name##_ = nullptr;
+		JCLIB_OPENGL_RECORD_FUNCTIONS(JCLIB_OPENGL_CAPTURE_SAVED)
+#undef JCLIB_OPENGL_CAPTURE_SAVED
+
+		std::vector<std::byte> calls_{};
+		std::vector<std::vector<std::byte>> payloads_{};
+		std::unordered_multimap<uint64_t, uint32_t> payload_ids_{};
+		std::unordered_map<GLenum, GLuint> bindings_{};
+		std::unordered_map<GLuint, capture_mapping> mappings_{};
+		GLint unpack_alignment_ = 4;
+		GLint unpack_row_length_ = 0;
+		size_t call_count_ = 0;
+		size_t frames_ = 0;
+		size_t payload_bytes_ = 0;
+		size_t referenced_payload_bytes_ = 0;
+
+		inline static capture_layer* active_ = nullptr;
+
+		capture_layer(const capture_layer&) = delete;
+		capture_layer& operator=(const capture_layer&) = delete;
+	};
+
+};
+#pragma endregion
+
+#pragma region CAPTURE_HOOKS
+namespace jc::gl
+{
+	/**
+	 * @brief Customization point for capturing the memory behind an entry point's pointer arguments.
+	 *
+	 * Specializations declare payload_slots and provide a static before(capture_layer&, std::span<uint32_t>, args...)
+	 * called ahead of the driver, and/or an after(capture_layer&, std::span<uint32_t>, [result,] args...) called
+	 * once the driver returns, that fill in the payload id of each slot.
+	*/
+	template <record_entry Entry>
+	struct capture_hook {};
+
+	/**
+	 * @brief Number of payload slots in an entry point's call records.
+	*/
+	template <record_entry Entry>
+	constexpr inline size_t capture_payload_slots = []()
+	{
+		if constexpr (requires { capture_hook<Entry>::payload_slots; })
+		{
+			return static_cast<size_t>(capture_hook<Entry>::payload_slots);
+		}
+		else
+		{
+			return size_t{ 0 };
+		};
+	}();
+
+	namespace gl_impl
+	{
+		/**
+		 * @brief Gets the size of a pixel transfer.
+		 * @param _alignment Row alignment in bytes, GL_UNPACK_ALIGNMENT.
+		 * @param _rowLength Pixels per row if not 0, GL_UNPACK_ROW_LENGTH.
+		*/
+		inline size_t capture_pixel_bytes(GLenum _format, GLenum _type, GLsizei _width, GLsizei _height, GLsizei _depth,
+			GLint _alignment = 4, GLint _rowLength = 0)
+		{
+			size_t _components = 4;
+			switch (_format)
+			{
+			case GL_RED: [[fallthrough]];
+			case GL_RED_INTEGER: [[fallthrough]];
+			case GL_DEPTH_COMPONENT: [[fallthrough]];
+			case GL_STENCIL_INDEX:
+				_components = 1;
+				break;
+			case GL_RG: [[fallthrough]];
+			case GL_RG_INTEGER: [[fallthrough]];
+			case GL_DEPTH_STENCIL:
+				_components = 2;
+				break;
+			case GL_RGB: [[fallthrough]];
+			case GL_BGR: [[fallthrough]];
+			case GL_RGB_INTEGER: [[fallthrough]];
+			case GL_BGR_INTEGER:
+				_components = 3;
+				break;
+			default:
+				break;
+			};
+
+			size_t _pixelBytes = 4;
+			switch (_type)
+			{
+			case GL_UNSIGNED_BYTE: [[fallthrough]];
+			case GL_BYTE:
+				_pixelBytes = _components;
+				break;
+			case GL_UNSIGNED_SHORT: [[fallthrough]];
+			case GL_SHORT: [[fallthrough]];
+			case GL_HALF_FLOAT:
+				_pixelBytes = _components * 2;
+				break;
+			case GL_UNSIGNED_INT: [[fallthrough]];
+			case GL_INT: [[fallthrough]];
+			case GL_FLOAT:
+				_pixelBytes = _components * 4;
+				break;
+			case GL_UNSIGNED_BYTE_3_3_2: [[fallthrough]];
+			case GL_UNSIGNED_BYTE_2_3_3_REV:
+				_pixelBytes = 1;
+				break;
+			case GL_UNSIGNED_SHORT_5_6_5: [[fallthrough]];
+			case GL_UNSIGNED_SHORT_5_6_5_REV: [[fallthrough]];
+			case GL_UNSIGNED_SHORT_4_4_4_4: [[fallthrough]];
+			case GL_UNSIGNED_SHORT_4_4_4_4_REV: [[fallthrough]];
+			case GL_UNSIGNED_SHORT_5_5_5_1: [[fallthrough]];
+			case GL_UNSIGNED_SHORT_1_5_5_5_REV:
+				_pixelBytes = 2;
+				break;
+			case GL_FLOAT_32_UNSIGNED_INT_24_8_REV:
+				_pixelBytes = 8;
+				break;
+			default:
+				// Remaining packed types are all one 32 bit word per pixel
+				_pixelBytes = 4;
+				break;
+			};
+
+			if (_width <= 0 || _height <= 0 || _depth <= 0)
+			{
+				return 0;
+			};
+			const auto _align = static_cast<size_t>(std::max(_alignment, 1));
+			const auto _row = static_cast<size_t>(_width) * _pixelBytes;
+			const auto _stride = (static_cast<size_t>(std::max(_rowLength, _width)) * _pixelBytes + _align - 1) / _align * _align;
+			return _stride * (static_cast<size_t>(_height) * static_cast<size_t>(_depth) - 1) + _row;
+		};
+
+		/**
+		 * @brief Captures pixel data unless a pixel unpack buffer is bound, in which case the pointer is an offset.
+		*/
+		inline uint32_t capture_pixels(capture_layer& _layer, const void* _pixels, GLenum _format, GLenum _type,
+			GLsizei _width, GLsizei _height, GLsizei _depth)
+		{
+			if (_layer.bound_buffer(GL_PIXEL_UNPACK_BUFFER) != 0)
+			{
+				return trace_null_payload;
+			};
+			return _layer.payload(_pixels, capture_pixel_bytes(_format, _type, _width, _height, _depth,
+				_layer.unpack_alignment(), _layer.unpack_row_length()));
+		};
+
+		/**
+		 * @brief Captures the names written by glGen* and glCreate* functions.
+		*/
+		struct capture_hook_new_names
+		{
+			constexpr static size_t payload_slots = 1;
+			static void after(capture_layer& _layer, std::span<uint32_t> _ids, GLsizei _count, GLuint* _names)
+			{
+				_ids[0] = _layer.payload(_names, static_cast<size_t>(_count) * sizeof(GLuint));
+			};
+		};
+
+		/**
+		 * @brief Captures the names passed to glDelete* functions.
+		*/
+		struct capture_hook_delete_names
+		{
+			constexpr static size_t payload_slots = 1;
+			static void before(capture_layer& _layer, std::span<uint32_t> _ids, GLsizei _count, const GLuint* _names)
+			{
+				_ids[0] = _layer.payload(_names, static_cast<size_t>(_count) * sizeof(GLuint));
+			};
+		};
+
+		/**
+		 * @brief Captures the null terminated name string passed to resource lookups.
+		*/
+		struct capture_hook_name_string
+		{
+			constexpr static size_t payload_slots = 1;
+			static void before(capture_layer& _layer, std::span<uint32_t> _ids, GLuint, const GLchar* _name)
+			{
+				_ids[0] = _layer.payload(_name, (_name) ? std::strlen(_name) + 1 : 0);
+			};
+			static void before(capture_layer& _layer, std::span<uint32_t> _ids, GLuint, GLenum, const GLchar* _name)
+			{
+				_ids[0] = _layer.payload(_name, (_name) ? std::strlen(_name) + 1 : 0);
+			};
+		};
+
+		/**
+		 * @brief Captures the text of labels, debug groups and inserted messages, which end in (length, text).
+		 *
+		 * A negative length means the text is null terminated, the terminator is kept so replay can pass the
+		 * same length.
+		*/
+		struct capture_hook_debug_text
+		{
+			constexpr static size_t payload_slots = 1;
+			static uint32_t text(capture_layer& _layer, GLsizei _length, const GLchar* _text)
+			{
+				if (!_text)
+				{
+					return trace_null_payload;
+				};
+				return _layer.payload(_text, (_length < 0) ? std::strlen(_text) + 1 : static_cast<size_t>(_length));
+			};
+
+			static void before(capture_layer& _layer, std::span<uint32_t> _ids, GLenum, GLuint, GLsizei _length, const GLchar* _text)
+			{
+				_ids[0] = text(_layer, _length, _text);
+			};
+			static void before(capture_layer& _layer, std::span<uint32_t> _ids, const void*, GLsizei _length, const GLchar* _text)
+			{
+				_ids[0] = text(_layer, _length, _text);
+			};
+			static void before(capture_layer& _layer, std::span<uint32_t> _ids, GLenum, GLenum, GLuint, GLenum,
+				GLsizei _length, const GLchar* _text)
+			{
+				_ids[0] = text(_layer, _length, _text);
+			};
+		};
+
+		/**
+		 * @brief Captures the attachment or draw buffer list passed as (count, array) after the first argument.
+		*/
+		struct capture_hook_enum_list
+		{
+			constexpr static size_t payload_slots = 1;
+			template <typename FirstT, typename... RestTs>
+			static void before(capture_layer& _layer, std::span<uint32_t> _ids, FirstT, GLsizei _count, const GLenum* _list, RestTs...)
+			{
+				_ids[0] = _layer.payload(_list, static_cast<size_t>(_count) * sizeof(GLenum));
+			};
+		};
+
+		/**
+		 * @brief Captures the value array of a glProgramUniform*v call.
+		*/
+		template <size_t Components>
+		struct capture_hook_program_uniform
+		{
+			constexpr static size_t payload_slots = 1;
+			template <typename T>
+			static void before(capture_layer& _layer, std::span<uint32_t> _ids, GLuint, GLint, GLsizei _count, const T* _values)
+			{
+				_ids[0] = _layer.payload(_values, static_cast<size_t>(_count) * Components * sizeof(T));
+			};
+			template <typename T>
+			static void before(capture_layer& _layer, std::span<uint32_t> _ids, GLuint, GLint, GLsizei _count, GLboolean, const T* _values)
+			{
+				_ids[0] = _layer.payload(_values, static_cast<size_t>(_count) * Components * sizeof(T));
+			};
+		};
+
+		/**
+		 * @brief Captures the data of calls shaped (object or target, [offset,] size, data, ...).
+		*/
+		template <bool HasOffset>
+		struct capture_hook_buffer_data
+		{
+			constexpr static size_t payload_slots = 1;
+			template <typename... RestTs>
+			static void before(capture_layer& _layer, std::span<uint32_t> _ids, GLuint, GLsizeiptr _size, const void* _data, RestTs...)
+				requires (!HasOffset)
+			{
+				_ids[0] = _layer.payload(_data, static_cast<size_t>(_size));
+			};
+			static void before(capture_layer& _layer, std::span<uint32_t> _ids, GLuint, GLintptr, GLsizeiptr _size, const void* _data)
+				requires (HasOffset)
+			{
+				_ids[0] = _layer.payload(_data, static_cast<size_t>(_size));
+			};
+		};
+	};
+
+	template <> struct capture_hook<record_entry::glGenBuffers> : gl_impl::capture_hook_new_names {};
+	template <> struct capture_hook<record_entry::glGenFramebuffers> : gl_impl::capture_hook_new_names {};
+	template <> struct capture_hook<record_entry::glGenRenderbuffers> : gl_impl::capture_hook_new_names {};
+	template <> struct capture_hook<record_entry::glGenTextures> : gl_impl::capture_hook_new_names {};
+	template <> struct capture_hook<record_entry::glGenVertexArrays> : gl_impl::capture_hook_new_names {};
+
+	template <> struct capture_hook<record_entry::glDeleteBuffers> : gl_impl::capture_hook_delete_names {};
+	template <> struct capture_hook<record_entry::glDeleteFramebuffers> : gl_impl::capture_hook_delete_names {};
+	template <> struct capture_hook<record_entry::glDeleteRenderbuffers> : gl_impl::capture_hook_delete_names {};
+	template <> struct capture_hook<record_entry::glDeleteTextures> : gl_impl::capture_hook_delete_names {};
+	template <> struct capture_hook<record_entry::glDeleteVertexArrays> : gl_impl::capture_hook_delete_names {};
+
+	template <> struct capture_hook<record_entry::glGetAttribLocation> : gl_impl::capture_hook_name_string {};
+	template <> struct capture_hook<record_entry::glGetUniformBlockIndex> : gl_impl::capture_hook_name_string {};
+	template <> struct capture_hook<record_entry::glGetUniformLocation> : gl_impl::capture_hook_name_string {};
+
+	template <> struct capture_hook<record_entry::glDrawBuffers>
+	{
+		constexpr static size_t payload_slots = 1;
+		static void before(capture_layer& _layer, std::span<uint32_t> _ids, GLsizei _count, const GLenum* _buffers)
+		{
+			_ids[0] = _layer.payload(_buffers, static_cast<size_t>(_count) * sizeof(GLenum));
+		};
+	};
+
+	template <> struct capture_hook<record_entry::glBufferData> : gl_impl::capture_hook_buffer_data<false> {};
+	template <> struct capture_hook<record_entry::glBufferSubData> : gl_impl::capture_hook_buffer_data<true> {};
+
+	template <>
+	struct capture_hook<record_entry::glUniform4fv>
+	{
+		constexpr static size_t payload_slots = 1;
+		static void before(capture_layer& _layer, std::span<uint32_t> _ids, GLint, GLsizei _count, const GLfloat* _values)
+		{
+			_ids[0] = _layer.payload(_values, static_cast<size_t>(_count) * 4 * sizeof(GLfloat));
+		};
+	};
+
+	template <>
+	struct capture_hook<record_entry::glPixelStorei>
+	{
+		static void after(capture_layer& _layer, std::span<uint32_t>, GLenum _parameter, GLint _value)
+		{
+			_layer.set_unpack(_parameter, _value);
+		};
+	};
+
+	template <>
+	struct capture_hook<record_entry::glTexImage2D>
+	{
+		constexpr static size_t payload_slots = 1;
+		static void before(capture_layer& _layer, std::span<uint32_t> _ids, GLenum, GLint, GLint, GLsizei _width,
+			GLsizei _height, GLint, GLenum _format, GLenum _type, const void* _pixels)
+		{
+			_ids[0] = gl_impl::capture_pixels(_layer, _pixels, _format, _type, _width, _height, 1);
+		};
+	};
+
+	template <>
+	struct capture_hook<record_entry::glUniformMatrix4fv>
+	{
+		constexpr static size_t payload_slots = 1;
+		static void before(capture_layer& _layer, std::span<uint32_t> _ids, GLint, GLsizei _count, GLboolean, const GLfloat* _values)
+		{
+			_ids[0] = _layer.payload(_values, static_cast<size_t>(_count) * 16 * sizeof(GLfloat));
+		};
+	};
+
+	template <>
+	struct capture_hook<record_entry::glShaderSource>
+	{
+		constexpr static size_t payload_slots = 1;
+		static void before(capture_layer& _layer, std::span<uint32_t> _ids, GLuint, GLsizei _count,
+			const GLchar* const* _strings, const GLint* _lengths)
+		{
+			std::string _source{};
+			for (GLsizei n = 0; n != _count; ++n)
+			{
+				if (_lengths && _lengths[n] >= 0)
+				{
+					_source.append(_strings[n], static_cast<size_t>(_lengths[n]));
+				}
+				else
+				{
+					_source.append(_strings[n]);
+				};
+			};
+			_ids[0] = _layer.payload(_source.data(), _source.size());
+		};
+	};
+
+	template <>
+	struct capture_hook<record_entry::glTexSubImage1D>
+	{
+		constexpr static size_t payload_slots = 1;
+		static void before(capture_layer& _layer, std::span<uint32_t> _ids, GLenum, GLint, GLint, GLsizei _width,
+			GLenum _format, GLenum _type, const void* _pixels)
+		{
+			_ids[0] = gl_impl::capture_pixels(_layer, _pixels, _format, _type, _width, 1, 1);
+		};
+	};
+
+	template <>
+	struct capture_hook<record_entry::glTexSubImage2D>
+	{
+		constexpr static size_t payload_slots = 1;
+		static void before(capture_layer& _layer, std::span<uint32_t> _ids, GLenum, GLint, GLint, GLint, GLsizei _width,
+			GLsizei _height, GLenum _format, GLenum _type, const void* _pixels)
+		{
+			_ids[0] = gl_impl::capture_pixels(_layer, _pixels, _format, _type, _width, _height, 1);
+		};
+	};
+
+	template <>
+	struct capture_hook<record_entry::glTexSubImage3D>
+	{
+		constexpr static size_t payload_slots = 1;
+		static void before(capture_layer& _layer, std::span<uint32_t> _ids, GLenum, GLint, GLint, GLint, GLint,
+			GLsizei _width, GLsizei _height, GLsizei _depth, GLenum _format, GLenum _type, const void* _pixels)
+		{
+			_ids[0] = gl_impl::capture_pixels(_layer, _pixels, _format, _type, _width, _height, _depth);
+		};
+	};
+
+	template <>
+	struct capture_hook<record_entry::glBindBuffer>
+	{
+		static void after(capture_layer& _layer, std::span<uint32_t>, GLenum _target, GLuint _buffer)
+		{
+			_layer.bind_buffer(_target, _buffer);
+		};
+	};
+
+	template <>
+	struct capture_hook<record_entry::glBindBufferBase>
+	{
+		static void after(capture_layer& _layer, std::span<uint32_t>, GLenum _target, GLuint, GLuint _buffer)
+		{
+			_layer.bind_buffer(_target, _buffer);
+		};
+	};
+
+	template <>
+	struct capture_hook<record_entry::glBindBufferRange>
+	{
+		static void after(capture_layer& _layer, std::span<uint32_t>, GLenum _target, GLuint, GLuint _buffer, GLintptr, GLsizeiptr)
+		{
+			_layer.bind_buffer(_target, _buffer);
+		};
+	};
+
+	namespace gl_impl
+	{
+		/**
+		 * @brief Captures the written contents of a mapping as it is unmapped.
+		*/
+		inline uint32_t capture_unmap(capture_layer& _layer, GLuint _buffer)
+		{
+			const auto _mapping = _layer.mapping(_buffer);
+			if (!_mapping)
+			{
+				return trace_null_payload;
+			};
+
+			auto _id = trace_null_payload;
+			if ((_mapping->access & GL_MAP_WRITE_BIT) && !(_mapping->access & GL_MAP_FLUSH_EXPLICIT_BIT))
+			{
+				_id = _layer.payload(_mapping->data, static_cast<size_t>(_mapping->length));
+			};
+			_layer.unmap_buffer(_buffer);
+			return _id;
+		};
+
+		/**
+		 * @brief Captures a flushed part of a mapping.
+		*/
+		inline uint32_t capture_flush(capture_layer& _layer, GLuint _buffer, GLintptr _offset, GLsizeiptr _length)
+		{
+			const auto _mapping = _layer.mapping(_buffer);
+			return (_mapping) ? _layer.payload(_mapping->data + _offset, static_cast<size_t>(_length)) : trace_null_payload;
+		};
+	};
+
+	template <>
+	struct capture_hook<record_entry::glMapBufferRange>
+	{
+		static void after(capture_layer& _layer, std::span<uint32_t>, void* _result, GLenum _target, GLintptr _offset,
+			GLsizeiptr _length, GLbitfield _access)
+		{
+			if (_result)
+			{
+				_layer.map_buffer(_layer.bound_buffer(_target),
+					capture_mapping{ static_cast<std::byte*>(_result), _offset, _length, _access });
+			};
+		};
+	};
+
+	template <>
+	struct capture_hook<record_entry::glFlushMappedBufferRange>
+	{
+		constexpr static size_t payload_slots = 1;
+		static void before(capture_layer& _layer, std::span<uint32_t> _ids, GLenum _target, GLintptr _offset, GLsizeiptr _length)
+		{
+			_ids[0] = gl_impl::capture_flush(_layer, _layer.bound_buffer(_target), _offset, _length);
+		};
+	};
+
+	template <>
+	struct capture_hook<record_entry::glUnmapBuffer>
+	{
+		constexpr static size_t payload_slots = 1;
+		static void before(capture_layer& _layer, std::span<uint32_t> _ids, GLenum _target)
+		{
+			_ids[0] = gl_impl::capture_unmap(_layer, _layer.bound_buffer(_target));
+		};
+	};
+
+#if GL_VERSION_4_1
+	template <> struct capture_hook<record_entry::glDeleteProgramPipelines> : gl_impl::capture_hook_delete_names {};
+	template <> struct capture_hook<record_entry::glProgramUniform2fv> : gl_impl::capture_hook_program_uniform<2> {};
+	template <> struct capture_hook<record_entry::glProgramUniform3fv> : gl_impl::capture_hook_program_uniform<3> {};
+	template <> struct capture_hook<record_entry::glProgramUniform4fv> : gl_impl::capture_hook_program_uniform<4> {};
+	template <> struct capture_hook<record_entry::glProgramUniformMatrix2fv> : gl_impl::capture_hook_program_uniform<4> {};
+	template <> struct capture_hook<record_entry::glProgramUniformMatrix3fv> : gl_impl::capture_hook_program_uniform<9> {};
+	template <> struct capture_hook<record_entry::glProgramUniformMatrix4fv> : gl_impl::capture_hook_program_uniform<16> {};
+
+	template <>
+	struct capture_hook<record_entry::glProgramBinary>
+	{
+		constexpr static size_t payload_slots = 1;
+		static void before(capture_layer& _layer, std::span<uint32_t> _ids, GLuint, GLenum, const void* _binary, GLsizei _length)
+		{
+			_ids[0] = _layer.payload(_binary, static_cast<size_t>(_length));
+		};
+	};
+#endif
+
+#if GL_VERSION_4_3
+	template <> struct capture_hook<record_entry::glGetProgramResourceIndex> : gl_impl::capture_hook_name_string {};
+	template <> struct capture_hook<record_entry::glGetProgramResourceLocation> : gl_impl::capture_hook_name_string {};
+	template <> struct capture_hook<record_entry::glInvalidateFramebuffer> : gl_impl::capture_hook_enum_list {};
+	template <> struct capture_hook<record_entry::glInvalidateSubFramebuffer> : gl_impl::capture_hook_enum_list {};
+	template <> struct capture_hook<record_entry::glDebugMessageInsert> : gl_impl::capture_hook_debug_text {};
+	template <> struct capture_hook<record_entry::glObjectLabel> : gl_impl::capture_hook_debug_text {};
+	template <> struct capture_hook<record_entry::glObjectPtrLabel> : gl_impl::capture_hook_debug_text {};
+	template <> struct capture_hook<record_entry::glPushDebugGroup> : gl_impl::capture_hook_debug_text {};
+#endif
+
+#if GL_VERSION_4_5
+	template <> struct capture_hook<record_entry::glCreateBuffers> : gl_impl::capture_hook_new_names {};
+	template <> struct capture_hook<record_entry::glCreateFramebuffers> : gl_impl::capture_hook_new_names {};
+	template <> struct capture_hook<record_entry::glCreateProgramPipelines> : gl_impl::capture_hook_new_names {};
+	template <> struct capture_hook<record_entry::glCreateRenderbuffers> : gl_impl::capture_hook_new_names {};
+	template <> struct capture_hook<record_entry::glCreateVertexArrays> : gl_impl::capture_hook_new_names {};
+
+	template <> struct capture_hook<record_entry::glNamedBufferData> : gl_impl::capture_hook_buffer_data<false> {};
+	template <> struct capture_hook<record_entry::glNamedBufferSubData> : gl_impl::capture_hook_buffer_data<true> {};
+	template <> struct capture_hook<record_entry::glNamedBufferStorage> : gl_impl::capture_hook_buffer_data<false> {};
+	template <> struct capture_hook<record_entry::glBufferStorage> : gl_impl::capture_hook_buffer_data<false> {};
+
+	template <> struct capture_hook<record_entry::glNamedFramebufferDrawBuffers> : gl_impl::capture_hook_enum_list {};
+	template <> struct capture_hook<record_entry::glInvalidateNamedFramebufferData> : gl_impl::capture_hook_enum_list {};
+	template <> struct capture_hook<record_entry::glInvalidateNamedFramebufferSubData> : gl_impl::capture_hook_enum_list {};
+
+	template <>
+	struct capture_hook<record_entry::glCreateTextures>
+	{
+		constexpr static size_t payload_slots = 1;
+		static void after(capture_layer& _layer, std::span<uint32_t> _ids, GLenum, GLsizei _count, GLuint* _names)
+		{
+			_ids[0] = _layer.payload(_names, static_cast<size_t>(_count) * sizeof(GLuint));
+		};
+	};
+
+	template <>
+	struct capture_hook<record_entry::glClearNamedFramebufferfv>
+	{
+		constexpr static size_t payload_slots = 1;
+		static void before(capture_layer& _layer, std::span<uint32_t> _ids, GLuint, GLenum _buffer, GLint, const GLfloat* _value)
+		{
+			_ids[0] = _layer.payload(_value, ((_buffer == GL_COLOR) ? 4 : 1) * sizeof(GLfloat));
+		};
+	};
+
+	template <>
+	struct capture_hook<record_entry::glTextureParameteriv>
+	{
+		constexpr static size_t payload_slots = 1;
+		static void before(capture_layer& _layer, std::span<uint32_t> _ids, GLuint, GLenum _parameter, const GLint* _values)
+		{
+			const size_t _count = (_parameter == GL_TEXTURE_BORDER_COLOR || _parameter == GL_TEXTURE_SWIZZLE_RGBA) ? 4 : 1;
+			_ids[0] = _layer.payload(_values, _count * sizeof(GLint));
+		};
+	};
+
+	template <>
+	struct capture_hook<record_entry::glTextureSubImage1D>
+	{
+		constexpr static size_t payload_slots = 1;
+		static void before(capture_layer& _layer, std::span<uint32_t> _ids, GLuint, GLint, GLint, GLsizei _width,
+			GLenum _format, GLenum _type, const void* _pixels)
+		{
+			_ids[0] = gl_impl::capture_pixels(_layer, _pixels, _format, _type, _width, 1, 1);
+		};
+	};
+
+	template <>
+	struct capture_hook<record_entry::glTextureSubImage2D>
+	{
+		constexpr static size_t payload_slots = 1;
+		static void before(capture_layer& _layer, std::span<uint32_t> _ids, GLuint, GLint, GLint, GLint, GLsizei _width,
+			GLsizei _height, GLenum _format, GLenum _type, const void* _pixels)
+		{
+			_ids[0] = gl_impl::capture_pixels(_layer, _pixels, _format, _type, _width, _height, 1);
+		};
+	};
+
+	template <>
+	struct capture_hook<record_entry::glTextureSubImage3D>
+	{
+		constexpr static size_t payload_slots = 1;
+		static void before(capture_layer& _layer, std::span<uint32_t> _ids, GLuint, GLint, GLint, GLint, GLint,
+			GLsizei _width, GLsizei _height, GLsizei _depth, GLenum _format, GLenum _type, const void* _pixels)
+		{
+			_ids[0] = gl_impl::capture_pixels(_layer, _pixels, _format, _type, _width, _height, _depth);
+		};
+	};
+
+	template <>
+	struct capture_hook<record_entry::glMapNamedBufferRange>
+	{
+		static void after(capture_layer& _layer, std::span<uint32_t>, void* _result, GLuint _buffer, GLintptr _offset,
+			GLsizeiptr _length, GLbitfield _access)
+		{
+			if (_result)
+			{
+				_layer.map_buffer(_buffer, capture_mapping{ static_cast<std::byte*>(_result), _offset, _length, _access });
+			};
+		};
+	};
+
+	template <>
+	struct capture_hook<record_entry::glFlushMappedNamedBufferRange>
+	{
+		constexpr static size_t payload_slots = 1;
+		static void before(capture_layer& _layer, std::span<uint32_t> _ids, GLuint _buffer, GLintptr _offset, GLsizeiptr _length)
+		{
+			_ids[0] = gl_impl::capture_flush(_layer, _buffer, _offset, _length);
+		};
+	};
+
+	template <>
+	struct capture_hook<record_entry::glUnmapNamedBuffer>
+	{
+		constexpr static size_t payload_slots = 1;
+		static void before(capture_layer& _layer, std::span<uint32_t> _ids, GLuint _buffer)
+		{
+			_ids[0] = gl_impl::capture_unmap(_layer, _buffer);
+		};
+	};
+#endif
+
+	/**
+	 * @brief Generates the function installed by capture_layer for an entry point.
+	*/
+	template <record_entry Entry, typename FnT>
+	struct capture_function;
+
+	template <record_entry Entry, typename RetT, typename... ArgTs>
+	struct capture_function<Entry, RetT(APIENTRY*)(ArgTs...)>
+	{
+		/**
+		 * @brief The function that was loaded before the layer was installed.
+		*/
+		inline static RetT(APIENTRY* real)(ArgTs...) = nullptr;
+
+		static RetT APIENTRY invoke(ArgTs... _args)
+		{
+			auto _layer = capture_layer::active();
+			JCLIB_ASSERT(_layer);
+
+			std::array<uint32_t, capture_payload_slots<Entry>> _ids{};
+			_ids.fill(trace_null_payload);
+			const auto _slots = std::span<uint32_t>{ _ids };
+			if constexpr (requires { capture_hook<Entry>::before(*_layer, _slots, _args...); })
+			{
+				capture_hook<Entry>::before(*_layer, _slots, _args...);
+			};
+
+			if constexpr (std::is_void_v<RetT>)
+			{
+				real(_args...);
+				if constexpr (requires { capture_hook<Entry>::after(*_layer, _slots, _args...); })
+				{
+					capture_hook<Entry>::after(*_layer, _slots, _args...);
+				};
+				_layer->append(Entry, _ids, _args...);
+			}
+			else
+			{
+				const RetT _result = real(_args...);
+				if constexpr (requires { capture_hook<Entry>::after(*_layer, _slots, _result, _args...); })
+				{
+					capture_hook<Entry>::after(*_layer, _slots, _result, _args...);
+				};
+				_layer->append(Entry, _ids, _args..., _result);
+				return _result;
+			};
+		};
+	};
+
+	inline void capture_layer::install()
+	{
+		if (this->installed())
+		{
+			return;
+		};
+		JCLIB_ASSERT(!active_);
+
+		// Unpack state may have been changed before install, read it back before glGetIntegerv is wrapped
+		std::array<std::pair<GLenum, GLint>, 2> _unpack
+		{
+			std::pair<GLenum, GLint>{ GL_UNPACK_ALIGNMENT, this->unpack_alignment_ },
+			std::pair<GLenum, GLint>{ GL_UNPACK_ROW_LENGTH, this->unpack_row_length_ },
+		};
+		if (glad_glGetIntegerv)
+		{
+			for (auto& [_parameter, _value] : _unpack)
+			{
+				glad_glGetIntegerv(_parameter, &_value);
+			};
+		};
+
+		// Functions the loader didn't find are left null so availability checks keep working
+#define JCLIB_OPENGL_CAPTURE_INSTALL(_name) \
+		this->_name##_ = glad_##_name; \
+		if (glad_##_name) \
+		{ \
+			capture_function<record_entry::_name, decltype(glad_##_name)>::real = glad_##_name; \
+			glad_##_name = &capture_function<record_entry::_name, decltype(glad_##_name)>::invoke; \
+		};
+		JCLIB_OPENGL_RECORD_FUNCTIONS(JCLIB_OPENGL_CAPTURE_INSTALL)
+#undef JCLIB_OPENGL_CAPTURE_INSTALL
+
+		active_ = this;
+
+		// Record state the trace doesn't know about yet so replays size pixel transfers the same way
+		for (auto& [_parameter, _value] : _unpack)
+		{
+			const auto _traced = (_parameter == GL_UNPACK_ALIGNMENT) ? this->unpack_alignment_ : this->unpack_row_length_;
+			if (_value != _traced)
+			{
+				this->set_unpack(_parameter, _value);
+				this->append(record_entry::glPixelStorei, {}, _parameter, _value);
+			};
+		};
+	};
+
+	inline void capture_layer::uninstall()
+	{
+		if (!this->installed())
+		{
+			return;
+		};
+
+#define JCLIB_OPENGL_CAPTURE_UNINSTALL(_name) \
+		glad_##_name = this->_name##_;
+		JCLIB_OPENGL_RECORD_FUNCTIONS(JCLIB_OPENGL_CAPTURE_UNINSTALL)
+#undef JCLIB_OPENGL_CAPTURE_UNINSTALL
+
+		active_ = nullptr;
+	};
+
+	inline trace capture_layer::take_trace()
+	{
+		trace _trace{};
+		_trace.entries.reserve(record_entry_count);
+
+#define JCLIB_OPENGL_CAPTURE_ENTRY_INFO(_name) \
+		{ \
+			using signature = record_entry_traits<record_entry::_name>::signature; \
+			using result_type = signature::result_type; \
+			constexpr uint32_t _resultBytes = std::is_void_v<result_type> ? 0 : sizeof(std::conditional_t<std::is_void_v<result_type>, char, result_type>); \
+			_trace.entries.push_back(trace_entry_info{ std::string{ #_name }, static_cast<uint32_t>(signature::arg_bytes), \
+				_resultBytes, static_cast<uint32_t>(capture_payload_slots<record_entry::_name>) }); \
+		};
+		JCLIB_OPENGL_RECORD_FUNCTIONS(JCLIB_OPENGL_CAPTURE_ENTRY_INFO)
+#undef JCLIB_OPENGL_CAPTURE_ENTRY_INFO
+
+		_trace.payloads = std::move(this->payloads_);
+		_trace.calls = std::move(this->calls_);
+
+		this->payloads_.clear();
+		this->calls_.clear();
+		this->payload_ids_.clear();
+		this->call_count_ = 0;
+		this->frames_ = 0;
+		this->payload_bytes_ = 0;
+		this->referenced_payload_bytes_ = 0;
+		return _trace;
+	};
+
+};
+#pragma endregion
+
+#pragma region TRACE_REPLAYER
+namespace jc::gl
+{
+	/**
+	 * @brief How the replayer treats an argument of a traced call.
+	*/
+	enum class replay_arg : uint8_t
+	{
+		/**
+		 * @brief Passed through unchanged.
+		*/
+		value,
+
+		/**
+		 * @brief Object names, remapped to the names created while replaying. Shaders use program as they share its namespace.
+		*/
+		buffer,
+		vao,
+		texture,
+		framebuffer,
+		renderbuffer,
+		program,
+		pipeline,
+
+		/**
+		 * @brief Sync object, remapped to the fence created while replaying.
+		*/
+		sync,
+
+		/**
+		 * @brief Uniform location of the nearest preceding program argument.
+		*/
+		location,
+
+		/**
+		 * @brief Uniform location of the program bound with glUseProgram.
+		*/
+		current_location,
+
+		/**
+		 * @brief Pointer replaced with the next payload of the call, left alone if no payload was captured.
+		*/
+		payload,
+	};
+
+	/**
+	 * @brief Describes the arguments of an entry point for replay.
+	 *
+	 * Unspecialized entry points pass every argument through unchanged. Arguments past the end of
+	 * kinds are values. Entry points with skip set are not replayed. Entry points writing through a
+	 * pointer argument are skipped too unless they have a replay_hook, the traced pointer is long gone.
+	*/
+	template <record_entry Entry>
+	struct replay_args
+	{
+		constexpr static std::array<replay_arg, 0> kinds{};
+		constexpr static bool skip = false;
+	};
+
+#define JCLIB_OPENGL_REPLAY_ARGS(_name, ...) \
+	template <> \
+	struct replay_args<record_entry::_name> \
+	{ \
+		using enum replay_arg; \
+		constexpr static std::array kinds{ __VA_ARGS__ }; \
+		constexpr static bool skip = false; \
+	};
+#define JCLIB_OPENGL_REPLAY_SKIP(_name) \
+	template <> \
+	struct replay_args<record_entry::_name> \
+	{ \
+		constexpr static std::array<replay_arg, 0> kinds{}; \
+		constexpr static bool skip = true; \
+	};
+
+	JCLIB_OPENGL_REPLAY_ARGS(glAttachShader, program, program)
+	JCLIB_OPENGL_REPLAY_ARGS(glBindBuffer, value, buffer)
+	JCLIB_OPENGL_REPLAY_ARGS(glBindBufferBase, value, value, buffer)
+	JCLIB_OPENGL_REPLAY_ARGS(glBindBufferRange, value, value, buffer)
+	JCLIB_OPENGL_REPLAY_ARGS(glBindFramebuffer, value, framebuffer)
+	JCLIB_OPENGL_REPLAY_ARGS(glBindRenderbuffer, value, renderbuffer)
+	JCLIB_OPENGL_REPLAY_ARGS(glBindTexture, value, texture)
+	JCLIB_OPENGL_REPLAY_ARGS(glBindVertexArray, vao)
+	JCLIB_OPENGL_REPLAY_ARGS(glBufferData, value, value, payload)
+	JCLIB_OPENGL_REPLAY_ARGS(glBufferSubData, value, value, value, payload)
+	JCLIB_OPENGL_REPLAY_ARGS(glClientWaitSync, sync)
+	JCLIB_OPENGL_REPLAY_ARGS(glCompileShader, program)
+	JCLIB_OPENGL_REPLAY_ARGS(glDeleteProgram, program)
+	JCLIB_OPENGL_REPLAY_ARGS(glDeleteShader, program)
+	JCLIB_OPENGL_REPLAY_ARGS(glDeleteSync, sync)
+	JCLIB_OPENGL_REPLAY_ARGS(glDetachShader, program, program)
+	JCLIB_OPENGL_REPLAY_ARGS(glDrawBuffers, value, payload)
+	JCLIB_OPENGL_REPLAY_ARGS(glFramebufferRenderbuffer, value, value, value, renderbuffer)
+	JCLIB_OPENGL_REPLAY_ARGS(glFramebufferTexture, value, value, texture)
+	JCLIB_OPENGL_REPLAY_ARGS(glFramebufferTextureLayer, value, value, texture)
+	JCLIB_OPENGL_REPLAY_ARGS(glGetAttribLocation, program, payload)
+	JCLIB_OPENGL_REPLAY_ARGS(glGetUniformBlockIndex, program, payload)
+	JCLIB_OPENGL_REPLAY_ARGS(glGetUniformLocation, program, payload)
+	JCLIB_OPENGL_REPLAY_ARGS(glIsBuffer, buffer)
+	JCLIB_OPENGL_REPLAY_ARGS(glIsFramebuffer, framebuffer)
+	JCLIB_OPENGL_REPLAY_ARGS(glIsProgram, program)
+	JCLIB_OPENGL_REPLAY_ARGS(glIsRenderbuffer, renderbuffer)
+	JCLIB_OPENGL_REPLAY_ARGS(glIsShader, program)
+	JCLIB_OPENGL_REPLAY_ARGS(glIsSync, sync)
+	JCLIB_OPENGL_REPLAY_ARGS(glIsTexture, texture)
+	JCLIB_OPENGL_REPLAY_ARGS(glIsVertexArray, vao)
+	JCLIB_OPENGL_REPLAY_ARGS(glLinkProgram, program)
+	JCLIB_OPENGL_REPLAY_ARGS(glShaderSource, program, value, payload)
+	JCLIB_OPENGL_REPLAY_ARGS(glTexBuffer, value, value, buffer)
+	JCLIB_OPENGL_REPLAY_ARGS(glTexImage2D, value, value, value, value, value, value, value, value, payload)
+	JCLIB_OPENGL_REPLAY_ARGS(glTexSubImage1D, value, value, value, value, value, value, payload)
+	JCLIB_OPENGL_REPLAY_ARGS(glTexSubImage2D, value, value, value, value, value, value, value, value, payload)
+	JCLIB_OPENGL_REPLAY_ARGS(glTexSubImage3D, value, value, value, value, value, value, value, value, value, value, payload)
+	JCLIB_OPENGL_REPLAY_ARGS(glUniform1f, current_location)
+	JCLIB_OPENGL_REPLAY_ARGS(glUniform1i, current_location)
+	JCLIB_OPENGL_REPLAY_ARGS(glUniform2f, current_location)
+	JCLIB_OPENGL_REPLAY_ARGS(glUniform3f, current_location)
+	JCLIB_OPENGL_REPLAY_ARGS(glUniform4f, current_location)
+	JCLIB_OPENGL_REPLAY_ARGS(glUniform4fv, current_location, value, payload)
+	JCLIB_OPENGL_REPLAY_ARGS(glUniformBlockBinding, program)
+	JCLIB_OPENGL_REPLAY_ARGS(glUniformMatrix4fv, current_location, value, value, payload)
+	JCLIB_OPENGL_REPLAY_ARGS(glUseProgram, program)
+	JCLIB_OPENGL_REPLAY_ARGS(glWaitSync, sync)
+
+	JCLIB_OPENGL_REPLAY_SKIP(glGetString)
+	JCLIB_OPENGL_REPLAY_SKIP(glGetStringi)
+
+#if GL_VERSION_4_1
+	JCLIB_OPENGL_REPLAY_ARGS(glBindProgramPipeline, pipeline)
+	JCLIB_OPENGL_REPLAY_ARGS(glIsProgramPipeline, pipeline)
+	JCLIB_OPENGL_REPLAY_ARGS(glProgramBinary, program, value, payload)
+	JCLIB_OPENGL_REPLAY_ARGS(glProgramUniform1d, program, location)
+	JCLIB_OPENGL_REPLAY_ARGS(glProgramUniform1f, program, location)
+	JCLIB_OPENGL_REPLAY_ARGS(glProgramUniform1ui, program, location)
+	JCLIB_OPENGL_REPLAY_ARGS(glProgramUniform2d, program, location)
+	JCLIB_OPENGL_REPLAY_ARGS(glProgramUniform2f, program, location)
+	JCLIB_OPENGL_REPLAY_ARGS(glProgramUniform2fv, program, location, value, payload)
+	JCLIB_OPENGL_REPLAY_ARGS(glProgramUniform3d, program, location)
+	JCLIB_OPENGL_REPLAY_ARGS(glProgramUniform3f, program, location)
+	JCLIB_OPENGL_REPLAY_ARGS(glProgramUniform3fv, program, location, value, payload)
+	JCLIB_OPENGL_REPLAY_ARGS(glProgramUniform4d, program, location)
+	JCLIB_OPENGL_REPLAY_ARGS(glProgramUniform4f, program, location)
+	JCLIB_OPENGL_REPLAY_ARGS(glProgramUniform4fv, program, location, value, payload)
+	JCLIB_OPENGL_REPLAY_ARGS(glProgramUniformMatrix2fv, program, location, value, value, payload)
+	JCLIB_OPENGL_REPLAY_ARGS(glProgramUniformMatrix3fv, program, location, value, value, payload)
+	JCLIB_OPENGL_REPLAY_ARGS(glProgramUniformMatrix4fv, program, location, value, value, payload)
+	JCLIB_OPENGL_REPLAY_ARGS(glUseProgramStages, pipeline, value, program)
+#endif
+
+#if GL_VERSION_4_3
+	JCLIB_OPENGL_REPLAY_ARGS(glBindVertexBuffer, value, buffer)
+	JCLIB_OPENGL_REPLAY_ARGS(glDebugMessageInsert, value, value, value, value, value, payload)
+	JCLIB_OPENGL_REPLAY_ARGS(glGetProgramResourceIndex, program, value, payload)
+	JCLIB_OPENGL_REPLAY_ARGS(glGetProgramResourceLocation, program, value, payload)
+	JCLIB_OPENGL_REPLAY_ARGS(glInvalidateFramebuffer, value, value, payload)
+	JCLIB_OPENGL_REPLAY_ARGS(glInvalidateSubFramebuffer, value, value, payload)
+	JCLIB_OPENGL_REPLAY_ARGS(glPushDebugGroup, value, value, value, payload)
+	JCLIB_OPENGL_REPLAY_ARGS(glShaderStorageBlockBinding, program)
+#endif
+
+#if GL_VERSION_4_5
+	JCLIB_OPENGL_REPLAY_ARGS(glBindTextureUnit, value, texture)
+	JCLIB_OPENGL_REPLAY_ARGS(glBlitNamedFramebuffer, framebuffer, framebuffer)
+	JCLIB_OPENGL_REPLAY_ARGS(glBufferStorage, value, value, payload)
+	JCLIB_OPENGL_REPLAY_ARGS(glCheckNamedFramebufferStatus, framebuffer)
+	JCLIB_OPENGL_REPLAY_ARGS(glClearNamedFramebufferfv, framebuffer, value, value, payload)
+	JCLIB_OPENGL_REPLAY_ARGS(glCopyNamedBufferSubData, buffer, buffer)
+	JCLIB_OPENGL_REPLAY_ARGS(glDisableVertexArrayAttrib, vao)
+	JCLIB_OPENGL_REPLAY_ARGS(glEnableVertexArrayAttrib, vao)
+	JCLIB_OPENGL_REPLAY_ARGS(glFlushMappedNamedBufferRange, buffer)
+	JCLIB_OPENGL_REPLAY_ARGS(glGenerateTextureMipmap, texture)
+	JCLIB_OPENGL_REPLAY_ARGS(glInvalidateNamedFramebufferData, framebuffer, value, payload)
+	JCLIB_OPENGL_REPLAY_ARGS(glMapNamedBufferRange, buffer)
+	JCLIB_OPENGL_REPLAY_ARGS(glInvalidateNamedFramebufferSubData, framebuffer, value, payload)
+	JCLIB_OPENGL_REPLAY_ARGS(glNamedBufferData, buffer, value, payload)
+	JCLIB_OPENGL_REPLAY_ARGS(glNamedBufferStorage, buffer, value, payload)
+	JCLIB_OPENGL_REPLAY_ARGS(glNamedBufferSubData, buffer, value, value, payload)
+	JCLIB_OPENGL_REPLAY_ARGS(glNamedFramebufferDrawBuffers, framebuffer, value, payload)
+	JCLIB_OPENGL_REPLAY_ARGS(glNamedFramebufferReadBuffer, framebuffer)
+	JCLIB_OPENGL_REPLAY_ARGS(glNamedFramebufferRenderbuffer, framebuffer, value, value, renderbuffer)
+	JCLIB_OPENGL_REPLAY_ARGS(glNamedFramebufferTexture, framebuffer, value, texture)
+	JCLIB_OPENGL_REPLAY_ARGS(glNamedFramebufferTextureLayer, framebuffer, value, texture)
+	JCLIB_OPENGL_REPLAY_ARGS(glNamedRenderbufferStorage, renderbuffer)
+	JCLIB_OPENGL_REPLAY_ARGS(glNamedRenderbufferStorageMultisample, renderbuffer)
+	JCLIB_OPENGL_REPLAY_ARGS(glTextureBuffer, texture, value, buffer)
+	JCLIB_OPENGL_REPLAY_ARGS(glTextureParameteri, texture)
+	JCLIB_OPENGL_REPLAY_ARGS(glTextureParameteriv, texture, value, payload)
+	JCLIB_OPENGL_REPLAY_ARGS(glTextureStorage1D, texture)
+	JCLIB_OPENGL_REPLAY_ARGS(glTextureStorage2D, texture)
+	JCLIB_OPENGL_REPLAY_ARGS(glTextureStorage3D, texture)
+	JCLIB_OPENGL_REPLAY_ARGS(glTextureSubImage1D, texture, value, value, value, value, value, payload)
+	JCLIB_OPENGL_REPLAY_ARGS(glTextureSubImage2D, texture, value, value, value, value, value, value, value, payload)
+	JCLIB_OPENGL_REPLAY_ARGS(glTextureSubImage3D, texture, value, value, value, value, value, value, value, value, value, payload)
+	JCLIB_OPENGL_REPLAY_ARGS(glUnmapNamedBuffer, buffer)
+	JCLIB_OPENGL_REPLAY_ARGS(glVertexArrayAttribBinding, vao)
+	JCLIB_OPENGL_REPLAY_ARGS(glVertexArrayAttribFormat, vao)
+	JCLIB_OPENGL_REPLAY_ARGS(glVertexArrayBindingDivisor, vao)
+	JCLIB_OPENGL_REPLAY_ARGS(glVertexArrayElementBuffer, vao, buffer)
+	JCLIB_OPENGL_REPLAY_ARGS(glVertexArrayVertexBuffer, vao, value, buffer)
+#endif
+
+#undef JCLIB_OPENGL_REPLAY_ARGS
+#undef JCLIB_OPENGL_REPLAY_SKIP
+
+	/**
+	 * @brief Gets how an argument of an entry point is replayed.
+	*/
+	template <record_entry Entry>
+	constexpr replay_arg replay_arg_of(size_t _index) noexcept
+	{
+		constexpr auto& _kinds = replay_args<Entry>::kinds;
+		if constexpr (_kinds.empty())
+		{
+			return replay_arg::value;
+		}
+		else
+		{
+			return (_index < _kinds.size()) ? _kinds[_index] : replay_arg::value;
+		};
+	};
+
+	/**
+	 * @brief Re-executes traced calls on the current context.
+	 *
+	 * Object names, sync objects and uniform locations are remapped to the ones created while replaying,
+	 * so traces replay on any context and driver. Pointer arguments are pointed at the trace's payloads.
+	*/
+	class trace_replayer
+	{
+	public:
+
+		/**
+		 * @brief Gets the local entry point a trace entry id refers to, record_entry::count if unknown.
+		*/
+		record_entry entry(uint16_t _id) const noexcept
+		{
+			return (_id < this->entries_.size()) ? this->entries_[_id] : record_entry::count;
+		};
+
+		/**
+		 * @brief Replays one call, frame markers are ignored.
+		 * @return True if the call was executed, false if it was skipped.
+		*/
+		bool replay(const trace_call& _call);
+
+		/**
+		 * @brief Gets the number of calls skipped, either queries or entries unknown to this build.
+		*/
+		size_t skipped() const noexcept { return this->skipped_; };
+
+		/**
+		 * @brief Forgets all remapped names so the trace can be replayed again from the start.
+		*/
+		void reset()
+		{
+			for (auto& m : this->names_)
+			{
+				m.clear();
+			};
+			this->syncs_.clear();
+			this->locations_.clear();
+			this->bindings_.clear();
+			this->mappings_.clear();
+			this->current_program_ = 0;
+		};
+
+		/**
+		 * @brief Gets a payload's memory, null for trace_null_payload.
+		*/
+		const std::byte* payload(uint32_t _id) const noexcept
+		{
+			return (_id < this->trace_->payloads.size()) ? this->trace_->payloads[_id].data() : nullptr;
+		};
+
+		/**
+		 * @brief Gets a payload's size, 0 for trace_null_payload.
+		*/
+		size_t payload_size(uint32_t _id) const noexcept
+		{
+			return (_id < this->trace_->payloads.size()) ? this->trace_->payloads[_id].size() : 0;
+		};
+
+		/**
+		 * @brief Gets the replayed name of a traced object name, unknown names are passed through.
+		*/
+		GLuint remap(replay_arg _kind, GLuint _name) const
+		{
+			const auto& _names = this->names_[jc::to_underlying(_kind)];
+			const auto it = _names.find(_name);
+			return (it != _names.end()) ? it->second : _name;
+		};
+
+		/**
+		 * @brief Records the replayed name of a traced object name.
+		*/
+		void map_name(replay_arg _kind, GLuint _traced, GLuint _replayed)
+		{
+			this->names_[jc::to_underlying(_kind)][_traced] = _replayed;
+		};
+
+		GLsync remap(GLsync _sync) const
+		{
+			const auto it = this->syncs_.find(_sync);
+			return (it != this->syncs_.end()) ? it->second : _sync;
+		};
+		void map_sync(GLsync _traced, GLsync _replayed)
+		{
+			this->syncs_[_traced] = _replayed;
+		};
+
+		/**
+		 * @brief Gets the replayed location of a uniform, keyed by the traced program name.
+		*/
+		GLint remap_location(GLuint _tracedProgram, GLint _location) const
+		{
+			const auto it = this->locations_.find(location_key(_tracedProgram, _location));
+			return (it != this->locations_.end()) ? it->second : _location;
+		};
+		void map_location(GLuint _tracedProgram, GLint _traced, GLint _replayed)
+		{
+			this->locations_[location_key(_tracedProgram, _traced)] = _replayed;
+		};
+
+		/**
+		 * @brief Tracks the traced program bound with glUseProgram.
+		*/
+		void set_current_program(GLuint _tracedProgram) noexcept { this->current_program_ = _tracedProgram; };
+		GLuint current_program() const noexcept { return this->current_program_; };
+
+		/**
+		 * @brief Tracks replayed buffer bindings and mappings for map, flush and unmap calls.
+		*/
+		void bind_buffer(GLenum _target, GLuint _buffer) { this->bindings_[_target] = _buffer; };
+		GLuint bound_buffer(GLenum _target) const
+		{
+			const auto it = this->bindings_.find(_target);
+			return (it != this->bindings_.end()) ? it->second : 0;
+		};
+		void map_buffer(GLuint _buffer, std::byte* _data) { this->mappings_[_buffer] = _data; };
+		std::byte* mapping(GLuint _buffer) const
+		{
+			const auto it = this->mappings_.find(_buffer);
+			return (it != this->mappings_.end()) ? it->second : nullptr;
+		};
+		void unmap_buffer(GLuint _buffer) { this->mappings_.erase(_buffer); };
+
+		/**
+		 * @brief Counts a skipped call.
+		*/
+		void skip() noexcept { ++this->skipped_; };
+
+		/**
+		 * @brief Remaps the arguments of a call according to replay_args.
+		*/
+		template <record_entry Entry, typename TupleT>
+		void fixup(TupleT& _args, const trace_call& _call) const
+		{
+			size_t _slot = 0;
+			GLuint _program = 0;
+			[&]<size_t... Is>(std::index_sequence<Is...>)
+			{
+				(this->fixup_arg(std::get<Is>(_args), replay_arg_of<Entry>(Is), _call, _slot, _program), ...);
+			}(std::make_index_sequence<std::tuple_size_v<TupleT>>{});
+		};
+
+		/**
+		 * @brief Prepares to replay a trace, the trace must outlive the replayer.
+		*/
+		explicit trace_replayer(const trace& _trace) :
+			trace_{ &_trace }
+		{
+			this->entries_.reserve(_trace.entries.size());
+			for (auto& e : _trace.entries)
+			{
+				auto _local = record_entry::count;
+				for (size_t n = 0; n != record_entry_count; ++n)
+				{
+					const auto _entry = static_cast<record_entry>(n);
+					if (to_string(_entry) == e.name && record_arg_bytes(_entry) == e.arg_bytes)
+					{
+						_local = _entry;
+						break;
+					};
+				};
+				this->entries_.push_back(_local);
+			};
+		};
+
+	private:
+
+		constexpr static uint64_t location_key(GLuint _program, GLint _location) noexcept
+		{
+			return (static_cast<uint64_t>(_program) << 32) | static_cast<uint32_t>(_location);
+		};
+
+		template <typename T>
+		void fixup_arg(T& _arg, replay_arg _kind, const trace_call& _call, size_t& _slot, GLuint& _program) const
+		{
+			if constexpr (std::is_same_v<T, GLsync>)
+			{
+				if (_kind == replay_arg::sync)
+				{
+					_arg = this->remap(_arg);
+				};
+			}
+			else if constexpr (std::is_pointer_v<T>)
+			{
+				if (_kind == replay_arg::payload)
+				{
+					const auto _id = _call.payload(_slot++);
+					if (_id != trace_null_payload)
+					{
+						_arg = reinterpret_cast<T>(const_cast<std::byte*>(this->payload(_id)));
+					};
+				};
+			}
+			else if constexpr (std::is_same_v<T, GLuint>)
+			{
+				if (_kind == replay_arg::program)
+				{
+					_program = _arg;
+				};
+				if (_kind >= replay_arg::buffer && _kind <= replay_arg::pipeline)
+				{
+					_arg = this->remap(_kind, _arg);
+				};
+			}
+			else if constexpr (std::is_same_v<T, GLint>)
+			{
+				if (_kind == replay_arg::location)
+				{
+					_arg = this->remap_location(_program, _arg);
+				}
+				else if (_kind == replay_arg::current_location)
+				{
+					_arg = this->remap_location(this->current_program_, _arg);
+				};
+			};
+		};
+
+		const trace* trace_;
+		std::vector<record_entry> entries_{};
+		std::array<std::unordered_map<GLuint, GLuint>, jc::to_underlying(replay_arg::pipeline) + 1> names_{};
+		std::unordered_map<GLsync, GLsync> syncs_{};
+		std::unordered_map<uint64_t, GLint> locations_{};
+		std::unordered_map<GLenum, GLuint> bindings_{};
+		std::unordered_map<GLuint, std::byte*> mappings_{};
+		GLuint current_program_ = 0;
+		size_t skipped_ = 0;
+	};
+
+};
+#pragma endregion
+
+#pragma region REPLAY_HOOKS
+namespace jc::gl
+{
+	/**
+	 * @brief Customization point for entry points whose replay can't be described by replay_args.
+	 *
+	 * Specializations provide a static apply(trace_replayer&, const trace_call&) that performs the call.
+	*/
+	template <record_entry Entry>
+	struct replay_hook {};
+
+	namespace gl_impl
+	{
+		template <record_entry Entry>
+		inline auto replay_decode(const trace_call& _call)
+		{
+			return decode_args<Entry>(record_view{ Entry, _call.args });
+		};
+
+		template <record_entry Entry>
+		inline auto replay_result(const trace_call& _call)
+		{
+			typename record_entry_traits<Entry>::signature::result_type _result{};
+			JCLIB_ASSERT(_call.result.size() == sizeof(_result));
+			std::memcpy(&_result, _call.result.data(), sizeof(_result));
+			return _result;
+		};
+
+		template <record_entry Entry, replay_arg Kind>
+		struct replay_hook_new_names
+		{
+			static void apply(trace_replayer& _replayer, const trace_call& _call)
+			{
+				const auto [_count, _ignored] = replay_decode<Entry>(_call);
+				std::vector<GLuint> _names(static_cast<size_t>(_count));
+				record_entry_traits<Entry>::pointer()(_count, _names.data());
+
+				const auto _traced = _replayer.payload(_call.payload(0));
+				for (size_t n = 0; _traced && n != _names.size(); ++n)
+				{
+					GLuint _name{};
+					std::memcpy(&_name, _traced + n * sizeof(GLuint), sizeof(_name));
+					_replayer.map_name(Kind, _name, _names[n]);
+				};
+			};
+		};
+
+		template <record_entry Entry, replay_arg Kind>
+		struct replay_hook_delete_names
+		{
+			static void apply(trace_replayer& _replayer, const trace_call& _call)
+			{
+				const auto [_count, _ignored] = replay_decode<Entry>(_call);
+				std::vector<GLuint> _names(static_cast<size_t>(_count));
+				const auto _traced = _replayer.payload(_call.payload(0));
+				for (size_t n = 0; _traced && n != _names.size(); ++n)
+				{
+					std::memcpy(&_names[n], _traced + n * sizeof(GLuint), sizeof(GLuint));
+					_names[n] = _replayer.remap(Kind, _names[n]);
+				};
+				record_entry_traits<Entry>::pointer()(_count, _names.data());
+			};
+		};
+
+		/**
+		 * @brief Replays a uniform location lookup and maps the traced location to the replayed one.
+		*/
+		template <record_entry Entry>
+		struct replay_hook_location
+		{
+			static void apply(trace_replayer& _replayer, const trace_call& _call)
+			{
+				auto _args = replay_decode<Entry>(_call);
+				const GLuint _program = std::get<0>(_args);
+				_replayer.fixup<Entry>(_args, _call);
+				const auto _location = std::apply(record_entry_traits<Entry>::pointer(), _args);
+				_replayer.map_location(_program, replay_result<Entry>(_call), _location);
+			};
+		};
+
+		/**
+		 * @brief Copies the captured writes into a replayed mapping.
+		*/
+		inline void replay_write_mapping(trace_replayer& _replayer, GLuint _buffer, const trace_call& _call, GLintptr _offset)
+		{
+			const auto _data = _replayer.mapping(_buffer);
+			const auto _id = _call.payload(0);
+			if (_data && _id != trace_null_payload)
+			{
+				std::memcpy(_data + _offset, _replayer.payload(_id), _replayer.payload_size(_id));
+			};
+		};
+	};
+
+#define JCLIB_OPENGL_REPLAY_NEW_NAMES(_name, _kind) \
+	template <> struct replay_hook<record_entry::_name> : gl_impl::replay_hook_new_names<record_entry::_name, replay_arg::_kind> {};
+#define JCLIB_OPENGL_REPLAY_DELETE_NAMES(_name, _kind) \
+	template <> struct replay_hook<record_entry::_name> : gl_impl::replay_hook_delete_names<record_entry::_name, replay_arg::_kind> {};
+
+	JCLIB_OPENGL_REPLAY_NEW_NAMES(glGenBuffers, buffer)
+	JCLIB_OPENGL_REPLAY_NEW_NAMES(glGenFramebuffers, framebuffer)
+	JCLIB_OPENGL_REPLAY_NEW_NAMES(glGenRenderbuffers, renderbuffer)
+	JCLIB_OPENGL_REPLAY_NEW_NAMES(glGenTextures, texture)
+	JCLIB_OPENGL_REPLAY_NEW_NAMES(glGenVertexArrays, vao)
+	JCLIB_OPENGL_REPLAY_DELETE_NAMES(glDeleteBuffers, buffer)
+	JCLIB_OPENGL_REPLAY_DELETE_NAMES(glDeleteFramebuffers, framebuffer)
+	JCLIB_OPENGL_REPLAY_DELETE_NAMES(glDeleteRenderbuffers, renderbuffer)
+	JCLIB_OPENGL_REPLAY_DELETE_NAMES(glDeleteTextures, texture)
+	JCLIB_OPENGL_REPLAY_DELETE_NAMES(glDeleteVertexArrays, vao)
+#if GL_VERSION_4_1
+	JCLIB_OPENGL_REPLAY_DELETE_NAMES(glDeleteProgramPipelines, pipeline)
+#endif
+#if GL_VERSION_4_5
+	JCLIB_OPENGL_REPLAY_NEW_NAMES(glCreateBuffers, buffer)
+	JCLIB_OPENGL_REPLAY_NEW_NAMES(glCreateFramebuffers, framebuffer)
+	JCLIB_OPENGL_REPLAY_NEW_NAMES(glCreateProgramPipelines, pipeline)
+	JCLIB_OPENGL_REPLAY_NEW_NAMES(glCreateRenderbuffers, renderbuffer)
+	JCLIB_OPENGL_REPLAY_NEW_NAMES(glCreateVertexArrays, vao)
+#endif
+
+#undef JCLIB_OPENGL_REPLAY_NEW_NAMES
+#undef JCLIB_OPENGL_REPLAY_DELETE_NAMES
+
+	template <> struct replay_hook<record_entry::glGetUniformLocation> : gl_impl::replay_hook_location<record_entry::glGetUniformLocation> {};
+#if GL_VERSION_4_3
+	template <> struct replay_hook<record_entry::glGetProgramResourceLocation> : gl_impl::replay_hook_location<record_entry::glGetProgramResourceLocation> {};
+
+	template <>
+	struct replay_hook<record_entry::glCopyImageSubData>
+	{
+		static void apply(trace_replayer& _replayer, const trace_call& _call)
+		{
+			const auto [_src, _srcTarget, _srcLevel, _srcX, _srcY, _srcZ, _dst, _dstTarget, _dstLevel, _dstX, _dstY, _dstZ,
+				_width, _height, _depth] = gl_impl::replay_decode<record_entry::glCopyImageSubData>(_call);
+
+			// Either side may be a texture or a renderbuffer, told apart by its target
+			const auto _kind = [](GLenum _target)
+			{
+				return (_target == GL_RENDERBUFFER) ? replay_arg::renderbuffer : replay_arg::texture;
+			};
+			glCopyImageSubData(_replayer.remap(_kind(_srcTarget), _src), _srcTarget, _srcLevel, _srcX, _srcY, _srcZ,
+				_replayer.remap(_kind(_dstTarget), _dst), _dstTarget, _dstLevel, _dstX, _dstY, _dstZ, _width, _height, _depth);
+		};
+	};
+
+	template <>
+	struct replay_hook<record_entry::glObjectLabel>
+	{
+		static void apply(trace_replayer& _replayer, const trace_call& _call)
+		{
+			const auto [_identifier, _name, _length, _ignored] = gl_impl::replay_decode<record_entry::glObjectLabel>(_call);
+
+			// The identifier says which namespace the name is from
+			auto _kind = replay_arg::value;
+			switch (_identifier)
+			{
+			case GL_BUFFER: _kind = replay_arg::buffer; break;
+			case GL_VERTEX_ARRAY: _kind = replay_arg::vao; break;
+			case GL_TEXTURE: _kind = replay_arg::texture; break;
+			case GL_FRAMEBUFFER: _kind = replay_arg::framebuffer; break;
+			case GL_RENDERBUFFER: _kind = replay_arg::renderbuffer; break;
+			case GL_PROGRAM: [[fallthrough]];
+			case GL_SHADER: _kind = replay_arg::program; break;
+			case GL_PROGRAM_PIPELINE: _kind = replay_arg::pipeline; break;
+			default: break;
+			};
+
+			const auto _replayed = (_kind != replay_arg::value) ? _replayer.remap(_kind, _name) : _name;
+			const auto _text = reinterpret_cast<const GLchar*>(_replayer.payload(_call.payload(0)));
+			glObjectLabel(_identifier, _replayed, _length, _text);
+		};
+	};
+
+	template <>
+	struct replay_hook<record_entry::glObjectPtrLabel>
+	{
+		static void apply(trace_replayer& _replayer, const trace_call& _call)
+		{
+			const auto [_ptr, _length, _ignored] = gl_impl::replay_decode<record_entry::glObjectPtrLabel>(_call);
+			const auto _sync = _replayer.remap(static_cast<GLsync>(const_cast<void*>(_ptr)));
+			const auto _text = reinterpret_cast<const GLchar*>(_replayer.payload(_call.payload(0)));
+			glObjectPtrLabel(_sync, _length, _text);
+		};
+	};
+#endif
+
+	template <>
+	struct replay_hook<record_entry::glCreateProgram>
+	{
+		static void apply(trace_replayer& _replayer, const trace_call& _call)
+		{
+			_replayer.map_name(replay_arg::program, gl_impl::replay_result<record_entry::glCreateProgram>(_call), glCreateProgram());
+		};
+	};
+
+	template <>
+	struct replay_hook<record_entry::glCreateShader>
+	{
+		static void apply(trace_replayer& _replayer, const trace_call& _call)
+		{
+			const auto [_type] = gl_impl::replay_decode<record_entry::glCreateShader>(_call);
+			_replayer.map_name(replay_arg::program, gl_impl::replay_result<record_entry::glCreateShader>(_call), glCreateShader(_type));
+		};
+	};
+
+	template <>
+	struct replay_hook<record_entry::glFenceSync>
+	{
+		static void apply(trace_replayer& _replayer, const trace_call& _call)
+		{
+			const auto [_condition, _flags] = gl_impl::replay_decode<record_entry::glFenceSync>(_call);
+			_replayer.map_sync(gl_impl::replay_result<record_entry::glFenceSync>(_call), glFenceSync(_condition, _flags));
+		};
+	};
+
+	template <>
+	struct replay_hook<record_entry::glShaderSource>
+	{
+		static void apply(trace_replayer& _replayer, const trace_call& _call)
+		{
+			const auto [_shader, _count, _strings, _lengths] = gl_impl::replay_decode<record_entry::glShaderSource>(_call);
+			const auto _id = _call.payload(0);
+			const auto _source = reinterpret_cast<const GLchar*>(_replayer.payload(_id));
+			const auto _length = static_cast<GLint>(_replayer.payload_size(_id));
+			glShaderSource(_replayer.remap(replay_arg::program, _shader), 1, &_source, &_length);
+		};
+	};
+
+	template <>
+	struct replay_hook<record_entry::glUseProgram>
+	{
+		static void apply(trace_replayer& _replayer, const trace_call& _call)
+		{
+			const auto [_program] = gl_impl::replay_decode<record_entry::glUseProgram>(_call);
+			_replayer.set_current_program(_program);
+			glUseProgram(_replayer.remap(replay_arg::program, _program));
+		};
+	};
+
+	template <>
+	struct replay_hook<record_entry::glBindBuffer>
+	{
+		static void apply(trace_replayer& _replayer, const trace_call& _call)
+		{
+			const auto [_target, _buffer] = gl_impl::replay_decode<record_entry::glBindBuffer>(_call);
+			const auto _replayed = _replayer.remap(replay_arg::buffer, _buffer);
+			_replayer.bind_buffer(_target, _replayed);
+			glBindBuffer(_target, _replayed);
+		};
+	};
+
+	template <>
+	struct replay_hook<record_entry::glBindBufferBase>
+	{
+		static void apply(trace_replayer& _replayer, const trace_call& _call)
+		{
+			const auto [_target, _index, _buffer] = gl_impl::replay_decode<record_entry::glBindBufferBase>(_call);
+			const auto _replayed = _replayer.remap(replay_arg::buffer, _buffer);
+			_replayer.bind_buffer(_target, _replayed);
+			glBindBufferBase(_target, _index, _replayed);
+		};
+	};
+
+	template <>
+	struct replay_hook<record_entry::glBindBufferRange>
+	{
+		static void apply(trace_replayer& _replayer, const trace_call& _call)
+		{
+			const auto [_target, _index, _buffer, _offset, _size] = gl_impl::replay_decode<record_entry::glBindBufferRange>(_call);
+			const auto _replayed = _replayer.remap(replay_arg::buffer, _buffer);
+			_replayer.bind_buffer(_target, _replayed);
+			glBindBufferRange(_target, _index, _replayed, _offset, _size);
+		};
+	};
+
+	template <>
+	struct replay_hook<record_entry::glMapBufferRange>
+	{
+		static void apply(trace_replayer& _replayer, const trace_call& _call)
+		{
+			const auto [_target, _offset, _length, _access] = gl_impl::replay_decode<record_entry::glMapBufferRange>(_call);
+			const auto _data = glMapBufferRange(_target, _offset, _length, _access);
+			_replayer.map_buffer(_replayer.bound_buffer(_target), static_cast<std::byte*>(_data));
+		};
+	};
+
+	template <>
+	struct replay_hook<record_entry::glFlushMappedBufferRange>
+	{
+		static void apply(trace_replayer& _replayer, const trace_call& _call)
+		{
+			const auto [_target, _offset, _length] = gl_impl::replay_decode<record_entry::glFlushMappedBufferRange>(_call);
+			gl_impl::replay_write_mapping(_replayer, _replayer.bound_buffer(_target), _call, _offset);
+			glFlushMappedBufferRange(_target, _offset, _length);
+		};
+	};
+
+	template <>
+	struct replay_hook<record_entry::glUnmapBuffer>
+	{
+		static void apply(trace_replayer& _replayer, const trace_call& _call)
+		{
+			const auto [_target] = gl_impl::replay_decode<record_entry::glUnmapBuffer>(_call);
+			const auto _buffer = _replayer.bound_buffer(_target);
+			gl_impl::replay_write_mapping(_replayer, _buffer, _call, 0);
+			_replayer.unmap_buffer(_buffer);
+			glUnmapBuffer(_target);
+		};
+	};
+
+#if GL_VERSION_4_5
+	template <>
+	struct replay_hook<record_entry::glCreateTextures>
+	{
+		static void apply(trace_replayer& _replayer, const trace_call& _call)
+		{
+			const auto [_target, _count, _ignored] = gl_impl::replay_decode<record_entry::glCreateTextures>(_call);
+			std::vector<GLuint> _names(static_cast<size_t>(_count));
+			glCreateTextures(_target, _count, _names.data());
+
+			const auto _traced = _replayer.payload(_call.payload(0));
+			for (size_t n = 0; _traced && n != _names.size(); ++n)
+			{
+				GLuint _name{};
+				std::memcpy(&_name, _traced + n * sizeof(GLuint), sizeof(_name));
+				_replayer.map_name(replay_arg::texture, _name, _names[n]);
+			};
+		};
+	};
+
+	template <>
+	struct replay_hook<record_entry::glMapNamedBufferRange>
+	{
+		static void apply(trace_replayer& _replayer, const trace_call& _call)
+		{
+			const auto [_buffer, _offset, _length, _access] = gl_impl::replay_decode<record_entry::glMapNamedBufferRange>(_call);
+			const auto _replayed = _replayer.remap(replay_arg::buffer, _buffer);
+			const auto _data = glMapNamedBufferRange(_replayed, _offset, _length, _access);
+			_replayer.map_buffer(_replayed, static_cast<std::byte*>(_data));
+		};
+	};
+
+	template <>
+	struct replay_hook<record_entry::glFlushMappedNamedBufferRange>
+	{
+		static void apply(trace_replayer& _replayer, const trace_call& _call)
+		{
+			const auto [_buffer, _offset, _length] = gl_impl::replay_decode<record_entry::glFlushMappedNamedBufferRange>(_call);
+			const auto _replayed = _replayer.remap(replay_arg::buffer, _buffer);
+			gl_impl::replay_write_mapping(_replayer, _replayed, _call, _offset);
+			glFlushMappedNamedBufferRange(_replayed, _offset, _length);
+		};
+	};
+
+	template <>
+	struct replay_hook<record_entry::glUnmapNamedBuffer>
+	{
+		static void apply(trace_replayer& _replayer, const trace_call& _call)
+		{
+			const auto [_buffer] = gl_impl::replay_decode<record_entry::glUnmapNamedBuffer>(_call);
+			const auto _replayed = _replayer.remap(replay_arg::buffer, _buffer);
+			gl_impl::replay_write_mapping(_replayer, _replayed, _call, 0);
+			_replayer.unmap_buffer(_replayed);
+			glUnmapNamedBuffer(_replayed);
+		};
+	};
+#endif
+
+	/**
+	 * @brief Generates the replay function for an entry point.
+	*/
+	template <record_entry Entry>
+	struct replay_function
+	{
+		static void invoke(trace_replayer& _replayer, const trace_call& _call)
+		{
+			if constexpr (requires { replay_hook<Entry>::apply(_replayer, _call); })
+			{
+				replay_hook<Entry>::apply(_replayer, _call);
+			}
+			else
+			{
+				auto _args = gl_impl::replay_decode<Entry>(_call);
+				_replayer.fixup<Entry>(_args, _call);
+				std::apply(record_entry_traits<Entry>::pointer(), _args);
+			};
+		};
+	};
+
+	namespace gl_impl
+	{
+		template <typename T>
+		concept replay_output_arg = std::is_pointer_v<T> && !std::is_same_v<T, GLsync> &&
+			!std::is_const_v<std::remove_pointer_t<T>>;
+
+		template <typename TupleT>
+		struct replay_has_output;
+		template <typename... ArgTs>
+		struct replay_has_output<std::tuple<ArgTs...>> : std::bool_constant<(replay_output_arg<ArgTs> || ...)> {};
+
+		template <record_entry Entry>
+		constexpr bool replay_skipped() noexcept
+		{
+			if constexpr (requires { &replay_hook<Entry>::apply; })
+			{
+				return false;
+			}
+			else
+			{
+				return replay_args<Entry>::skip ||
+					replay_has_output<typename record_entry_traits<Entry>::signature::args_type>::value;
+			};
+		};
+
+		using replay_function_ptr = void(*)(trace_replayer&, const trace_call&);
+
+		template <record_entry Entry>
+		constexpr replay_function_ptr replay_function_for() noexcept
+		{
+			if constexpr (replay_skipped<Entry>())
+			{
+				return nullptr;
+			}
+			else
+			{
+				return &replay_function<Entry>::invoke;
+			};
+		};
+
+		constexpr inline std::array<replay_function_ptr, record_entry_count> replay_functions
+		{
+#define JCLIB_OPENGL_REPLAY_FUNCTION(_name) \
+			replay_function_for<record_entry::_name>(),
+			JCLIB_OPENGL_RECORD_FUNCTIONS(JCLIB_OPENGL_REPLAY_FUNCTION)
+#undef JCLIB_OPENGL_REPLAY_FUNCTION
+		};
+
+		constexpr inline std::array<size_t, record_entry_count> replay_payload_slots
+		{
+#define JCLIB_OPENGL_REPLAY_PAYLOAD_SLOTS(_name) \
+			capture_payload_slots<record_entry::_name>,
+			JCLIB_OPENGL_RECORD_FUNCTIONS(JCLIB_OPENGL_REPLAY_PAYLOAD_SLOTS)
+#undef JCLIB_OPENGL_REPLAY_PAYLOAD_SLOTS
+		};
+	};
+
+	inline bool trace_replayer::replay(const trace_call& _call)
+	{
+		if (_call.is_frame_marker())
+		{
+			return false;
+		};
+
+		// Entries whose payload layout changed since the trace was written can't be decoded safely
+		const auto _entry = this->entry(_call.id);
+		const auto _index = jc::to_underlying(_entry);
+		const auto _function = (_entry != record_entry::count) ? gl_impl::replay_functions[_index] : nullptr;
+		if (!_function || _call.payload_count() != gl_impl::replay_payload_slots[_index])
+		{
+			this->skip();
+			return false;
+		};
+		_function(*this, _call);
+		return true;
+	};
+
+};
+#pragma endregion
+
+#endif // JCLIB_OPENGL_GLCAPTURE_HPP
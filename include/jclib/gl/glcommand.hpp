@@ -0,0 +1,751 @@
+#pragma once
+#ifndef JCLIB_OPENGL_GLCOMMAND_HPP
+#define JCLIB_OPENGL_GLCOMMAND_HPP
+
+/*
+	Command lists recorded on any thread and submitted on the thread owning the context
+*/
+
+#include "gl.hpp"
+
+#include <span>
+#include <memory>
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <concepts>
+#include <utility>
+#include <algorithm>
+
+#define _JCLIB_OPENGL_GLCOMMAND_
+
+#pragma region COMMAND_ARENA
+namespace jc::gl
+{
+	/**
+	 * @brief Bump allocator made of fixed size blocks, memory is kept across clear() so steady state recording doesn't allocate.
+	*/
+	class command_arena
+	{
+	public:
+
+		/**
+		 * @brief Alignment of every allocation, enough for every command's fields.
+		*/
+		constexpr static size_t alignment = alignof(uint64_t);
+
+		/**
+		 * @brief A block of the arena and how much of it is in use.
+		*/
+		struct block
+		{
+			std::unique_ptr<std::byte[]> data;
+			size_t capacity;
+			size_t used;
+		};
+
+		/**
+		 * @brief Allocates memory, allocations larger than the block size get a block of their own.
+		 * @param _sizeBytes Size of the allocation.
+		 * @return Uninitialized memory aligned to command_arena::alignment.
+		*/
+		std::byte* allocate(size_t _sizeBytes)
+		{
+			const auto _size = (_sizeBytes + alignment - 1) & ~(alignment - 1);
+			while (this->current_ != this->blocks_.size())
+			{
+				auto& _block = this->blocks_[this->current_];
+				if (_block.capacity - _block.used >= _size)
+				{
+					const auto _at = _block.data.get() + _block.used;
+					_block.used += _size;
+					return _at;
+				};
+				++this->current_;
+			};
+
+			const auto _capacity = std::max(_size, this->block_bytes_);
+			this->blocks_.push_back(block{ std::make_unique_for_overwrite<std::byte[]>(_capacity), _capacity, _size });
+			this->current_ = this->blocks_.size() - 1;
+			return this->blocks_.back().data.get();
+		};
+
+		/**
+		 * @brief Gets the blocks in allocation order, the used part of each holds the allocations.
+		*/
+		std::span<const block> blocks() const noexcept
+		{
+			return std::span<const block>{ this->blocks_ }.first(std::min(this->current_ + 1, this->blocks_.size()));
+		};
+
+		/**
+		 * @brief Gets the total size of the blocks.
+		*/
+		size_t capacity() const noexcept
+		{
+			size_t _total = 0;
+			for (auto& b : this->blocks_)
+			{
+				_total += b.capacity;
+			};
+			return _total;
+		};
+
+		/**
+		 * @brief Frees every allocation, keeping the blocks for reuse.
+		*/
+		void clear() noexcept
+		{
+			for (auto& b : this->blocks_)
+			{
+				b.used = 0;
+			};
+			this->current_ = 0;
+		};
+
+		/**
+		 * @brief Releases the blocks.
+		*/
+		void release() noexcept
+		{
+			this->blocks_.clear();
+			this->current_ = 0;
+		};
+
+		/**
+		 * @param _blockBytes Size of each block.
+		*/
+		explicit command_arena(size_t _blockBytes = 64 * 1024) noexcept :
+			block_bytes_{ std::max(_blockBytes, alignment) }
+		{};
+
+	private:
+		std::vector<block> blocks_{};
+		size_t current_ = 0;
+		size_t block_bytes_;
+	};
+
+};
+#pragma endregion
+
+#pragma region COMMAND_LIST
+namespace jc::gl
+{
+	/**
+	 * @brief Commands that can be stored in a command_list.
+	*/
+	enum class command_type : uint8_t
+	{
+		bind_vao,
+		use_program,
+		bind_vertex_buffer,
+		bind_element_buffer,
+		bind_buffer_base,
+		bind_buffer_range,
+		bind_texture_unit,
+		uniform_1f,
+		uniform_2f,
+		uniform_3f,
+		uniform_4f,
+		uniform_matrix_4f,
+		buffer_subdata,
+		clear,
+		draw_arrays,
+		draw_elements,
+		draw_elements_indirect,
+		multi_draw_elements_indirect,
+		dispatch_compute,
+		memory_barrier,
+	};
+
+	namespace gl_impl
+	{
+		/**
+		 * @brief Precedes every command, size covers the header, the command and any trailing data.
+		*/
+		struct command_header
+		{
+			command_type type;
+			uint32_t size;
+		};
+
+		struct command_bind
+		{
+			GLuint name;
+		};
+		struct command_bind_vertex_buffer
+		{
+			GLuint vao;
+			GLuint index;
+			GLuint buffer;
+			GLsizei stride;
+			GLintptr offset;
+		};
+		struct command_bind_buffer
+		{
+			GLenum target;
+			GLuint index;
+			GLuint buffer;
+			GLintptr offset;
+			GLsizeiptr size;
+		};
+		struct command_uniform
+		{
+			GLuint program;
+			GLint location;
+			GLfloat values[4];
+		};
+		struct command_uniform_matrix
+		{
+			GLuint program;
+			GLint location;
+			GLboolean transpose;
+			GLfloat values[16];
+		};
+		struct command_bind_to
+		{
+			GLuint target;
+			GLuint name;
+		};
+		struct command_buffer_subdata
+		{
+			GLuint buffer;
+			GLintptr offset;
+			GLsizeiptr size;
+		};
+		struct command_draw
+		{
+			GLenum mode;
+			GLenum index_type;
+			GLuint count;
+			GLuint instance_count;
+			GLuint first;
+		};
+		struct command_draw_indirect
+		{
+			GLenum mode;
+			GLenum index_type;
+			GLsizei draw_count;
+			GLsizei stride;
+			size_t offset;
+		};
+		struct command_dispatch
+		{
+			GLuint groups[3];
+		};
+		struct command_bits
+		{
+			GLbitfield bits;
+		};
+
+		/**
+		 * @brief Gets the size of one index.
+		*/
+		constexpr inline size_t command_index_bytes(typecode _type) noexcept
+		{
+			switch (_type)
+			{
+			case typecode::gl_unsigned_byte:
+				return 1;
+			case typecode::gl_unsigned_short:
+				return 2;
+			default:
+				return 4;
+			};
+		};
+	};
+
+	/**
+	 * @brief Compact stream of draw, bind, uniform and buffer update commands recorded without a context.
+	 *
+	 * Recording only writes into the list's own arena so any thread can record a list, but each list must
+	 * only be recorded by one thread at a time. Lists are executed in order on the context's thread by
+	 * submit(). Buffer updates copy their data into the list, the source may be freed after recording.
+	 * Objects referenced by a list must stay alive until it is submitted.
+	 *
+	 * Commands use the same conventions as the free functions they mirror, see draw_arrays(), draw_elements(),
+	 * buffer_subdata() and set_uniform().
+	*/
+	class command_list
+	{
+	public:
+
+		/**
+		 * @brief Gets the number of recorded commands.
+		*/
+		size_t size() const noexcept { return this->count_; };
+
+		/**
+		 * @brief Checks if no commands are recorded.
+		*/
+		bool empty() const noexcept { return this->count_ == 0; };
+
+		/**
+		 * @brief Gets the number of bytes the recorded commands use, including buffer update data.
+		*/
+		size_t size_bytes() const noexcept { return this->bytes_; };
+
+		/**
+		 * @brief Gets the arena holding the commands.
+		*/
+		const command_arena& arena() const noexcept { return this->arena_; };
+
+		/**
+		 * @brief Removes all commands, keeping the memory for the next recording.
+		*/
+		void clear() noexcept
+		{
+			this->arena_.clear();
+			this->count_ = 0;
+			this->bytes_ = 0;
+		};
+
+		/**
+		 * @brief Binds a vao.
+		*/
+		void bind(const vao_id& _vao)
+		{
+			this->push(command_type::bind_vao, gl_impl::command_bind{ _vao.get() });
+		};
+
+		/**
+		 * @brief Sets the program used for drawing, null to unbind.
+		*/
+		void use_program(const program_id& _program)
+		{
+			this->push(command_type::use_program, gl_impl::command_bind{ _program.get() });
+		};
+
+		/**
+		 * @brief Binds a vbo to an indexed binding point of a target.
+		*/
+		void bind_buffer_base(indexed_vbo_target _target, gl_unsigned_int _index, const vbo_id& _vbo)
+		{
+			this->push(command_type::bind_buffer_base,
+				gl_impl::command_bind_buffer{ jc::to_underlying(_target), _index, _vbo.get(), 0, 0 });
+		};
+
+		/**
+		 * @brief Binds a range of a vbo to an indexed binding point of a target.
+		*/
+		void bind_buffer_range(indexed_vbo_target _target, gl_unsigned_int _index, const vbo_id& _vbo,
+			size_t _offsetBytes, size_t _sizeBytes)
+		{
+			JCLIB_ASSERT(_vbo);
+			JCLIB_ASSERT(_sizeBytes != 0);
+			this->push(command_type::bind_buffer_range, gl_impl::command_bind_buffer{ jc::to_underlying(_target), _index, _vbo.get(),
+				static_cast<GLintptr>(_offsetBytes), static_cast<GLsizeiptr>(_sizeBytes) });
+		};
+
+		/**
+		 * @brief Sets a float uniform from 1 to 4 components.
+		*/
+		template <typename... Ts> requires (sizeof...(Ts) >= 1 && sizeof...(Ts) <= 4 && (std::same_as<Ts, gl_float> && ...))
+		void set_uniform(const program_id& _program, const uniform_location& _uniform, Ts... _values)
+		{
+			constexpr auto _type = static_cast<command_type>(jc::to_underlying(command_type::uniform_1f) + sizeof...(Ts) - 1);
+			this->push(_type, gl_impl::command_uniform{ _program.get(), static_cast<GLint>(_uniform.get()), { _values... } });
+		};
+
+		/**
+		 * @brief Sets a mat4 uniform from column major values.
+		*/
+		void set_uniform(const program_id& _program, const uniform_location& _uniform, std::span<const gl_float, 16> _values,
+			bool _transpose = false)
+		{
+			gl_impl::command_uniform_matrix _command{ _program.get(), static_cast<GLint>(_uniform.get()),
+				static_cast<GLboolean>((_transpose) ? GL_TRUE : GL_FALSE), {} };
+			std::ranges::copy(_values, _command.values);
+			this->push(command_type::uniform_matrix_4f, _command);
+		};
+
+		/**
+		 * @brief Clears buffers of the draw framebuffer.
+		*/
+		void clear(buffer_bit _mask)
+		{
+			this->push(command_type::clear, gl_impl::command_bits{ jc::to_underlying(_mask) });
+		};
+
+		/**
+		 * @brief Draws vertices from the bound vao.
+		*/
+		void draw_arrays(primitive _mode, size_t _count, size_t _first = 0)
+		{
+			this->draw_arrays_instanced(_mode, 1, _count, _first);
+		};
+		void draw_arrays(size_t _count, size_t _first = 0)
+		{
+			this->draw_arrays_instanced(primitive::triangles, 1, _count, _first);
+		};
+
+		/**
+		 * @brief Draws instances of vertices from the bound vao.
+		*/
+		void draw_arrays_instanced(primitive _mode, size_t _instanceCount, size_t _count, size_t _first = 0)
+		{
+			this->push(command_type::draw_arrays, gl_impl::command_draw{ jc::to_underlying(_mode), 0,
+				static_cast<GLuint>(_count), static_cast<GLuint>(_instanceCount), static_cast<GLuint>(_first) });
+		};
+		void draw_arrays_instanced(size_t _instanceCount, size_t _count, size_t _first = 0)
+		{
+			this->draw_arrays_instanced(primitive::triangles, _instanceCount, _count, _first);
+		};
+
+		/**
+		 * @brief Draws indexed vertices from the bound vao.
+		 * @param _first Index of the first index to draw, not a byte offset.
+		*/
+		void draw_elements(primitive _mode, typecode _indiceType, size_t _count, size_t _first = 0)
+		{
+			this->draw_elements_instanced(_mode, 1, _indiceType, _count, _first);
+		};
+		void draw_elements(typecode _indiceType, size_t _count, size_t _first = 0)
+		{
+			this->draw_elements_instanced(primitive::triangles, 1, _indiceType, _count, _first);
+		};
+
+		/**
+		 * @brief Draws instances of indexed vertices from the bound vao.
+		 * @param _first Index of the first index to draw, not a byte offset.
+		*/
+		void draw_elements_instanced(primitive _mode, size_t _instanceCount, typecode _indiceType, size_t _count, size_t _first = 0)
+		{
+			this->push(command_type::draw_elements, gl_impl::command_draw{ jc::to_underlying(_mode), jc::to_underlying(_indiceType),
+				static_cast<GLuint>(_count), static_cast<GLuint>(_instanceCount), static_cast<GLuint>(_first) });
+		};
+		void draw_elements_instanced(size_t _instanceCount, typecode _indiceType, size_t _count, size_t _first = 0)
+		{
+			this->draw_elements_instanced(primitive::triangles, _instanceCount, _indiceType, _count, _first);
+		};
+
+		/**
+		 * @brief Draws using a draw_elements_command read from the vbo bound to vbo_target::draw_indirect.
+		*/
+		void draw_elements_indirect(primitive _mode, typecode _indiceType, size_t _offsetBytes = 0)
+		{
+			this->push(command_type::draw_elements_indirect, gl_impl::command_draw_indirect{ jc::to_underlying(_mode),
+				jc::to_underlying(_indiceType), 1, 0, _offsetBytes });
+		};
+
+#if GL_VERSION_4_3
+		/**
+		 * @brief Binds a vbo to a vertex buffer binding of a vao.
+		*/
+		void bind_vertex_buffer(const vao_id& _vao, vertex_binding_index _index, const vbo_id& _vbo, size_t _offsetBytes, size_t _strideBytes)
+		{
+			this->push(command_type::bind_vertex_buffer, gl_impl::command_bind_vertex_buffer{ _vao.get(), _index.get(), _vbo.get(),
+				static_cast<GLsizei>(_strideBytes), static_cast<GLintptr>(_offsetBytes) });
+		};
+
+		/**
+		 * @brief Draws using a packed array of draw_elements_command read from the vbo bound to vbo_target::draw_indirect.
+		*/
+		void multi_draw_elements_indirect(primitive _mode, typecode _indiceType, size_t _drawCount,
+			size_t _offsetBytes = 0, size_t _strideBytes = 0)
+		{
+			this->push(command_type::multi_draw_elements_indirect, gl_impl::command_draw_indirect{ jc::to_underlying(_mode),
+				jc::to_underlying(_indiceType), static_cast<GLsizei>(_drawCount), static_cast<GLsizei>(_strideBytes), _offsetBytes });
+		};
+
+		/**
+		 * @brief Dispatches compute work groups with the used program.
+		*/
+		void dispatch_compute(gl_unsigned_int _groupsX, gl_unsigned_int _groupsY = 1, gl_unsigned_int _groupsZ = 1)
+		{
+			this->push(command_type::dispatch_compute, gl_impl::command_dispatch{ { _groupsX, _groupsY, _groupsZ } });
+		};
+#endif
+
+#if GL_VERSION_4_2
+		/**
+		 * @brief Orders memory accesses between commands.
+		*/
+		void memory_barrier(memory_barrier_bit _barriers)
+		{
+			this->push(command_type::memory_barrier, gl_impl::command_bits{ jc::to_underlying(_barriers) });
+		};
+#endif
+
+#if GL_VERSION_4_5
+		/**
+		 * @brief Sets a vao's element buffer.
+		*/
+		void bind_element_buffer(const vao_id& _vao, const vbo_id& _vbo)
+		{
+			this->push(command_type::bind_element_buffer, gl_impl::command_bind_to{ _vao.get(), _vbo.get() });
+		};
+
+		/**
+		 * @brief Binds a texture to a texture unit.
+		*/
+		void bind_texture_unit(gl_unsigned_int _unit, const texture_id& _texture)
+		{
+			this->push(command_type::bind_texture_unit, gl_impl::command_bind_to{ _unit, _texture.get() });
+		};
+
+		/**
+		 * @brief Updates part of a vbo's data, the data is copied into the list.
+		 * @param _offset Offset in elements of the range's value type.
+		*/
+		template <std::ranges::contiguous_range RangeT>
+		void buffer_subdata(const vbo_id& _vbo, const RangeT& _data, size_t _offset = 0)
+		{
+			JCLIB_ASSERT(_vbo);
+			using value_type = jc::ranges::value_t<RangeT>;
+			const auto _sizeBytes = static_cast<size_t>(jc::ranges::distance(_data)) * sizeof(value_type);
+			const auto _at = this->push(command_type::buffer_subdata, gl_impl::command_buffer_subdata{ _vbo.get(),
+				static_cast<GLintptr>(_offset * sizeof(value_type)), static_cast<GLsizeiptr>(_sizeBytes) }, _sizeBytes);
+			std::memcpy(_at, std::ranges::data(_data), _sizeBytes);
+		};
+#endif
+
+		/**
+		 * @brief Executes the recorded commands, must be called on the thread owning the context.
+		*/
+		void execute() const;
+
+		/**
+		 * @param _blockBytes Size of each block of the list's arena.
+		*/
+		explicit command_list(size_t _blockBytes = 64 * 1024) :
+			arena_{ _blockBytes }
+		{};
+
+		command_list(command_list&&) noexcept = default;
+		command_list& operator=(command_list&&) noexcept = default;
+
+	private:
+
+		/**
+		 * @brief Appends a command.
+		 * @param _extraBytes Bytes reserved after the command for trailing data.
+		 * @return The trailing data.
+		*/
+		template <typename CommandT>
+		std::byte* push(command_type _type, const CommandT& _command, size_t _extraBytes = 0)
+		{
+			static_assert(std::is_trivially_copyable_v<CommandT>);
+			constexpr auto _commandOffset = (sizeof(gl_impl::command_header) + alignof(CommandT) - 1) & ~(alignof(CommandT) - 1);
+			const auto _size = _commandOffset + sizeof(CommandT) + _extraBytes;
+
+			const auto _at = this->arena_.allocate(_size);
+			const gl_impl::command_header _header{ _type, static_cast<uint32_t>(_size) };
+			std::memcpy(_at, &_header, sizeof(_header));
+			std::memcpy(_at + _commandOffset, &_command, sizeof(CommandT));
+
+			++this->count_;
+			this->bytes_ += _size;
+			return _at + _commandOffset + sizeof(CommandT);
+		};
+
+		command_arena arena_;
+		size_t count_ = 0;
+		size_t bytes_ = 0;
+	};
+
+	namespace gl_impl
+	{
+		template <typename CommandT>
+		inline CommandT read_command(const std::byte* _at) noexcept
+		{
+			constexpr auto _commandOffset = (sizeof(command_header) + alignof(CommandT) - 1) & ~(alignof(CommandT) - 1);
+			CommandT _command;
+			std::memcpy(&_command, _at + _commandOffset, sizeof(CommandT));
+			return _command;
+		};
+
+		template <typename CommandT>
+		inline const std::byte* command_trailing_data(const std::byte* _at) noexcept
+		{
+			constexpr auto _commandOffset = (sizeof(command_header) + alignof(CommandT) - 1) & ~(alignof(CommandT) - 1);
+			return _at + _commandOffset + sizeof(CommandT);
+		};
+
+		/**
+		 * @brief Executes one command.
+		*/
+		inline void execute_command(command_type _type, const std::byte* _at)
+		{
+			switch (_type)
+			{
+			case command_type::bind_vao:
+				glBindVertexArray(read_command<command_bind>(_at).name);
+				break;
+			case command_type::use_program:
+				glUseProgram(read_command<command_bind>(_at).name);
+				break;
+			case command_type::bind_buffer_base:
+			{
+				const auto c = read_command<command_bind_buffer>(_at);
+				glBindBufferBase(c.target, c.index, c.buffer);
+				break;
+			}
+			case command_type::bind_buffer_range:
+			{
+				const auto c = read_command<command_bind_buffer>(_at);
+				glBindBufferRange(c.target, c.index, c.buffer, c.offset, c.size);
+				break;
+			}
+			case command_type::uniform_1f:
+			{
+				const auto c = read_command<command_uniform>(_at);
+				glProgramUniform1f(c.program, c.location, c.values[0]);
+				break;
+			}
+			case command_type::uniform_2f:
+			{
+				const auto c = read_command<command_uniform>(_at);
+				glProgramUniform2f(c.program, c.location, c.values[0], c.values[1]);
+				break;
+			}
+			case command_type::uniform_3f:
+			{
+				const auto c = read_command<command_uniform>(_at);
+				glProgramUniform3f(c.program, c.location, c.values[0], c.values[1], c.values[2]);
+				break;
+			}
+			case command_type::uniform_4f:
+			{
+				const auto c = read_command<command_uniform>(_at);
+				glProgramUniform4f(c.program, c.location, c.values[0], c.values[1], c.values[2], c.values[3]);
+				break;
+			}
+			case command_type::uniform_matrix_4f:
+			{
+				const auto c = read_command<command_uniform_matrix>(_at);
+				glProgramUniformMatrix4fv(c.program, c.location, 1, c.transpose, c.values);
+				break;
+			}
+			case command_type::clear:
+				glClear(read_command<command_bits>(_at).bits);
+				break;
+			case command_type::draw_arrays:
+			{
+				const auto c = read_command<command_draw>(_at);
+				if (c.instance_count == 1)
+				{
+					glDrawArrays(c.mode, static_cast<GLint>(c.first), static_cast<GLsizei>(c.count));
+				}
+				else
+				{
+					glDrawArraysInstanced(c.mode, static_cast<GLint>(c.first), static_cast<GLsizei>(c.count),
+						static_cast<GLsizei>(c.instance_count));
+				};
+				break;
+			}
+			case command_type::draw_elements:
+			{
+				const auto c = read_command<command_draw>(_at);
+				const auto _offset = reinterpret_cast<const void*>(c.first * command_index_bytes(static_cast<typecode>(c.index_type)));
+				if (c.instance_count == 1)
+				{
+					glDrawElements(c.mode, static_cast<GLsizei>(c.count), c.index_type, _offset);
+				}
+				else
+				{
+					glDrawElementsInstanced(c.mode, static_cast<GLsizei>(c.count), c.index_type, _offset,
+						static_cast<GLsizei>(c.instance_count));
+				};
+				break;
+			}
+			case command_type::draw_elements_indirect:
+			{
+				const auto c = read_command<command_draw_indirect>(_at);
+				glDrawElementsIndirect(c.mode, c.index_type, reinterpret_cast<const void*>(c.offset));
+				break;
+			}
+#if GL_VERSION_4_2
+			case command_type::memory_barrier:
+				glMemoryBarrier(read_command<command_bits>(_at).bits);
+				break;
+#endif
+#if GL_VERSION_4_3
+			case command_type::bind_vertex_buffer:
+			{
+				const auto c = read_command<command_bind_vertex_buffer>(_at);
+				glVertexArrayVertexBuffer(c.vao, c.index, c.buffer, c.offset, c.stride);
+				break;
+			}
+			case command_type::multi_draw_elements_indirect:
+			{
+				const auto c = read_command<command_draw_indirect>(_at);
+				glMultiDrawElementsIndirect(c.mode, c.index_type, reinterpret_cast<const void*>(c.offset), c.draw_count, c.stride);
+				break;
+			}
+			case command_type::dispatch_compute:
+			{
+				const auto c = read_command<command_dispatch>(_at);
+				glDispatchCompute(c.groups[0], c.groups[1], c.groups[2]);
+				break;
+			}
+#endif
+#if GL_VERSION_4_5
+			case command_type::bind_element_buffer:
+			{
+				const auto c = read_command<command_bind_to>(_at);
+				glVertexArrayElementBuffer(c.target, c.name);
+				break;
+			}
+			case command_type::bind_texture_unit:
+			{
+				const auto c = read_command<command_bind_to>(_at);
+				glBindTextureUnit(c.target, c.name);
+				break;
+			}
+			case command_type::buffer_subdata:
+			{
+				const auto c = read_command<command_buffer_subdata>(_at);
+				glNamedBufferSubData(c.buffer, c.offset, c.size, command_trailing_data<command_buffer_subdata>(_at));
+				break;
+			}
+#endif
+			default:
+				JCLIB_ASSERT(false);
+				break;
+			};
+		};
+	};
+
+	inline void command_list::execute() const
+	{
+		for (auto& _block : this->arena_.blocks())
+		{
+			const auto _begin = _block.data.get();
+			const auto _end = _begin + _block.used;
+			for (auto _at = static_cast<const std::byte*>(_begin); _at != _end;)
+			{
+				gl_impl::command_header _header;
+				std::memcpy(&_header, _at, sizeof(_header));
+				gl_impl::execute_command(_header.type, _at);
+				_at += (_header.size + command_arena::alignment - 1) & ~(command_arena::alignment - 1);
+			};
+		};
+	};
+
+	/**
+	 * @brief Executes command lists in order, must be called on the thread owning the context.
+	 *
+	 * Recording of the lists must have finished (ie. the recording threads joined or synchronized with
+	 * this one). The lists are not cleared so static lists can be submitted every frame.
+	*/
+	inline void submit(std::span<const command_list> _lists)
+	{
+		for (auto& _list : _lists)
+		{
+			_list.execute();
+		};
+	};
+
+	/**
+	 * @brief Executes a single command list, must be called on the thread owning the context.
+	*/
+	inline void submit(const command_list& _list)
+	{
+		_list.execute();
+	};
+
+};
+#pragma endregion
+
+#endif // JCLIB_OPENGL_GLCOMMAND_HPP
@@ -0,0 +1,545 @@
+#pragma once
+#ifndef JCLIB_OPENGL_GLCULL_HPP
+#define JCLIB_OPENGL_GLCULL_HPP
+
+/*
+	CPU side frustum culling of instance bounds ahead of instanced draws
+*/
+
+#include "gl.hpp"
+#include "glsimd.hpp"
+#include "glthread.hpp"
+
+#include <jclib/type.h>
+#include <jclib/concepts.h>
+
+#include <span>
+#include <array>
+#include <cmath>
+#include <bit>
+#include <cstdint>
+#include <atomic>
+#include <vector>
+#include <cstring>
+#include <algorithm>
+#include <type_traits>
+
+#define _JCLIB_OPENGL_GLCULL_
+
+#pragma region CULL_TYPES
+namespace jc::gl
+{
+	/**
+	 * @brief Six normalized planes (xyz normal, w distance), a point p is inside a plane when dot(n, p) + w >= 0.
+	 *
+	 * Plane order is left, right, bottom, top, near, far.
+	*/
+	struct frustum
+	{
+		std::array<std::array<gl_float, 4>, 6> planes{};
+	};
+
+	/**
+	 * @brief Extracts the frustum planes from a view projection matrix.
+	 *
+	 * Uses the Gribb/Hartmann method, assumes OpenGL clip space (-w <= z <= w).
+	 *
+	 * @param _viewProjection Column major 4x4 view projection matrix, as uploaded with glUniformMatrix4fv.
+	 * @return Normalized frustum planes.
+	*/
+	inline frustum make_frustum(std::span<const gl_float, 16> _viewProjection) noexcept
+	{
+		const auto& m = _viewProjection;
+		const auto _row = [&m](size_t r)
+		{
+			return std::array<gl_float, 4>{ m[0 + r], m[4 + r], m[8 + r], m[12 + r] };
+		};
+		const auto _r0 = _row(0);
+		const auto _r1 = _row(1);
+		const auto _r2 = _row(2);
+		const auto _r3 = _row(3);
+
+		frustum _out{};
+		for (size_t c = 0; c != 4; ++c)
+		{
+			_out.planes[0][c] = _r3[c] + _r0[c];
+			_out.planes[1][c] = _r3[c] - _r0[c];
+			_out.planes[2][c] = _r3[c] + _r1[c];
+			_out.planes[3][c] = _r3[c] - _r1[c];
+			_out.planes[4][c] = _r3[c] + _r2[c];
+			_out.planes[5][c] = _r3[c] - _r2[c];
+		};
+		for (auto& p : _out.planes)
+		{
+			const auto _len = std::sqrt(p[0] * p[0] + p[1] * p[1] + p[2] * p[2]);
+			if (_len > 0.0f)
+			{
+				for (auto& v : p)
+				{
+					v /= _len;
+				};
+			};
+		};
+		return _out;
+	};
+
+	/**
+	 * @brief Bounding spheres stored as structure of arrays.
+	*/
+	struct sphere_bounds
+	{
+		std::vector<gl_float> x{};
+		std::vector<gl_float> y{};
+		std::vector<gl_float> z{};
+		std::vector<gl_float> radius{};
+
+		size_t size() const noexcept { return this->x.size(); };
+		void reserve(size_t _count)
+		{
+			this->x.reserve(_count);
+			this->y.reserve(_count);
+			this->z.reserve(_count);
+			this->radius.reserve(_count);
+		};
+		void clear() noexcept
+		{
+			this->x.clear();
+			this->y.clear();
+			this->z.clear();
+			this->radius.clear();
+		};
+		void push_back(gl_float _x, gl_float _y, gl_float _z, gl_float _radius)
+		{
+			this->x.push_back(_x);
+			this->y.push_back(_y);
+			this->z.push_back(_z);
+			this->radius.push_back(_radius);
+		};
+	};
+
+	/**
+	 * @brief Axis aligned bounding boxes stored as structure of arrays of centers and half extents.
+	*/
+	struct aabb_bounds
+	{
+		std::vector<gl_float> x{};
+		std::vector<gl_float> y{};
+		std::vector<gl_float> z{};
+		std::vector<gl_float> extent_x{};
+		std::vector<gl_float> extent_y{};
+		std::vector<gl_float> extent_z{};
+
+		size_t size() const noexcept { return this->x.size(); };
+		void reserve(size_t _count)
+		{
+			for (auto v : { &this->x, &this->y, &this->z, &this->extent_x, &this->extent_y, &this->extent_z })
+			{
+				v->reserve(_count);
+			};
+		};
+		void clear() noexcept
+		{
+			for (auto v : { &this->x, &this->y, &this->z, &this->extent_x, &this->extent_y, &this->extent_z })
+			{
+				v->clear();
+			};
+		};
+		void push_back(gl_float _x, gl_float _y, gl_float _z, gl_float _extentX, gl_float _extentY, gl_float _extentZ)
+		{
+			this->x.push_back(_x);
+			this->y.push_back(_y);
+			this->z.push_back(_z);
+			this->extent_x.push_back(_extentX);
+			this->extent_y.push_back(_extentY);
+			this->extent_z.push_back(_extentZ);
+		};
+	};
+
+};
+#pragma endregion
+
+#pragma region CULL_KERNELS
+namespace jc::gl
+{
+	namespace gl_impl
+	{
+		/**
+		 * @brief Writes the index of every set bit in a visibility mask.
+		*/
+		inline size_t write_mask_indices(uint32_t _mask, gl_unsigned_int _base, gl_unsigned_int* _out) noexcept
+		{
+			size_t _written = 0;
+			while (_mask != 0)
+			{
+				const auto _bit = static_cast<gl_unsigned_int>(std::countr_zero(_mask));
+				_out[_written++] = _base + _bit;
+				_mask &= _mask - 1;
+			};
+			return _written;
+		};
+
+		/**
+		 * @brief Signed distance from a point to a plane.
+		 *
+		 * Evaluated as ((x * a + w) + y * b) + z * c with separate multiplies and adds, the SIMD paths
+		 * use the same order without fused multiply add so every path culls the same set of bounds.
+		 * Products are kept in their own statements so they are not contracted into fma, building with
+		 * -ffp-contract=fast voids this and results may then differ by an ulp near a plane.
+		*/
+		inline gl_float plane_distance(const std::array<gl_float, 4>& p, gl_float x, gl_float y, gl_float z) noexcept
+		{
+			const auto _px = x * p[0];
+			const auto _py = y * p[1];
+			const auto _pz = z * p[2];
+			auto _d = _px + p[3];
+			_d = _py + _d;
+			_d = _pz + _d;
+			return _d;
+		};
+
+		/**
+		 * @brief Scalar sphere test.
+		 *
+		 * Uses an ordered greater-or-equal compare like the SIMD paths, so NaN bounds are culled.
+		*/
+		inline bool sphere_visible(const frustum& _frustum, gl_float x, gl_float y, gl_float z, gl_float r) noexcept
+		{
+			const auto _nr = 0.0f - r;
+			for (auto& p : _frustum.planes)
+			{
+				if (!(plane_distance(p, x, y, z) >= _nr))
+				{
+					return false;
+				};
+			};
+			return true;
+		};
+
+		/**
+		 * @brief Scalar box test.
+		 *
+		 * Uses an ordered greater-or-equal compare like the SIMD paths, so NaN bounds are culled.
+		*/
+		inline bool aabb_visible(const frustum& _frustum, gl_float x, gl_float y, gl_float z,
+			gl_float ex, gl_float ey, gl_float ez) noexcept
+		{
+			for (auto& p : _frustum.planes)
+			{
+				const auto _ry = ey * std::abs(p[1]);
+				const auto _rz = ez * std::abs(p[2]);
+				auto _reach = ex * std::abs(p[0]);
+				_reach = _ry + _reach;
+				_reach = _rz + _reach;
+				if (!(plane_distance(p, x, y, z) + _reach >= 0.0f))
+				{
+					return false;
+				};
+			};
+			return true;
+		};
+	};
+
+	/**
+	 * @brief Frustum culls a range of bounding spheres.
+	 *
+	 * Tests 16 (AVX-512), 8 (AVX2), or 1 sphere per iteration depending on the enabled instruction set.
+	 * Distinct ranges may be culled concurrently.
+	 *
+	 * @param _frustum Frustum to test against.
+	 * @param _bounds Spheres to test.
+	 * @param _first First sphere to test.
+	 * @param _count Number of spheres to test.
+	 * @param _visible Output indices of the visible spheres, must have room for _count indices.
+	 * @return Number of visible spheres written.
+	*/
+	inline size_t cull_spheres(const frustum& _frustum, const sphere_bounds& _bounds, size_t _first, size_t _count,
+		std::span<gl_unsigned_int> _visible) noexcept
+	{
+		JCLIB_ASSERT(_first + _count <= _bounds.size());
+		JCLIB_ASSERT(_visible.size() >= _count);
+
+		const auto _x = _bounds.x.data();
+		const auto _y = _bounds.y.data();
+		const auto _z = _bounds.z.data();
+		const auto _r = _bounds.radius.data();
+		const auto _out = _visible.data();
+		const auto _end = _first + _count;
+
+		size_t _written = 0;
+		size_t n = _first;
+
+#if JCLIB_OPENGL_AVX512_V
+		{
+			const auto _lane = _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+			for (; n + 16 <= _end; n += 16)
+			{
+				const auto _vx = _mm512_loadu_ps(_x + n);
+				const auto _vy = _mm512_loadu_ps(_y + n);
+				const auto _vz = _mm512_loadu_ps(_z + n);
+				const auto _vnr = _mm512_sub_ps(_mm512_setzero_ps(), _mm512_loadu_ps(_r + n));
+
+				__mmask16 _mask = 0xFFFF;
+				for (auto& p : _frustum.planes)
+				{
+					auto _d = _mm512_add_ps(_mm512_mul_ps(_vx, _mm512_set1_ps(p[0])), _mm512_set1_ps(p[3]));
+					_d = _mm512_add_ps(_mm512_mul_ps(_vy, _mm512_set1_ps(p[1])), _d);
+					_d = _mm512_add_ps(_mm512_mul_ps(_vz, _mm512_set1_ps(p[2])), _d);
+					_mask = _mm512_mask_cmp_ps_mask(_mask, _d, _vnr, _CMP_GE_OQ);
+				};
+
+				const auto _ids = _mm512_add_epi32(_mm512_set1_epi32(static_cast<int>(n)), _lane);
+				_mm512_mask_compressstoreu_epi32(_out + _written, _mask, _ids);
+				_written += static_cast<size_t>(std::popcount(static_cast<uint32_t>(_mask)));
+			};
+		};
+#endif
+#if JCLIB_OPENGL_AVX2_V
+		for (; n + 8 <= _end; n += 8)
+		{
+			const auto _vx = _mm256_loadu_ps(_x + n);
+			const auto _vy = _mm256_loadu_ps(_y + n);
+			const auto _vz = _mm256_loadu_ps(_z + n);
+			const auto _vnr = _mm256_sub_ps(_mm256_setzero_ps(), _mm256_loadu_ps(_r + n));
+
+			auto _inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+			for (auto& p : _frustum.planes)
+			{
+				auto _d = _mm256_add_ps(_mm256_mul_ps(_vx, _mm256_set1_ps(p[0])), _mm256_set1_ps(p[3]));
+				_d = _mm256_add_ps(_mm256_mul_ps(_vy, _mm256_set1_ps(p[1])), _d);
+				_d = _mm256_add_ps(_mm256_mul_ps(_vz, _mm256_set1_ps(p[2])), _d);
+				_inside = _mm256_and_ps(_inside, _mm256_cmp_ps(_d, _vnr, _CMP_GE_OQ));
+			};
+
+			const auto _mask = static_cast<uint32_t>(_mm256_movemask_ps(_inside));
+			_written += gl_impl::write_mask_indices(_mask, static_cast<gl_unsigned_int>(n), _out + _written);
+		};
+#endif
+		for (; n != _end; ++n)
+		{
+			if (gl_impl::sphere_visible(_frustum, _x[n], _y[n], _z[n], _r[n]))
+			{
+				_out[_written++] = static_cast<gl_unsigned_int>(n);
+			};
+		};
+		return _written;
+	};
+
+	/**
+	 * @brief Frustum culls a range of axis aligned bounding boxes.
+	 *
+	 * Tests 16 (AVX-512), 8 (AVX2), or 1 box per iteration depending on the enabled instruction set.
+	 * Distinct ranges may be culled concurrently.
+	 *
+	 * @param _frustum Frustum to test against.
+	 * @param _bounds Boxes to test.
+	 * @param _first First box to test.
+	 * @param _count Number of boxes to test.
+	 * @param _visible Output indices of the visible boxes, must have room for _count indices.
+	 * @return Number of visible boxes written.
+	*/
+	inline size_t cull_aabbs(const frustum& _frustum, const aabb_bounds& _bounds, size_t _first, size_t _count,
+		std::span<gl_unsigned_int> _visible) noexcept
+	{
+		JCLIB_ASSERT(_first + _count <= _bounds.size());
+		JCLIB_ASSERT(_visible.size() >= _count);
+
+		const auto _x = _bounds.x.data();
+		const auto _y = _bounds.y.data();
+		const auto _z = _bounds.z.data();
+		const auto _ex = _bounds.extent_x.data();
+		const auto _ey = _bounds.extent_y.data();
+		const auto _ez = _bounds.extent_z.data();
+		const auto _out = _visible.data();
+		const auto _end = _first + _count;
+
+		size_t _written = 0;
+		size_t n = _first;
+
+#if JCLIB_OPENGL_AVX512_V
+		{
+			const auto _lane = _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+			for (; n + 16 <= _end; n += 16)
+			{
+				const auto _vx = _mm512_loadu_ps(_x + n);
+				const auto _vy = _mm512_loadu_ps(_y + n);
+				const auto _vz = _mm512_loadu_ps(_z + n);
+				const auto _vex = _mm512_loadu_ps(_ex + n);
+				const auto _vey = _mm512_loadu_ps(_ey + n);
+				const auto _vez = _mm512_loadu_ps(_ez + n);
+
+				__mmask16 _mask = 0xFFFF;
+				for (auto& p : _frustum.planes)
+				{
+					auto _d = _mm512_add_ps(_mm512_mul_ps(_vx, _mm512_set1_ps(p[0])), _mm512_set1_ps(p[3]));
+					_d = _mm512_add_ps(_mm512_mul_ps(_vy, _mm512_set1_ps(p[1])), _d);
+					_d = _mm512_add_ps(_mm512_mul_ps(_vz, _mm512_set1_ps(p[2])), _d);
+					auto _reach = _mm512_mul_ps(_vex, _mm512_set1_ps(std::abs(p[0])));
+					_reach = _mm512_add_ps(_mm512_mul_ps(_vey, _mm512_set1_ps(std::abs(p[1]))), _reach);
+					_reach = _mm512_add_ps(_mm512_mul_ps(_vez, _mm512_set1_ps(std::abs(p[2]))), _reach);
+					_mask = _mm512_mask_cmp_ps_mask(_mask, _mm512_add_ps(_d, _reach), _mm512_setzero_ps(), _CMP_GE_OQ);
+				};
+
+				const auto _ids = _mm512_add_epi32(_mm512_set1_epi32(static_cast<int>(n)), _lane);
+				_mm512_mask_compressstoreu_epi32(_out + _written, _mask, _ids);
+				_written += static_cast<size_t>(std::popcount(static_cast<uint32_t>(_mask)));
+			};
+		};
+#endif
+#if JCLIB_OPENGL_AVX2_V
+		for (; n + 8 <= _end; n += 8)
+		{
+			const auto _vx = _mm256_loadu_ps(_x + n);
+			const auto _vy = _mm256_loadu_ps(_y + n);
+			const auto _vz = _mm256_loadu_ps(_z + n);
+			const auto _vex = _mm256_loadu_ps(_ex + n);
+			const auto _vey = _mm256_loadu_ps(_ey + n);
+			const auto _vez = _mm256_loadu_ps(_ez + n);
+
+			auto _inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+			for (auto& p : _frustum.planes)
+			{
+				auto _d = _mm256_add_ps(_mm256_mul_ps(_vx, _mm256_set1_ps(p[0])), _mm256_set1_ps(p[3]));
+				_d = _mm256_add_ps(_mm256_mul_ps(_vy, _mm256_set1_ps(p[1])), _d);
+				_d = _mm256_add_ps(_mm256_mul_ps(_vz, _mm256_set1_ps(p[2])), _d);
+				auto _reach = _mm256_mul_ps(_vex, _mm256_set1_ps(std::abs(p[0])));
+				_reach = _mm256_add_ps(_mm256_mul_ps(_vey, _mm256_set1_ps(std::abs(p[1]))), _reach);
+				_reach = _mm256_add_ps(_mm256_mul_ps(_vez, _mm256_set1_ps(std::abs(p[2]))), _reach);
+				_inside = _mm256_and_ps(_inside, _mm256_cmp_ps(_mm256_add_ps(_d, _reach), _mm256_setzero_ps(), _CMP_GE_OQ));
+			};
+
+			const auto _mask = static_cast<uint32_t>(_mm256_movemask_ps(_inside));
+			_written += gl_impl::write_mask_indices(_mask, static_cast<gl_unsigned_int>(n), _out + _written);
+		};
+#endif
+		for (; n != _end; ++n)
+		{
+			if (gl_impl::aabb_visible(_frustum, _x[n], _y[n], _z[n], _ex[n], _ey[n], _ez[n]))
+			{
+				_out[_written++] = static_cast<gl_unsigned_int>(n);
+			};
+		};
+		return _written;
+	};
+
+};
+#pragma endregion
+
+#pragma region CULL_INSTANCES
+namespace jc::gl
+{
+	/**
+	 * @brief Number of bounds each worker culls at a time in cull_instances().
+	*/
+	constexpr inline size_t cull_chunk_size = 4096;
+
+	/**
+	 * @brief Frustum culls instances and compacts the surviving instance data into an output span.
+	 *
+	 * The output span is typically memory from map_buffer_range() on the instance vbo so surviving
+	 * instances are written straight into GPU visible memory, draw with the returned count as the
+	 * instance count.
+	 *
+	 * Chunks of cull_chunk_size bounds are culled on the thread pool and each chunk reserves its
+	 * output range atomically, so surviving instances keep their relative order within a chunk but
+	 * chunks may land in any order.
+	 *
+	 * @tparam BoundsT sphere_bounds or aabb_bounds.
+	 * @tparam InstanceT Per instance data type.
+	 * @param _frustum Frustum to test against.
+	 * @param _bounds Bounds of each instance.
+	 * @param _instances Instance data, one per bound.
+	 * @param _out Where surviving instance data is written, must have room for every instance.
+	 * @param _pool Thread pool to split the work across.
+	 * @return Number of instances written.
+	*/
+	template <typename BoundsT, typename InstanceT>
+	requires (std::is_same_v<BoundsT, sphere_bounds> || std::is_same_v<BoundsT, aabb_bounds>) &&
+		std::is_trivially_copyable_v<InstanceT>
+	inline size_t cull_instances(const frustum& _frustum, const BoundsT& _bounds, std::span<const InstanceT> _instances,
+		std::span<InstanceT> _out, thread_pool& _pool)
+	{
+		JCLIB_ASSERT(_instances.size() == _bounds.size());
+		JCLIB_ASSERT(_out.size() >= _instances.size());
+
+		const auto _count = _bounds.size();
+		const auto _chunks = (_count + cull_chunk_size - 1) / cull_chunk_size;
+		std::atomic<size_t> _written{ 0 };
+
+		_pool.parallel_for(_chunks, [&](size_t c)
+		{
+			thread_local std::vector<gl_unsigned_int> _visible{};
+			_visible.resize(cull_chunk_size);
+
+			const auto _first = c * cull_chunk_size;
+			const auto _chunkCount = std::min(cull_chunk_size, _count - _first);
+
+			size_t _found = 0;
+			if constexpr (std::is_same_v<BoundsT, sphere_bounds>)
+			{
+				_found = cull_spheres(_frustum, _bounds, _first, _chunkCount, _visible);
+			}
+			else
+			{
+				_found = cull_aabbs(_frustum, _bounds, _first, _chunkCount, _visible);
+			};
+
+			const auto _dst = _out.data() + _written.fetch_add(_found, std::memory_order_relaxed);
+			for (size_t n = 0; n != _found; ++n)
+			{
+				std::memcpy(_dst + n, _instances.data() + _visible[n], sizeof(InstanceT));
+			};
+		});
+
+		return _written.load(std::memory_order_relaxed);
+	};
+
+};
+#pragma endregion
+
+#pragma region GLM_EXTENSION
+#if JCLIB_OPENGL_GLM_V
+
+#include <glm/mat4x4.hpp>
+#include <glm/vec3.hpp>
+
+namespace jc::gl
+{
+	/**
+	 * @brief Extracts the frustum planes from a view projection matrix.
+	 * @param _viewProjection View projection matrix.
+	 * @return Normalized frustum planes.
+	*/
+	inline frustum make_frustum(const glm::mat4& _viewProjection) noexcept
+	{
+		return make_frustum(std::span<const gl_float, 16>{ &_viewProjection[0][0], 16 });
+	};
+
+	/**
+	 * @brief Adds a bounding sphere.
+	 * @param _bounds Spheres to add to.
+	 * @param _center Sphere center.
+	 * @param _radius Sphere radius.
+	*/
+	inline void push_bounds(sphere_bounds& _bounds, const glm::vec3& _center, gl_float _radius)
+	{
+		_bounds.push_back(_center.x, _center.y, _center.z, _radius);
+	};
+
+	/**
+	 * @brief Adds a bounding box.
+	 * @param _bounds Boxes to add to.
+	 * @param _min Box minimum corner.
+	 * @param _max Box maximum corner.
+	*/
+	inline void push_bounds(aabb_bounds& _bounds, const glm::vec3& _min, const glm::vec3& _max)
+	{
+		const auto _center = (_min + _max) * 0.5f;
+		const auto _extent = (_max - _min) * 0.5f;
+		_bounds.push_back(_center.x, _center.y, _center.z, _extent.x, _extent.y, _extent.z);
+	};
+};
+
+#endif
+#pragma endregion
+
+#endif // JCLIB_OPENGL_GLCULL_HPP
@@ -0,0 +1,731 @@
+#pragma once
+#ifndef JCLIB_OPENGL_GLDEBUG_HPP
+#define JCLIB_OPENGL_GLDEBUG_HPP
+
+/*
+	Debug groups and object labels shown by external profilers and debuggers (RenderDoc, Nsight, apitrace).
+
+	JCLIB_OPENGL_DEBUG_LABELS_V defaults to JCLIB_DEBUG_V and can be predefined to force labels on in
+	release builds or off in debug builds. When false, or without OpenGL 4.3, every function here has an
+	empty body so callers don't need their own version checks.
+
+	debug_message_pipeline is a deduplicating, rate limited debug callback that stays on regardless.
+*/
+
+#include "gl.hpp"
+
+#include <jclib/config.h>
+#include <jclib/type.h>
+
+#include <bit>
+#include <array>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <functional>
+#include <string_view>
+#include <condition_variable>
+
+#if !defined(JCLIB_OPENGL_DEBUG_LABELS_V)
+#define JCLIB_OPENGL_DEBUG_LABELS_V JCLIB_DEBUG_V
+#endif
+
+#define _JCLIB_OPENGL_GLDEBUG_
+
+namespace jc::gl
+{
+	/**
+	 * @brief Names an object in debug output and profiler captures.
+	 * @param _id Object to name, must be good.
+	 * @param _label Name to show, copied by OpenGL.
+	*/
+	template <object_type Type>
+	inline void set_label([[maybe_unused]] const object_id<Type>& _id, [[maybe_unused]] std::string_view _label)
+	{
+#if JCLIB_OPENGL_DEBUG_LABELS_V && GL_VERSION_4_3
+		JCLIB_ASSERT(_id.good());
+		const auto _length = static_cast<GLsizei>(_label.size());
+		if constexpr (Type == object_type::sync)
+		{
+			glObjectPtrLabel(_id.get(), _length, _label.data());
+		}
+		else
+		{
+			// object_type values are the identifiers glObjectLabel expects
+			glObjectLabel(jc::to_underlying(Type), _id.get(), _length, _label.data());
+		};
+#endif
+	};
+
+	/**
+	 * @brief Names an owned object in debug output and profiler captures.
+	 * @param _object Object to name, must be good.
+	 * @param _label Name to show, copied by OpenGL.
+	*/
+	template <object_type Type, typename DestroyPolicyT>
+	inline void set_label(const unique_object<Type, DestroyPolicyT>& _object, std::string_view _label)
+	{
+		set_label(_object.id(), _label);
+	};
+
+	/**
+	 * @brief Inserts a single marker into the command stream.
+	 * @param _message Text of the marker.
+	 * @param _id Application defined message ID.
+	*/
+	inline void debug_marker([[maybe_unused]] std::string_view _message, [[maybe_unused]] GLuint _id = 0)
+	{
+#if JCLIB_OPENGL_DEBUG_LABELS_V && GL_VERSION_4_3
+		glDebugMessageInsert(GL_DEBUG_SOURCE_APPLICATION, GL_DEBUG_TYPE_MARKER, _id, GL_DEBUG_SEVERITY_NOTIFICATION,
+			static_cast<GLsizei>(_message.size()), _message.data());
+#endif
+	};
+
+	/**
+	 * @brief Pushes a named debug group on construction and pops it on destruction.
+	 *
+	 * Groups nest and show up as regions around the commands issued inside them.
+	 *
+	 * ```
+	 * {
+	 *     gl::scoped_debug_group _group{ "shadow pass" };
+	 *     ...
+	 * };
+	 * ```
+	*/
+	class scoped_debug_group
+	{
+	public:
+
+		/**
+		 * @brief Pushes a debug group.
+		 * @param _name Name of the group, copied by OpenGL.
+		 * @param _id Application defined message ID.
+		*/
+		explicit scoped_debug_group([[maybe_unused]] std::string_view _name, [[maybe_unused]] GLuint _id = 0)
+		{
+#if JCLIB_OPENGL_DEBUG_LABELS_V && GL_VERSION_4_3
+			glPushDebugGroup(GL_DEBUG_SOURCE_APPLICATION, _id, static_cast<GLsizei>(_name.size()), _name.data());
+#endif
+		};
+
+		/**
+		 * @brief Pops the debug group.
+		*/
+		~scoped_debug_group()
+		{
+#if JCLIB_OPENGL_DEBUG_LABELS_V && GL_VERSION_4_3
+			glPopDebugGroup();
+#endif
+		};
+
+		scoped_debug_group(const scoped_debug_group&) = delete;
+		scoped_debug_group& operator=(const scoped_debug_group&) = delete;
+		scoped_debug_group(scoped_debug_group&&) = delete;
+		scoped_debug_group& operator=(scoped_debug_group&&) = delete;
+	};
+
+};
+
+#pragma region DEBUG_MESSAGE_PIPELINE
+#if GL_VERSION_4_3
+namespace jc::gl
+{
+	/**
+	 * @brief Debug message severities in order, usable as an index.
+	*/
+	enum class debug_severity : uint8_t
+	{
+		high,
+		medium,
+		low,
+		notification,
+		count_
+	};
+
+	/**
+	 * @brief Converts a GL_DEBUG_SEVERITY_* value.
+	*/
+	constexpr inline debug_severity to_debug_severity(GLenum _severity) noexcept
+	{
+		switch (_severity)
+		{
+		case GL_DEBUG_SEVERITY_HIGH: return debug_severity::high;
+		case GL_DEBUG_SEVERITY_MEDIUM: return debug_severity::medium;
+		case GL_DEBUG_SEVERITY_LOW: return debug_severity::low;
+		default: return debug_severity::notification;
+		};
+	};
+
+	constexpr inline std::string_view to_string(debug_severity _severity) noexcept
+	{
+		switch (_severity)
+		{
+		case debug_severity::high: return "high";
+		case debug_severity::medium: return "medium";
+		case debug_severity::low: return "low";
+		default: return "notification";
+		};
+	};
+
+	namespace gl_impl
+	{
+		constexpr inline std::string_view debug_source_name(GLenum _source) noexcept
+		{
+			switch (_source)
+			{
+			case GL_DEBUG_SOURCE_API: return "api";
+			case GL_DEBUG_SOURCE_WINDOW_SYSTEM: return "window system";
+			case GL_DEBUG_SOURCE_SHADER_COMPILER: return "shader compiler";
+			case GL_DEBUG_SOURCE_THIRD_PARTY: return "third party";
+			case GL_DEBUG_SOURCE_APPLICATION: return "application";
+			default: return "other";
+			};
+		};
+		constexpr inline std::string_view debug_type_name(GLenum _type) noexcept
+		{
+			switch (_type)
+			{
+			case GL_DEBUG_TYPE_ERROR: return "error";
+			case GL_DEBUG_TYPE_DEPRECATED_BEHAVIOR: return "deprecated";
+			case GL_DEBUG_TYPE_UNDEFINED_BEHAVIOR: return "undefined behavior";
+			case GL_DEBUG_TYPE_PORTABILITY: return "portability";
+			case GL_DEBUG_TYPE_PERFORMANCE: return "performance";
+			case GL_DEBUG_TYPE_MARKER: return "marker";
+			default: return "other";
+			};
+		};
+	};
+
+	/**
+	 * @brief A debug message handed to a debug_message_pipeline's sink.
+	*/
+	struct debug_message
+	{
+		GLenum source = 0;
+		GLenum type = 0;
+		GLuint id = 0;
+		debug_severity severity = debug_severity::notification;
+
+		/**
+		 * @brief Number of times the message was received since it was last dispatched.
+		*/
+		uint64_t count = 0;
+
+		/**
+		 * @brief Number of times the message was received in total.
+		*/
+		uint64_t total = 0;
+
+		/**
+		 * @brief Text of the first occurrence, possibly truncated.
+		*/
+		std::string_view text{};
+	};
+
+	/**
+	 * @brief Formats a debug message as a single line without a trailing newline.
+	*/
+	inline std::string to_string(const debug_message& _message)
+	{
+		std::string _out{};
+		_out.reserve(_message.text.size() + 64);
+		_out.append("[GL ").append(to_string(_message.severity)).append("] ");
+		_out.append(gl_impl::debug_source_name(_message.source)).append(" ");
+		_out.append(gl_impl::debug_type_name(_message.type));
+		_out.append(" ").append(std::to_string(_message.id)).append(": ");
+		_out.append(_message.text);
+		if (_message.count > 1)
+		{
+			_out.append(" (x").append(std::to_string(_message.count)).append(")");
+		};
+		return _out;
+	};
+
+	/**
+	 * @brief Number of times a message was received, see debug_message_pipeline::performance_counters().
+	*/
+	struct debug_counter
+	{
+		GLenum source = 0;
+		GLuint id = 0;
+		uint64_t count = 0;
+		std::string text{};
+	};
+
+	/**
+	 * @brief Counters for a debug_message_pipeline.
+	*/
+	struct debug_pipeline_stats
+	{
+		/**
+		 * @brief Messages received from the driver, including repeats.
+		*/
+		uint64_t received = 0;
+
+		/**
+		 * @brief Messages handed to the sink, a repeat summary counts once.
+		*/
+		uint64_t dispatched = 0;
+
+		/**
+		 * @brief Messages lost because the ring buffer was full.
+		*/
+		uint64_t dropped = 0;
+
+		/**
+		 * @brief Dispatches skipped because their severity hit its rate limit.
+		*/
+		uint64_t rate_limited = 0;
+
+		/**
+		 * @brief GL_DEBUG_TYPE_PERFORMANCE messages received, including repeats.
+		*/
+		uint64_t performance = 0;
+	};
+
+	/**
+	 * @brief Settings for a debug_message_pipeline.
+	*/
+	struct debug_pipeline_settings
+	{
+		/**
+		 * @brief Number of distinct messages that can wait for the consumer, rounded up to a power of two.
+		*/
+		size_t ring_capacity = 256;
+
+		/**
+		 * @brief Number of distinct (source, type, id) keys tracked, rounded up to a power of two.
+		 *
+		 * Messages that don't fit are passed through without deduplication.
+		*/
+		size_t key_capacity = 1024;
+
+		/**
+		 * @brief How often the consumer thread dispatches messages.
+		*/
+		std::chrono::milliseconds interval{ 100 };
+
+		/**
+		 * @brief Dispatches allowed per second for each debug_severity, 0 for unlimited.
+		*/
+		std::array<uint32_t, static_cast<size_t>(debug_severity::count_)> max_per_second{ 0, 0, 20, 5 };
+	};
+
+	/**
+	 * @brief Debug message callback that stays cheap enough to leave on in production.
+	 *
+	 * The callback installed by install() does no formatting and takes no locks. It bumps an atomic count for
+	 * the message's (source, type, id) and only copies the text into a lock-free ring buffer the first time a
+	 * key is seen. GL_DEBUG_OUTPUT_SYNCHRONOUS is turned off so the driver may report from its own threads.
+	 *
+	 * A consumer thread wakes every settings interval and hands new messages, then repeat summaries carrying
+	 * the number of occurrences since the last dispatch, to the sink. Each severity has its own per-second
+	 * rate limit. Repeats of GL_DEBUG_TYPE_PERFORMANCE messages are available as performance_counters().
+	 *
+	 * ```
+	 * gl::debug_message_pipeline _debug{};
+	 * _debug.install();
+	 * ...
+	 * _debug.uninstall();
+	 * ```
+	*/
+	class debug_message_pipeline
+	{
+	public:
+
+		using sink_fn = std::function<void(const debug_message&)>;
+
+		/**
+		 * @brief Installs the callback and enables asynchronous debug output, call on the GL thread.
+		*/
+		void install()
+		{
+			glDisable(GL_DEBUG_OUTPUT_SYNCHRONOUS);
+			set_debug_callback(&debug_message_pipeline::callback, this);
+			enable_debug_output();
+		};
+
+		/**
+		 * @brief Removes the callback, call on the GL thread before destroying the pipeline.
+		*/
+		void uninstall()
+		{
+			set_debug_callback(nullptr, nullptr);
+		};
+
+		/**
+		 * @brief Dispatches everything received so far on the calling thread.
+		 * @return Number of messages handed to the sink.
+		*/
+		size_t flush()
+		{
+			std::unique_lock _lock{ this->mtx_ };
+			return this->drain();
+		};
+
+		/**
+		 * @brief Gets the repeat counts of every GL_DEBUG_TYPE_PERFORMANCE message seen so far.
+		*/
+		std::vector<debug_counter> performance_counters() const
+		{
+			std::vector<debug_counter> _out{};
+			std::unique_lock _lock{ this->mtx_ };
+			for (size_t n = 0; n != this->keys_.size(); ++n)
+			{
+				const auto _key = this->keys_[n].key.load(std::memory_order_acquire);
+				if (_key != 0 && unpack_type(_key) == GL_DEBUG_TYPE_PERFORMANCE)
+				{
+					_out.push_back(debug_counter{ unpack_source(_key), unpack_id(_key),
+						this->keys_[n].count.load(std::memory_order_relaxed), this->texts_[n] });
+				};
+			};
+			return _out;
+		};
+
+		/**
+		 * @brief Gets the pipeline's counters.
+		*/
+		debug_pipeline_stats stats() const
+		{
+			std::unique_lock _lock{ this->mtx_ };
+			auto _stats = this->stats_;
+			_stats.received = this->received_.load(std::memory_order_relaxed);
+			_stats.dropped = this->dropped_.load(std::memory_order_relaxed);
+			_stats.performance = this->performance_.load(std::memory_order_relaxed);
+			return _stats;
+		};
+
+		/**
+		 * @brief Starts the consumer thread, the callback is not installed until install().
+		 * @param _sink Receives dispatched messages, writes to_string() lines to stderr if empty.
+		 * @param _settings Buffer sizes, interval and rate limits.
+		*/
+		explicit debug_message_pipeline(sink_fn _sink = {}, const debug_pipeline_settings& _settings = {}) :
+			sink_{ std::move(_sink) },
+			settings_{ _settings },
+			ring_(std::bit_ceil(std::max(_settings.ring_capacity, size_t{ 2 }))),
+			keys_(std::bit_ceil(std::max(_settings.key_capacity, size_t{ 2 }))),
+			texts_(this->keys_.size()),
+			reported_(this->keys_.size())
+		{
+			if (!this->sink_)
+			{
+				this->sink_ = [](const debug_message& _message)
+				{
+					const auto _line = to_string(_message);
+					std::fprintf(stderr, "%s\n", _line.c_str());
+				};
+			};
+			for (size_t n = 0; n != this->ring_.size(); ++n)
+			{
+				this->ring_[n].sequence.store(n, std::memory_order_relaxed);
+			};
+
+			this->thread_ = std::jthread([this](std::stop_token _stop)
+			{
+				std::mutex _waitMtx{};
+				std::unique_lock _waitLock{ _waitMtx };
+				while (!this->wake_.wait_for(_waitLock, _stop, this->settings_.interval, []() { return false; }) && !_stop.stop_requested())
+				{
+					std::unique_lock _lock{ this->mtx_ };
+					this->drain();
+				};
+			});
+		};
+
+		/**
+		 * @brief Stops the consumer thread and dispatches what is left, uninstall() must have been called.
+		*/
+		~debug_message_pipeline()
+		{
+			this->thread_.request_stop();
+			if (this->thread_.joinable())
+			{
+				this->thread_.join();
+			};
+			this->flush();
+		};
+
+		debug_message_pipeline(const debug_message_pipeline&) = delete;
+		debug_message_pipeline& operator=(const debug_message_pipeline&) = delete;
+
+	private:
+
+		/**
+		 * @brief Longest message text kept, longer messages are truncated.
+		*/
+		constexpr static size_t max_text_length = 512;
+
+		/**
+		 * @brief Key slot index of messages that could not be tracked.
+		*/
+		constexpr static uint32_t untracked = UINT32_MAX;
+
+		/**
+		 * @brief Slot of the bounded multiple producer ring buffer (Vyukov's bounded queue).
+		*/
+		struct ring_slot
+		{
+			std::atomic<size_t> sequence{ 0 };
+			GLenum source = 0;
+			GLenum type = 0;
+			GLuint id = 0;
+			GLenum severity = 0;
+			uint32_t key_slot = untracked;
+			uint32_t length = 0;
+			char text[max_text_length];
+		};
+
+		struct key_slot
+		{
+			/**
+			 * @brief Packed (source, type, id), 0 if the slot is free.
+			*/
+			std::atomic<uint64_t> key{ 0 };
+			std::atomic<uint64_t> count{ 0 };
+
+			/**
+			 * @brief Set once the key's text has been queued.
+			*/
+			std::atomic<bool> published{ false };
+			debug_severity severity = debug_severity::notification;
+		};
+
+		// GL debug enums are all below 0x10000
+		constexpr static uint64_t pack_key(GLenum _source, GLenum _type, GLuint _id) noexcept
+		{
+			return (uint64_t{ _source & 0xFFFF } << 48) | (uint64_t{ _type & 0xFFFF } << 32) | _id;
+		};
+		constexpr static GLenum unpack_source(uint64_t _key) noexcept { return static_cast<GLenum>(_key >> 48); };
+		constexpr static GLenum unpack_type(uint64_t _key) noexcept { return static_cast<GLenum>((_key >> 32) & 0xFFFF); };
+		constexpr static GLuint unpack_id(uint64_t _key) noexcept { return static_cast<GLuint>(_key); };
+
+		/**
+		 * @brief Finds or claims the slot for a key with linear probing.
+		 * @return Slot index or untracked if the probe limit was reached.
+		*/
+		uint32_t find_key(uint64_t _key) noexcept
+		{
+			constexpr size_t _maxProbes = 16;
+			const auto _mask = this->keys_.size() - 1;
+			auto _index = static_cast<size_t>((_key * 0x9E3779B97F4A7C15ull) >> 32) & _mask;
+			for (size_t n = 0; n != _maxProbes; ++n)
+			{
+				auto& _slot = this->keys_[_index];
+				auto _existing = _slot.key.load(std::memory_order_acquire);
+				if (_existing == 0 && _slot.key.compare_exchange_strong(_existing, _key, std::memory_order_acq_rel))
+				{
+					return static_cast<uint32_t>(_index);
+				};
+				if (_existing == _key)
+				{
+					return static_cast<uint32_t>(_index);
+				};
+				_index = (_index + 1) & _mask;
+			};
+			return untracked;
+		};
+
+		/**
+		 * @brief Copies a message into the ring buffer.
+		 * @return False if the ring is full.
+		*/
+		bool enqueue(GLenum _source, GLenum _type, GLuint _id, GLenum _severity, uint32_t _keySlot, GLsizei _length, const GLchar* _message) noexcept
+		{
+			const auto _mask = this->ring_.size() - 1;
+			auto _pos = this->ring_head_.load(std::memory_order_relaxed);
+			ring_slot* _slot = nullptr;
+			while (true)
+			{
+				_slot = &this->ring_[_pos & _mask];
+				const auto _sequence = _slot->sequence.load(std::memory_order_acquire);
+				const auto _diff = static_cast<std::ptrdiff_t>(_sequence) - static_cast<std::ptrdiff_t>(_pos);
+				if (_diff == 0)
+				{
+					if (this->ring_head_.compare_exchange_weak(_pos, _pos + 1, std::memory_order_relaxed))
+					{
+						break;
+					};
+				}
+				else if (_diff < 0)
+				{
+					return false;
+				}
+				else
+				{
+					_pos = this->ring_head_.load(std::memory_order_relaxed);
+				};
+			};
+
+			_slot->source = _source;
+			_slot->type = _type;
+			_slot->id = _id;
+			_slot->severity = _severity;
+			_slot->key_slot = _keySlot;
+			const auto _textLength = (_length < 0) ? std::strlen(_message) : static_cast<size_t>(_length);
+			_slot->length = static_cast<uint32_t>(std::min(_textLength, max_text_length));
+			std::memcpy(_slot->text, _message, _slot->length);
+			_slot->sequence.store(_pos + 1, std::memory_order_release);
+			return true;
+		};
+
+		static void APIENTRY callback(GLenum _source, GLenum _type, GLuint _id, GLenum _severity, GLsizei _length,
+			const GLchar* _message, const void* _userParam)
+		{
+			// Debug group push/pop notifications only echo what the application already knows
+			if (_type == GL_DEBUG_TYPE_PUSH_GROUP || _type == GL_DEBUG_TYPE_POP_GROUP)
+			{
+				return;
+			};
+
+			auto& _pipeline = *static_cast<debug_message_pipeline*>(const_cast<void*>(_userParam));
+			_pipeline.received_.fetch_add(1, std::memory_order_relaxed);
+			if (_type == GL_DEBUG_TYPE_PERFORMANCE)
+			{
+				_pipeline.performance_.fetch_add(1, std::memory_order_relaxed);
+			};
+
+			const auto _keySlot = _pipeline.find_key(pack_key(_source, _type, _id));
+			if (_keySlot != untracked)
+			{
+				auto& _key = _pipeline.keys_[_keySlot];
+				_key.count.fetch_add(1, std::memory_order_relaxed);
+				if (_key.published.exchange(true, std::memory_order_acq_rel))
+				{
+					return;
+				};
+			};
+
+			if (!_pipeline.enqueue(_source, _type, _id, _severity, _keySlot, _length, _message))
+			{
+				_pipeline.dropped_.fetch_add(1, std::memory_order_relaxed);
+				if (_keySlot != untracked)
+				{
+					// Let the next occurrence try again
+					_pipeline.keys_[_keySlot].published.store(false, std::memory_order_release);
+				};
+			};
+		};
+
+		/**
+		 * @brief Checks a severity's rate limit and counts the dispatch against it.
+		*/
+		bool allow(debug_severity _severity, std::chrono::steady_clock::time_point _now) noexcept
+		{
+			const auto _index = static_cast<size_t>(_severity);
+			const auto _limit = this->settings_.max_per_second[_index];
+			if (_limit == 0)
+			{
+				return true;
+			};
+			if (_now - this->window_start_ >= std::chrono::seconds{ 1 })
+			{
+				this->window_start_ = _now;
+				this->window_counts_.fill(0);
+			};
+			if (this->window_counts_[_index] >= _limit)
+			{
+				++this->stats_.rate_limited;
+				return false;
+			};
+			++this->window_counts_[_index];
+			return true;
+		};
+
+		void dispatch(const debug_message& _message, size_t& _dispatched)
+		{
+			if (this->allow(_message.severity, std::chrono::steady_clock::now()))
+			{
+				this->sink_(_message);
+				++this->stats_.dispatched;
+				++_dispatched;
+			};
+		};
+
+		/**
+		 * @brief Dispatches queued messages, then repeat summaries, with mtx_ held.
+		*/
+		size_t drain()
+		{
+			size_t _dispatched = 0;
+			const auto _mask = this->ring_.size() - 1;
+			while (true)
+			{
+				auto& _slot = this->ring_[this->ring_tail_ & _mask];
+				if (_slot.sequence.load(std::memory_order_acquire) != this->ring_tail_ + 1)
+				{
+					break;
+				};
+
+				debug_message _message{ _slot.source, _slot.type, _slot.id, to_debug_severity(_slot.severity), 1, 1,
+					std::string_view{ _slot.text, _slot.length } };
+				if (_slot.key_slot != untracked)
+				{
+					auto& _key = this->keys_[_slot.key_slot];
+					_key.severity = _message.severity;
+					this->texts_[_slot.key_slot].assign(_message.text);
+					this->reported_[_slot.key_slot] = _key.count.load(std::memory_order_relaxed);
+					_message.count = this->reported_[_slot.key_slot];
+					_message.total = _message.count;
+				};
+
+				this->dispatch(_message, _dispatched);
+				_slot.sequence.store(this->ring_tail_ + this->ring_.size(), std::memory_order_release);
+				++this->ring_tail_;
+			};
+
+			for (size_t n = 0; n != this->keys_.size(); ++n)
+			{
+				auto& _key = this->keys_[n];
+				const auto _total = _key.count.load(std::memory_order_relaxed);
+				if (_total == this->reported_[n] || this->reported_[n] == 0)
+				{
+					continue;
+				};
+
+				const auto _packed = _key.key.load(std::memory_order_relaxed);
+				const debug_message _message{ unpack_source(_packed), unpack_type(_packed), unpack_id(_packed), _key.severity,
+					_total - this->reported_[n], _total, this->texts_[n] };
+				this->dispatch(_message, _dispatched);
+				this->reported_[n] = _total;
+			};
+			return _dispatched;
+		};
+
+		sink_fn sink_;
+		debug_pipeline_settings settings_;
+
+		std::vector<ring_slot> ring_;
+		std::atomic<size_t> ring_head_{ 0 };
+		std::vector<key_slot> keys_;
+
+		std::atomic<uint64_t> received_{ 0 };
+		std::atomic<uint64_t> dropped_{ 0 };
+		std::atomic<uint64_t> performance_{ 0 };
+
+		// Only touched with mtx_ held
+		mutable std::mutex mtx_{};
+		size_t ring_tail_ = 0;
+		std::vector<std::string> texts_;
+		std::vector<uint64_t> reported_;
+		debug_pipeline_stats stats_{};
+		std::chrono::steady_clock::time_point window_start_{};
+		std::array<uint32_t, static_cast<size_t>(debug_severity::count_)> window_counts_{};
+
+		std::condition_variable_any wake_{};
+		std::jthread thread_{};
+	};
+
+};
+#endif
+#pragma endregion
+
+#endif // JCLIB_OPENGL_GLDEBUG_HPP
@@ -6,6 +6,8 @@
 
 #include <jclib/type_traits.h>
 
+#include <string_view>
+
 #define _JCLIB_OPENGL_GLENUM_
 
 #pragma region BASIC
@@ -28,6 +30,8 @@ namespace jc::gl
 		gl_byte = GL_BYTE,
 		gl_unsigned_byte = GL_UNSIGNED_BYTE,
 
+		gl_half_float = GL_HALF_FLOAT,
+
 
 		gl_int_vec2 = GL_INT_VEC2,
 		gl_int_vec3 = GL_INT_VEC3,
@@ -72,6 +76,61 @@ namespace jc::gl
 		gl_sampler_2D_array = GL_SAMPLER_2D_ARRAY,
 	};
 
+	/**
+	 * @brief Gets the name of a typecode value, empty if it isn't one of the enumerators.
+	*/
+	constexpr inline std::string_view to_string(typecode _value) noexcept
+	{
+		switch (_value)
+		{
+		case typecode::gl_float: return "gl_float";
+		case typecode::gl_double: return "gl_double";
+		case typecode::gl_int: return "gl_int";
+		case typecode::gl_unsigned_int: return "gl_unsigned_int";
+		case typecode::gl_short: return "gl_short";
+		case typecode::gl_unsigned_short: return "gl_unsigned_short";
+		case typecode::gl_byte: return "gl_byte";
+		case typecode::gl_unsigned_byte: return "gl_unsigned_byte";
+		case typecode::gl_half_float: return "gl_half_float";
+		case typecode::gl_int_vec2: return "gl_int_vec2";
+		case typecode::gl_int_vec3: return "gl_int_vec3";
+		case typecode::gl_int_vec4: return "gl_int_vec4";
+		case typecode::gl_unsigned_int_vec2: return "gl_unsigned_int_vec2";
+		case typecode::gl_unsigned_int_vec3: return "gl_unsigned_int_vec3";
+		case typecode::gl_unsigned_int_vec4: return "gl_unsigned_int_vec4";
+		case typecode::gl_float_vec2: return "gl_float_vec2";
+		case typecode::gl_float_vec3: return "gl_float_vec3";
+		case typecode::gl_float_vec4: return "gl_float_vec4";
+		case typecode::gl_double_vec2: return "gl_double_vec2";
+		case typecode::gl_double_vec3: return "gl_double_vec3";
+		case typecode::gl_double_vec4: return "gl_double_vec4";
+		case typecode::gl_float_mat2: return "gl_float_mat2";
+		case typecode::gl_float_mat3x2: return "gl_float_mat3x2";
+		case typecode::gl_float_mat2x3: return "gl_float_mat2x3";
+		case typecode::gl_float_mat3: return "gl_float_mat3";
+		case typecode::gl_float_mat3x4: return "gl_float_mat3x4";
+		case typecode::gl_float_mat4x3: return "gl_float_mat4x3";
+		case typecode::gl_float_mat2x4: return "gl_float_mat2x4";
+		case typecode::gl_float_mat4x2: return "gl_float_mat4x2";
+		case typecode::gl_float_mat4: return "gl_float_mat4";
+		case typecode::gl_double_mat2: return "gl_double_mat2";
+		case typecode::gl_double_mat3x2: return "gl_double_mat3x2";
+		case typecode::gl_double_mat2x3: return "gl_double_mat2x3";
+		case typecode::gl_double_mat3: return "gl_double_mat3";
+		case typecode::gl_double_mat3x4: return "gl_double_mat3x4";
+		case typecode::gl_double_mat4x3: return "gl_double_mat4x3";
+		case typecode::gl_double_mat2x4: return "gl_double_mat2x4";
+		case typecode::gl_double_mat4x2: return "gl_double_mat4x2";
+		case typecode::gl_double_mat4: return "gl_double_mat4";
+		case typecode::gl_sampler_1D: return "gl_sampler_1D";
+		case typecode::gl_sampler_2D: return "gl_sampler_2D";
+		case typecode::gl_sampler_3D: return "gl_sampler_3D";
+		case typecode::gl_sampler_1D_array: return "gl_sampler_1D_array";
+		case typecode::gl_sampler_2D_array: return "gl_sampler_2D_array";
+		};
+		return {};
+	};
+
 	/**
 	 * @brief Enumeration of (supported) OpenGL object types
 	*/
@@ -83,6 +142,29 @@ namespace jc::gl
 		vbo = GL_BUFFER,
 		program_pipeline = GL_PROGRAM_PIPELINE,
 		texture = GL_TEXTURE,
+		framebuffer = GL_FRAMEBUFFER,
+		renderbuffer = GL_RENDERBUFFER,
+		sync = GL_SYNC_FENCE,
+	};
+
+	/**
+	 * @brief Gets the name of a object_type value, empty if it isn't one of the enumerators.
+	*/
+	constexpr inline std::string_view to_string(object_type _value) noexcept
+	{
+		switch (_value)
+		{
+		case object_type::program: return "program";
+		case object_type::shader: return "shader";
+		case object_type::vao: return "vao";
+		case object_type::vbo: return "vbo";
+		case object_type::program_pipeline: return "program_pipeline";
+		case object_type::texture: return "texture";
+		case object_type::framebuffer: return "framebuffer";
+		case object_type::renderbuffer: return "renderbuffer";
+		case object_type::sync: return "sync";
+		};
+		return {};
 	};
 
 	/**
@@ -99,6 +181,39 @@ namespace jc::gl
 		return static_cast<buffer_bit>(jc::to_underlying(lhs) | jc::to_underlying(rhs));
 	};
 
+	/**
+	 * @brief Bit masks for the kinds of memory access a memory barrier orders against incoherent shader writes
+	*/
+	enum class memory_barrier_bit : GLbitfield
+	{
+		vertex_attrib_array = GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT,
+		element_array = GL_ELEMENT_ARRAY_BARRIER_BIT,
+		uniform = GL_UNIFORM_BARRIER_BIT,
+		texture_fetch = GL_TEXTURE_FETCH_BARRIER_BIT,
+		shader_image_access = GL_SHADER_IMAGE_ACCESS_BARRIER_BIT,
+		command = GL_COMMAND_BARRIER_BIT,
+		pixel_buffer = GL_PIXEL_BUFFER_BARRIER_BIT,
+		texture_update = GL_TEXTURE_UPDATE_BARRIER_BIT,
+		buffer_update = GL_BUFFER_UPDATE_BARRIER_BIT,
+		framebuffer = GL_FRAMEBUFFER_BARRIER_BIT,
+		transform_feedback = GL_TRANSFORM_FEEDBACK_BARRIER_BIT,
+		atomic_counter = GL_ATOMIC_COUNTER_BARRIER_BIT,
+#if defined(GL_SHADER_STORAGE_BARRIER_BIT)
+		shader_storage = GL_SHADER_STORAGE_BARRIER_BIT,
+#endif
+#if defined(GL_CLIENT_MAPPED_BUFFER_BARRIER_BIT)
+		client_mapped_buffer = GL_CLIENT_MAPPED_BUFFER_BARRIER_BIT,
+#endif
+#if defined(GL_QUERY_BUFFER_BARRIER_BIT)
+		query_buffer = GL_QUERY_BUFFER_BARRIER_BIT,
+#endif
+		all = GL_ALL_BARRIER_BITS,
+	};
+	constexpr inline memory_barrier_bit operator|(const memory_barrier_bit& lhs, const memory_barrier_bit& rhs) noexcept
+	{
+		return static_cast<memory_barrier_bit>(jc::to_underlying(lhs) | jc::to_underlying(rhs));
+	};
+
 
 
 };
@@ -126,6 +241,24 @@ namespace jc::gl
 		dynamic_read = GL_DYNAMIC_READ,
 	};
 
+	/**
+	 * @brief Gets the name of a vbo_usage value, empty if it isn't one of the enumerators.
+	*/
+	constexpr inline std::string_view to_string(vbo_usage _value) noexcept
+	{
+		switch (_value)
+		{
+		case vbo_usage::static_draw: return "static_draw";
+		case vbo_usage::static_copy: return "static_copy";
+		case vbo_usage::static_read: return "static_read";
+		case vbo_usage::stream_draw: return "stream_draw";
+		case vbo_usage::stream_copy: return "stream_copy";
+		case vbo_usage::dynamic_draw: return "dynamic_draw";
+		case vbo_usage::dynamic_copy: return "dynamic_copy";
+		};
+		return {};
+	};
+
 	/**
 	 * @brief Enumerates targets that a vbo can be bound to
 	*/
@@ -175,6 +308,101 @@ namespace jc::gl
 #endif
 	};
 
+	/**
+	 * @brief Gets the name of a vbo_target value, empty if it isn't one of the enumerators.
+	*/
+	constexpr inline std::string_view to_string(vbo_target _value) noexcept
+	{
+		switch (_value)
+		{
+#if defined(GL_ARRAY_BUFFER)
+		case vbo_target::array: return "array";
+#endif
+#if defined(GL_ATOMIC_COUNTER_BUFFER)
+		case vbo_target::atomic_counter: return "atomic_counter";
+#endif
+#if defined(GL_COPY_READ_BUFFER)
+		case vbo_target::copy_read: return "copy_read";
+#endif
+#if defined(GL_COPY_WRITE_BUFFER)
+		case vbo_target::copy_write: return "copy_write";
+#endif
+#if defined(GL_DISPATCH_INDIRECT_BUFFER)
+		case vbo_target::dispatch_indirect: return "dispatch_indirect";
+#endif
+#if defined(GL_DRAW_INDIRECT_BUFFER)
+		case vbo_target::draw_indirect: return "draw_indirect";
+#endif
+#if defined(GL_ELEMENT_ARRAY_BUFFER)
+		case vbo_target::element_array: return "element_array";
+#endif
+#if defined(GL_PIXEL_PACK_BUFFER)
+		case vbo_target::pixel_pack: return "pixel_pack";
+#endif
+#if defined(GL_PIXEL_UNPACK_BUFFER)
+		case vbo_target::pixel_unpack: return "pixel_unpack";
+#endif
+#if defined(GL_QUERY_BUFFER)
+		case vbo_target::query: return "query";
+#endif
+#if defined(GL_SHADER_STORAGE_BUFFER)
+		case vbo_target::shader_storage: return "shader_storage";
+#endif
+#if defined(GL_TEXTURE_BUFFER)
+		case vbo_target::texture: return "texture";
+#endif
+#if defined(GL_TRANSFORM_FEEDBACK_BUFFER)
+		case vbo_target::transform_feedback: return "transform_feedback";
+#endif
+#if defined(GL_UNIFORM_BUFFER)
+		case vbo_target::uniform: return "uniform";
+#endif
+		};
+		return {};
+	};
+
+	/**
+	 * @brief Vbo targets that have indexed binding points
+	*/
+	enum class indexed_vbo_target : GLenum
+	{
+#if defined(GL_ATOMIC_COUNTER_BUFFER)
+		atomic_counter = GL_ATOMIC_COUNTER_BUFFER,
+#endif
+#if defined(GL_SHADER_STORAGE_BUFFER)
+		shader_storage = GL_SHADER_STORAGE_BUFFER,
+#endif
+#if defined(GL_TRANSFORM_FEEDBACK_BUFFER)
+		transform_feedback = GL_TRANSFORM_FEEDBACK_BUFFER,
+#endif
+#if defined(GL_UNIFORM_BUFFER)
+		uniform = GL_UNIFORM_BUFFER,
+#endif
+	};
+
+	/**
+	 * @brief Gets the name of a indexed_vbo_target value, empty if it isn't one of the enumerators.
+	*/
+	constexpr inline std::string_view to_string(indexed_vbo_target _value) noexcept
+	{
+		switch (_value)
+		{
+#if defined(GL_ATOMIC_COUNTER_BUFFER)
+		case indexed_vbo_target::atomic_counter: return "atomic_counter";
+#endif
+#if defined(GL_SHADER_STORAGE_BUFFER)
+		case indexed_vbo_target::shader_storage: return "shader_storage";
+#endif
+#if defined(GL_TRANSFORM_FEEDBACK_BUFFER)
+		case indexed_vbo_target::transform_feedback: return "transform_feedback";
+#endif
+#if defined(GL_UNIFORM_BUFFER)
+		case indexed_vbo_target::uniform: return "uniform";
+#endif
+		};
+		return {};
+	};
+
 	/**
 	 * @brief Parameters that can be queried and possible set for a vbo
 	*/
@@ -209,6 +437,95 @@ namespace jc::gl
 	#endif
 	};
 
+	/**
+	 * @brief Gets the name of a vbo_parameter value, empty if it isn't one of the enumerators.
+	*/
+	constexpr inline std::string_view to_string(vbo_parameter _value) noexcept
+	{
+		switch (_value)
+		{
+#if defined(GL_BUFFER_ACCESS)
+		case vbo_parameter::access: return "access";
+#endif
+#if defined(GL_BUFFER_ACCESS_FLAGS)
+		case vbo_parameter::access_flags: return "access_flags";
+#endif
+#if defined(GL_BUFFER_IMMUTABLE_STORAGE)
+		case vbo_parameter::immutable_storage: return "immutable_storage";
+#endif
+#if defined(GL_BUFFER_MAPPED)
+		case vbo_parameter::mapped: return "mapped";
+#endif
+#if defined(GL_BUFFER_MAP_LENGTH)
+		case vbo_parameter::map_length: return "map_length";
+#endif
+#if defined(GL_BUFFER_MAP_OFFSET)
+		case vbo_parameter::map_offset: return "map_offset";
+#endif
+#if defined(GL_BUFFER_SIZE)
+		case vbo_parameter::size: return "size";
+#endif
+#if defined(GL_BUFFER_STORAGE_FLAGS)
+		case vbo_parameter::storage_flags: return "storage_flags";
+#endif
+#if defined(GL_BUFFER_USAGE)
+		case vbo_parameter::usage: return "usage";
+#endif
+		};
+		return {};
+	};
+
+	/**
+	 * @brief Bit flags for how a mapped vbo range may be accessed
+	*/
+	enum class map_access_bit : GLbitfield
+	{
+		read = GL_MAP_READ_BIT,
+		write = GL_MAP_WRITE_BIT,
+		invalidate_range = GL_MAP_INVALIDATE_RANGE_BIT,
+		invalidate_buffer = GL_MAP_INVALIDATE_BUFFER_BIT,
+		flush_explicit = GL_MAP_FLUSH_EXPLICIT_BIT,
+		unsynchronized = GL_MAP_UNSYNCHRONIZED_BIT,
+	#if defined(GL_MAP_PERSISTENT_BIT)
+		persistent = GL_MAP_PERSISTENT_BIT,
+	#endif
+	#if defined(GL_MAP_COHERENT_BIT)
+		coherent = GL_MAP_COHERENT_BIT,
+	#endif
+	};
+	constexpr map_access_bit operator|(map_access_bit lhs, map_access_bit rhs)
+	{
+		return static_cast<map_access_bit>(jc::to_underlying(lhs) | jc::to_underlying(rhs));
+	};
+	constexpr map_access_bit& operator|=(map_access_bit& lhs, map_access_bit rhs)
+	{
+		lhs = lhs | rhs;
+		return lhs;
+	};
+
+	/**
+	 * @brief Bit flags for how the immutable storage of a vbo may be used
+	*/
+	enum class buffer_storage_bit : GLbitfield
+	{
+		none = 0,
+		dynamic_storage = GL_DYNAMIC_STORAGE_BIT,
+		map_read = GL_MAP_READ_BIT,
+		map_write = GL_MAP_WRITE_BIT,
+		map_persistent = GL_MAP_PERSISTENT_BIT,
+		map_coherent = GL_MAP_COHERENT_BIT,
+		client_storage = GL_CLIENT_STORAGE_BIT,
+	};
+	constexpr buffer_storage_bit operator|(buffer_storage_bit lhs, buffer_storage_bit rhs)
+	{
+		return static_cast<buffer_storage_bit>(jc::to_underlying(lhs) | jc::to_underlying(rhs));
+	};
+	constexpr buffer_storage_bit& operator|=(buffer_storage_bit& lhs, buffer_storage_bit rhs)
+	{
+		lhs = lhs | rhs;
+		return lhs;
+	};
+
 }
 
 #pragma endregion
@@ -259,6 +576,53 @@ namespace jc::gl
 #endif
 	};
 
+	/**
+	 * @brief Gets the name of a primitive value, empty if it isn't one of the enumerators.
+	*/
+	constexpr inline std::string_view to_string(primitive _value) noexcept
+	{
+		switch (_value)
+		{
+#if defined(GL_POINTS)
+		case primitive::points: return "points";
+#endif
+#if defined(GL_LINE_STRIP)
+		case primitive::line_strip: return "line_strip";
+#endif
+#if defined(GL_LINE_LOOP)
+		case primitive::line_loop: return "line_loop";
+#endif
+#if defined(GL_LINES)
+		case primitive::lines: return "lines";
+#endif
+#if defined(GL_LINE_STRIP_ADJACENCY)
+		case primitive::line_strip_adjacency: return "line_strip_adjacency";
+#endif
+#if defined(GL_LINES_ADJACENCY)
+		case primitive::lines_adjacency: return "lines_adjacency";
+#endif
+#if defined(GL_TRIANGLE_STRIP)
+		case primitive::triangle_strip: return "triangle_strip";
+#endif
+#if defined(GL_TRIANGLE_FAN)
+		case primitive::triangle_fan: return "triangle_fan";
+#endif
+#if defined(GL_TRIANGLES)
+		case primitive::triangles: return "triangles";
+#endif
+#if defined(GL_TRIANGLE_STRIP_ADJACENCY)
+		case primitive::triangle_strip_adjacency: return "triangle_strip_adjacency";
+#endif
+#if defined(GL_TRIANGLES_ADJACENCY)
+		case primitive::triangles_adjacency: return "triangles_adjacency";
+#endif
+#if defined(GL_PATCHES)
+		case primitive::patches: return "patches";
+#endif
+		};
+		return {};
+	};
+
 };
 #pragma endregion
 
@@ -278,6 +642,23 @@ namespace jc::gl
 		tesselation_evaluation = GL_TESS_EVALUATION_SHADER,
 	};
 
+	/**
+	 * @brief Gets the name of a shader_type value, empty if it isn't one of the enumerators.
+	*/
+	constexpr inline std::string_view to_string(shader_type _value) noexcept
+	{
+		switch (_value)
+		{
+		case shader_type::vertex: return "vertex";
+		case shader_type::fragment: return "fragment";
+		case shader_type::geometry: return "geometry";
+		case shader_type::compute: return "compute";
+		case shader_type::tesselation_control: return "tesselation_control";
+		case shader_type::tesselation_evaluation: return "tesselation_evaluation";
+		};
+		return {};
+	};
+
 	/**
 	 * @brief Parameters that can be queried and possible set for a shader object
 	*/
@@ -290,6 +671,22 @@ namespace jc::gl
 		delete_status = GL_DELETE_STATUS,
 	};
 
+	/**
+	 * @brief Gets the name of a shader_parameter value, empty if it isn't one of the enumerators.
+	*/
+	constexpr inline std::string_view to_string(shader_parameter _value) noexcept
+	{
+		switch (_value)
+		{
+		case shader_parameter::info_log_length: return "info_log_length";
+		case shader_parameter::compile_status: return "compile_status";
+		case shader_parameter::type: return "type";
+		case shader_parameter::source_length: return "source_length";
+		case shader_parameter::delete_status: return "delete_status";
+		};
+		return {};
+	};
+
 	/**
 	 * @brief Bit flags for denoting shader stages in a program pipeline
 	*/
@@ -354,6 +751,68 @@ namespace jc::gl
 #if defined(GL_UNIFORM_BLOCK)
 		uniform_block = GL_UNIFORM_BLOCK,
 #endif
+#if defined(GL_ATOMIC_COUNTER_BUFFER)
+		atomic_counter_buffer = GL_ATOMIC_COUNTER_BUFFER,
+#endif
+#if defined(GL_SHADER_STORAGE_BLOCK)
+		shader_storage_block = GL_SHADER_STORAGE_BLOCK,
+#endif
+#if defined(GL_BUFFER_VARIABLE)
+		buffer_variable = GL_BUFFER_VARIABLE,
+#endif
+	};
+
+	/**
+	 * @brief Gets the name of a resource_type value, empty if it isn't one of the enumerators.
+	*/
+	constexpr inline std::string_view to_string(resource_type _value) noexcept
+	{
+		switch (_value)
+		{
+#if defined(GL_UNIFORM)
+		case resource_type::uniform: return "uniform";
+#endif
+#if defined(GL_PROGRAM_INPUT)
+		case resource_type::program_input: return "program_input";
+#endif
+#if defined(GL_PROGRAM_OUTPUT)
+		case resource_type::program_output: return "program_output";
+#endif
+#if defined(GL_VERTEX_SUBROUTINE_UNIFORM)
+		case resource_type::vertex_subroutine_uniform: return "vertex_subroutine_uniform";
+#endif
+#if defined(GL_TESS_CONTROL_SUBROUTINE_UNIFORM)
+		case resource_type::tess_control_subroutine_uniform: return "tess_control_subroutine_uniform";
+#endif
+#if defined(GL_TESS_EVALUATION_SUBROUTINE_UNIFORM)
+		case resource_type::tess_evaluation_subroutine_uniform: return "tess_evaluation_subroutine_uniform";
+#endif
+#if defined(GL_GEOMETRY_SUBROUTINE_UNIFORM)
+		case resource_type::geometry_subroutine_uniform: return "geometry_subroutine_uniform";
+#endif
+#if defined(GL_FRAGMENT_SUBROUTINE_UNIFORM)
+		case resource_type::fragment_subroutine_uniform: return "fragment_subroutine_uniform";
+#endif
+#if defined(GL_COMPUTE_SUBROUTINE_UNIFORM)
+		case resource_type::compute_subroutine_uniform: return "compute_subroutine_uniform";
+#endif
+#if defined(GL_TRANSFORM_FEEDBACK_BUFFER)
+		case resource_type::transform_feedback_buffer: return "transform_feedback_buffer";
+#endif
+#if defined(GL_UNIFORM_BLOCK)
+		case resource_type::uniform_block: return "uniform_block";
+#endif
+#if defined(GL_ATOMIC_COUNTER_BUFFER)
+		case resource_type::atomic_counter_buffer: return "atomic_counter_buffer";
+#endif
+#if defined(GL_SHADER_STORAGE_BLOCK)
+		case resource_type::shader_storage_block: return "shader_storage_block";
+#endif
+#if defined(GL_BUFFER_VARIABLE)
+		case resource_type::buffer_variable: return "buffer_variable";
+#endif
+		};
+		return {};
 	};
 
 	/**
@@ -377,6 +836,39 @@ namespace jc::gl
 		transform_feedback_varyings = GL_TRANSFORM_FEEDBACK_VARYINGS,
 		transform_feedback_varying_max_length = GL_TRANSFORM_FEEDBACK_VARYING_MAX_LENGTH,
 		validate_status = GL_VALIDATE_STATUS,
+#if defined(GL_COMPUTE_WORK_GROUP_SIZE)
+		compute_work_group_size = GL_COMPUTE_WORK_GROUP_SIZE,
+#endif
+	};
+
+	/**
+	 * @brief Gets the name of a program_parameter value, empty if it isn't one of the enumerators.
+	*/
+	constexpr inline std::string_view to_string(program_parameter _value) noexcept
+	{
+		switch (_value)
+		{
+		case program_parameter::active_attributes: return "active_attributes";
+		case program_parameter::active_attribute_max_length: return "active_attribute_max_length";
+		case program_parameter::active_uniforms: return "active_uniforms";
+		case program_parameter::active_uniform_blocks: return "active_uniform_blocks";
+		case program_parameter::active_uniform_block_max_name_length: return "active_uniform_block_max_name_length";
+		case program_parameter::active_uniform_max_length: return "active_uniform_max_length";
+		case program_parameter::attached_shaders: return "attached_shaders";
+		case program_parameter::binary_length: return "binary_length";
+		case program_parameter::delete_status: return "delete_status";
+		case program_parameter::info_log_length: return "info_log_length";
+		case program_parameter::link_status: return "link_status";
+		case program_parameter::program_binary_retrievable_hint: return "program_binary_retrievable_hint";
+		case program_parameter::transform_feedback_buffer_mode: return "transform_feedback_buffer_mode";
+		case program_parameter::transform_feedback_varyings: return "transform_feedback_varyings";
+		case program_parameter::transform_feedback_varying_max_length: return "transform_feedback_varying_max_length";
+		case program_parameter::validate_status: return "validate_status";
+#if defined(GL_COMPUTE_WORK_GROUP_SIZE)
+		case program_parameter::compute_work_group_size: return "compute_work_group_size";
+#endif
+		};
+		return {};
 	};
 
 	/**
@@ -390,6 +882,21 @@ namespace jc::gl
 		max_num_compatible_subroutines = GL_MAX_NUM_COMPATIBLE_SUBROUTINES,
 	};
 
+	/**
+	 * @brief Gets the name of a program_interface value, empty if it isn't one of the enumerators.
+	*/
+	constexpr inline std::string_view to_string(program_interface _value) noexcept
+	{
+		switch (_value)
+		{
+		case program_interface::active_resources: return "active_resources";
+		case program_interface::max_name_length: return "max_name_length";
+		case program_interface::max_num_active_variables: return "max_num_active_variables";
+		case program_interface::max_num_compatible_subroutines: return "max_num_compatible_subroutines";
+		};
+		return {};
+	};
+
 	/**
 	 * @brief Parameters that can be queried for a program resource.
 	*/
@@ -427,6 +934,47 @@ namespace jc::gl
 		transform_feedback_buffer_stride = GL_TRANSFORM_FEEDBACK_BUFFER_STRIDE,
 	};
 
+	/**
+	 * @brief Gets the name of a resource_parameter value, empty if it isn't one of the enumerators.
+	*/
+	constexpr inline std::string_view to_string(resource_parameter _value) noexcept
+	{
+		switch (_value)
+		{
+		case resource_parameter::name_length: return "name_length";
+		case resource_parameter::type: return "type";
+		case resource_parameter::array_size: return "array_size";
+		case resource_parameter::offset: return "offset";
+		case resource_parameter::block_index: return "block_index";
+		case resource_parameter::array_stride: return "array_stride";
+		case resource_parameter::matrix_stride: return "matrix_stride";
+		case resource_parameter::is_row_major: return "is_row_major";
+		case resource_parameter::atomic_counter_buffer_index: return "atomic_counter_buffer_index";
+		case resource_parameter::texture_buffer: return "texture_buffer";
+		case resource_parameter::buffer_binding: return "buffer_binding";
+		case resource_parameter::buffer_data_size: return "buffer_data_size";
+		case resource_parameter::num_active_variables: return "num_active_variables";
+		case resource_parameter::active_variables: return "active_variables";
+		case resource_parameter::referenced_by_vertex_shader: return "referenced_by_vertex_shader";
+		case resource_parameter::referenced_by_tess_control_shader: return "referenced_by_tess_control_shader";
+		case resource_parameter::referenced_by_tess_evaluation_shader: return "referenced_by_tess_evaluation_shader";
+		case resource_parameter::referenced_by_geometry_shader: return "referenced_by_geometry_shader";
+		case resource_parameter::referenced_by_fragment_shader: return "referenced_by_fragment_shader";
+		case resource_parameter::referenced_by_compute_shader: return "referenced_by_compute_shader";
+		case resource_parameter::num_compatible_subroutines: return "num_compatible_subroutines";
+		case resource_parameter::compatible_subroutines: return "compatible_subroutines";
+		case resource_parameter::top_level_array_size: return "top_level_array_size";
+		case resource_parameter::top_level_array_stride: return "top_level_array_stride";
+		case resource_parameter::location: return "location";
+		case resource_parameter::location_index: return "location_index";
+		case resource_parameter::is_per_patch: return "is_per_patch";
+		case resource_parameter::location_component: return "location_component";
+		case resource_parameter::transform_feedback_buffer_index: return "transform_feedback_buffer_index";
+		case resource_parameter::transform_feedback_buffer_stride: return "transform_feedback_buffer_stride";
+		};
+		return {};
+	};
+
 };
 #pragma endregion
 
@@ -451,6 +999,28 @@ namespace jc::gl
 		mutisample_array = GL_TEXTURE_2D_MULTISAMPLE_ARRAY
 	};
 
+	/**
+	 * @brief Gets the name of a texture_target value, empty if it isn't one of the enumerators.
+	*/
+	constexpr inline std::string_view to_string(texture_target _value) noexcept
+	{
+		switch (_value)
+		{
+		case texture_target::tex1D: return "tex1D";
+		case texture_target::array1D: return "array1D";
+		case texture_target::tex2D: return "tex2D";
+		case texture_target::array2D: return "array2D";
+		case texture_target::tex3D: return "tex3D";
+		case texture_target::rectangle: return "rectangle";
+		case texture_target::cube_map: return "cube_map";
+		case texture_target::cube_map_array: return "cube_map_array";
+		case texture_target::buffer: return "buffer";
+		case texture_target::multisample: return "multisample";
+		case texture_target::mutisample_array: return "mutisample_array";
+		};
+		return {};
+	};
+
 	/**
 	 * @brief Enumeration of internal data formats
 	*/
@@ -503,6 +1073,73 @@ namespace jc::gl
 		rgba32i = GL_RGBA32I,
 		rgba8ui = GL_RGBA8UI,
 		rgba16ui = GL_RGBA16UI,
+
+		depth_component16 = GL_DEPTH_COMPONENT16,
+		depth_component24 = GL_DEPTH_COMPONENT24,
+		depth_component32f = GL_DEPTH_COMPONENT32F,
+		depth24_stencil8 = GL_DEPTH24_STENCIL8,
+		depth32f_stencil8 = GL_DEPTH32F_STENCIL8,
+		stencil_index8 = GL_STENCIL_INDEX8,
+	};
+
+	/**
+	 * @brief Gets the name of a internal_format value, empty if it isn't one of the enumerators.
+	*/
+	constexpr inline std::string_view to_string(internal_format _value) noexcept
+	{
+		switch (_value)
+		{
+		case internal_format::r8: return "r8";
+		case internal_format::r16: return "r16";
+		case internal_format::r16f: return "r16f";
+		case internal_format::r32f: return "r32f";
+		case internal_format::r8i: return "r8i";
+		case internal_format::r16i: return "r16i";
+		case internal_format::r32i: return "r32i";
+		case internal_format::r8ui: return "r8ui";
+		case internal_format::r16ui: return "r16ui";
+		case internal_format::r32ui: return "r32ui";
+		case internal_format::rg8: return "rg8";
+		case internal_format::rg16: return "rg16";
+		case internal_format::rg16f: return "rg16f";
+		case internal_format::rg32f: return "rg32f";
+		case internal_format::rg8i: return "rg8i";
+		case internal_format::rg16i: return "rg16i";
+		case internal_format::rg32i: return "rg32i";
+		case internal_format::rg8ui: return "rg8ui";
+		case internal_format::rg16ui: return "rg16ui";
+		case internal_format::rgb4: return "rgb4";
+		case internal_format::rgb5: return "rgb5";
+		case internal_format::rgb8: return "rgb8";
+		case internal_format::rgb8i: return "rgb8i";
+		case internal_format::rgb8ui: return "rgb8ui";
+		case internal_format::rgb8_snorm: return "rgb8_snorm";
+		case internal_format::rgb16: return "rgb16";
+		case internal_format::rgb16f: return "rgb16f";
+		case internal_format::rgb16i: return "rgb16i";
+		case internal_format::rgb16ui: return "rgb16ui";
+		case internal_format::rgb16_snorm: return "rgb16_snorm";
+		case internal_format::rg32ui: return "rg32ui";
+		case internal_format::rgb32f: return "rgb32f";
+		case internal_format::rgb32i: return "rgb32i";
+		case internal_format::rgb32ui: return "rgb32ui";
+		case internal_format::rgba8: return "rgba8";
+		case internal_format::rgba16: return "rgba16";
+		case internal_format::rgba16f: return "rgba16f";
+		case internal_format::rgba32f: return "rgba32f";
+		case internal_format::rgba8i: return "rgba8i";
+		case internal_format::rgba16i: return "rgba16i";
+		case internal_format::rgba32i: return "rgba32i";
+		case internal_format::rgba8ui: return "rgba8ui";
+		case internal_format::rgba16ui: return "rgba16ui";
+		case internal_format::depth_component16: return "depth_component16";
+		case internal_format::depth_component24: return "depth_component24";
+		case internal_format::depth_component32f: return "depth_component32f";
+		case internal_format::depth24_stencil8: return "depth24_stencil8";
+		case internal_format::depth32f_stencil8: return "depth32f_stencil8";
+		case internal_format::stencil_index8: return "stencil_index8";
+		};
+		return {};
 	};
 
 	/**
@@ -527,6 +1164,32 @@ namespace jc::gl
 		depth_stencil = GL_DEPTH_STENCIL,
 	};
 
+	/**
+	 * @brief Gets the name of a format value, empty if it isn't one of the enumerators.
+	*/
+	constexpr inline std::string_view to_string(format _value) noexcept
+	{
+		switch (_value)
+		{
+		case format::red: return "red";
+		case format::rg: return "rg";
+		case format::rgb: return "rgb";
+		case format::bgr: return "bgr";
+		case format::rgba: return "rgba";
+		case format::bgra: return "bgra";
+		case format::red_integer: return "red_integer";
+		case format::rg_integer: return "rg_integer";
+		case format::rgb_integer: return "rgb_integer";
+		case format::bgr_integer: return "bgr_integer";
+		case format::rgba_integer: return "rgba_integer";
+		case format::bgra_integer: return "bgra_integer";
+		case format::stencil_index: return "stencil_index";
+		case format::depth_component: return "depth_component";
+		case format::depth_stencil: return "depth_stencil";
+		};
+		return {};
+	};
+
 	/**
 	 * @brief Typecodes that can be used for pixel data types
 	*/
@@ -553,6 +1216,36 @@ namespace jc::gl
 		gl_unsigned_int_2_10_10_10_rev = GL_UNSIGNED_INT_2_10_10_10_REV,
 	};
 
+	/**
+	 * @brief Gets the name of a pixel_typecode value, empty if it isn't one of the enumerators.
+	*/
+	constexpr inline std::string_view to_string(pixel_typecode _value) noexcept
+	{
+		switch (_value)
+		{
+		case pixel_typecode::gl_unsigned_byte: return "gl_unsigned_byte";
+		case pixel_typecode::gl_byte: return "gl_byte";
+		case pixel_typecode::gl_unsigned_short: return "gl_unsigned_short";
+		case pixel_typecode::gl_short: return "gl_short";
+		case pixel_typecode::gl_unsigned_int: return "gl_unsigned_int";
+		case pixel_typecode::gl_int: return "gl_int";
+		case pixel_typecode::gl_float: return "gl_float";
+		case pixel_typecode::gl_unsigned_byte_3_3_2: return "gl_unsigned_byte_3_3_2";
+		case pixel_typecode::gl_unsigned_byte_2_3_3_rev: return "gl_unsigned_byte_2_3_3_rev";
+		case pixel_typecode::gl_unsigned_short_5_6_5: return "gl_unsigned_short_5_6_5";
+		case pixel_typecode::gl_unsigned_short_5_6_5_rev: return "gl_unsigned_short_5_6_5_rev";
+		case pixel_typecode::gl_unsigned_short_4_4_4_4: return "gl_unsigned_short_4_4_4_4";
+		case pixel_typecode::gl_unsigned_short_4_4_4_4_rev: return "gl_unsigned_short_4_4_4_4_rev";
+		case pixel_typecode::gl_unsigned_short_5_5_5_1: return "gl_unsigned_short_5_5_5_1";
+		case pixel_typecode::gl_unsigned_short_1_5_5_5_rev: return "gl_unsigned_short_1_5_5_5_rev";
+		case pixel_typecode::gl_unsigned_int_8_8_8_8: return "gl_unsigned_int_8_8_8_8";
+		case pixel_typecode::gl_unsigned_int_8_8_8_8_rev: return "gl_unsigned_int_8_8_8_8_rev";
+		case pixel_typecode::gl_unsigned_int_10_10_10_2: return "gl_unsigned_int_10_10_10_2";
+		case pixel_typecode::gl_unsigned_int_2_10_10_10_rev: return "gl_unsigned_int_2_10_10_10_rev";
+		};
+		return {};
+	};
+
 	/**
 	 * 	@brief Parameters that can be queried and possible set for a texture object
 	 */
@@ -586,6 +1279,223 @@ namespace jc::gl
 		wrap_t = GL_TEXTURE_WRAP_T,
 		wrap_r = GL_TEXTURE_WRAP_R
 	};
+
+	/**
+	 * @brief Gets the name of a texture_parameter value, empty if it isn't one of the enumerators.
+	*/
+	constexpr inline std::string_view to_string(texture_parameter _value) noexcept
+	{
+		switch (_value)
+		{
+		case texture_parameter::depth_stencil_mode: return "depth_stencil_mode";
+		case texture_parameter::image_format_compatibility_type: return "image_format_compatibility_type";
+		case texture_parameter::base_level: return "base_level";
+		case texture_parameter::border_color: return "border_color";
+		case texture_parameter::compare_mode: return "compare_mode";
+		case texture_parameter::compare_func: return "compare_func";
+		case texture_parameter::immutable_format: return "immutable_format";
+		case texture_parameter::immutable_levels: return "immutable_levels";
+		case texture_parameter::lod_bias: return "lod_bias";
+		case texture_parameter::mag_filter: return "mag_filter";
+		case texture_parameter::max_level: return "max_level";
+		case texture_parameter::max_lod: return "max_lod";
+		case texture_parameter::min_filter: return "min_filter";
+		case texture_parameter::min_lod: return "min_lod";
+		case texture_parameter::swizzle_r: return "swizzle_r";
+		case texture_parameter::swizzle_g: return "swizzle_g";
+		case texture_parameter::swizzle_b: return "swizzle_b";
+		case texture_parameter::swizzle_a: return "swizzle_a";
+		case texture_parameter::swizzle_rgba: return "swizzle_rgba";
+		case texture_parameter::target: return "target";
+		case texture_parameter::view_min_layer: return "view_min_layer";
+		case texture_parameter::view_min_level: return "view_min_level";
+		case texture_parameter::view_num_layers: return "view_num_layers";
+		case texture_parameter::view_num_levels: return "view_num_levels";
+		case texture_parameter::wrap_s: return "wrap_s";
+		case texture_parameter::wrap_t: return "wrap_t";
+		case texture_parameter::wrap_r: return "wrap_r";
+		};
+		return {};
+	};
+};
+#pragma endregion
+
+#pragma region FRAMEBUFFER
+namespace jc::gl
+{
+	/**
+	 * @brief Targets that a framebuffer can be bound to
+	*/
+	enum class framebuffer_target : GLenum
+	{
+		framebuffer = GL_FRAMEBUFFER,
+		draw = GL_DRAW_FRAMEBUFFER,
+		read = GL_READ_FRAMEBUFFER,
+	};
+
+	/**
+	 * @brief Gets the name of a framebuffer_target value, empty if it isn't one of the enumerators.
+	*/
+	constexpr inline std::string_view to_string(framebuffer_target _value) noexcept
+	{
+		switch (_value)
+		{
+		case framebuffer_target::framebuffer: return "framebuffer";
+		case framebuffer_target::draw: return "draw";
+		case framebuffer_target::read: return "read";
+		};
+		return {};
+	};
+
+	/**
+	 * @brief Attachment points of a framebuffer
+	 *
+	 * The default_* values name the buffers of the default framebuffer, use them when invalidating it.
+	*/
+	enum class framebuffer_attachment : GLenum
+	{
+		color0 = GL_COLOR_ATTACHMENT0,
+		color1 = GL_COLOR_ATTACHMENT1,
+		color2 = GL_COLOR_ATTACHMENT2,
+		color3 = GL_COLOR_ATTACHMENT3,
+		color4 = GL_COLOR_ATTACHMENT4,
+		color5 = GL_COLOR_ATTACHMENT5,
+		color6 = GL_COLOR_ATTACHMENT6,
+		color7 = GL_COLOR_ATTACHMENT7,
+		depth = GL_DEPTH_ATTACHMENT,
+		stencil = GL_STENCIL_ATTACHMENT,
+		depth_stencil = GL_DEPTH_STENCIL_ATTACHMENT,
+
+		default_color = GL_COLOR,
+		default_depth = GL_DEPTH,
+		default_stencil = GL_STENCIL,
+	};
+
+	/**
+	 * @brief Gets the name of a framebuffer_attachment value, empty if it isn't one of the enumerators.
+	*/
+	constexpr inline std::string_view to_string(framebuffer_attachment _value) noexcept
+	{
+		switch (_value)
+		{
+		case framebuffer_attachment::color0: return "color0";
+		case framebuffer_attachment::color1: return "color1";
+		case framebuffer_attachment::color2: return "color2";
+		case framebuffer_attachment::color3: return "color3";
+		case framebuffer_attachment::color4: return "color4";
+		case framebuffer_attachment::color5: return "color5";
+		case framebuffer_attachment::color6: return "color6";
+		case framebuffer_attachment::color7: return "color7";
+		case framebuffer_attachment::depth: return "depth";
+		case framebuffer_attachment::stencil: return "stencil";
+		case framebuffer_attachment::depth_stencil: return "depth_stencil";
+		case framebuffer_attachment::default_color: return "default_color";
+		case framebuffer_attachment::default_depth: return "default_depth";
+		case framebuffer_attachment::default_stencil: return "default_stencil";
+		};
+		return {};
+	};
+
+	/**
+	 * @brief Gets the color attachment point with the given index
+	 * @param _index Color attachment index, must be less than GL_MAX_COLOR_ATTACHMENTS
+	 * @return Color attachment point
+	*/
+	constexpr inline framebuffer_attachment color_attachment(GLuint _index) noexcept
+	{
+		return static_cast<framebuffer_attachment>(GL_COLOR_ATTACHMENT0 + _index);
+	};
+
+	/**
+	 * @brief Completeness status of a framebuffer
+	*/
+	enum class framebuffer_status : GLenum
+	{
+		complete = GL_FRAMEBUFFER_COMPLETE,
+		undefined = GL_FRAMEBUFFER_UNDEFINED,
+		incomplete_attachment = GL_FRAMEBUFFER_INCOMPLETE_ATTACHMENT,
+		incomplete_missing_attachment = GL_FRAMEBUFFER_INCOMPLETE_MISSING_ATTACHMENT,
+		incomplete_draw_buffer = GL_FRAMEBUFFER_INCOMPLETE_DRAW_BUFFER,
+		incomplete_read_buffer = GL_FRAMEBUFFER_INCOMPLETE_READ_BUFFER,
+		unsupported = GL_FRAMEBUFFER_UNSUPPORTED,
+		incomplete_multisample = GL_FRAMEBUFFER_INCOMPLETE_MULTISAMPLE,
+		incomplete_layer_targets = GL_FRAMEBUFFER_INCOMPLETE_LAYER_TARGETS,
+	};
+
+	/**
+	 * @brief Gets the name of a framebuffer_status value, empty if it isn't one of the enumerators.
+	*/
+	constexpr inline std::string_view to_string(framebuffer_status _value) noexcept
+	{
+		switch (_value)
+		{
+		case framebuffer_status::complete: return "complete";
+		case framebuffer_status::undefined: return "undefined";
+		case framebuffer_status::incomplete_attachment: return "incomplete_attachment";
+		case framebuffer_status::incomplete_missing_attachment: return "incomplete_missing_attachment";
+		case framebuffer_status::incomplete_draw_buffer: return "incomplete_draw_buffer";
+		case framebuffer_status::incomplete_read_buffer: return "incomplete_read_buffer";
+		case framebuffer_status::unsupported: return "unsupported";
+		case framebuffer_status::incomplete_multisample: return "incomplete_multisample";
+		case framebuffer_status::incomplete_layer_targets: return "incomplete_layer_targets";
+		};
+		return {};
+	};
+
+	/**
+	 * @brief Filter used to resample when blitting between framebuffers
+	*/
+	enum class blit_filter : GLenum
+	{
+		nearest = GL_NEAREST,
+		linear = GL_LINEAR,
+	};
+
+	/**
+	 * @brief Gets the name of a blit_filter value, empty if it isn't one of the enumerators.
+	*/
+	constexpr inline std::string_view to_string(blit_filter _value) noexcept
+	{
+		switch (_value)
+		{
+		case blit_filter::nearest: return "nearest";
+		case blit_filter::linear: return "linear";
+		};
+		return {};
+	};
+
+};
+#pragma endregion
+
+#pragma region SYNC
+namespace jc::gl
+{
+	/**
+	 * @brief Results of waiting on a sync object
+	*/
+	enum class sync_status : GLenum
+	{
+		already_signaled = GL_ALREADY_SIGNALED,
+		timeout_expired = GL_TIMEOUT_EXPIRED,
+		condition_satisfied = GL_CONDITION_SATISFIED,
+		wait_failed = GL_WAIT_FAILED,
+	};
+
+	/**
+	 * @brief Gets the name of a sync_status value, empty if it isn't one of the enumerators.
+	*/
+	constexpr inline std::string_view to_string(sync_status _value) noexcept
+	{
+		switch (_value)
+		{
+		case sync_status::already_signaled: return "already_signaled";
+		case sync_status::timeout_expired: return "timeout_expired";
+		case sync_status::condition_satisfied: return "condition_satisfied";
+		case sync_status::wait_failed: return "wait_failed";
+		};
+		return {};
+	};
+
 };
 #pragma endregion
 
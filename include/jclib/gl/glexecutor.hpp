@@ -0,0 +1,596 @@
+#pragma once
+#ifndef JCLIB_OPENGL_GLEXECUTOR_HPP
+#define JCLIB_OPENGL_GLEXECUTOR_HPP
+
+/*
+	Runs work pushed from any thread on the thread owning the OpenGL context
+*/
+
+#include <jclib/type.h>
+
+#include <array>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <cstdint>
+#include <utility>
+#include <optional>
+#include <functional>
+#include <type_traits>
+#include <condition_variable>
+
+#define _JCLIB_OPENGL_GLEXECUTOR_
+
+#pragma region MPSC_QUEUE
+namespace jc::gl
+{
+	/**
+	 * @brief Base for nodes of an mpsc_queue.
+	*/
+	struct mpsc_node
+	{
+		std::atomic<mpsc_node*> mpsc_next_{ nullptr };
+	};
+
+	/**
+	 * @brief Lock-free intrusive multiple producer, single consumer queue.
+	 *
+	 * push() may be called from any thread, pop() must only be called from one thread at a time. Push is
+	 * wait-free, pop is lock-free but may briefly report empty while a push is half way done. The queue
+	 * does not own its nodes.
+	 *
+	 * Based on Dmitry Vyukov's intrusive MPSC node-based queue.
+	*/
+	class mpsc_queue
+	{
+	public:
+
+		/**
+		 * @brief Appends a node, safe to call from any thread.
+		*/
+		void push(mpsc_node* _node) noexcept
+		{
+			_node->mpsc_next_.store(nullptr, std::memory_order_relaxed);
+			const auto _prev = this->head_.exchange(_node, std::memory_order_acq_rel);
+			_prev->mpsc_next_.store(_node, std::memory_order_release);
+		};
+
+		/**
+		 * @brief Removes the oldest node, only call from the consumer thread.
+		 * @return The node or null if the queue is empty.
+		*/
+		mpsc_node* pop() noexcept
+		{
+			auto _tail = this->tail_;
+			auto _next = _tail->mpsc_next_.load(std::memory_order_acquire);
+			if (_tail == &this->stub_)
+			{
+				if (!_next)
+				{
+					return nullptr;
+				};
+				this->tail_ = _next;
+				_tail = _next;
+				_next = _next->mpsc_next_.load(std::memory_order_acquire);
+			};
+
+			if (_next)
+			{
+				this->tail_ = _next;
+				return _tail;
+			};
+
+			// A producer swapped the head but hasn't linked its node yet
+			if (_tail != this->head_.load(std::memory_order_acquire))
+			{
+				return nullptr;
+			};
+
+			this->push(&this->stub_);
+			_next = _tail->mpsc_next_.load(std::memory_order_acquire);
+			if (_next)
+			{
+				this->tail_ = _next;
+				return _tail;
+			};
+			return nullptr;
+		};
+
+		mpsc_queue() noexcept :
+			head_{ &this->stub_ },
+			tail_{ &this->stub_ }
+		{};
+
+		mpsc_queue(const mpsc_queue&) = delete;
+		mpsc_queue& operator=(const mpsc_queue&) = delete;
+
+	private:
+		mpsc_node stub_{};
+		alignas(64) std::atomic<mpsc_node*> head_;
+		alignas(64) mpsc_node* tail_;
+	};
+
+};
+#pragma endregion
+
+#pragma region GL_FUTURE
+namespace jc::gl
+{
+	class gl_executor;
+
+	namespace gl_impl
+	{
+		enum class future_status : uint8_t
+		{
+			pending,
+			ready,
+			cancelled,
+			abandoned,
+		};
+
+		/**
+		 * @brief State shared by a gl_future and the task producing its value.
+		*/
+		template <typename T>
+		struct future_state
+		{
+			std::mutex mtx{};
+			std::condition_variable cv{};
+			std::atomic<future_status> status{ future_status::pending };
+			std::optional<T> value{};
+
+			/**
+			 * @brief Publishes the task's outcome, returns the previous status.
+			*/
+			future_status finish(future_status _status)
+			{
+				future_status _prev{};
+				{
+					std::unique_lock _lock{ this->mtx };
+					_prev = this->status.exchange(_status, std::memory_order_acq_rel);
+				};
+				this->cv.notify_all();
+				return _prev;
+			};
+		};
+
+		/**
+		 * @brief Stand in for the value of tasks returning void.
+		*/
+		struct future_void {};
+	};
+
+	/**
+	 * @brief Handle to the result of a task pushed to a gl_executor.
+	 *
+	 * The result is moved out with get(). If a future holding a result is destroyed, the result is destroyed on the
+	 * executor's thread so OpenGL objects such as unique_texture are never deleted off the context's thread. The
+	 * executor must outlive its futures.
+	 *
+	 * Never wait on a future from the executor's own thread, the task can't run while the thread is blocked.
+	*/
+	template <typename T>
+	class gl_future
+	{
+	private:
+		using value_type = std::conditional_t<std::is_void_v<T>, gl_impl::future_void, T>;
+		using state_type = gl_impl::future_state<value_type>;
+
+	public:
+
+		/**
+		 * @brief Checks if this refers to a task.
+		*/
+		bool valid() const noexcept { return static_cast<bool>(this->state_); };
+
+		/**
+		 * @brief Checks if the task has finished, either by running or by being cancelled.
+		*/
+		bool ready() const noexcept
+		{
+			JCLIB_ASSERT(this->valid());
+			return this->state_->status.load(std::memory_order_acquire) != gl_impl::future_status::pending;
+		};
+
+		/**
+		 * @brief Waits for the task to finish.
+		*/
+		void wait() const
+		{
+			JCLIB_ASSERT(this->valid());
+			std::unique_lock _lock{ this->state_->mtx };
+			this->state_->cv.wait(_lock, [this]() { return this->ready(); });
+		};
+
+		/**
+		 * @brief Waits for the task to finish or for a timeout.
+		 * @return True if the task finished.
+		*/
+		template <typename RepT, typename PeriodT>
+		bool wait_for(std::chrono::duration<RepT, PeriodT> _timeout) const
+		{
+			JCLIB_ASSERT(this->valid());
+			std::unique_lock _lock{ this->state_->mtx };
+			return this->state_->cv.wait_for(_lock, _timeout, [this]() { return this->ready(); });
+		};
+
+		/**
+		 * @brief Waits for the task and takes its result, leaving the future invalid.
+		 * @return The result, or nullopt if the task was cancelled. Tasks returning void give true if they ran.
+		*/
+		auto get()
+		{
+			this->wait();
+			const auto _state = std::move(this->state_);
+			if constexpr (std::is_void_v<T>)
+			{
+				return _state->status.load(std::memory_order_acquire) == gl_impl::future_status::ready;
+			}
+			else
+			{
+				return std::move(_state->value);
+			};
+		};
+
+		gl_future() noexcept = default;
+		gl_future(std::shared_ptr<state_type> _state, gl_executor* _executor) noexcept :
+			state_{ std::move(_state) },
+			executor_{ _executor }
+		{};
+
+		gl_future(gl_future&& other) noexcept :
+			state_{ std::move(other.state_) },
+			executor_{ other.executor_ }
+		{};
+		gl_future& operator=(gl_future&& other) noexcept
+		{
+			if (this != &other)
+			{
+				this->abandon();
+				this->state_ = std::move(other.state_);
+				this->executor_ = other.executor_;
+			};
+			return *this;
+		};
+
+		~gl_future()
+		{
+			this->abandon();
+		};
+
+	private:
+
+		/**
+		 * @brief Gives up on the result, destroying it on the executor's thread.
+		*/
+		void abandon();
+
+		std::shared_ptr<state_type> state_{};
+		gl_executor* executor_ = nullptr;
+	};
+
+};
+#pragma endregion
+
+#pragma region GL_EXECUTOR
+namespace jc::gl
+{
+	/**
+	 * @brief Queue latency and drain timing of a gl_executor.
+	*/
+	struct gl_executor_stats
+	{
+		using duration = std::chrono::nanoseconds;
+
+		/**
+		 * @brief Number of latency histogram buckets, bucket n counts latencies below 2^n microseconds.
+		*/
+		constexpr static size_t bucket_count = 24;
+
+		size_t executed = 0;
+		duration total_latency{};
+		duration max_latency{};
+		std::array<size_t, bucket_count> latency_histogram{};
+
+		/**
+		 * @brief Time spent and tasks run by the last call to gl_executor::run().
+		*/
+		duration last_run_time{};
+		size_t last_run_count = 0;
+
+		/**
+		 * @brief Number of run() calls that stopped with tasks still queued because the budget ran out.
+		*/
+		size_t budget_exhausted = 0;
+
+		/**
+		 * @brief Gets the mean time tasks waited in the queue.
+		*/
+		duration mean_latency() const noexcept
+		{
+			return (this->executed != 0) ? this->total_latency / static_cast<duration::rep>(this->executed) : duration{};
+		};
+
+		/**
+		 * @brief Gets an upper bound of the latency below which a fraction of tasks started.
+		 * @param _fraction Fraction of tasks, ie. 0.99 for the 99th percentile.
+		 * @return Upper edge of the histogram bucket holding the percentile.
+		*/
+		duration latency_percentile(double _fraction) const noexcept
+		{
+			const auto _target = static_cast<size_t>(_fraction * static_cast<double>(this->executed));
+			size_t _seen = 0;
+			for (size_t n = 0; n != bucket_count; ++n)
+			{
+				_seen += this->latency_histogram[n];
+				if (_seen > _target || _seen == this->executed)
+				{
+					return std::chrono::microseconds{ size_t{ 1 } << n };
+				};
+			};
+			return this->max_latency;
+		};
+	};
+
+	/**
+	 * @brief Runs tasks pushed from any thread on the thread owning the OpenGL context.
+	 *
+	 * Worker threads push closures with push() (giving a gl_future for the result) or post(). The context's
+	 * thread drains the queue with run(), usually once per frame with a time budget so uploads can't stall
+	 * a frame. Tasks run in the order they were pushed. Tasks still queued when the executor is destroyed are
+	 * cancelled without running.
+	 *
+	 * ```
+	 * // asset thread
+	 * auto _texture = _executor.push([]() { return gl::new_texture(gl::texture_target::tex2D); });
+	 * gl::unique_texture _result = std::move(_texture.get().value());
+	 *
+	 * // GL thread, every frame
+	 * _executor.run(std::chrono::milliseconds{ 2 });
+	 * ```
+	*/
+	class gl_executor
+	{
+	private:
+
+		using clock_type = std::chrono::steady_clock;
+
+		struct task_base : mpsc_node
+		{
+			clock_type::time_point queued{};
+
+			/**
+			 * @brief Runs the task.
+			*/
+			virtual void run() = 0;
+
+			/**
+			 * @brief Destroys a task that never ran, cancelling its future.
+			*/
+			virtual ~task_base() = default;
+		};
+
+		template <typename FnT>
+		struct post_task final : task_base
+		{
+			FnT fn;
+
+			void run() override { std::invoke(this->fn); };
+
+			explicit post_task(FnT&& _fn) :
+				fn{ std::move(_fn) }
+			{};
+		};
+
+		template <typename FnT, typename T>
+		struct future_task final : task_base
+		{
+			using value_type = std::conditional_t<std::is_void_v<T>, gl_impl::future_void, T>;
+
+			FnT fn;
+			std::shared_ptr<gl_impl::future_state<value_type>> state;
+			bool ran = false;
+
+			void run() override
+			{
+				if constexpr (std::is_void_v<T>)
+				{
+					std::invoke(this->fn);
+					this->state->value.emplace();
+				}
+				else
+				{
+					this->state->value.emplace(std::invoke(this->fn));
+				};
+				this->ran = true;
+
+				// Nobody will take the result, destroy it here on the context's thread
+				if (this->state->finish(gl_impl::future_status::ready) == gl_impl::future_status::abandoned)
+				{
+					this->state->value.reset();
+				};
+			};
+
+			future_task(FnT&& _fn, std::shared_ptr<gl_impl::future_state<value_type>> _state) :
+				fn{ std::move(_fn) },
+				state{ std::move(_state) }
+			{};
+			~future_task()
+			{
+				if (!this->ran)
+				{
+					this->state->finish(gl_impl::future_status::cancelled);
+				};
+			};
+		};
+
+	public:
+
+		/**
+		 * @brief Queues a function to run on the executor's thread, safe to call from any thread.
+		 * @param _fn Function to invoke with no arguments.
+		 * @return Future for the function's result.
+		*/
+		template <typename FnT>
+		auto push(FnT&& _fn) -> gl_future<std::invoke_result_t<std::decay_t<FnT>&>>
+		{
+			using fn_type = std::decay_t<FnT>;
+			using result_type = std::invoke_result_t<fn_type&>;
+			using value_type = std::conditional_t<std::is_void_v<result_type>, gl_impl::future_void, result_type>;
+
+			auto _state = std::make_shared<gl_impl::future_state<value_type>>();
+			this->enqueue(new future_task<fn_type, result_type>{ fn_type{ std::forward<FnT>(_fn) }, _state });
+			return gl_future<result_type>{ std::move(_state), this };
+		};
+
+		/**
+		 * @brief Queues a function to run on the executor's thread without a future, safe to call from any thread.
+		 * @param _fn Function to invoke with no arguments, its result is discarded.
+		*/
+		template <typename FnT>
+		void post(FnT&& _fn)
+		{
+			using fn_type = std::decay_t<FnT>;
+			this->enqueue(new post_task<fn_type>{ fn_type{ std::forward<FnT>(_fn) } });
+		};
+
+		/**
+		 * @brief Runs queued tasks until the queue is empty or the time budget is used up, only call from the context's thread.
+		 *
+		 * At least one task is run if any are queued so the queue always makes progress. The budget is checked
+		 * between tasks, one long task can overrun it.
+		 *
+		 * @param _budget Time budget for this call.
+		 * @return Number of tasks run.
+		*/
+		size_t run(std::chrono::nanoseconds _budget)
+		{
+			const auto _start = clock_type::now();
+			auto _now = _start;
+			size_t _count = 0;
+			while (true)
+			{
+				const auto _node = this->queue_.pop();
+				if (!_node)
+				{
+					break;
+				};
+
+				std::unique_ptr<task_base> _task{ static_cast<task_base*>(_node) };
+				this->pending_.fetch_sub(1, std::memory_order_relaxed);
+				this->record_latency(_now - _task->queued);
+				_task->run();
+				++_count;
+
+				_now = clock_type::now();
+				if (_now - _start >= _budget)
+				{
+					if (this->pending() != 0)
+					{
+						++this->stats_.budget_exhausted;
+					};
+					break;
+				};
+			};
+
+			this->stats_.last_run_time = std::chrono::duration_cast<std::chrono::nanoseconds>(_now - _start);
+			this->stats_.last_run_count = _count;
+			return _count;
+		};
+
+		/**
+		 * @brief Runs queued tasks until the queue is empty, only call from the context's thread.
+		 * @return Number of tasks run.
+		*/
+		size_t run_all()
+		{
+			return this->run(std::chrono::nanoseconds::max());
+		};
+
+		/**
+		 * @brief Gets the number of queued tasks, safe to call from any thread.
+		*/
+		size_t pending() const noexcept
+		{
+			return this->pending_.load(std::memory_order_relaxed);
+		};
+
+		/**
+		 * @brief Gets the latency and drain statistics, only call from the context's thread.
+		*/
+		const gl_executor_stats& stats() const noexcept { return this->stats_; };
+
+		/**
+		 * @brief Resets the statistics, only call from the context's thread.
+		*/
+		void reset_stats() noexcept { this->stats_ = gl_executor_stats{}; };
+
+		gl_executor() = default;
+
+		/**
+		 * @brief Cancels the tasks still queued, must be called on the context's thread.
+		*/
+		~gl_executor()
+		{
+			while (const auto _node = this->queue_.pop())
+			{
+				delete static_cast<task_base*>(_node);
+			};
+		};
+
+		gl_executor(const gl_executor&) = delete;
+		gl_executor& operator=(const gl_executor&) = delete;
+
+	private:
+
+		void enqueue(task_base* _task) noexcept
+		{
+			_task->queued = clock_type::now();
+			this->pending_.fetch_add(1, std::memory_order_relaxed);
+			this->queue_.push(_task);
+		};
+
+		void record_latency(clock_type::duration _latency) noexcept
+		{
+			const auto _ns = std::chrono::duration_cast<std::chrono::nanoseconds>(_latency);
+			auto& s = this->stats_;
+			++s.executed;
+			s.total_latency += _ns;
+			s.max_latency = std::max(s.max_latency, _ns);
+
+			const auto _us = static_cast<uint64_t>(std::max<int64_t>(_ns.count(), 0)) / 1000;
+			size_t _bucket = 0;
+			while (_bucket + 1 < gl_executor_stats::bucket_count && (uint64_t{ 1 } << _bucket) <= _us)
+			{
+				++_bucket;
+			};
+			++s.latency_histogram[_bucket];
+		};
+
+		mpsc_queue queue_{};
+		std::atomic<size_t> pending_{ 0 };
+		gl_executor_stats stats_{};
+	};
+
+	template <typename T>
+	inline void gl_future<T>::abandon()
+	{
+		if (!this->state_)
+		{
+			return;
+		};
+
+		const auto _prev = this->state_->status.exchange(gl_impl::future_status::abandoned, std::memory_order_acq_rel);
+		if (_prev == gl_impl::future_status::ready && this->state_->value && this->executor_)
+		{
+			// The result is here but unclaimed, hand it back to the context's thread to destroy
+			this->executor_->post([_state = std::move(this->state_)]() { _state->value.reset(); });
+		};
+		this->state_.reset();
+	};
+
+};
+#pragma endregion
+
+#endif // JCLIB_OPENGL_GLEXECUTOR_HPP
@@ -0,0 +1,211 @@
+#pragma once
+#ifndef JCLIB_OPENGL_GLFRAMERING_HPP
+#define JCLIB_OPENGL_GLFRAMERING_HPP
+
+/*
+	N-buffered per-frame resources rotated once the GPU is done reading them
+*/
+
+#include "gl.hpp"
+
+#include <jclib/type.h>
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <utility>
+#include <concepts>
+#include <algorithm>
+#include <type_traits>
+
+#define _JCLIB_OPENGL_GLFRAMERING_
+
+namespace jc::gl
+{
+	/**
+	 * @brief Counters for a frame_ring.
+	*/
+	struct frame_ring_stats
+	{
+		/**
+		 * @brief Number of calls to next_frame().
+		*/
+		size_t rotations = 0;
+
+		/**
+		 * @brief Number of rotations that had to wait for the GPU.
+		*/
+		size_t stalls = 0;
+
+		/**
+		 * @brief Time the last rotation spent waiting.
+		*/
+		std::chrono::nanoseconds last_wait{ 0 };
+
+		/**
+		 * @brief Longest time a rotation spent waiting.
+		*/
+		std::chrono::nanoseconds max_wait{ 0 };
+
+		/**
+		 * @brief Time spent waiting across all rotations.
+		*/
+		std::chrono::nanoseconds total_wait{ 0 };
+	};
+
+	/**
+	 * @brief Holds N copies of a per-frame resource and rotates to the next once the GPU has finished reading it.
+	 *
+	 * Writing to a buffer or texture the GPU is still reading from last frame stalls inside the driver. With a ring
+	 * the CPU writes current() while the GPU reads the copies from earlier frames. next_frame() fences the slot
+	 * just used and moves to the oldest slot, waiting for its fence if the GPU is more than N - 1 frames behind.
+	 * How long each rotation waited is kept in stats().
+	 *
+	 * ```
+	 * gl::frame_ring<gl::unique_vbo, 3> _instances{ [](size_t)
+	 * {
+	 *     auto _vbo = gl::new_vbo();
+	 *     gl::resize_buffer<instance>(_vbo, max_instances, gl::vbo_usage::stream_draw);
+	 *     return _vbo;
+	 * } };
+	 *
+	 * gl::buffer_subdata(_instances.current(), _frameInstances);
+	 * ...
+	 * _instances.next_frame();
+	 * ```
+	 *
+	 * @tparam ResourceT Owning object type, ie. unique_vbo or unique_texture.
+	 * @tparam N Number of copies, at least 1.
+	*/
+	template <typename ResourceT, size_t N>
+	class frame_ring
+	{
+	public:
+		static_assert(N >= 1, "frame_ring needs at least one resource");
+
+		using resource_type = ResourceT;
+
+		/**
+		 * @brief Gets the resource to write this frame.
+		*/
+		resource_type& current() noexcept
+		{
+			return this->resources_[this->index_];
+		};
+		const resource_type& current() const noexcept
+		{
+			return this->resources_[this->index_];
+		};
+
+		/**
+		 * @brief Gets the index of current() within the ring.
+		*/
+		size_t index() const noexcept
+		{
+			return this->index_;
+		};
+
+		/**
+		 * @brief Gets a resource by its index within the ring, ie. to read the previous frame's copy.
+		*/
+		resource_type& operator[](size_t _index) noexcept
+		{
+			JCLIB_ASSERT(_index < N);
+			return this->resources_[_index];
+		};
+		const resource_type& operator[](size_t _index) const noexcept
+		{
+			JCLIB_ASSERT(_index < N);
+			return this->resources_[_index];
+		};
+
+		/**
+		 * @brief Fences the current resource and rotates to the next, waiting until the GPU is done with it.
+		 * @return The new write target.
+		*/
+		resource_type& next_frame()
+		{
+			this->fences_[this->index_] = new_fence();
+			this->index_ = (this->index_ + 1) % N;
+			++this->stats_.rotations;
+
+			auto _waited = std::chrono::nanoseconds{ 0 };
+			auto& _fence = this->fences_[this->index_];
+			if (_fence)
+			{
+				const auto _wait = wait_signaled(_fence);
+				if (_wait.stalled())
+				{
+					++this->stats_.stalls;
+				};
+				_waited = _wait.waited;
+				_fence.reset();
+			};
+
+			this->stats_.last_wait = _waited;
+			this->stats_.max_wait = std::max(this->stats_.max_wait, _waited);
+			this->stats_.total_wait += _waited;
+			return this->current();
+		};
+
+		/**
+		 * @brief Gets the rotation and wait counters.
+		*/
+		const frame_ring_stats& stats() const noexcept
+		{
+			return this->stats_;
+		};
+
+		/**
+		 * @brief Gets the number of resources in the ring.
+		*/
+		constexpr static size_t size() noexcept
+		{
+			return N;
+		};
+
+		/**
+		 * @brief Creates the resources, the context must be current.
+		 * @param _make Called with each index in order, returns that slot's resource.
+		*/
+		template <typename MakeFnT> requires std::invocable<MakeFnT&, size_t> &&
+			std::convertible_to<std::invoke_result_t<MakeFnT&, size_t>, resource_type>
+		explicit frame_ring(MakeFnT&& _make) :
+			resources_{ make_resources(_make, std::make_index_sequence<N>{}) }
+		{};
+
+		frame_ring(const frame_ring&) = delete;
+		frame_ring& operator=(const frame_ring&) = delete;
+
+		frame_ring(frame_ring&&) noexcept = default;
+		frame_ring& operator=(frame_ring&&) noexcept = default;
+
+	private:
+
+		template <typename MakeFnT, size_t... Is>
+		static std::array<resource_type, N> make_resources(MakeFnT& _make, std::index_sequence<Is...>)
+		{
+			// Braced init runs the calls in index order
+			return std::array<resource_type, N>{ resource_type(_make(Is))... };
+		};
+
+		std::array<resource_type, N> resources_;
+		std::array<unique_sync, N> fences_{};
+		size_t index_ = 0;
+		frame_ring_stats stats_{};
+	};
+
+	/**
+	 * @brief Double buffered frame_ring.
+	*/
+	template <typename ResourceT>
+	using double_buffered = frame_ring<ResourceT, 2>;
+
+	/**
+	 * @brief Triple buffered frame_ring.
+	*/
+	template <typename ResourceT>
+	using triple_buffered = frame_ring<ResourceT, 3>;
+};
+
+#endif // JCLIB_OPENGL_GLFRAMERING_HPP
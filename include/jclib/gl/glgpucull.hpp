@@ -0,0 +1,344 @@
+#pragma once
+#ifndef JCLIB_OPENGL_GLGPUCULL_HPP
+#define JCLIB_OPENGL_GLGPUCULL_HPP
+
+/*
+	GPU driven frustum culling that writes indirect draw commands
+*/
+
+#include "gl.hpp"
+#include "glcull.hpp"
+#include "glcaps.hpp"
+
+#include <span>
+#include <array>
+#include <string>
+#include <vector>
+#include <string_view>
+
+#define _JCLIB_OPENGL_GLGPUCULL_
+
+#if GL_VERSION_4_3
+
+#pragma region GPU_CULL_TYPES
+namespace jc::gl
+{
+	/**
+	 * @brief Describes one draw whose instances are culled on the GPU, std430 layout.
+	 *
+	 * Each draw owns the range of the output instance buffer starting at first_instance, the range
+	 * must have room for every instance referencing the draw (see assign_first_instances()).
+	*/
+	struct gpu_cull_draw
+	{
+		gl_unsigned_int count;
+		gl_unsigned_int first_index;
+		gl_int base_vertex;
+		gl_unsigned_int first_instance;
+	};
+
+	/**
+	 * @brief Buffers read and written by a gpu_cull_stage, all are used as shader storage buffers.
+	*/
+	struct gpu_cull_buffers
+	{
+		/**
+		 * @brief Instance bounding spheres as vec4 (xyz center, w radius).
+		*/
+		vbo_id bounds;
+
+		/**
+		 * @brief Index of the gpu_cull_draw each instance belongs to, one gl_unsigned_int per instance.
+		*/
+		vbo_id draw_ids;
+
+		/**
+		 * @brief The gpu_cull_draw descriptions.
+		*/
+		vbo_id draws;
+
+		/**
+		 * @brief Written with one draw_elements_command per draw, bind as vbo_target::draw_indirect to draw.
+		*/
+		vbo_id commands;
+
+		/**
+		 * @brief Written with the indices of the visible instances, one gl_unsigned_int per instance.
+		 *
+		 * Commands set base_instance to the draw's first_instance so this can be bound as an instanced
+		 * vertex attribute (divisor 1) to fetch the visible instance index.
+		*/
+		vbo_id instances;
+	};
+
+	/**
+	 * @brief Output of cull_gpu_reference().
+	*/
+	struct gpu_cull_result
+	{
+		std::vector<draw_elements_command> commands{};
+		std::vector<gl_unsigned_int> instances{};
+	};
+
+	/**
+	 * @brief Sets the first_instance of each draw so every draw gets a packed range big enough for its instances.
+	 * @param _draws Draws to assign ranges to.
+	 * @param _drawIds Draw index of each instance.
+	 * @return Total number of instance slots needed in the output instance buffer.
+	*/
+	inline size_t assign_first_instances(std::span<gpu_cull_draw> _draws, std::span<const gl_unsigned_int> _drawIds)
+	{
+		std::vector<gl_unsigned_int> _counts(_draws.size(), 0);
+		for (auto& d : _drawIds)
+		{
+			JCLIB_ASSERT(d < _draws.size());
+			++_counts[d];
+		};
+
+		gl_unsigned_int _offset = 0;
+		for (size_t n = 0; n != _draws.size(); ++n)
+		{
+			_draws[n].first_instance = _offset;
+			_offset += _counts[n];
+		};
+		return static_cast<size_t>(_offset);
+	};
+
+	/**
+	 * @brief CPU reference of the work done by gpu_cull_stage::dispatch(), for correctness testing.
+	 *
+	 * Visible instances are written in instance order, the GPU appends them in whatever order the
+	 * atomics resolve so sort each draw's instance range before comparing.
+	 *
+	 * @param _frustum Frustum to test against.
+	 * @param _bounds Instance bounding spheres (xyz center, w radius).
+	 * @param _drawIds Draw index of each instance.
+	 * @param _draws Draw descriptions.
+	 * @param _instanceCapacity Size of the output instance buffer.
+	 * @return The commands and instance buffer contents the GPU would produce.
+	*/
+	inline gpu_cull_result cull_gpu_reference(const frustum& _frustum, std::span<const std::array<gl_float, 4>> _bounds,
+		std::span<const gl_unsigned_int> _drawIds, std::span<const gpu_cull_draw> _draws, size_t _instanceCapacity)
+	{
+		JCLIB_ASSERT(_bounds.size() == _drawIds.size());
+
+		gpu_cull_result _out{};
+		_out.commands.reserve(_draws.size());
+		for (auto& d : _draws)
+		{
+			_out.commands.push_back(draw_elements_command{ d.count, 0, d.first_index, d.base_vertex, d.first_instance });
+		};
+		_out.instances.resize(_instanceCapacity, 0);
+
+		for (size_t n = 0; n != _bounds.size(); ++n)
+		{
+			const auto& b = _bounds[n];
+			if (gl_impl::sphere_visible(_frustum, b[0], b[1], b[2], b[3]))
+			{
+				auto& _command = _out.commands[_drawIds[n]];
+				const auto _slot = _command.base_instance + _command.instance_count++;
+				JCLIB_ASSERT(_slot < _instanceCapacity);
+				_out.instances[_slot] = static_cast<gl_unsigned_int>(n);
+			};
+		};
+		return _out;
+	};
+
+};
+#pragma endregion
+
+#pragma region GPU_CULL_STAGE
+namespace jc::gl
+{
+	/**
+	 * @brief Compute program that culls instance bounds against a frustum and writes indirect draw commands.
+	 *
+	 * Runs as two dispatches, the first writes a draw_elements_command with zero instances for each draw,
+	 * the second tests one instance per invocation and appends visible ones to their draw with an atomic
+	 * add on the command's instance_count. The commands can be drawn with multi_draw_elements_indirect()
+	 * without reading anything back.
+	*/
+	class gpu_cull_stage
+	{
+	public:
+
+		/**
+		 * @brief Local work group size of the culling program.
+		*/
+		constexpr static gl_unsigned_int local_size = 64;
+
+		/**
+		 * @brief Shader storage binding points used by the stage, in gpu_cull_buffers member order.
+		*/
+		constexpr static storage_binding_point bounds_binding{ 0 };
+		constexpr static storage_binding_point draw_ids_binding{ 1 };
+		constexpr static storage_binding_point draws_binding{ 2 };
+		constexpr static storage_binding_point commands_binding{ 3 };
+		constexpr static storage_binding_point instances_binding{ 4 };
+
+		/**
+		 * @brief GLSL source of the culling program.
+		*/
+		constexpr static std::string_view source = R"(#version 430 core
+layout(local_size_x = 64) in;
+
+struct draw_elements_command
+{
+	uint count;
+	uint instance_count;
+	uint first_index;
+	int base_vertex;
+	uint base_instance;
+};
+struct cull_draw
+{
+	uint count;
+	uint first_index;
+	int base_vertex;
+	uint first_instance;
+};
+
+layout(std430, binding = 0) readonly buffer cull_bounds { vec4 bounds[]; };
+layout(std430, binding = 1) readonly buffer cull_draw_ids { uint draw_ids[]; };
+layout(std430, binding = 2) readonly buffer cull_draws { cull_draw draws[]; };
+layout(std430, binding = 3) buffer cull_commands { draw_elements_command commands[]; };
+layout(std430, binding = 4) writeonly buffer cull_instances { uint instances[]; };
+
+layout(location = 0) uniform vec4 u_planes[6];
+layout(location = 6) uniform uint u_count;
+layout(location = 7) uniform uint u_phase;
+
+void main()
+{
+	const uint n = gl_GlobalInvocationID.x;
+	if (n >= u_count)
+	{
+		return;
+	};
+
+	if (u_phase == 0u)
+	{
+		const cull_draw d = draws[n];
+		commands[n] = draw_elements_command(d.count, 0u, d.first_index, d.base_vertex, d.first_instance);
+		return;
+	};
+
+	const vec4 b = bounds[n];
+	for (int p = 0; p != 6; ++p)
+	{
+		const vec4 _plane = u_planes[p];
+		if (_plane.x * b.x + _plane.y * b.y + _plane.z * b.z + _plane.w < -b.w)
+		{
+			return;
+		};
+	};
+
+	const uint d = draw_ids[n];
+	const uint _slot = atomicAdd(commands[d].instance_count, 1u);
+	instances[commands[d].base_instance + _slot] = n;
+}
+)";
+
+		/**
+		 * @brief Gets the info log from building the program, empty on success.
+		*/
+		const std::string& info_log() const noexcept { return this->log_; };
+
+		/**
+		 * @brief Gets the culling program.
+		*/
+		program_id program() const noexcept { return this->program_.id(); };
+
+		/**
+		 * @brief Checks if the program was built successfully.
+		*/
+		explicit operator bool() const noexcept { return this->good_; };
+
+		/**
+		 * @brief Culls the instances and writes the draw commands and visible instance indices.
+		 *
+		 * Leaves the program in use and ends with a memory barrier so the outputs may be consumed as
+		 * indirect commands, shader storage or vertex attributes.
+		 *
+		 * Each pass is a single row of work groups, so _instanceCount and _drawCount are limited to
+		 * GL_MAX_COMPUTE_WORK_GROUP_COUNT[0] * local_size (at least 65535 * 64). This is asserted once caps are loaded.
+		 *
+		 * @param _buffers Buffers to read and write.
+		 * @param _frustum Frustum to test against.
+		 * @param _instanceCount Number of instances to cull.
+		 * @param _drawCount Number of draws.
+		*/
+		void dispatch(const gpu_cull_buffers& _buffers, const frustum& _frustum, size_t _instanceCount, size_t _drawCount) const
+		{
+			JCLIB_ASSERT(this->good_);
+
+			const auto _program = this->program_.id();
+			bind(_program);
+
+			bind_buffer_base(bounds_binding, _buffers.bounds);
+			bind_buffer_base(draw_ids_binding, _buffers.draw_ids);
+			bind_buffer_base(draws_binding, _buffers.draws);
+			bind_buffer_base(commands_binding, _buffers.commands);
+			bind_buffer_base(instances_binding, _buffers.instances);
+
+			glProgramUniform4fv(_program.get(), 0, 6, _frustum.planes[0].data());
+
+			glProgramUniform1ui(_program.get(), 6, static_cast<GLuint>(_drawCount));
+			glProgramUniform1ui(_program.get(), 7, 0);
+			dispatch_compute(group_count(_drawCount));
+			memory_barrier(memory_barrier_bit::shader_storage);
+
+			glProgramUniform1ui(_program.get(), 6, static_cast<GLuint>(_instanceCount));
+			glProgramUniform1ui(_program.get(), 7, 1);
+			dispatch_compute(group_count(_instanceCount));
+			memory_barrier(memory_barrier_bit::command | memory_barrier_bit::shader_storage | memory_barrier_bit::vertex_attrib_array);
+		};
+
+		/**
+		 * @brief Compiles and links the culling program, check for success with operator bool.
+		*/
+		gpu_cull_stage() :
+			program_{ new_program() }
+		{
+			const auto _shader = new_shader(shader_type::compute);
+			if (!compile(_shader, source))
+			{
+				this->log_ = get_info_log(_shader);
+				return;
+			};
+
+			const auto _shaders = std::array<shader_id, 1>{ _shader.id() };
+			if (!link(this->program_, _shaders))
+			{
+				this->log_ = get_info_log(this->program_);
+				return;
+			};
+			this->good_ = true;
+		};
+
+	private:
+
+		/**
+		 * @brief Gets the number of work groups for a pass over _count elements.
+		*/
+		static gl_unsigned_int group_count(size_t _count) noexcept
+		{
+			const auto _groups = dispatch_group_count(_count, local_size);
+			if (const auto _caps = context_caps_loaded(); _caps)
+			{
+				JCLIB_ASSERT(_groups <= static_cast<gl_unsigned_int>(_caps->max_compute_work_group_count[0]));
+			};
+			return _groups;
+		};
+
+		unique_program program_;
+		std::string log_{};
+		bool good_ = false;
+	};
+
+};
+#pragma endregion
+
+#endif
+
+#endif // JCLIB_OPENGL_GLGPUCULL_HPP
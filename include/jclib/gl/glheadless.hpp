@@ -0,0 +1,349 @@
+#pragma once
+#ifndef JCLIB_OPENGL_GLHEADLESS_HPP
+#define JCLIB_OPENGL_GLHEADLESS_HPP
+
+/*
+	Headless OpenGL context creation through EGL, link the jcopengl_headless target to use this
+*/
+
+#include "gllib.hpp"
+
+#include <glad/glad.h>
+
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+
+#include <jclib/type.h>
+
+#include <array>
+#include <string>
+#include <utility>
+#include <string_view>
+
+#define _JCLIB_OPENGL_GLHEADLESS_
+
+namespace jc::gl
+{
+	/**
+	 * @brief How a headless context ended up being created.
+	*/
+	enum class headless_platform
+	{
+		/**
+		 * @brief EGL_MESA_platform_surfaceless display, the context is made current without any surface.
+		*/
+		surfaceless,
+
+		/**
+		 * @brief Default EGL display with a small pbuffer surface.
+		*/
+		pbuffer,
+	};
+
+	/**
+	 * @brief Settings for creating a headless_context.
+	*/
+	struct headless_context_settings
+	{
+		GLint major_version = 4;
+		GLint minor_version = 5;
+
+		/**
+		 * @brief Requests a debug context.
+		*/
+		bool debug = false;
+
+		/**
+		 * @brief Makes the context current and loads glad through it on creation.
+		 *
+		 * Set to false for contexts that will be made current on another thread.
+		*/
+		bool make_current = true;
+
+		/**
+		 * @brief Size of the pbuffer used when surfaceless contexts are not available.
+		*/
+		EGLint pbuffer_width = 1;
+		EGLint pbuffer_height = 1;
+	};
+
+	namespace gl_impl
+	{
+		/**
+		 * @brief Checks if a space separated EGL extension string contains an extension.
+		*/
+		inline bool has_egl_extension(const char* _extensions, std::string_view _name) noexcept
+		{
+			if (!_extensions)
+			{
+				return false;
+			};
+
+			auto _list = std::string_view{ _extensions };
+			while (!_list.empty())
+			{
+				const auto _end = _list.find(' ');
+				if (_list.substr(0, _end) == _name)
+				{
+					return true;
+				};
+				if (_end == std::string_view::npos)
+				{
+					break;
+				};
+				_list.remove_prefix(_end + 1);
+			};
+			return false;
+		};
+	};
+
+	/**
+	 * @brief Loads the OpenGL functions through EGL for the context current on this thread.
+	 * @return True on good load, false otherwise.
+	*/
+	inline bool load_headless_functions()
+	{
+		return gladLoadGLLoader(reinterpret_cast<GLADloadproc>(eglGetProcAddress)) != 0;
+	};
+
+	/**
+	 * @brief Owning handle to an OpenGL core context that does not need a window system.
+	 *
+	 * Uses an EGL_MESA_platform_surfaceless display when available and falls back to the default
+	 * display with a pbuffer surface. With Mesa's llvmpipe driver this gives a fully CPU rendered
+	 * context for tests and benchmarks.
+	 *
+	 * Check for success with operator bool, error() describes the failure otherwise.
+	*/
+	class headless_context
+	{
+	public:
+
+		/**
+		 * @brief Makes the context current on the calling thread.
+		 * @return True on success, false otherwise.
+		*/
+		bool make_current() const
+		{
+			JCLIB_ASSERT(this->context_ != EGL_NO_CONTEXT);
+			return eglMakeCurrent(this->display_, this->surface_, this->surface_, this->context_) == EGL_TRUE;
+		};
+
+		/**
+		 * @brief Releases whatever context is current on the calling thread.
+		*/
+		void release_current() const
+		{
+			eglMakeCurrent(this->display_, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+		};
+
+		/**
+		 * @brief Gets how the context was created.
+		*/
+		headless_platform platform() const noexcept { return this->platform_; };
+
+		/**
+		 * @brief Gets the EGL display the context was created on.
+		*/
+		EGLDisplay display() const noexcept { return this->display_; };
+
+		/**
+		 * @brief Gets the raw EGL context.
+		*/
+		EGLContext native_handle() const noexcept { return this->context_; };
+
+		/**
+		 * @brief Gets the reason creation failed, empty on success.
+		*/
+		const std::string& error() const noexcept { return this->error_; };
+
+		/**
+		 * @brief Checks if the context was created.
+		*/
+		explicit operator bool() const noexcept { return this->context_ != EGL_NO_CONTEXT; };
+
+		/**
+		 * @brief Creates a headless context.
+		 * @param _settings Context settings.
+		 * @param _share Context to share objects with, the new context is created on the same display. May be null.
+		*/
+		explicit headless_context(const headless_context_settings& _settings = {}, const headless_context* _share = nullptr)
+		{
+			if (_share)
+			{
+				JCLIB_ASSERT(*_share);
+				this->display_ = _share->display_;
+				this->platform_ = _share->platform_;
+			}
+			else if (!this->open_display())
+			{
+				return;
+			};
+
+			if (eglBindAPI(EGL_OPENGL_API) != EGL_TRUE)
+			{
+				this->error_ = "eglBindAPI(EGL_OPENGL_API) failed";
+				return;
+			};
+
+			const EGLint _surfaceType = (this->platform_ == headless_platform::pbuffer) ? EGL_PBUFFER_BIT : 0;
+			const std::array<EGLint, 5> _configAttribs
+			{
+				EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+				EGL_SURFACE_TYPE, _surfaceType,
+				EGL_NONE
+			};
+
+			EGLConfig _config{};
+			EGLint _configCount = 0;
+			if (eglChooseConfig(this->display_, _configAttribs.data(), &_config, 1, &_configCount) != EGL_TRUE || _configCount == 0)
+			{
+				this->error_ = "no EGL config supports desktop OpenGL";
+				return;
+			};
+
+			const std::array<EGLint, 9> _contextAttribs
+			{
+				EGL_CONTEXT_MAJOR_VERSION, _settings.major_version,
+				EGL_CONTEXT_MINOR_VERSION, _settings.minor_version,
+				EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+				EGL_CONTEXT_OPENGL_DEBUG, _settings.debug ? EGL_TRUE : EGL_FALSE,
+				EGL_NONE
+			};
+
+			const auto _shareContext = (_share) ? _share->context_ : EGL_NO_CONTEXT;
+			this->context_ = eglCreateContext(this->display_, _config, _shareContext, _contextAttribs.data());
+			if (this->context_ == EGL_NO_CONTEXT)
+			{
+				this->error_ = "eglCreateContext failed for the requested OpenGL version";
+				return;
+			};
+
+			if (this->platform_ == headless_platform::pbuffer)
+			{
+				const std::array<EGLint, 5> _surfaceAttribs
+				{
+					EGL_WIDTH, _settings.pbuffer_width,
+					EGL_HEIGHT, _settings.pbuffer_height,
+					EGL_NONE
+				};
+				this->surface_ = eglCreatePbufferSurface(this->display_, _config, _surfaceAttribs.data());
+				if (this->surface_ == EGL_NO_SURFACE)
+				{
+					this->error_ = "eglCreatePbufferSurface failed";
+					this->destroy();
+					return;
+				};
+			};
+
+			if (_settings.make_current)
+			{
+				if (!this->make_current())
+				{
+					this->error_ = "eglMakeCurrent failed";
+					this->destroy();
+					return;
+				};
+				if (!load_headless_functions())
+				{
+					this->error_ = "failed to load OpenGL functions through eglGetProcAddress";
+					this->destroy();
+					return;
+				};
+			};
+		};
+
+		headless_context(headless_context&& other) noexcept :
+			display_{ std::exchange(other.display_, EGL_NO_DISPLAY) },
+			context_{ std::exchange(other.context_, EGL_NO_CONTEXT) },
+			surface_{ std::exchange(other.surface_, EGL_NO_SURFACE) },
+			platform_{ other.platform_ },
+			error_{ std::move(other.error_) }
+		{};
+		headless_context& operator=(headless_context&& other) noexcept
+		{
+			if (this != &other)
+			{
+				this->destroy();
+				this->display_ = std::exchange(other.display_, EGL_NO_DISPLAY);
+				this->context_ = std::exchange(other.context_, EGL_NO_CONTEXT);
+				this->surface_ = std::exchange(other.surface_, EGL_NO_SURFACE);
+				this->platform_ = other.platform_;
+				this->error_ = std::move(other.error_);
+			};
+			return *this;
+		};
+
+		/**
+		 * @brief Destroys the context, the display is left initialized as other contexts may still be using it.
+		*/
+		~headless_context()
+		{
+			this->destroy();
+		};
+
+	private:
+
+		bool open_display()
+		{
+			const auto _clientExtensions = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+			if (gl_impl::has_egl_extension(_clientExtensions, "EGL_MESA_platform_surfaceless") &&
+				gl_impl::has_egl_extension(_clientExtensions, "EGL_EXT_platform_base"))
+			{
+				const auto _getPlatformDisplay = reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(
+					eglGetProcAddress("eglGetPlatformDisplayEXT"));
+				if (_getPlatformDisplay)
+				{
+					const auto _display = _getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+					if (_display != EGL_NO_DISPLAY && eglInitialize(_display, nullptr, nullptr) == EGL_TRUE &&
+						gl_impl::has_egl_extension(eglQueryString(_display, EGL_EXTENSIONS), "EGL_KHR_surfaceless_context"))
+					{
+						this->display_ = _display;
+						this->platform_ = headless_platform::surfaceless;
+						return true;
+					};
+				};
+			};
+
+			const auto _display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+			if (_display == EGL_NO_DISPLAY || eglInitialize(_display, nullptr, nullptr) != EGL_TRUE)
+			{
+				this->error_ = "failed to initialize an EGL display";
+				return false;
+			};
+			this->display_ = _display;
+			this->platform_ = headless_platform::pbuffer;
+			return true;
+		};
+
+		void destroy() noexcept
+		{
+			if (this->context_ != EGL_NO_CONTEXT)
+			{
+				if (eglGetCurrentContext() == this->context_)
+				{
+					this->release_current();
+				};
+				eglDestroyContext(this->display_, this->context_);
+				this->context_ = EGL_NO_CONTEXT;
+			};
+			if (this->surface_ != EGL_NO_SURFACE)
+			{
+				eglDestroySurface(this->display_, this->surface_);
+				this->surface_ = EGL_NO_SURFACE;
+			};
+		};
+
+		EGLDisplay display_ = EGL_NO_DISPLAY;
+		EGLContext context_ = EGL_NO_CONTEXT;
+		EGLSurface surface_ = EGL_NO_SURFACE;
+		headless_platform platform_ = headless_platform::surfaceless;
+		std::string error_{};
+
+		headless_context(const headless_context&) = delete;
+		headless_context& operator=(const headless_context&) = delete;
+	};
+
+};
+
+#endif // JCLIB_OPENGL_GLHEADLESS_HPP
@@ -0,0 +1,599 @@
+#pragma once
+#ifndef JCLIB_OPENGL_GLINDEX_HPP
+#define JCLIB_OPENGL_GLINDEX_HPP
+
+/*
+	CPU side index buffer optimization, intended to be run before uploading with buffer_data
+*/
+
+#include "gl.hpp"
+#include "glenum.hpp"
+#include "glthread.hpp"
+
+#include <jclib/type.h>
+#include <jclib/concepts.h>
+
+#include <span>
+#include <array>
+#include <cmath>
+#include <vector>
+#include <limits>
+#include <cstring>
+#include <numeric>
+#include <algorithm>
+
+#define _JCLIB_OPENGL_GLINDEX_
+
+#pragma region INDEX_METRICS
+namespace jc::gl
+{
+	/**
+	 * @brief Post transform vertex cache statistics for an index buffer.
+	*/
+	struct index_metrics
+	{
+		/**
+		 * @brief Average cache miss ratio, transformed vertices per triangle. Best case is ~0.5.
+		*/
+		double acmr = 0.0;
+
+		/**
+		 * @brief Average transform to vertex ratio, transformed vertices per referenced vertex. Best case is 1.0.
+		*/
+		double atvr = 0.0;
+	};
+
+	/**
+	 * @brief Default simulated post transform cache size.
+	*/
+	constexpr inline size_t default_vertex_cache_size = 16;
+
+	/**
+	 * @brief Simulates a FIFO post transform cache over a triangle list.
+	 * @param _indices Triangle list indices.
+	 * @param _vertexCount Number of vertices referenced by the indices.
+	 * @param _cacheSize Number of cache entries to simulate.
+	 * @return ACMR and ATVR for the index buffer.
+	*/
+	inline index_metrics compute_index_metrics(std::span<const gl_unsigned_int> _indices, size_t _vertexCount,
+		size_t _cacheSize = default_vertex_cache_size)
+	{
+		index_metrics _out{};
+		const auto _triangleCount = _indices.size() / 3;
+		if (_triangleCount == 0)
+		{
+			return _out;
+		};
+
+		// Vertex -> time it entered the cache, a vertex is cached if it entered within the last _cacheSize misses
+		std::vector<size_t> _entered(_vertexCount, 0);
+		std::vector<bool> _referenced(_vertexCount, false);
+		size_t _time = _cacheSize + 1;
+		size_t _misses = 0;
+		size_t _unique = 0;
+
+		for (auto& _index : _indices)
+		{
+			JCLIB_ASSERT(_index < _vertexCount);
+			if (_time - _entered[_index] > _cacheSize)
+			{
+				_entered[_index] = _time++;
+				++_misses;
+			};
+			if (!_referenced[_index])
+			{
+				_referenced[_index] = true;
+				++_unique;
+			};
+		};
+
+		_out.acmr = static_cast<double>(_misses) / static_cast<double>(_triangleCount);
+		_out.atvr = static_cast<double>(_misses) / static_cast<double>(_unique);
+		return _out;
+	};
+
+};
+#pragma endregion
+
+#pragma region INDEX_OPTIMIZATION
+namespace jc::gl
+{
+	/**
+	 * @brief Result of vertex cache optimization.
+	*/
+	struct vertex_cache_result
+	{
+		/**
+		 * @brief Reordered triangle list indices.
+		*/
+		std::vector<gl_unsigned_int> indices{};
+
+		/**
+		 * @brief First triangle of each cluster, clusters start where the cache was effectively flushed.
+		*/
+		std::vector<size_t> clusters{};
+	};
+
+	/**
+	 * @brief Reorders triangles for post transform vertex cache locality using Tipsify.
+	 *
+	 * See "Fast Triangle Reordering for Vertex Locality and Reduced Overdraw" (Sander, Nehab, Barczak 2007).
+	 * Runs in linear time and is not tied to an exact cache size.
+	 *
+	 * @param _indices Triangle list indices.
+	 * @param _vertexCount Number of vertices referenced by the indices.
+	 * @param _cacheSize Target cache size.
+	 * @return Reordered indices and cluster boundaries for optimize_overdraw().
+	*/
+	inline vertex_cache_result optimize_vertex_cache(std::span<const gl_unsigned_int> _indices, size_t _vertexCount,
+		size_t _cacheSize = default_vertex_cache_size)
+	{
+		vertex_cache_result _out{};
+		const auto _triangleCount = _indices.size() / 3;
+		_out.indices.reserve(_triangleCount * 3);
+		if (_triangleCount == 0)
+		{
+			return _out;
+		};
+
+		// Vertex -> adjacent triangles (compressed rows)
+		std::vector<size_t> _live(_vertexCount, 0);
+		for (auto& _index : _indices)
+		{
+			JCLIB_ASSERT(_index < _vertexCount);
+			++_live[_index];
+		};
+		std::vector<size_t> _offsets(_vertexCount + 1, 0);
+		std::inclusive_scan(_live.begin(), _live.end(), _offsets.begin() + 1);
+		std::vector<size_t> _adjacency(_indices.size());
+		{
+			std::vector<size_t> _cursor(_offsets.begin(), _offsets.end() - 1);
+			for (size_t n = 0; n != _indices.size(); ++n)
+			{
+				_adjacency[_cursor[_indices[n]]++] = n / 3;
+			};
+		};
+
+		std::vector<size_t> _cacheTime(_vertexCount, 0);
+		std::vector<bool> _emitted(_triangleCount, false);
+		std::vector<gl_unsigned_int> _deadEnd{};
+		std::vector<gl_unsigned_int> _candidates{};
+
+		size_t _time = _cacheSize + 1;
+		size_t _cursor = 0;
+
+		// Finds a vertex with live triangles when the current fan has no good candidates
+		const auto _skipDeadEnd = [&]() -> size_t
+		{
+			while (!_deadEnd.empty())
+			{
+				const auto _v = _deadEnd.back();
+				_deadEnd.pop_back();
+				if (_live[_v] > 0)
+				{
+					return _v;
+				};
+			};
+			for (; _cursor != _vertexCount; ++_cursor)
+			{
+				if (_live[_cursor] > 0)
+				{
+					return _cursor;
+				};
+			};
+			return _vertexCount;
+		};
+
+		size_t _fan = _skipDeadEnd();
+		_out.clusters.push_back(0);
+
+		while (_fan != _vertexCount)
+		{
+			// Emit every remaining triangle around the fanning vertex
+			_candidates.clear();
+			for (auto a = _offsets[_fan]; a != _offsets[_fan + 1]; ++a)
+			{
+				const auto _triangle = _adjacency[a];
+				if (_emitted[_triangle])
+				{
+					continue;
+				};
+				for (size_t c = 0; c != 3; ++c)
+				{
+					const auto _v = _indices[_triangle * 3 + c];
+					_out.indices.push_back(_v);
+					_deadEnd.push_back(_v);
+					_candidates.push_back(_v);
+					--_live[_v];
+					if (_time - _cacheTime[_v] > _cacheSize)
+					{
+						_cacheTime[_v] = _time++;
+					};
+				};
+				_emitted[_triangle] = true;
+			};
+
+			// Pick the next fan among the candidates still in the cache after emitting their triangles
+			size_t _best = _vertexCount;
+			size_t _bestPriority = 0;
+			bool _hasPriority = false;
+			for (auto& _v : _candidates)
+			{
+				if (_live[_v] == 0)
+				{
+					continue;
+				};
+				size_t _priority = 0;
+				if (_time - _cacheTime[_v] + 2 * _live[_v] <= _cacheSize)
+				{
+					_priority = _time - _cacheTime[_v];
+				};
+				if (!_hasPriority || _priority > _bestPriority)
+				{
+					_hasPriority = true;
+					_bestPriority = _priority;
+					_best = _v;
+				};
+			};
+
+			if (_best == _vertexCount)
+			{
+				_best = _skipDeadEnd();
+
+				// The cache no longer helps us here, start a new cluster
+				const auto _emittedCount = _out.indices.size() / 3;
+				if (_best != _vertexCount && _emittedCount != _out.clusters.back())
+				{
+					_out.clusters.push_back(_emittedCount);
+				};
+			};
+			_fan = _best;
+		};
+
+		return _out;
+	};
+
+	/**
+	 * @brief Reorders the clusters of a vertex cache optimized index buffer to reduce overdraw.
+	 *
+	 * Clusters facing away from the mesh center are drawn first as they are the most likely to occlude
+	 * the rest of the mesh. Triangle order within each cluster is preserved so the cache locality is kept.
+	 *
+	 * @param _result Output of optimize_vertex_cache(), modified in place.
+	 * @param _positions Vertex positions, 3 floats per vertex.
+	*/
+	inline void optimize_overdraw(vertex_cache_result& _result, std::span<const gl_float> _positions)
+	{
+		const auto _triangleCount = _result.indices.size() / 3;
+		const auto _clusterCount = _result.clusters.size();
+		if (_clusterCount < 2 || _positions.empty())
+		{
+			return;
+		};
+
+		const auto _vertex = [&_positions](gl_unsigned_int _index)
+		{
+			const auto _p = _positions.data() + _index * 3;
+			return std::array<double, 3>{ _p[0], _p[1], _p[2] };
+		};
+
+		// Area weighted centroid and normal for each cluster, plus the mesh centroid
+		std::vector<std::array<double, 3>> _centroids(_clusterCount);
+		std::vector<std::array<double, 3>> _normals(_clusterCount);
+		std::array<double, 3> _meshCentroid{};
+		double _meshArea = 0.0;
+
+		for (size_t c = 0; c != _clusterCount; ++c)
+		{
+			const auto _begin = _result.clusters[c];
+			const auto _end = (c + 1 != _clusterCount) ? _result.clusters[c + 1] : _triangleCount;
+
+			std::array<double, 3> _centroid{};
+			std::array<double, 3> _normal{};
+			double _area = 0.0;
+			for (auto t = _begin; t != _end; ++t)
+			{
+				const auto a = _vertex(_result.indices[t * 3 + 0]);
+				const auto b = _vertex(_result.indices[t * 3 + 1]);
+				const auto d = _vertex(_result.indices[t * 3 + 2]);
+				const std::array<double, 3> _e0{ b[0] - a[0], b[1] - a[1], b[2] - a[2] };
+				const std::array<double, 3> _e1{ d[0] - a[0], d[1] - a[1], d[2] - a[2] };
+				const std::array<double, 3> _n
+				{
+					_e0[1] * _e1[2] - _e0[2] * _e1[1],
+					_e0[2] * _e1[0] - _e0[0] * _e1[2],
+					_e0[0] * _e1[1] - _e0[1] * _e1[0]
+				};
+				const auto _triArea = std::sqrt(_n[0] * _n[0] + _n[1] * _n[1] + _n[2] * _n[2]);
+				for (size_t i = 0; i != 3; ++i)
+				{
+					_centroid[i] += (a[i] + b[i] + d[i]) * (_triArea / 3.0);
+					_normal[i] += _n[i];
+				};
+				_area += _triArea;
+			};
+
+			for (size_t i = 0; i != 3; ++i)
+			{
+				_meshCentroid[i] += _centroid[i];
+				_centroids[c][i] = (_area > 0.0) ? (_centroid[i] / _area) : 0.0;
+				_normals[c][i] = _normal[i];
+			};
+			_meshArea += _area;
+		};
+		for (auto& v : _meshCentroid)
+		{
+			v = (_meshArea > 0.0) ? (v / _meshArea) : 0.0;
+		};
+
+		std::vector<double> _sortKey(_clusterCount);
+		for (size_t c = 0; c != _clusterCount; ++c)
+		{
+			double _dot = 0.0;
+			for (size_t i = 0; i != 3; ++i)
+			{
+				_dot += (_centroids[c][i] - _meshCentroid[i]) * _normals[c][i];
+			};
+			_sortKey[c] = _dot;
+		};
+
+		std::vector<size_t> _order(_clusterCount);
+		std::iota(_order.begin(), _order.end(), size_t{ 0 });
+		std::stable_sort(_order.begin(), _order.end(), [&_sortKey](size_t lhs, size_t rhs)
+		{
+			return _sortKey[lhs] > _sortKey[rhs];
+		});
+
+		std::vector<gl_unsigned_int> _indices{};
+		std::vector<size_t> _clusters{};
+		_indices.reserve(_result.indices.size());
+		_clusters.reserve(_clusterCount);
+		for (auto& c : _order)
+		{
+			const auto _begin = _result.clusters[c];
+			const auto _end = (c + 1 != _clusterCount) ? _result.clusters[c + 1] : _triangleCount;
+			_clusters.push_back(_indices.size() / 3);
+			_indices.insert(_indices.end(), _result.indices.begin() + _begin * 3, _result.indices.begin() + _end * 3);
+		};
+
+		_result.indices = std::move(_indices);
+		_result.clusters = std::move(_clusters);
+	};
+
+	/**
+	 * @brief Reorders vertices into the order they are first referenced, improving vertex fetch locality.
+	 *
+	 * The indices are remapped in place. Unreferenced vertices are moved to the end.
+	 *
+	 * @param _indices Triangle list indices, remapped in place.
+	 * @param _vertexCount Number of vertices referenced by the indices.
+	 * @return Remap table where remap[old vertex] = new vertex, use with remap_vertices().
+	*/
+	inline std::vector<gl_unsigned_int> optimize_vertex_fetch(std::span<gl_unsigned_int> _indices, size_t _vertexCount)
+	{
+		constexpr auto _unset = std::numeric_limits<gl_unsigned_int>::max();
+		std::vector<gl_unsigned_int> _remap(_vertexCount, _unset);
+
+		gl_unsigned_int _next = 0;
+		for (auto& _index : _indices)
+		{
+			auto& _mapped = _remap[_index];
+			if (_mapped == _unset)
+			{
+				_mapped = _next++;
+			};
+			_index = _mapped;
+		};
+		for (auto& _mapped : _remap)
+		{
+			if (_mapped == _unset)
+			{
+				_mapped = _next++;
+			};
+		};
+
+		return _remap;
+	};
+
+	/**
+	 * @brief Reorders a vertex buffer using a remap table from optimize_vertex_fetch().
+	 * @param _vertices Source vertex data, must hold remap.size() vertices.
+	 * @param _strideBytes Size of each vertex in bytes.
+	 * @param _remap Remap table where remap[old vertex] = new vertex.
+	 * @return Reordered vertex data.
+	*/
+	inline std::vector<std::byte> remap_vertices(std::span<const std::byte> _vertices, size_t _strideBytes,
+		std::span<const gl_unsigned_int> _remap)
+	{
+		JCLIB_ASSERT(_vertices.size() == _remap.size() * _strideBytes);
+		std::vector<std::byte> _out(_vertices.size());
+		for (size_t n = 0; n != _remap.size(); ++n)
+		{
+			std::memcpy(_out.data() + _remap[n] * _strideBytes, _vertices.data() + n * _strideBytes, _strideBytes);
+		};
+		return _out;
+	};
+
+	/**
+	 * @brief Reorders a vertex buffer using a remap table from optimize_vertex_fetch().
+	 * @param _vertices Source vertices, must hold remap.size() vertices.
+	 * @param _remap Remap table where remap[old vertex] = new vertex.
+	 * @return Reordered vertices.
+	*/
+	template <typename T> requires std::is_trivially_copyable_v<T>
+	inline std::vector<T> remap_vertices(std::span<const T> _vertices, std::span<const gl_unsigned_int> _remap)
+	{
+		JCLIB_ASSERT(_vertices.size() == _remap.size());
+		std::vector<T> _out(_vertices.size());
+		for (size_t n = 0; n != _remap.size(); ++n)
+		{
+			_out[_remap[n]] = _vertices[n];
+		};
+		return _out;
+	};
+
+};
+#pragma endregion
+
+#pragma region INDEX_BUFFER
+namespace jc::gl
+{
+	/**
+	 * @brief Index data using the narrowest typecode that can address every vertex.
+	*/
+	struct index_buffer
+	{
+		/**
+		 * @brief Index typecode, pass to draw_elements().
+		*/
+		typecode type = typecode::gl_unsigned_int;
+
+		/**
+		 * @brief Number of indices, pass to draw_elements().
+		*/
+		size_t count = 0;
+
+		/**
+		 * @brief Raw index data, pass to buffer_data().
+		*/
+		std::vector<std::byte> data{};
+	};
+
+	/**
+	 * @brief Gets the narrowest index typecode that can address a number of vertices.
+	 * @param _vertexCount Number of vertices.
+	 * @return gl_unsigned_short if every index fits in 16 bits, gl_unsigned_int otherwise.
+	*/
+	constexpr inline typecode select_index_typecode(size_t _vertexCount) noexcept
+	{
+		constexpr auto _maxShort = static_cast<size_t>(std::numeric_limits<gl_unsigned_short>::max());
+		return (_vertexCount <= _maxShort + 1) ? typecode::gl_unsigned_short : typecode::gl_unsigned_int;
+	};
+
+	/**
+	 * @brief Packs indices into an index buffer using the narrowest possible typecode.
+	 * @param _indices Triangle list indices.
+	 * @param _vertexCount Number of vertices referenced by the indices.
+	 * @return Index buffer data ready for upload.
+	*/
+	inline index_buffer make_index_buffer(std::span<const gl_unsigned_int> _indices, size_t _vertexCount)
+	{
+		index_buffer _out{};
+		_out.type = select_index_typecode(_vertexCount);
+		_out.count = _indices.size();
+
+		if (_out.type == typecode::gl_unsigned_short)
+		{
+			_out.data.resize(_indices.size() * sizeof(gl_unsigned_short));
+			const auto _dst = reinterpret_cast<gl_unsigned_short*>(_out.data.data());
+			std::transform(_indices.begin(), _indices.end(), _dst, [](gl_unsigned_int v)
+			{
+				return static_cast<gl_unsigned_short>(v);
+			});
+		}
+		else
+		{
+			_out.data.resize(_indices.size() * sizeof(gl_unsigned_int));
+			std::memcpy(_out.data.data(), _indices.data(), _out.data.size());
+		};
+
+		return _out;
+	};
+
+};
+#pragma endregion
+
+#pragma region INDEX_PIPELINE
+namespace jc::gl
+{
+	/**
+	 * @brief Input mesh for optimize_indices().
+	*/
+	struct index_optimize_input
+	{
+		/**
+		 * @brief Triangle list indices in authoring order.
+		*/
+		std::span<const gl_unsigned_int> indices{};
+
+		/**
+		 * @brief Number of vertices in the mesh.
+		*/
+		size_t vertex_count = 0;
+
+		/**
+		 * @brief Vertex positions, 3 floats per vertex. If empty overdraw optimization is skipped.
+		*/
+		std::span<const gl_float> positions{};
+
+		/**
+		 * @brief Simulated post transform cache size.
+		*/
+		size_t cache_size = default_vertex_cache_size;
+	};
+
+	/**
+	 * @brief Output of optimize_indices().
+	*/
+	struct index_optimize_result
+	{
+		/**
+		 * @brief Optimized index data ready for upload.
+		*/
+		index_buffer indices{};
+
+		/**
+		 * @brief Remap table where remap[old vertex] = new vertex, apply to each vertex stream with remap_vertices().
+		*/
+		std::vector<gl_unsigned_int> remap{};
+
+		/**
+		 * @brief Cache metrics of the input indices.
+		*/
+		index_metrics before{};
+
+		/**
+		 * @brief Cache metrics of the optimized indices.
+		*/
+		index_metrics after{};
+	};
+
+	/**
+	 * @brief Runs vertex cache, overdraw, and vertex fetch optimization over a mesh.
+	 * @param _input Mesh to optimize.
+	 * @return Optimized index buffer, vertex remap table, and metrics.
+	*/
+	inline index_optimize_result optimize_indices(const index_optimize_input& _input)
+	{
+		index_optimize_result _out{};
+		_out.before = compute_index_metrics(_input.indices, _input.vertex_count, _input.cache_size);
+
+		auto _ordered = optimize_vertex_cache(_input.indices, _input.vertex_count, _input.cache_size);
+		optimize_overdraw(_ordered, _input.positions);
+		_out.remap = optimize_vertex_fetch(_ordered.indices, _input.vertex_count);
+
+		_out.after = compute_index_metrics(_ordered.indices, _input.vertex_count, _input.cache_size);
+		_out.indices = make_index_buffer(_ordered.indices, _input.vertex_count);
+		return _out;
+	};
+
+	/**
+	 * @brief Optimizes many meshes in parallel.
+	 * @param _inputs Meshes to optimize.
+	 * @param _pool Thread pool to run on.
+	 * @return Optimization results in the same order as the inputs.
+	*/
+	inline std::vector<index_optimize_result> optimize_indices(std::span<const index_optimize_input> _inputs, thread_pool& _pool)
+	{
+		std::vector<index_optimize_result> _out(_inputs.size());
+		_pool.parallel_for(_inputs.size(), [&_inputs, &_out](size_t n)
+		{
+			_out[n] = optimize_indices(_inputs[n]);
+		});
+		return _out;
+	};
+
+};
+#pragma endregion
+
+#endif // JCLIB_OPENGL_GLINDEX_HPP
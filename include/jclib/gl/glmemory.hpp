@@ -0,0 +1,522 @@
+#pragma once
+#ifndef JCLIB_OPENGL_GLMEMORY_HPP
+#define JCLIB_OPENGL_GLMEMORY_HPP
+
+/*
+	Accounting of the video memory allocated through the library's buffer, texture and renderbuffer storage functions.
+
+	JCLIB_OPENGL_MEMORY_TRACKING_V defaults to JCLIB_DEBUG_V and can be predefined to force tracking on in release
+	builds. When false the hooks have empty bodies and every report is empty, so release builds see 0 bytes unless
+	tracking was forced on. Code that relies on the numbers should static_assert on memory_tracking_enabled. Only
+	the DSA storage functions are tracked, storage set through a bound target is not. Sizes are estimates from the
+	requested storage, drivers may pad or compress.
+*/
+
+#include "gllib.hpp"
+#include "glenum.hpp"
+
+#include <jclib/config.h>
+
+#include <array>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <string_view>
+#include <unordered_map>
+
+#if !defined(JCLIB_OPENGL_MEMORY_TRACKING_V)
+#define JCLIB_OPENGL_MEMORY_TRACKING_V JCLIB_DEBUG_V
+#endif
+
+#define _JCLIB_OPENGL_GLMEMORY_
+
+namespace jc::gl
+{
+	/**
+	 * @brief True if allocations are tracked, use in a static_assert to require JCLIB_OPENGL_MEMORY_TRACKING_V.
+	 *
+	 * ```
+	 * static_assert(gl::memory_tracking_enabled, "the streaming budget needs JCLIB_OPENGL_MEMORY_TRACKING_V");
+	 * ```
+	*/
+	constexpr inline bool memory_tracking_enabled = JCLIB_OPENGL_MEMORY_TRACKING_V;
+
+	/**
+	 * @brief Kinds of allocation tracked, usable as an index.
+	*/
+	enum class memory_category : uint8_t
+	{
+		buffer,
+		texture,
+		renderbuffer,
+		count_
+	};
+
+	constexpr inline std::string_view to_string(memory_category _category) noexcept
+	{
+		switch (_category)
+		{
+		case memory_category::buffer: return "buffer";
+		case memory_category::texture: return "texture";
+		case memory_category::renderbuffer: return "renderbuffer";
+		default: return "unknown";
+		};
+	};
+
+	/**
+	 * @brief Gets the size of one texel of an internal format in bytes.
+	 *
+	 * Formats that aren't byte aligned (rgb4, rgb5) and depth24 are rounded up to what drivers store.
+	*/
+	constexpr inline size_t bytes_per_texel(internal_format _format) noexcept
+	{
+		using enum internal_format;
+		switch (_format)
+		{
+		case r8: [[fallthrough]];
+		case r8i: [[fallthrough]];
+		case r8ui: [[fallthrough]];
+		case stencil_index8:
+			return 1;
+
+		case r16: [[fallthrough]];
+		case r16f: [[fallthrough]];
+		case r16i: [[fallthrough]];
+		case r16ui: [[fallthrough]];
+		case rg8: [[fallthrough]];
+		case rg8i: [[fallthrough]];
+		case rg8ui: [[fallthrough]];
+		case rgb4: [[fallthrough]];
+		case rgb5: [[fallthrough]];
+		case depth_component16:
+			return 2;
+
+		case rgb8: [[fallthrough]];
+		case rgb8i: [[fallthrough]];
+		case rgb8ui: [[fallthrough]];
+		case rgb8_snorm:
+			return 3;
+
+		case r32f: [[fallthrough]];
+		case r32i: [[fallthrough]];
+		case r32ui: [[fallthrough]];
+		case rg16: [[fallthrough]];
+		case rg16f: [[fallthrough]];
+		case rg16i: [[fallthrough]];
+		case rg16ui: [[fallthrough]];
+		case rgba8: [[fallthrough]];
+		case rgba8i: [[fallthrough]];
+		case rgba8ui: [[fallthrough]];
+		case depth_component24: [[fallthrough]];
+		case depth_component32f: [[fallthrough]];
+		case depth24_stencil8:
+			return 4;
+
+		case rgb16: [[fallthrough]];
+		case rgb16f: [[fallthrough]];
+		case rgb16i: [[fallthrough]];
+		case rgb16ui: [[fallthrough]];
+		case rgb16_snorm:
+			return 6;
+
+		case rg32f: [[fallthrough]];
+		case rg32i: [[fallthrough]];
+		case rg32ui: [[fallthrough]];
+		case rgba16: [[fallthrough]];
+		case rgba16f: [[fallthrough]];
+		case rgba16i: [[fallthrough]];
+		case rgba16ui: [[fallthrough]];
+		case depth32f_stencil8:
+			return 8;
+
+		case rgb32f: [[fallthrough]];
+		case rgb32i: [[fallthrough]];
+		case rgb32ui:
+			return 12;
+
+		case rgba32f: [[fallthrough]];
+		case rgba32i:
+			return 16;
+
+		default:
+			return 4;
+		};
+	};
+
+	/**
+	 * @brief Computes the size of a texture's storage including its mip chain.
+	 *
+	 * @param _format Internal texture data format.
+	 * @param _width Width of the base level in texels.
+	 * @param _height Height of the base level in texels, 1 for 1D textures.
+	 * @param _depth Depth of the base level in texels, 1 for 1D and 2D textures.
+	 * @param _layers Number of array layers (or cube faces), which don't shrink with the mip level.
+	 * @param _levels Number of mipmap levels.
+	 * @return Size in bytes.
+	*/
+	constexpr inline size_t texture_storage_bytes(internal_format _format, GLsizei _width, GLsizei _height, GLsizei _depth,
+		GLsizei _layers, GLsizei _levels) noexcept
+	{
+		size_t _texels = 0;
+		size_t _w = static_cast<size_t>(_width);
+		size_t _h = static_cast<size_t>(_height);
+		size_t _d = static_cast<size_t>(_depth);
+		for (GLsizei n = 0; n < _levels; ++n)
+		{
+			_texels += _w * _h * _d;
+			_w = std::max<size_t>(_w / 2, 1);
+			_h = std::max<size_t>(_h / 2, 1);
+			_d = std::max<size_t>(_d / 2, 1);
+		};
+		return _texels * static_cast<size_t>(_layers) * bytes_per_texel(_format);
+	};
+
+	/**
+	 * @brief Current and peak usage of a memory_category.
+	*/
+	struct memory_category_stats
+	{
+		/**
+		 * @brief Bytes currently allocated.
+		*/
+		size_t bytes = 0;
+
+		/**
+		 * @brief Highest value bytes has reached.
+		*/
+		size_t high_water = 0;
+
+		/**
+		 * @brief Number of objects with storage.
+		*/
+		size_t objects = 0;
+	};
+
+	/**
+	 * @brief Snapshot of tracked memory usage, see memory_usage().
+	 *
+	 * Every field is 0 when memory_tracking_enabled is false.
+	*/
+	struct memory_usage_stats
+	{
+		std::array<memory_category_stats, static_cast<size_t>(memory_category::count_)> categories{};
+
+		/**
+		 * @brief Bytes currently allocated across all categories.
+		*/
+		size_t bytes = 0;
+
+		/**
+		 * @brief Highest value bytes has reached.
+		*/
+		size_t high_water = 0;
+
+		const memory_category_stats& operator[](memory_category _category) const noexcept
+		{
+			return this->categories[static_cast<size_t>(_category)];
+		};
+	};
+
+	/**
+	 * @brief Storage of a single object, see largest_allocations().
+	*/
+	struct memory_allocation
+	{
+		memory_category category = memory_category::buffer;
+		GLuint id = 0;
+		size_t bytes = 0;
+	};
+
+	namespace gl_impl
+	{
+		class memory_registry
+		{
+		public:
+
+			/**
+			 * @brief Sets the size of an object's storage, replacing any previous size.
+			*/
+			void allocate(memory_category _category, GLuint _id, size_t _bytes)
+			{
+				std::unique_lock _lock{ this->mtx_ };
+				auto& _categoryStats = this->stats_.categories[static_cast<size_t>(_category)];
+				auto [_it, _inserted] = this->sizes_.try_emplace(key(_category, _id), 0);
+				if (_inserted)
+				{
+					++_categoryStats.objects;
+				};
+				_categoryStats.bytes = _categoryStats.bytes - _it->second + _bytes;
+				this->stats_.bytes = this->stats_.bytes - _it->second + _bytes;
+				_it->second = _bytes;
+
+				_categoryStats.high_water = std::max(_categoryStats.high_water, _categoryStats.bytes);
+				this->stats_.high_water = std::max(this->stats_.high_water, this->stats_.bytes);
+			};
+
+			/**
+			 * @brief Forgets an object's storage, does nothing if it had none.
+			*/
+			void release(memory_category _category, GLuint _id)
+			{
+				std::unique_lock _lock{ this->mtx_ };
+				if (_category == memory_category::texture)
+				{
+					this->texture_targets_.erase(_id);
+				};
+				const auto _it = this->sizes_.find(key(_category, _id));
+				if (_it == this->sizes_.end())
+				{
+					return;
+				};
+				auto& _categoryStats = this->stats_.categories[static_cast<size_t>(_category)];
+				--_categoryStats.objects;
+				_categoryStats.bytes -= _it->second;
+				this->stats_.bytes -= _it->second;
+				this->sizes_.erase(_it);
+			};
+
+			/**
+			 * @brief Remembers the target a texture was created with so its storage can be sized without a query.
+			*/
+			void set_texture_target(GLuint _id, GLenum _target)
+			{
+				std::unique_lock _lock{ this->mtx_ };
+				this->texture_targets_[_id] = _target;
+			};
+
+			/**
+			 * @brief Gets the target a texture was created with, 0 if it wasn't created through object_traits.
+			*/
+			GLenum texture_target(GLuint _id) const
+			{
+				std::unique_lock _lock{ this->mtx_ };
+				const auto _it = this->texture_targets_.find(_id);
+				return (_it != this->texture_targets_.end()) ? _it->second : 0;
+			};
+
+			size_t size_of(memory_category _category, GLuint _id) const
+			{
+				std::unique_lock _lock{ this->mtx_ };
+				const auto _it = this->sizes_.find(key(_category, _id));
+				return (_it != this->sizes_.end()) ? _it->second : 0;
+			};
+
+			memory_usage_stats stats() const
+			{
+				std::unique_lock _lock{ this->mtx_ };
+				return this->stats_;
+			};
+
+			std::vector<memory_allocation> largest(size_t _count) const
+			{
+				std::vector<memory_allocation> _out{};
+				{
+					std::unique_lock _lock{ this->mtx_ };
+					_out.reserve(this->sizes_.size());
+					for (const auto& [_key, _bytes] : this->sizes_)
+					{
+						_out.push_back(memory_allocation{ static_cast<memory_category>(_key >> 32), static_cast<GLuint>(_key), _bytes });
+					};
+				};
+
+				const auto _bySize = [](const memory_allocation& lhs, const memory_allocation& rhs)
+				{
+					return lhs.bytes > rhs.bytes;
+				};
+				_count = std::min(_count, _out.size());
+				std::partial_sort(_out.begin(), _out.begin() + _count, _out.end(), _bySize);
+				_out.resize(_count);
+				return _out;
+			};
+
+			void reset_high_water()
+			{
+				std::unique_lock _lock{ this->mtx_ };
+				for (auto& _categoryStats : this->stats_.categories)
+				{
+					_categoryStats.high_water = _categoryStats.bytes;
+				};
+				this->stats_.high_water = this->stats_.bytes;
+			};
+
+		private:
+
+			constexpr static uint64_t key(memory_category _category, GLuint _id) noexcept
+			{
+				return (uint64_t{ static_cast<uint8_t>(_category) } << 32) | _id;
+			};
+
+			mutable std::mutex mtx_{};
+			std::unordered_map<uint64_t, size_t> sizes_{};
+			std::unordered_map<GLuint, GLenum> texture_targets_{};
+			memory_usage_stats stats_{};
+		};
+
+		inline memory_registry& memory_registry_instance()
+		{
+			static memory_registry _registry{};
+			return _registry;
+		};
+
+		/**
+		 * @brief Records the size of an object's storage, called by the storage functions in gl.hpp.
+		*/
+		inline void track_allocation([[maybe_unused]] memory_category _category, [[maybe_unused]] GLuint _id,
+			[[maybe_unused]] size_t _bytes)
+		{
+#if JCLIB_OPENGL_MEMORY_TRACKING_V
+			if (_id != 0)
+			{
+				memory_registry_instance().allocate(_category, _id, _bytes);
+			};
+#endif
+		};
+
+		/**
+		 * @brief Records the size of a texture's storage, taking array layers and cube faces from its target.
+		*/
+		inline void track_texture_storage([[maybe_unused]] GLuint _id, [[maybe_unused]] internal_format _format,
+			[[maybe_unused]] GLsizei _width, [[maybe_unused]] GLsizei _height, [[maybe_unused]] GLsizei _depth,
+			[[maybe_unused]] GLsizei _levels)
+		{
+#if JCLIB_OPENGL_MEMORY_TRACKING_V
+			if (_id == 0)
+			{
+				return;
+			};
+
+			auto& _registry = memory_registry_instance();
+			size_t _bytes = 0;
+			switch (_registry.texture_target(_id))
+			{
+			case GL_TEXTURE_1D_ARRAY:
+				// Height is the layer count
+				_bytes = texture_storage_bytes(_format, _width, 1, 1, _height, _levels);
+				break;
+			case GL_TEXTURE_2D_ARRAY: [[fallthrough]];
+			case GL_TEXTURE_CUBE_MAP_ARRAY:
+				// Depth is the layer count, counting each cube face for cube map arrays
+				_bytes = texture_storage_bytes(_format, _width, _height, 1, _depth, _levels);
+				break;
+			case GL_TEXTURE_CUBE_MAP:
+				_bytes = texture_storage_bytes(_format, _width, _height, 1, 6, _levels);
+				break;
+			default:
+				_bytes = texture_storage_bytes(_format, _width, _height, _depth, 1, _levels);
+				break;
+			};
+			_registry.allocate(memory_category::texture, _id, _bytes);
+#endif
+		};
+
+		/**
+		 * @brief Remembers a new texture's target, called by object_traits<texture>::create.
+		*/
+		inline void track_texture_target([[maybe_unused]] GLuint _id, [[maybe_unused]] GLenum _target)
+		{
+#if JCLIB_OPENGL_MEMORY_TRACKING_V
+			memory_registry_instance().set_texture_target(_id, _target);
+#endif
+		};
+
+		/**
+		 * @brief Forgets an object's storage, called by object_traits destroy functions.
+		*/
+		inline void track_release([[maybe_unused]] memory_category _category, [[maybe_unused]] GLuint _id)
+		{
+#if JCLIB_OPENGL_MEMORY_TRACKING_V
+			memory_registry_instance().release(_category, _id);
+#endif
+		};
+	};
+
+	/**
+	 * @brief Gets the per-category and total memory usage and high-water marks.
+	 * @return The usage, all 0 when memory_tracking_enabled is false.
+	*/
+	inline memory_usage_stats memory_usage()
+	{
+		return gl_impl::memory_registry_instance().stats();
+	};
+
+	/**
+	 * @brief Gets the tracked storage size of a single object.
+	 *
+	 * Always 0 when memory_tracking_enabled is false, which is the default in release builds. Don't use this
+	 * to enforce budgets unless tracking is required with a static_assert.
+	 *
+	 * @return Size in bytes, 0 if the object has no tracked storage or tracking is off.
+	*/
+	inline size_t allocated_bytes(memory_category _category, GLuint _id)
+	{
+		return gl_impl::memory_registry_instance().size_of(_category, _id);
+	};
+
+	/**
+	 * @brief Gets the objects with the largest storage, largest first.
+	 * @param _count Maximum number of objects to return.
+	*/
+	inline std::vector<memory_allocation> largest_allocations(size_t _count)
+	{
+		return gl_impl::memory_registry_instance().largest(_count);
+	};
+
+	/**
+	 * @brief Lowers every high-water mark to the current usage, ie. at the start of a level.
+	*/
+	inline void reset_memory_high_water()
+	{
+		gl_impl::memory_registry_instance().reset_high_water();
+	};
+
+	/**
+	 * @brief Formats the memory usage and the largest allocations as a JSON object.
+	 *
+	 * ```
+	 * { "bytes": 0, "high_water": 0, "categories": { "buffer": { "bytes": 0, "high_water": 0, "objects": 0 }, ... },
+	 *   "largest": [ { "category": "texture", "id": 3, "bytes": 0 }, ... ] }
+	 * ```
+	 *
+	 * @param _topCount Number of allocations to list under "largest".
+	*/
+	inline std::string memory_usage_json(size_t _topCount = 16)
+	{
+		const auto _stats = memory_usage();
+		std::string _out{};
+		_out.append("{\"bytes\":").append(std::to_string(_stats.bytes));
+		_out.append(",\"high_water\":").append(std::to_string(_stats.high_water));
+		_out.append(",\"categories\":{");
+		for (size_t n = 0; n != _stats.categories.size(); ++n)
+		{
+			const auto& _category = _stats.categories[n];
+			if (n != 0)
+			{
+				_out.append(",");
+			};
+			_out.append("\"").append(to_string(static_cast<memory_category>(n))).append("\":{");
+			_out.append("\"bytes\":").append(std::to_string(_category.bytes));
+			_out.append(",\"high_water\":").append(std::to_string(_category.high_water));
+			_out.append(",\"objects\":").append(std::to_string(_category.objects)).append("}");
+		};
+		_out.append("},\"largest\":[");
+
+		const auto _largest = largest_allocations(_topCount);
+		for (size_t n = 0; n != _largest.size(); ++n)
+		{
+			if (n != 0)
+			{
+				_out.append(",");
+			};
+			_out.append("{\"category\":\"").append(to_string(_largest[n].category)).append("\"");
+			_out.append(",\"id\":").append(std::to_string(_largest[n].id));
+			_out.append(",\"bytes\":").append(std::to_string(_largest[n].bytes)).append("}");
+		};
+		_out.append("]}");
+		return _out;
+	};
+};
+
+#endif // JCLIB_OPENGL_GLMEMORY_HPP
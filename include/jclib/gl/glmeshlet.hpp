@@ -0,0 +1,509 @@
+#pragma once
+#ifndef JCLIB_OPENGL_GLMESHLET_HPP
+#define JCLIB_OPENGL_GLMESHLET_HPP
+
+/*
+	CPU side meshlet (triangle cluster) building for cluster granular culling
+*/
+
+#include "gl.hpp"
+#include "glenum.hpp"
+#include "glsimd.hpp"
+#include "glthread.hpp"
+
+#include <jclib/type.h>
+#include <jclib/concepts.h>
+
+#include <span>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <vector>
+#include <algorithm>
+
+#define _JCLIB_OPENGL_GLMESHLET_
+
+#pragma region MESHLET_TYPES
+namespace jc::gl
+{
+	/**
+	 * @brief Size limits for each meshlet.
+	*/
+	struct meshlet_limits
+	{
+		/**
+		 * @brief Max unique vertices per meshlet, at most 256 as local indices are 8-bit.
+		*/
+		size_t max_vertices = 64;
+
+		/**
+		 * @brief Max triangles per meshlet.
+		*/
+		size_t max_triangles = 124;
+	};
+
+	/**
+	 * @brief Ranges of a single meshlet within a meshlet_mesh.
+	*/
+	struct meshlet
+	{
+		/**
+		 * @brief Offset into meshlet_mesh::vertices.
+		*/
+		gl_unsigned_int vertex_offset;
+
+		/**
+		 * @brief Number of unique vertices.
+		*/
+		gl_unsigned_int vertex_count;
+
+		/**
+		 * @brief Offset in triangles into meshlet_mesh::triangles and meshlet_mesh::indices.
+		*/
+		gl_unsigned_int triangle_offset;
+
+		/**
+		 * @brief Number of triangles.
+		*/
+		gl_unsigned_int triangle_count;
+	};
+
+	/**
+	 * @brief Culling data for a single meshlet, laid out to match a std430 struct of three vec4s.
+	 *
+	 * The cluster can be culled when outside the frustum using the sphere, and when backfacing using:
+	 *
+	 *		dot(normalize(cone_apex - camera_position), cone_axis) >= cone_cutoff
+	*/
+	struct alignas(16) meshlet_bounds
+	{
+		/**
+		 * @brief Bounding sphere center.
+		*/
+		std::array<gl_float, 3> center;
+
+		/**
+		 * @brief Bounding sphere radius.
+		*/
+		gl_float radius;
+
+		/**
+		 * @brief Normal cone axis, zero if the cone can't be used for culling.
+		*/
+		std::array<gl_float, 3> cone_axis;
+
+		/**
+		 * @brief Normal cone cutoff, 1 if the cone can't be used for culling.
+		*/
+		gl_float cone_cutoff;
+
+		/**
+		 * @brief Normal cone apex, the last vec4's w is padding.
+		*/
+		std::array<gl_float, 3> cone_apex;
+	};
+
+	/**
+	 * @brief Meshlets laid out contiguously and ready for upload.
+	*/
+	struct meshlet_mesh
+	{
+		/**
+		 * @brief Meshlet ranges.
+		*/
+		std::vector<meshlet> meshlets{};
+
+		/**
+		 * @brief Culling data, one per meshlet.
+		*/
+		std::vector<meshlet_bounds> bounds{};
+
+		/**
+		 * @brief Meshlet local vertex -> mesh vertex.
+		*/
+		std::vector<gl_unsigned_int> vertices{};
+
+		/**
+		 * @brief Meshlet local triangle indices, 3 per triangle.
+		*/
+		std::vector<gl_unsigned_byte> triangles{};
+
+		/**
+		 * @brief Mesh vertex triangle indices with every meshlet contiguous, upload to the element array.
+		*/
+		std::vector<gl_unsigned_int> indices{};
+
+		/**
+		 * @brief Indirect draw command for each meshlet, base_instance is set to the meshlet index.
+		*/
+		std::vector<draw_elements_command> commands{};
+	};
+
+	/**
+	 * @brief Input mesh for build_meshlets().
+	*/
+	struct meshlet_input
+	{
+		/**
+		 * @brief Triangle list indices, ideally already optimized with optimize_vertex_cache().
+		*/
+		std::span<const gl_unsigned_int> indices{};
+
+		/**
+		 * @brief Vertex positions, 3 floats per vertex.
+		*/
+		std::span<const gl_float> positions{};
+
+		/**
+		 * @brief Meshlet size limits.
+		*/
+		meshlet_limits limits{};
+	};
+
+};
+#pragma endregion
+
+#pragma region MESHLET_BUILDER
+namespace jc::gl
+{
+	namespace gl_impl
+	{
+		/**
+		 * @brief Structure of arrays scratch space for a single meshlet.
+		*/
+		struct meshlet_scratch
+		{
+			std::vector<gl_float> x{}, y{}, z{};
+			std::vector<gl_float> nx{}, ny{}, nz{};
+
+			/**
+			 * @brief First vertex of the triangle each normal belongs to, degenerate triangles have no entry.
+			*/
+			std::vector<gl_unsigned_byte> anchor{};
+		};
+
+		/**
+		 * @brief Min and max of a float array.
+		*/
+		inline void soa_min_max(const gl_float* _values, size_t _count, gl_float& _min, gl_float& _max) noexcept
+		{
+			_min = std::numeric_limits<gl_float>::infinity();
+			_max = -_min;
+			size_t n = 0;
+#if JCLIB_OPENGL_SSE2_V
+			if (_count >= 4)
+			{
+				auto _vmin = _mm_set1_ps(_min);
+				auto _vmax = _mm_set1_ps(_max);
+				for (; n + 4 <= _count; n += 4)
+				{
+					const auto _v = _mm_loadu_ps(_values + n);
+					_vmin = _mm_min_ps(_vmin, _v);
+					_vmax = _mm_max_ps(_vmax, _v);
+				};
+				alignas(16) gl_float _lanes[8];
+				_mm_store_ps(_lanes, _vmin);
+				_mm_store_ps(_lanes + 4, _vmax);
+				_min = std::min({ _lanes[0], _lanes[1], _lanes[2], _lanes[3] });
+				_max = std::max({ _lanes[4], _lanes[5], _lanes[6], _lanes[7] });
+			};
+#endif
+			for (; n != _count; ++n)
+			{
+				_min = std::min(_min, _values[n]);
+				_max = std::max(_max, _values[n]);
+			};
+		};
+
+		/**
+		 * @brief Max squared distance from a point over structure of arrays points.
+		*/
+		inline gl_float soa_max_distance_sq(const meshlet_scratch& _s, size_t _count, const std::array<gl_float, 3>& _c) noexcept
+		{
+			gl_float _max = 0.0f;
+			size_t n = 0;
+#if JCLIB_OPENGL_SSE2_V
+			if (_count >= 4)
+			{
+				const auto _cx = _mm_set1_ps(_c[0]);
+				const auto _cy = _mm_set1_ps(_c[1]);
+				const auto _cz = _mm_set1_ps(_c[2]);
+				auto _vmax = _mm_setzero_ps();
+				for (; n + 4 <= _count; n += 4)
+				{
+					const auto _dx = _mm_sub_ps(_mm_loadu_ps(_s.x.data() + n), _cx);
+					const auto _dy = _mm_sub_ps(_mm_loadu_ps(_s.y.data() + n), _cy);
+					const auto _dz = _mm_sub_ps(_mm_loadu_ps(_s.z.data() + n), _cz);
+					const auto _d = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_dx, _dx), _mm_mul_ps(_dy, _dy)), _mm_mul_ps(_dz, _dz));
+					_vmax = _mm_max_ps(_vmax, _d);
+				};
+				alignas(16) gl_float _lanes[4];
+				_mm_store_ps(_lanes, _vmax);
+				_max = std::max({ _lanes[0], _lanes[1], _lanes[2], _lanes[3] });
+			};
+#endif
+			for (; n != _count; ++n)
+			{
+				const auto _dx = _s.x[n] - _c[0];
+				const auto _dy = _s.y[n] - _c[1];
+				const auto _dz = _s.z[n] - _c[2];
+				_max = std::max(_max, _dx * _dx + _dy * _dy + _dz * _dz);
+			};
+			return _max;
+		};
+
+		/**
+		 * @brief Min dot product of an axis with structure of arrays normals.
+		*/
+		inline gl_float soa_min_dot(const meshlet_scratch& _s, size_t _count, const std::array<gl_float, 3>& _axis) noexcept
+		{
+			gl_float _min = 1.0f;
+			size_t n = 0;
+#if JCLIB_OPENGL_SSE2_V
+			if (_count >= 4)
+			{
+				const auto _ax = _mm_set1_ps(_axis[0]);
+				const auto _ay = _mm_set1_ps(_axis[1]);
+				const auto _az = _mm_set1_ps(_axis[2]);
+				auto _vmin = _mm_set1_ps(1.0f);
+				for (; n + 4 <= _count; n += 4)
+				{
+					const auto _d = _mm_add_ps(_mm_add_ps(
+						_mm_mul_ps(_mm_loadu_ps(_s.nx.data() + n), _ax),
+						_mm_mul_ps(_mm_loadu_ps(_s.ny.data() + n), _ay)),
+						_mm_mul_ps(_mm_loadu_ps(_s.nz.data() + n), _az));
+					_vmin = _mm_min_ps(_vmin, _d);
+				};
+				alignas(16) gl_float _lanes[4];
+				_mm_store_ps(_lanes, _vmin);
+				_min = std::min({ _lanes[0], _lanes[1], _lanes[2], _lanes[3] });
+			};
+#endif
+			for (; n != _count; ++n)
+			{
+				_min = std::min(_min, _s.nx[n] * _axis[0] + _s.ny[n] * _axis[1] + _s.nz[n] * _axis[2]);
+			};
+			return _min;
+		};
+
+		/**
+		 * @brief Computes the bounding sphere and normal cone of a finished meshlet.
+		*/
+		inline meshlet_bounds compute_meshlet_bounds(const meshlet_mesh& _mesh, const meshlet& _meshlet,
+			std::span<const gl_float> _positions, meshlet_scratch& _s)
+		{
+			meshlet_bounds _out{};
+
+			// Gather the vertex positions
+			_s.x.resize(_meshlet.vertex_count);
+			_s.y.resize(_meshlet.vertex_count);
+			_s.z.resize(_meshlet.vertex_count);
+			for (size_t n = 0; n != _meshlet.vertex_count; ++n)
+			{
+				const auto _p = _positions.data() + _mesh.vertices[_meshlet.vertex_offset + n] * 3;
+				_s.x[n] = _p[0];
+				_s.y[n] = _p[1];
+				_s.z[n] = _p[2];
+			};
+
+			// Sphere around the bounding box center
+			std::array<gl_float, 3> _min{}, _max{};
+			soa_min_max(_s.x.data(), _meshlet.vertex_count, _min[0], _max[0]);
+			soa_min_max(_s.y.data(), _meshlet.vertex_count, _min[1], _max[1]);
+			soa_min_max(_s.z.data(), _meshlet.vertex_count, _min[2], _max[2]);
+			for (size_t c = 0; c != 3; ++c)
+			{
+				_out.center[c] = (_min[c] + _max[c]) * 0.5f;
+			};
+			_out.radius = std::sqrt(soa_max_distance_sq(_s, _meshlet.vertex_count, _out.center));
+
+			// Triangle normals
+			_s.nx.clear(); _s.ny.clear(); _s.nz.clear(); _s.anchor.clear();
+			std::array<gl_float, 3> _axis{};
+			const auto _tris = _mesh.triangles.data() + _meshlet.triangle_offset * 3;
+			for (size_t t = 0; t != _meshlet.triangle_count; ++t)
+			{
+				const auto a = _tris[t * 3 + 0], b = _tris[t * 3 + 1], c = _tris[t * 3 + 2];
+				const gl_float _e0[3]{ _s.x[b] - _s.x[a], _s.y[b] - _s.y[a], _s.z[b] - _s.z[a] };
+				const gl_float _e1[3]{ _s.x[c] - _s.x[a], _s.y[c] - _s.y[a], _s.z[c] - _s.z[a] };
+				gl_float _n[3]
+				{
+					_e0[1] * _e1[2] - _e0[2] * _e1[1],
+					_e0[2] * _e1[0] - _e0[0] * _e1[2],
+					_e0[0] * _e1[1] - _e0[1] * _e1[0]
+				};
+				const auto _len = std::sqrt(_n[0] * _n[0] + _n[1] * _n[1] + _n[2] * _n[2]);
+				if (_len == 0.0f)
+				{
+					continue;
+				};
+				for (auto& v : _n)
+				{
+					v /= _len;
+				};
+				_s.nx.push_back(_n[0]);
+				_s.ny.push_back(_n[1]);
+				_s.nz.push_back(_n[2]);
+				_s.anchor.push_back(a);
+				for (size_t i = 0; i != 3; ++i)
+				{
+					_axis[i] += _n[i];
+				};
+			};
+
+			// Normal cone, degenerate cones (> ~84 degree spread) are left unusable
+			_out.cone_axis = { 0.0f, 0.0f, 0.0f };
+			_out.cone_cutoff = 1.0f;
+			_out.cone_apex = _out.center;
+
+			const auto _axisLen = std::sqrt(_axis[0] * _axis[0] + _axis[1] * _axis[1] + _axis[2] * _axis[2]);
+			if (_axisLen == 0.0f || _s.nx.empty())
+			{
+				return _out;
+			};
+			for (auto& v : _axis)
+			{
+				v /= _axisLen;
+			};
+
+			const auto _minDot = soa_min_dot(_s, _s.nx.size(), _axis);
+			if (_minDot <= 0.1f)
+			{
+				return _out;
+			};
+
+			// Move the apex back so every triangle plane is in front of it
+			gl_float _maxT = 0.0f;
+			for (size_t n = 0; n != _s.nx.size(); ++n)
+			{
+				const auto a = _s.anchor[n];
+				const gl_float _n[3]{ _s.nx[n], _s.ny[n], _s.nz[n] };
+				const auto _dp = _n[0] * _axis[0] + _n[1] * _axis[1] + _n[2] * _axis[2];
+				const auto _dc = (_out.center[0] - _s.x[a]) * _n[0] + (_out.center[1] - _s.y[a]) * _n[1] + (_out.center[2] - _s.z[a]) * _n[2];
+				_maxT = std::max(_maxT, _dc / _dp);
+			};
+
+			_out.cone_axis = _axis;
+			_out.cone_cutoff = std::sqrt(1.0f - _minDot * _minDot);
+			for (size_t c = 0; c != 3; ++c)
+			{
+				_out.cone_apex[c] = _out.center[c] - _axis[c] * _maxT;
+			};
+			return _out;
+		};
+	};
+
+	/**
+	 * @brief Splits an indexed triangle mesh into meshlets.
+	 *
+	 * Triangles are added to the current meshlet in index order until either limit would be
+	 * exceeded, so feeding indices from optimize_vertex_cache() gives tightly packed meshlets.
+	 * Bounding data uses SSE2 over the meshlet vertices when available.
+	 *
+	 * @param _input Mesh to split.
+	 * @return Contiguous meshlet data and an indirect draw command per meshlet.
+	*/
+	inline meshlet_mesh build_meshlets(const meshlet_input& _input)
+	{
+		const auto& _limits = _input.limits;
+		JCLIB_ASSERT(_limits.max_vertices >= 3 && _limits.max_vertices <= 256);
+		JCLIB_ASSERT(_limits.max_triangles >= 1);
+		JCLIB_ASSERT(_input.positions.size() % 3 == 0);
+
+		meshlet_mesh _out{};
+		const auto _vertexCount = _input.positions.size() / 3;
+		const auto _triangleCount = _input.indices.size() / 3;
+
+		// Mesh vertex -> local index in the current meshlet
+		constexpr auto _absent = std::numeric_limits<size_t>::max();
+		std::vector<size_t> _local(_vertexCount, _absent);
+
+		meshlet _current{ 0, 0, 0, 0 };
+		const auto _flush = [&]()
+		{
+			if (_current.triangle_count == 0)
+			{
+				return;
+			};
+			for (size_t n = 0; n != _current.vertex_count; ++n)
+			{
+				_local[_out.vertices[_current.vertex_offset + n]] = _absent;
+			};
+			_out.meshlets.push_back(_current);
+			_current = meshlet{ static_cast<gl_unsigned_int>(_out.vertices.size()), 0,
+				static_cast<gl_unsigned_int>(_out.triangles.size() / 3), 0 };
+		};
+
+		for (size_t t = 0; t != _triangleCount; ++t)
+		{
+			const auto _tri = _input.indices.data() + t * 3;
+			size_t _newVertices = 0;
+			for (size_t c = 0; c != 3; ++c)
+			{
+				JCLIB_ASSERT(_tri[c] < _vertexCount);
+				_newVertices += (_local[_tri[c]] == _absent) ? 1 : 0;
+			};
+			// Repeated indices in a degenerate triangle are counted twice which is harmless
+
+			if (_current.vertex_count + _newVertices > _limits.max_vertices ||
+				_current.triangle_count + 1 > _limits.max_triangles)
+			{
+				_flush();
+			};
+
+			for (size_t c = 0; c != 3; ++c)
+			{
+				auto& _l = _local[_tri[c]];
+				if (_l == _absent)
+				{
+					_l = _current.vertex_count++;
+					_out.vertices.push_back(_tri[c]);
+				};
+				_out.triangles.push_back(static_cast<gl_unsigned_byte>(_l));
+				_out.indices.push_back(_tri[c]);
+			};
+			++_current.triangle_count;
+		};
+		_flush();
+
+		// Bounds and draw commands
+		gl_impl::meshlet_scratch _scratch{};
+		_out.bounds.reserve(_out.meshlets.size());
+		_out.commands.reserve(_out.meshlets.size());
+		for (size_t n = 0; n != _out.meshlets.size(); ++n)
+		{
+			const auto& _m = _out.meshlets[n];
+			_out.bounds.push_back(gl_impl::compute_meshlet_bounds(_out, _m, _input.positions, _scratch));
+			_out.commands.push_back(draw_elements_command
+			{
+				_m.triangle_count * 3,
+				1,
+				_m.triangle_offset * 3,
+				0,
+				static_cast<gl_unsigned_int>(n)
+			});
+		};
+
+		return _out;
+	};
+
+	/**
+	 * @brief Splits many meshes into meshlets in parallel.
+	 * @param _inputs Meshes to split.
+	 * @param _pool Thread pool to run on.
+	 * @return Meshlet data in the same order as the inputs.
+	*/
+	inline std::vector<meshlet_mesh> build_meshlets(std::span<const meshlet_input> _inputs, thread_pool& _pool)
+	{
+		std::vector<meshlet_mesh> _out(_inputs.size());
+		_pool.parallel_for(_inputs.size(), [&_inputs, &_out](size_t n)
+		{
+			_out[n] = build_meshlets(_inputs[n]);
+		});
+		return _out;
+	};
+
+};
+#pragma endregion
+
+#endif // JCLIB_OPENGL_GLMESHLET_HPP
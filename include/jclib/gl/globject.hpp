@@ -4,6 +4,7 @@
 
 #include "gllib.hpp"
 #include "glenum.hpp"
+#include "glmemory.hpp"
 
 #include <jclib/type.h>
 #include <jclib/concepts.h>
@@ -677,10 +678,16 @@ namespace jc::gl
 		{
 			value_type _out;
 			glCreateTextures(jc::to_underlying(_target), 1, &_out);
+#if JCLIB_OPENGL_MEMORY_TRACKING_V
+			gl_impl::track_texture_target(_out, jc::to_underlying(_target));
+#endif
 			return _out;
 		};
 		static void destroy(value_type _value)
 		{
+#if JCLIB_OPENGL_MEMORY_TRACKING_V
+			gl_impl::track_release(memory_category::texture, _value);
+#endif
 			glDeleteTextures(1, &_value);
 		};
 		static bool check(const value_type& _value)
@@ -761,6 +768,9 @@ namespace jc::gl
 		};
 		static void destroy(value_type _value)
 		{
+#if JCLIB_OPENGL_MEMORY_TRACKING_V
+			gl_impl::track_release(memory_category::buffer, _value);
+#endif
 			glDeleteBuffers(1, &_value);
 			_value = 0;
 		};
@@ -784,6 +794,142 @@ namespace jc::gl
 	*/
 	using vbo_traits = object_traits<object_type::vbo>;
 
+	/**
+	 * @brief Traits type for OpenGL framebuffer objects (FBOs)
+	*/
+	template <>
+	struct object_traits<object_type::framebuffer>
+	{
+		using value_type = GLuint;
+
+		/**
+		 * @brief Enum for the targets this object can be bound to
+		*/
+		using target_type = framebuffer_target;
+
+		static value_type create()
+		{
+			value_type _value;
+			glCreateFramebuffers(1, &_value);
+			return _value;
+		};
+		static void destroy(value_type _value)
+		{
+			glDeleteFramebuffers(1, &_value);
+			_value = 0;
+		};
+		static bool check(const value_type& _value)
+		{
+			return glIsFramebuffer(_value);
+		};
+		constexpr static value_type null()
+		{
+			return value_type{ 0 };
+		};
+
+		static void bind(const value_type& _value, framebuffer_target _target)
+		{
+			glBindFramebuffer(jc::to_underlying(_target), _value);
+		};
+		static void bind(const value_type& _value)
+		{
+			bind(_value, framebuffer_target::framebuffer);
+		};
+	};
+
+	/**
+	 * @brief Traits type for OpenGL framebuffer objects (FBOs)
+	*/
+	using framebuffer_traits = object_traits<object_type::framebuffer>;
+
+	/**
+	 * @brief Traits type for OpenGL renderbuffer objects
+	*/
+	template <>
+	struct object_traits<object_type::renderbuffer>
+	{
+		using value_type = GLuint;
+
+		/**
+		 * @brief No target type for renderbuffers.
+		*/
+		using target_type = void;
+
+		static value_type create()
+		{
+			value_type _value;
+			glCreateRenderbuffers(1, &_value);
+			return _value;
+		};
+		static void destroy(value_type _value)
+		{
+#if JCLIB_OPENGL_MEMORY_TRACKING_V
+			gl_impl::track_release(memory_category::renderbuffer, _value);
+#endif
+			glDeleteRenderbuffers(1, &_value);
+			_value = 0;
+		};
+		static bool check(const value_type& _value)
+		{
+			return glIsRenderbuffer(_value);
+		};
+		constexpr static value_type null()
+		{
+			return value_type{ 0 };
+		};
+
+		static void bind(const value_type& _value)
+		{
+			glBindRenderbuffer(GL_RENDERBUFFER, _value);
+		};
+	};
+
+	/**
+	 * @brief Traits type for OpenGL renderbuffer objects
+	*/
+	using renderbuffer_traits = object_traits<object_type::renderbuffer>;
+
+	/**
+	 * @brief Traits type for OpenGL sync objects
+	*/
+	template <>
+	struct object_traits<object_type::sync>
+	{
+		using value_type = GLsync;
+
+		/**
+		 * @brief No target type for sync objects.
+		*/
+		using target_type = void;
+
+		/**
+		 * @brief Creates a fence that is signaled once all previously issued commands complete.
+		 *
+		 * https://www.khronos.org/registry/OpenGL-Refpages/gl4/html/glFenceSync.xhtml
+		*/
+		static value_type create()
+		{
+			return glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+		};
+		static void destroy(value_type _value)
+		{
+			glDeleteSync(_value);
+		};
+		static bool check(const value_type& _value)
+		{
+			return glIsSync(_value);
+		};
+		constexpr static value_type null()
+		{
+			return value_type{ nullptr };
+		};
+	};
+
+	/**
+	 * @brief Traits type for OpenGL sync objects
+	*/
+	using sync_traits = object_traits<object_type::sync>;
+
 };
 
 #pragma endregion
@@ -5,6 +5,7 @@
 */
 
 #include "gl.hpp"
+#include "glcaps.hpp"
 #include "glenum.hpp"
 
 #include <jclib/concepts.h>
@@ -16,11 +17,67 @@ namespace jc::gl
 
 	inline GLint get_max_uniform_locations()
 	{
+		if (const auto _caps = context_caps_loaded())
+		{
+			return _caps->max_uniform_locations;
+		};
 		GLint _v{};
 		glGetIntegerv(GL_MAX_UNIFORM_LOCATIONS, &_v);
 		return _v;
 	};
 
+	/**
+	 * @brief Gets the alignment required for offsets passed to bind_buffer_range() for uniform buffers
+	 *
+	 * Like the other getters here this reads the context_caps snapshot once load_context_caps() has been called.
+	 *
+	 * @return Alignment in bytes
+	*/
+	inline GLint get_uniform_buffer_offset_alignment()
+	{
+		if (const auto _caps = context_caps_loaded())
+		{
+			return _caps->uniform_buffer_offset_alignment;
+		};
+		GLint _v{};
+		glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &_v);
+		return _v;
+	};
+
+#if GL_VERSION_4_3
+	/**
+	 * @brief Gets the alignment required for offsets passed to bind_buffer_range() for shader storage buffers
+	 *
+	 * @return Alignment in bytes
+	*/
+	inline GLint get_shader_storage_buffer_offset_alignment()
+	{
+		if (const auto _caps = context_caps_loaded())
+		{
+			return _caps->shader_storage_buffer_offset_alignment;
+		};
+		GLint _v{};
+		glGetIntegerv(GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT, &_v);
+		return _v;
+	};
+
+	/**
+	 * @brief Gets the maximum size of a shader storage block
+	 *
+	 * @return Size in bytes
+	*/
+	inline GLint64 get_max_shader_storage_block_size()
+	{
+		if (const auto _caps = context_caps_loaded())
+		{
+			return _caps->max_shader_storage_block_size;
+		};
+		GLint64 _v{};
+		glGetInteger64v(GL_MAX_SHADER_STORAGE_BLOCK_SIZE, &_v);
+		return _v;
+	};
+#endif
+
 	/**
 	 * @brief Gets the target a texture is assigned to
 	 * 
@@ -0,0 +1,682 @@
+#pragma once
+#ifndef JCLIB_OPENGL_GLQUANTIZE_HPP
+#define JCLIB_OPENGL_GLQUANTIZE_HPP
+
+/*
+	CPU side vertex quantization, intended to be run before uploading with buffer_data
+*/
+
+#include "gl.hpp"
+#include "glenum.hpp"
+#include "glsimd.hpp"
+
+#include <jclib/type.h>
+#include <jclib/concepts.h>
+
+#include <span>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <cstdint>
+#include <vector>
+#include <cstring>
+#include <algorithm>
+#include <string_view>
+
+#define _JCLIB_OPENGL_GLQUANTIZE_
+
+#pragma region QUANTIZE_TYPES
+namespace jc::gl
+{
+	/**
+	 * @brief Tightly packed floating point vertex streams for a mesh.
+	 *
+	 * Every non-empty stream must hold the same number of vertices. Empty streams are skipped.
+	*/
+	struct mesh_streams
+	{
+		/**
+		 * @brief Vertex positions, 3 floats per vertex (xyz).
+		*/
+		std::span<const gl_float> positions{};
+
+		/**
+		 * @brief Unit length vertex normals, 3 floats per vertex (xyz).
+		*/
+		std::span<const gl_float> normals{};
+
+		/**
+		 * @brief Unit length vertex tangents, 4 floats per vertex (xyz + handedness in w).
+		*/
+		std::span<const gl_float> tangents{};
+
+		/**
+		 * @brief Texture coordinates, 2 floats per vertex (uv).
+		*/
+		std::span<const gl_float> uvs{};
+	};
+
+	/**
+	 * @brief Describes the vertex format of a single quantized stream.
+	 *
+	 * Each quantized stream is stored in its own buffer so the relative offset is always 0.
+	*/
+	struct quantized_attribute
+	{
+		/**
+		 * @brief Component type of the attribute.
+		*/
+		typecode type;
+
+		/**
+		 * @brief Number of components the shader reads.
+		*/
+		gl_int count;
+
+		/**
+		 * @brief If the components are normalized when read.
+		*/
+		bool normalized;
+
+		/**
+		 * @brief Distance in bytes between two vertices in the stream, use for bind_vertex_buffer.
+		*/
+		gl_sizei stride_bytes;
+	};
+
+	/**
+	 * @brief Vertex format for a quantized mesh plus the data needed to dequantize positions.
+	 *
+	 * Positions are normalized to [0, 1] within the mesh bounds and must be dequantized
+	 * in the shader using:
+	 *
+	 *		position = position_offset + position_scale * quantized_position;
+	*/
+	struct quantized_layout
+	{
+		/**
+		 * @brief Normalized 16-bit unsigned xyz, padded to 8 bytes per vertex.
+		*/
+		quantized_attribute position{ typecode::gl_unsigned_short, 3, true, 4 * sizeof(gl_unsigned_short) };
+
+		/**
+		 * @brief Octahedral encoded normal as two normalized 16-bit signed values.
+		*/
+		quantized_attribute normal{ typecode::gl_short, 2, true, 2 * sizeof(gl_short) };
+
+		/**
+		 * @brief Octahedral encoded tangent as two normalized 16-bit signed values with the handedness in z.
+		*/
+		quantized_attribute tangent{ typecode::gl_short, 3, true, 4 * sizeof(gl_short) };
+
+		/**
+		 * @brief Half float uv.
+		*/
+		quantized_attribute uv{ typecode::gl_half_float, 2, false, 2 * sizeof(gl_half_float) };
+
+		/**
+		 * @brief Mesh bounds extent, multiply the normalized position by this.
+		*/
+		std::array<gl_float, 3> position_scale{ 1.0f, 1.0f, 1.0f };
+
+		/**
+		 * @brief Mesh bounds minimum, add this to the scaled position.
+		*/
+		std::array<gl_float, 3> position_offset{ 0.0f, 0.0f, 0.0f };
+	};
+
+	/**
+	 * @brief Size report for a quantized mesh.
+	*/
+	struct quantize_report
+	{
+		/**
+		 * @brief Number of vertices quantized.
+		*/
+		size_t vertex_count = 0;
+
+		/**
+		 * @brief Size of the source float streams in bytes.
+		*/
+		size_t source_bytes = 0;
+
+		/**
+		 * @brief Size of the quantized streams in bytes.
+		*/
+		size_t quantized_bytes = 0;
+
+		/**
+		 * @brief Gets the number of bytes saved by quantization.
+		 * @return Source size minus quantized size.
+		*/
+		constexpr size_t bytes_saved() const noexcept
+		{
+			return this->source_bytes - this->quantized_bytes;
+		};
+	};
+
+	/**
+	 * @brief Quantized vertex streams ready to be uploaded using buffer_data.
+	*/
+	struct quantized_mesh
+	{
+		/**
+		 * @brief 4 values per vertex, the 4th value is padding.
+		*/
+		std::vector<gl_unsigned_short> positions{};
+
+		/**
+		 * @brief 2 values per vertex.
+		*/
+		std::vector<gl_short> normals{};
+
+		/**
+		 * @brief 4 values per vertex, the 4th value is padding.
+		*/
+		std::vector<gl_short> tangents{};
+
+		/**
+		 * @brief 2 values per vertex.
+		*/
+		std::vector<gl_half_float> uvs{};
+
+		/**
+		 * @brief Vertex format of the streams.
+		*/
+		quantized_layout layout{};
+
+		/**
+		 * @brief Size report for this mesh.
+		*/
+		quantize_report report{};
+	};
+
+	/**
+	 * @brief GLSL function for decoding the octahedral normals and tangents written by quantize_mesh().
+	 *
+	 * Paste this into a shader and call "jc_oct_decode(normal)".
+	*/
+	constexpr inline std::string_view octahedral_decode_glsl = R"(
+vec3 jc_oct_decode(vec2 e)
+{
+	vec3 v = vec3(e.xy, 1.0 - abs(e.x) - abs(e.y));
+	float t = max(-v.z, 0.0);
+	v.xy += vec2(v.x >= 0.0 ? -t : t, v.y >= 0.0 ? -t : t);
+	return normalize(v);
+}
+)";
+
+};
+#pragma endregion
+
+#pragma region QUANTIZE_KERNELS
+namespace jc::gl
+{
+	namespace gl_impl
+	{
+		/**
+		 * @brief Converts a float to a half float, rounding to nearest even.
+		 * @param _value Value to convert.
+		 * @return IEEE 754 binary16 bits.
+		*/
+		inline gl_half_float float_to_half(gl_float _value) noexcept
+		{
+			uint32_t _bits{};
+			std::memcpy(&_bits, &_value, sizeof(_bits));
+
+			const uint32_t _sign = (_bits >> 16) & 0x8000u;
+			const uint32_t _abs = _bits & 0x7FFFFFFFu;
+
+			// NaN and inf
+			if (_abs >= 0x7F800000u)
+			{
+				const uint32_t _nan = (_abs > 0x7F800000u) ? 0x0200u : 0u;
+				return static_cast<gl_half_float>(_sign | 0x7C00u | _nan);
+			};
+
+			// Overflow to inf
+			if (_abs >= 0x477FF000u)
+			{
+				return static_cast<gl_half_float>(_sign | 0x7C00u);
+			};
+
+			// Denormal or zero
+			if (_abs < 0x38800000u)
+			{
+				if (_abs < 0x33000000u)
+				{
+					return static_cast<gl_half_float>(_sign);
+				};
+				const uint32_t _exp = _abs >> 23;
+				const uint32_t _mantissa = (_abs & 0x007FFFFFu) | 0x00800000u;
+				const uint32_t _shift = 126u - _exp;
+				uint32_t _half = _mantissa >> _shift;
+				const uint32_t _rem = _mantissa & ((1u << _shift) - 1u);
+				const uint32_t _mid = 1u << (_shift - 1u);
+				if (_rem > _mid || (_rem == _mid && (_half & 1u)))
+				{
+					++_half;
+				};
+				return static_cast<gl_half_float>(_sign | _half);
+			};
+
+			// Normal, rebias the exponent and round the mantissa
+			uint32_t _half = (_abs - 0x38000000u) >> 13;
+			const uint32_t _rem = _abs & 0x1FFFu;
+			if (_rem > 0x1000u || (_rem == 0x1000u && (_half & 1u)))
+			{
+				++_half;
+			};
+			return static_cast<gl_half_float>(_sign | _half);
+		};
+
+		/**
+		 * @brief Converts a float in [-1, 1] to a normalized 16-bit signed value.
+		*/
+		inline gl_short float_to_snorm16(gl_float _value) noexcept
+		{
+			const auto _clamped = std::clamp(_value, -1.0f, 1.0f);
+			return static_cast<gl_short>(std::lround(_clamped * 32767.0f));
+		};
+
+		/**
+		 * @brief Octahedral encodes a unit vector.
+		 * @return Encoded xy in [-1, 1].
+		*/
+		inline std::array<gl_float, 2> oct_encode(gl_float _x, gl_float _y, gl_float _z) noexcept
+		{
+			const auto _l1 = std::abs(_x) + std::abs(_y) + std::abs(_z);
+			const auto _inv = (_l1 > 0.0f) ? (1.0f / _l1) : 0.0f;
+			auto _px = _x * _inv;
+			auto _py = _y * _inv;
+			if (_z < 0.0f)
+			{
+				const auto _ox = (1.0f - std::abs(_py)) * (_px >= 0.0f ? 1.0f : -1.0f);
+				const auto _oy = (1.0f - std::abs(_px)) * (_py >= 0.0f ? 1.0f : -1.0f);
+				_px = _ox;
+				_py = _oy;
+			};
+			return { _px, _py };
+		};
+
+#if JCLIB_OPENGL_SSE2_V
+		/**
+		 * @brief Octahedral encodes 4 unit vectors stored as structure of arrays.
+		*/
+		inline void oct_encode_sse(__m128 _x, __m128 _y, __m128 _z, __m128& _outX, __m128& _outY) noexcept
+		{
+			const auto _signMask = _mm_set1_ps(-0.0f);
+			const auto _one = _mm_set1_ps(1.0f);
+			const auto _zero = _mm_setzero_ps();
+
+			const auto _ax = _mm_andnot_ps(_signMask, _x);
+			const auto _ay = _mm_andnot_ps(_signMask, _y);
+			const auto _az = _mm_andnot_ps(_signMask, _z);
+			const auto _l1 = _mm_add_ps(_mm_add_ps(_ax, _ay), _az);
+
+			// Guard against zero length input
+			const auto _nonZero = _mm_cmpgt_ps(_l1, _zero);
+			const auto _inv = _mm_and_ps(_nonZero, _mm_div_ps(_one, _mm_or_ps(_l1, _mm_andnot_ps(_nonZero, _one))));
+
+			const auto _px = _mm_mul_ps(_x, _inv);
+			const auto _py = _mm_mul_ps(_y, _inv);
+
+			// Lower hemisphere fold, sign(p) is +1 for p >= 0
+			const auto _sx = _mm_or_ps(_one, _mm_and_ps(_signMask, _px));
+			const auto _sy = _mm_or_ps(_one, _mm_and_ps(_signMask, _py));
+			const auto _fx = _mm_mul_ps(_mm_sub_ps(_one, _mm_andnot_ps(_signMask, _py)), _sx);
+			const auto _fy = _mm_mul_ps(_mm_sub_ps(_one, _mm_andnot_ps(_signMask, _px)), _sy);
+
+			const auto _lower = _mm_cmplt_ps(_z, _zero);
+			_outX = _mm_or_ps(_mm_and_ps(_lower, _fx), _mm_andnot_ps(_lower, _px));
+			_outY = _mm_or_ps(_mm_and_ps(_lower, _fy), _mm_andnot_ps(_lower, _py));
+		};
+
+		/**
+		 * @brief Converts 4 floats in [-1, 1] to normalized 16-bit signed values held in 32-bit lanes.
+		*/
+		inline __m128i snorm16_sse(__m128 _v) noexcept
+		{
+			const auto _clamped = _mm_max_ps(_mm_min_ps(_v, _mm_set1_ps(1.0f)), _mm_set1_ps(-1.0f));
+			return _mm_cvtps_epi32(_mm_mul_ps(_clamped, _mm_set1_ps(32767.0f)));
+		};
+
+		/**
+		 * @brief Loads 4 packed xyz vertices and splits them into 4 xyz_ vectors.
+		*/
+		inline void load_xyz4_sse(const gl_float* _src, __m128& _v0, __m128& _v1, __m128& _v2, __m128& _v3) noexcept
+		{
+			const auto _r0 = _mm_loadu_ps(_src + 0); // x0 y0 z0 x1
+			const auto _r1 = _mm_loadu_ps(_src + 4); // y1 z1 x2 y2
+			const auto _r2 = _mm_loadu_ps(_src + 8); // z2 x3 y3 z3
+
+			_v0 = _r0;
+			const auto _t1 = _mm_shuffle_ps(_r0, _r1, _MM_SHUFFLE(1, 0, 3, 3));
+			_v1 = _mm_shuffle_ps(_t1, _t1, _MM_SHUFFLE(0, 3, 2, 1));
+			_v2 = _mm_shuffle_ps(_r1, _r2, _MM_SHUFFLE(0, 0, 3, 2));
+			_v3 = _mm_shuffle_ps(_r2, _r2, _MM_SHUFFLE(3, 3, 2, 1));
+		};
+
+		/**
+		 * @brief Packs 8 unsigned 32-bit lanes in [0, 65535] into 8 unsigned 16-bit values.
+		*/
+		inline __m128i pack_u16_sse(__m128i _lo, __m128i _hi) noexcept
+		{
+			// SSE2 only has a signed saturating pack, bias into signed range and back
+			const auto _bias32 = _mm_set1_epi32(32768);
+			const auto _bias16 = _mm_set1_epi16(static_cast<short>(0x8000));
+			const auto _packed = _mm_packs_epi32(_mm_sub_epi32(_lo, _bias32), _mm_sub_epi32(_hi, _bias32));
+			return _mm_xor_si128(_packed, _bias16);
+		};
+#endif
+
+		/**
+		 * @brief Computes the axis aligned bounds of a packed xyz stream.
+		 * @param _positions Packed positions, 3 floats per vertex.
+		 * @param _min Output minimum.
+		 * @param _max Output maximum.
+		*/
+		inline void compute_bounds(std::span<const gl_float> _positions, std::array<gl_float, 3>& _min, std::array<gl_float, 3>& _max) noexcept
+		{
+			constexpr auto _inf = std::numeric_limits<gl_float>::infinity();
+			_min = { _inf, _inf, _inf };
+			_max = { -_inf, -_inf, -_inf };
+
+			const size_t _vertexCount = _positions.size() / 3;
+			const auto _data = _positions.data();
+			size_t _vertex = 0;
+
+#if JCLIB_OPENGL_SSE2_V
+			// 4 vertices (12 floats) per iteration, the lanes rotate through xyz
+			if (_vertexCount >= 4)
+			{
+				auto _min0 = _mm_set1_ps(_inf), _min1 = _min0, _min2 = _min0;
+				auto _max0 = _mm_set1_ps(-_inf), _max1 = _max0, _max2 = _max0;
+				for (; _vertex + 4 <= _vertexCount; _vertex += 4)
+				{
+					const auto _src = _data + _vertex * 3;
+					const auto _r0 = _mm_loadu_ps(_src + 0);
+					const auto _r1 = _mm_loadu_ps(_src + 4);
+					const auto _r2 = _mm_loadu_ps(_src + 8);
+					_min0 = _mm_min_ps(_min0, _r0); _max0 = _mm_max_ps(_max0, _r0);
+					_min1 = _mm_min_ps(_min1, _r1); _max1 = _mm_max_ps(_max1, _r1);
+					_min2 = _mm_min_ps(_min2, _r2); _max2 = _mm_max_ps(_max2, _r2);
+				};
+
+				alignas(16) gl_float _lanes[12]{};
+				const auto _reduce = [&_lanes](auto&& _pick, auto _0, auto _1, auto _2, std::array<gl_float, 3>& _out)
+				{
+					_mm_store_ps(_lanes + 0, _0);
+					_mm_store_ps(_lanes + 4, _1);
+					_mm_store_ps(_lanes + 8, _2);
+					for (size_t n = 0; n != 12; ++n)
+					{
+						_out[n % 3] = _pick(_out[n % 3], _lanes[n]);
+					};
+				};
+				_reduce([](gl_float a, gl_float b) { return std::min(a, b); }, _min0, _min1, _min2, _min);
+				_reduce([](gl_float a, gl_float b) { return std::max(a, b); }, _max0, _max1, _max2, _max);
+			};
+#endif
+			for (; _vertex != _vertexCount; ++_vertex)
+			{
+				for (size_t c = 0; c != 3; ++c)
+				{
+					const auto _v = _data[_vertex * 3 + c];
+					_min[c] = std::min(_min[c], _v);
+					_max[c] = std::max(_max[c], _v);
+				};
+			};
+		};
+
+		/**
+		 * @brief Quantizes packed xyz positions into normalized 16-bit unsigned xyz_ values.
+		*/
+		inline void quantize_positions(std::span<const gl_float> _positions, const std::array<gl_float, 3>& _min,
+			const std::array<gl_float, 3>& _scale, std::span<gl_unsigned_short> _out) noexcept
+		{
+			const size_t _vertexCount = _positions.size() / 3;
+			const auto _src = _positions.data();
+			const auto _dst = _out.data();
+			size_t _vertex = 0;
+
+#if JCLIB_OPENGL_SSE2_V
+			const auto _vmin = _mm_setr_ps(_min[0], _min[1], _min[2], 0.0f);
+			const auto _vscale = _mm_setr_ps(_scale[0], _scale[1], _scale[2], 0.0f);
+			const auto _half = _mm_set1_ps(0.5f);
+			const auto _top = _mm_set1_ps(65535.0f);
+			const auto _zero = _mm_setzero_ps();
+
+			const auto _quantize = [&](__m128 _v)
+			{
+				// Padding lane has a scale of 0 so it always quantizes to 0
+				auto _q = _mm_add_ps(_mm_mul_ps(_mm_sub_ps(_v, _vmin), _vscale), _half);
+				_q = _mm_min_ps(_mm_max_ps(_q, _zero), _top);
+				return _mm_cvttps_epi32(_q);
+			};
+
+			for (; _vertex + 4 <= _vertexCount; _vertex += 4)
+			{
+				__m128 _v0, _v1, _v2, _v3;
+				load_xyz4_sse(_src + _vertex * 3, _v0, _v1, _v2, _v3);
+				const auto _p01 = pack_u16_sse(_quantize(_v0), _quantize(_v1));
+				const auto _p23 = pack_u16_sse(_quantize(_v2), _quantize(_v3));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(_dst + _vertex * 4 + 0), _p01);
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(_dst + _vertex * 4 + 8), _p23);
+			};
+#endif
+			for (; _vertex != _vertexCount; ++_vertex)
+			{
+				for (size_t c = 0; c != 3; ++c)
+				{
+					const auto _q = (_src[_vertex * 3 + c] - _min[c]) * _scale[c] + 0.5f;
+					_dst[_vertex * 4 + c] = static_cast<gl_unsigned_short>(std::clamp(_q, 0.0f, 65535.0f));
+				};
+				_dst[_vertex * 4 + 3] = 0;
+			};
+		};
+
+		/**
+		 * @brief Octahedral encodes packed xyz normals into 2 normalized 16-bit signed values each.
+		*/
+		inline void quantize_normals(std::span<const gl_float> _normals, std::span<gl_short> _out) noexcept
+		{
+			const size_t _vertexCount = _normals.size() / 3;
+			const auto _src = _normals.data();
+			const auto _dst = _out.data();
+			size_t _vertex = 0;
+
+#if JCLIB_OPENGL_SSE2_V
+			for (; _vertex + 4 <= _vertexCount; _vertex += 4)
+			{
+				__m128 _x, _y, _z, _w;
+				load_xyz4_sse(_src + _vertex * 3, _x, _y, _z, _w);
+				_MM_TRANSPOSE4_PS(_x, _y, _z, _w);
+
+				__m128 _ox, _oy;
+				oct_encode_sse(_x, _y, _z, _ox, _oy);
+
+				const auto _sx = snorm16_sse(_ox);
+				const auto _sy = snorm16_sse(_oy);
+				const auto _packed = _mm_unpacklo_epi16(_mm_packs_epi32(_sx, _sx), _mm_packs_epi32(_sy, _sy));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(_dst + _vertex * 2), _packed);
+			};
+#endif
+			for (; _vertex != _vertexCount; ++_vertex)
+			{
+				const auto _p = _src + _vertex * 3;
+				const auto _e = oct_encode(_p[0], _p[1], _p[2]);
+				_dst[_vertex * 2 + 0] = float_to_snorm16(_e[0]);
+				_dst[_vertex * 2 + 1] = float_to_snorm16(_e[1]);
+			};
+		};
+
+		/**
+		 * @brief Octahedral encodes packed xyzw tangents into 2 normalized 16-bit signed values,
+		 * the handedness, and a padding value.
+		*/
+		inline void quantize_tangents(std::span<const gl_float> _tangents, std::span<gl_short> _out) noexcept
+		{
+			const size_t _vertexCount = _tangents.size() / 4;
+			const auto _src = _tangents.data();
+			const auto _dst = _out.data();
+			size_t _vertex = 0;
+
+#if JCLIB_OPENGL_SSE2_V
+			const auto _zero = _mm_setzero_ps();
+			const auto _posOne = _mm_set1_epi32(32767);
+			const auto _negOne = _mm_set1_epi32(-32767);
+			for (; _vertex + 4 <= _vertexCount; _vertex += 4)
+			{
+				auto _x = _mm_loadu_ps(_src + _vertex * 4 + 0);
+				auto _y = _mm_loadu_ps(_src + _vertex * 4 + 4);
+				auto _z = _mm_loadu_ps(_src + _vertex * 4 + 8);
+				auto _w = _mm_loadu_ps(_src + _vertex * 4 + 12);
+				_MM_TRANSPOSE4_PS(_x, _y, _z, _w);
+
+				__m128 _ox, _oy;
+				oct_encode_sse(_x, _y, _z, _ox, _oy);
+
+				const auto _negative = _mm_castps_si128(_mm_cmplt_ps(_w, _zero));
+				const auto _sign = _mm_or_si128(_mm_and_si128(_negative, _negOne), _mm_andnot_si128(_negative, _posOne));
+
+				const auto _sx = snorm16_sse(_ox);
+				const auto _sy = snorm16_sse(_oy);
+				const auto _xy = _mm_unpacklo_epi16(_mm_packs_epi32(_sx, _sx), _mm_packs_epi32(_sy, _sy));
+				const auto _zw = _mm_unpacklo_epi16(_mm_packs_epi32(_sign, _sign), _mm_setzero_si128());
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(_dst + _vertex * 4 + 0), _mm_unpacklo_epi32(_xy, _zw));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(_dst + _vertex * 4 + 8), _mm_unpackhi_epi32(_xy, _zw));
+			};
+#endif
+			for (; _vertex != _vertexCount; ++_vertex)
+			{
+				const auto _p = _src + _vertex * 4;
+				const auto _e = oct_encode(_p[0], _p[1], _p[2]);
+				_dst[_vertex * 4 + 0] = float_to_snorm16(_e[0]);
+				_dst[_vertex * 4 + 1] = float_to_snorm16(_e[1]);
+				_dst[_vertex * 4 + 2] = (_p[3] < 0.0f) ? -32767 : 32767;
+				_dst[_vertex * 4 + 3] = 0;
+			};
+		};
+
+		/**
+		 * @brief Converts a float stream to half floats.
+		*/
+		inline void quantize_halfs(std::span<const gl_float> _values, std::span<gl_half_float> _out) noexcept
+		{
+			const size_t _count = _values.size();
+			const auto _src = _values.data();
+			const auto _dst = _out.data();
+			size_t n = 0;
+
+#if JCLIB_OPENGL_F16C_V
+			for (; n + 8 <= _count; n += 8)
+			{
+				const auto _v = _mm256_loadu_ps(_src + n);
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(_dst + n), _mm256_cvtps_ph(_v, _MM_FROUND_TO_NEAREST_INT));
+			};
+#endif
+			for (; n != _count; ++n)
+			{
+				_dst[n] = float_to_half(_src[n]);
+			};
+		};
+	};
+
+	/**
+	 * @brief Quantizes the vertex streams of a mesh.
+	 *
+	 * Positions are normalized to 16-bit unsigned values within the mesh bounds, normals and
+	 * tangents are octahedral encoded into 16-bit signed values, and uvs are converted to half floats.
+	 * The hot loops run 4 (SSE2) or 8 (F16C) values at a time when the target supports it.
+	 *
+	 * @param _streams Source float streams.
+	 * @return Quantized streams, their vertex format, and the size report.
+	*/
+	inline quantized_mesh quantize_mesh(const mesh_streams& _streams)
+	{
+		quantized_mesh _out{};
+		auto& _report = _out.report;
+
+		if (!_streams.positions.empty())
+		{
+			JCLIB_ASSERT(_streams.positions.size() % 3 == 0);
+			const auto _count = _streams.positions.size() / 3;
+			_report.vertex_count = _count;
+
+			std::array<gl_float, 3> _min{};
+			std::array<gl_float, 3> _max{};
+			gl_impl::compute_bounds(_streams.positions, _min, _max);
+
+			std::array<gl_float, 3> _scale{};
+			for (size_t c = 0; c != 3; ++c)
+			{
+				const auto _extent = _max[c] - _min[c];
+				_scale[c] = (_extent > 0.0f) ? (65535.0f / _extent) : 0.0f;
+				_out.layout.position_scale[c] = _extent;
+				_out.layout.position_offset[c] = _min[c];
+			};
+
+			_out.positions.resize(_count * 4);
+			gl_impl::quantize_positions(_streams.positions, _min, _scale, _out.positions);
+			_report.source_bytes += _streams.positions.size_bytes();
+			_report.quantized_bytes += _out.positions.size() * sizeof(gl_unsigned_short);
+		};
+		if (!_streams.normals.empty())
+		{
+			JCLIB_ASSERT(_streams.normals.size() % 3 == 0);
+			_out.normals.resize(_streams.normals.size() / 3 * 2);
+			gl_impl::quantize_normals(_streams.normals, _out.normals);
+			_report.source_bytes += _streams.normals.size_bytes();
+			_report.quantized_bytes += _out.normals.size() * sizeof(gl_short);
+		};
+		if (!_streams.tangents.empty())
+		{
+			JCLIB_ASSERT(_streams.tangents.size() % 4 == 0);
+			_out.tangents.resize(_streams.tangents.size());
+			gl_impl::quantize_tangents(_streams.tangents, _out.tangents);
+			_report.source_bytes += _streams.tangents.size_bytes();
+			_report.quantized_bytes += _out.tangents.size() * sizeof(gl_short);
+		};
+		if (!_streams.uvs.empty())
+		{
+			JCLIB_ASSERT(_streams.uvs.size() % 2 == 0);
+			_out.uvs.resize(_streams.uvs.size());
+			gl_impl::quantize_halfs(_streams.uvs, _out.uvs);
+			_report.source_bytes += _streams.uvs.size_bytes();
+			_report.quantized_bytes += _out.uvs.size() * sizeof(gl_half_float);
+		};
+
+		return _out;
+	};
+
+	/**
+	 * @brief Sets the format of a vertex attribute to read a quantized stream.
+	 * @param _attribute Attribute to set the format of.
+	 * @param _format Quantized stream format, see quantized_layout.
+	*/
+	inline void set_attribute_format(vertex_attribute_index _attribute, const quantized_attribute& _format)
+	{
+		set_attribute_format(_attribute, _format.type, _format.count, _format.normalized, 0);
+	};
+
+	/**
+	 * @brief Sets the position dequantization uniforms for a quantized mesh.
+	 * @param _program Program to set the uniforms on.
+	 * @param _scale Location of the vec3 scale uniform.
+	 * @param _offset Location of the vec3 offset uniform.
+	 * @param _layout Layout of the quantized mesh.
+	*/
+	inline void set_dequantize_uniform(const program_id& _program, const uniform_location& _scale, const uniform_location& _offset,
+		const quantized_layout& _layout)
+	{
+		const auto& s = _layout.position_scale;
+		const auto& o = _layout.position_offset;
+		set_uniform(_program, _scale, s[0], s[1], s[2]);
+		set_uniform(_program, _offset, o[0], o[1], o[2]);
+	};
+
+};
+#pragma endregion
+
+#endif // JCLIB_OPENGL_GLQUANTIZE_HPP
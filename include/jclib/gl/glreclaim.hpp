@@ -0,0 +1,423 @@
+#pragma once
+#ifndef JCLIB_OPENGL_GLRECLAIM_HPP
+#define JCLIB_OPENGL_GLRECLAIM_HPP
+
+/*
+	Deferred deletion of OpenGL objects released on threads without a context
+*/
+
+#include "gl.hpp"
+
+#include <jclib/type.h>
+
+#include <array>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+#define _JCLIB_OPENGL_GLRECLAIM_
+
+namespace jc::gl
+{
+	/**
+	 * @brief Collects object names released on other threads so the context's thread can delete them in batches.
+	 *
+	 * Pushing is lock-free and safe from any thread. reclaim() must be called regularly on the thread owning the
+	 * context, usually once per frame, and deletes everything queued with one glDelete* call per object type
+	 * where OpenGL allows it.
+	 *
+	 * Queue nodes are recycled: reclaim() hands them back to a free list, and a pushing thread takes that whole
+	 * list into a thread local cache with one exchange. push() only calls operator new while no recycled node
+	 * is available, which reserve() avoids by preallocating nodes up front.
+	 *
+	 * The thread local cache is shared by every reclaim_queue, not kept per instance. Nodes are plain heap
+	 * allocations so this is safe, but a thread pushing to several queues may spend nodes reserved for one
+	 * queue on another, and cached nodes outlive the queue they came from until the thread exits.
+	 *
+	 * Objects owned through reclaim_destroy (ie. reclaimable_texture) use global(), whose GL thread must be set
+	 * with set_gl_thread() before any are released off-thread. Until then releases are deleted immediately.
+	*/
+	class reclaim_queue
+	{
+	public:
+
+		/**
+		 * @brief Gets the queue used by reclaim_destroy.
+		*/
+		static reclaim_queue& global() noexcept
+		{
+			static reclaim_queue _queue{};
+			return _queue;
+		};
+
+		/**
+		 * @brief Sets the thread owning the context, objects released there are deleted immediately.
+		 * @param _thread Thread owning the context, defaults to the calling thread.
+		*/
+		void set_gl_thread(std::thread::id _thread = std::this_thread::get_id()) noexcept
+		{
+			this->gl_thread_.store(_thread, std::memory_order_release);
+		};
+
+		/**
+		 * @brief Checks if the calling thread may delete objects directly.
+		 * @return True on the GL thread or if no GL thread was set.
+		*/
+		bool on_gl_thread() const noexcept
+		{
+			const auto _thread = this->gl_thread_.load(std::memory_order_acquire);
+			return _thread == std::thread::id{} || _thread == std::this_thread::get_id();
+		};
+
+		/**
+		 * @brief Queues an object for deletion and nulls the id, safe to call from any thread.
+		 * @param _id Object to delete.
+		*/
+		template <object_type Type>
+		void push(object_id<Type>& _id)
+		{
+			auto _node = this->take_node();
+			_node->type = Type;
+			if constexpr (Type == object_type::sync)
+			{
+				_node->sync = _id.get();
+			}
+			else
+			{
+				_node->name = _id.get();
+			};
+			_id = jc::null;
+
+			_node->next = this->head_.load(std::memory_order_relaxed);
+			while (!this->head_.compare_exchange_weak(_node->next, _node, std::memory_order_release, std::memory_order_relaxed))
+			{};
+			this->pending_.fetch_add(1, std::memory_order_relaxed);
+		};
+
+		/**
+		 * @brief Preallocates nodes so the next pushes don't allocate.
+		 * @param _count Number of nodes to add to the free list.
+		*/
+		void reserve(size_t _count)
+		{
+			node* _first = nullptr;
+			node* _last = nullptr;
+			for (size_t n = 0; n != _count; ++n)
+			{
+				_first = new node{ _first };
+				if (!_last)
+				{
+					_last = _first;
+				};
+			};
+			this->recycle(_first, _last);
+		};
+
+		/**
+		 * @brief Deletes every queued object, only call from the GL thread.
+		 * @return Number of objects deleted.
+		*/
+		size_t reclaim()
+		{
+			auto _list = this->head_.exchange(nullptr, std::memory_order_acquire);
+			if (!_list)
+			{
+				return 0;
+			};
+
+			size_t _count = 0;
+			const auto _first = _list;
+			node* _last = nullptr;
+			while (_list)
+			{
+				const auto _node = _list;
+				_last = _node;
+				_list = _list->next;
+				if (_node->type == object_type::sync)
+				{
+					this->syncs_.push_back(_node->sync);
+				}
+				else
+				{
+					this->names_[batch_index(_node->type)].push_back(_node->name);
+				};
+				++_count;
+			};
+			this->pending_.fetch_sub(_count, std::memory_order_relaxed);
+			this->recycle(_first, _last);
+
+			for (size_t n = 0; n != this->names_.size(); ++n)
+			{
+				auto& _names = this->names_[n];
+				if (!_names.empty())
+				{
+					delete_names(static_cast<batch>(n), _names);
+					_names.clear();
+				};
+			};
+			for (auto& _sync : this->syncs_)
+			{
+				glDeleteSync(_sync);
+			};
+			this->syncs_.clear();
+
+			this->reclaimed_ += _count;
+			++this->batches_;
+			return _count;
+		};
+
+		/**
+		 * @brief Gets the number of objects waiting to be deleted, safe to call from any thread.
+		*/
+		size_t pending() const noexcept
+		{
+			return this->pending_.load(std::memory_order_relaxed);
+		};
+
+		/**
+		 * @brief Gets the number of objects deleted by reclaim().
+		*/
+		size_t reclaimed() const noexcept { return this->reclaimed_; };
+
+		/**
+		 * @brief Gets the number of reclaim() calls that deleted anything.
+		*/
+		size_t batches() const noexcept { return this->batches_; };
+
+		reclaim_queue() = default;
+
+		/**
+		 * @brief Frees the queue without deleting anything, the context is usually gone by now.
+		*/
+		~reclaim_queue()
+		{
+			for (auto& _head : { &this->head_, &this->free_ })
+			{
+				auto _list = _head->exchange(nullptr, std::memory_order_acquire);
+				while (_list)
+				{
+					delete std::exchange(_list, _list->next);
+				};
+			};
+		};
+
+		reclaim_queue(const reclaim_queue&) = delete;
+		reclaim_queue& operator=(const reclaim_queue&) = delete;
+
+	private:
+
+		struct node
+		{
+			node* next = nullptr;
+			object_type type{};
+			GLuint name = 0;
+			GLsync sync = nullptr;
+		};
+
+		/**
+		 * @brief Nodes a thread took from a free list, deleted when the thread exits.
+		*/
+		struct node_cache
+		{
+			node* head = nullptr;
+
+			~node_cache()
+			{
+				while (this->head)
+				{
+					delete std::exchange(this->head, this->head->next);
+				};
+			};
+		};
+
+		/**
+		 * @brief Gets a node from the calling thread's cache, refilling it from the free list first if empty.
+		 *
+		 * The cache is shared by all queues, see the class comment.
+		*/
+		node* take_node()
+		{
+			thread_local node_cache _cache{};
+			if (!_cache.head)
+			{
+				// Taking the whole list with one exchange avoids the ABA problem of popping single nodes
+				_cache.head = this->free_.exchange(nullptr, std::memory_order_acquire);
+			};
+			if (!_cache.head)
+			{
+				return new node{};
+			};
+			auto _node = std::exchange(_cache.head, _cache.head->next);
+			*_node = node{};
+			return _node;
+		};
+
+		/**
+		 * @brief Pushes a linked list of nodes onto the free list.
+		*/
+		void recycle(node* _first, node* _last) noexcept
+		{
+			if (!_first)
+			{
+				return;
+			};
+			_last->next = this->free_.load(std::memory_order_relaxed);
+			while (!this->free_.compare_exchange_weak(_last->next, _first, std::memory_order_release, std::memory_order_relaxed))
+			{};
+		};
+
+		/**
+		 * @brief Object types with a name based delete function.
+		*/
+		enum class batch : uint8_t
+		{
+			shader,
+			program,
+			vao,
+			vbo,
+			program_pipeline,
+			texture,
+			framebuffer,
+			renderbuffer,
+			count_
+		};
+
+		static size_t batch_index(object_type _type) noexcept
+		{
+			switch (_type)
+			{
+			case object_type::shader: return jc::to_underlying(batch::shader);
+			case object_type::program: return jc::to_underlying(batch::program);
+			case object_type::vao: return jc::to_underlying(batch::vao);
+			case object_type::vbo: return jc::to_underlying(batch::vbo);
+			case object_type::program_pipeline: return jc::to_underlying(batch::program_pipeline);
+			case object_type::texture: return jc::to_underlying(batch::texture);
+			case object_type::framebuffer: return jc::to_underlying(batch::framebuffer);
+			case object_type::renderbuffer: return jc::to_underlying(batch::renderbuffer);
+			default:
+				JCLIB_ASSERT(false);
+				return 0;
+			};
+		};
+
+		static void delete_names(batch _batch, const std::vector<GLuint>& _names)
+		{
+			const auto _count = static_cast<GLsizei>(_names.size());
+			switch (_batch)
+			{
+			case batch::shader:
+				// Shaders and programs can only be deleted one at a time
+				for (auto& _name : _names)
+				{
+					glDeleteShader(_name);
+				};
+				break;
+			case batch::program:
+				for (auto& _name : _names)
+				{
+					glDeleteProgram(_name);
+				};
+				break;
+			case batch::vao:
+				glDeleteVertexArrays(_count, _names.data());
+				break;
+			case batch::vbo:
+#if JCLIB_OPENGL_MEMORY_TRACKING_V
+				for (auto& _name : _names)
+				{
+					gl_impl::track_release(memory_category::buffer, _name);
+				};
+#endif
+				glDeleteBuffers(_count, _names.data());
+				break;
+			case batch::program_pipeline:
+				glDeleteProgramPipelines(_count, _names.data());
+				break;
+			case batch::texture:
+#if JCLIB_OPENGL_MEMORY_TRACKING_V
+				for (auto& _name : _names)
+				{
+					gl_impl::track_release(memory_category::texture, _name);
+				};
+#endif
+				glDeleteTextures(_count, _names.data());
+				break;
+			case batch::framebuffer:
+				glDeleteFramebuffers(_count, _names.data());
+				break;
+			case batch::renderbuffer:
+#if JCLIB_OPENGL_MEMORY_TRACKING_V
+				for (auto& _name : _names)
+				{
+					gl_impl::track_release(memory_category::renderbuffer, _name);
+				};
+#endif
+				glDeleteRenderbuffers(_count, _names.data());
+				break;
+			default:
+				break;
+			};
+		};
+
+		std::atomic<node*> head_{ nullptr };
+		std::atomic<node*> free_{ nullptr };
+		std::atomic<size_t> pending_{ 0 };
+		std::atomic<std::thread::id> gl_thread_{};
+
+		// Only touched by reclaim() on the GL thread
+		std::array<std::vector<GLuint>, static_cast<size_t>(batch::count_)> names_{};
+		std::vector<GLsync> syncs_{};
+		size_t reclaimed_ = 0;
+		size_t batches_ = 0;
+	};
+
+	/**
+	 * @brief Destroy policy for unique_object that defers deletion to reclaim_queue::global() off the GL thread.
+	*/
+	struct reclaim_destroy
+	{
+		template <object_type Type>
+		static void destroy(object_id<Type>& _id)
+		{
+			auto& _queue = reclaim_queue::global();
+			if (_queue.on_gl_thread())
+			{
+				gl::destroy(_id);
+			}
+			else
+			{
+				_queue.push(_id);
+			};
+		};
+	};
+
+	/**
+	 * @brief Owning handle that may be released from any thread, see reclaim_queue.
+	*/
+	template <object_type Type>
+	using reclaimable_object = unique_object<Type, reclaim_destroy>;
+
+	using reclaimable_shader = reclaimable_object<object_type::shader>;
+	using reclaimable_program = reclaimable_object<object_type::program>;
+	using reclaimable_vao = reclaimable_object<object_type::vao>;
+	using reclaimable_vbo = reclaimable_object<object_type::vbo>;
+	using reclaimable_texture = reclaimable_object<object_type::texture>;
+	using reclaimable_framebuffer = reclaimable_object<object_type::framebuffer>;
+	using reclaimable_renderbuffer = reclaimable_object<object_type::renderbuffer>;
+	using reclaimable_sync = reclaimable_object<object_type::sync>;
+
+	/**
+	 * @brief Deletes the objects released off the GL thread, only call from the GL thread.
+	 * @return Number of objects deleted.
+	*/
+	inline size_t reclaim()
+	{
+		return reclaim_queue::global().reclaim();
+	};
+
+};
+
+#endif // JCLIB_OPENGL_GLRECLAIM_HPP
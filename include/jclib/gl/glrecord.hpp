@@ -0,0 +1,1520 @@
+#pragma once
+#ifndef JCLIB_OPENGL_GLRECORD_HPP
+#define JCLIB_OPENGL_GLRECORD_HPP
+
+/*
+	Recording OpenGL backend that replaces glad's function pointers, for driverless call count tests
+*/
+
+#include "gllib.hpp"
+
+#include <glad/glad.h>
+
+#include <jclib/type.h>
+
+#include <span>
+#include <array>
+#include <tuple>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include <algorithm>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+
+#define _JCLIB_OPENGL_GLRECORD_
+
+#pragma region RECORD_FUNCTIONS
+
+/*
+	The functions replaced by the recording backend, X(name) per function, grouped by the version guard
+	they need. Glad defines each function name as a macro for its glad_ pointer, so anything generated
+	from these lists without token pasting (such as the record_entry enumerators) uses the glad_ name.
+	Refer to them with the plain function name and the macro keeps both sides in agreement.
+*/
+
+#define JCLIB_OPENGL_RECORD_FUNCTIONS_3_3(X) \
+	X(glActiveTexture) \
+	X(glAttachShader) \
+	X(glBindBuffer) \
+	X(glBindBufferBase) \
+	X(glBindBufferRange) \
+	X(glBindFramebuffer) \
+	X(glBindRenderbuffer) \
+	X(glBindTexture) \
+	X(glBindVertexArray) \
+	X(glBlendEquation) \
+	X(glBlendFunc) \
+	X(glBlendFuncSeparate) \
+	X(glBlitFramebuffer) \
+	X(glBufferData) \
+	X(glBufferSubData) \
+	X(glCheckFramebufferStatus) \
+	X(glClear) \
+	X(glClearColor) \
+	X(glClearDepth) \
+	X(glClearStencil) \
+	X(glClientWaitSync) \
+	X(glColorMask) \
+	X(glCompileShader) \
+	X(glCopyBufferSubData) \
+	X(glCreateProgram) \
+	X(glCreateShader) \
+	X(glCullFace) \
+	X(glDeleteBuffers) \
+	X(glDeleteFramebuffers) \
+	X(glDeleteProgram) \
+	X(glDeleteRenderbuffers) \
+	X(glDeleteShader) \
+	X(glDeleteSync) \
+	X(glDeleteTextures) \
+	X(glDeleteVertexArrays) \
+	X(glDepthFunc) \
+	X(glDepthMask) \
+	X(glDetachShader) \
+	X(glDisable) \
+	X(glDrawArrays) \
+	X(glDrawArraysInstanced) \
+	X(glDrawBuffers) \
+	X(glDrawElements) \
+	X(glDrawElementsInstanced) \
+	X(glEnable) \
+	X(glEnableVertexAttribArray) \
+	X(glFenceSync) \
+	X(glFinish) \
+	X(glFlush) \
+	X(glFlushMappedBufferRange) \
+	X(glFramebufferRenderbuffer) \
+	X(glFramebufferTexture) \
+	X(glFramebufferTextureLayer) \
+	X(glFrontFace) \
+	X(glGenBuffers) \
+	X(glGenerateMipmap) \
+	X(glGenFramebuffers) \
+	X(glGenRenderbuffers) \
+	X(glGenTextures) \
+	X(glGenVertexArrays) \
+	X(glGetAttribLocation) \
+	X(glGetBufferParameteriv) \
+	X(glGetError) \
+	X(glGetFloatv) \
+	X(glGetInteger64v) \
+	X(glGetIntegeri_v) \
+	X(glGetIntegerv) \
+	X(glGetProgramInfoLog) \
+	X(glGetProgramiv) \
+	X(glGetShaderInfoLog) \
+	X(glGetShaderiv) \
+	X(glGetString) \
+	X(glGetStringi) \
+	X(glGetSynciv) \
+	X(glGetTexParameteriv) \
+	X(glGetUniformBlockIndex) \
+	X(glGetUniformLocation) \
+	X(glIsBuffer) \
+	X(glIsEnabled) \
+	X(glIsFramebuffer) \
+	X(glIsProgram) \
+	X(glIsRenderbuffer) \
+	X(glIsShader) \
+	X(glIsSync) \
+	X(glIsTexture) \
+	X(glIsVertexArray) \
+	X(glLineWidth) \
+	X(glLinkProgram) \
+	X(glMapBufferRange) \
+	X(glPixelStorei) \
+	X(glPolygonMode) \
+	X(glReadBuffer) \
+	X(glReadPixels) \
+	X(glRenderbufferStorage) \
+	X(glRenderbufferStorageMultisample) \
+	X(glScissor) \
+	X(glShaderSource) \
+	X(glStencilFunc) \
+	X(glStencilMask) \
+	X(glStencilOp) \
+	X(glTexBuffer) \
+	X(glTexImage2D) \
+	X(glTexParameteri) \
+	X(glTexSubImage1D) \
+	X(glTexSubImage2D) \
+	X(glTexSubImage3D) \
+	X(glUniform1f) \
+	X(glUniform1i) \
+	X(glUniform2f) \
+	X(glUniform3f) \
+	X(glUniform4f) \
+	X(glUniform4fv) \
+	X(glUniformBlockBinding) \
+	X(glUniformMatrix4fv) \
+	X(glUnmapBuffer) \
+	X(glUseProgram) \
+	X(glVertexAttribDivisor) \
+	X(glVertexAttribPointer) \
+	X(glViewport) \
+	X(glWaitSync)
+
+#if GL_VERSION_4_1
+#define JCLIB_OPENGL_RECORD_FUNCTIONS_4_1(X) \
+	X(glBindProgramPipeline) \
+	X(glDeleteProgramPipelines) \
+	X(glGetProgramBinary) \
+	X(glIsProgramPipeline) \
+	X(glProgramBinary) \
+	X(glProgramUniform1d) \
+	X(glProgramUniform1f) \
+	X(glProgramUniform1ui) \
+	X(glProgramUniform2d) \
+	X(glProgramUniform2f) \
+	X(glProgramUniform2fv) \
+	X(glProgramUniform3d) \
+	X(glProgramUniform3f) \
+	X(glProgramUniform3fv) \
+	X(glProgramUniform4d) \
+	X(glProgramUniform4f) \
+	X(glProgramUniform4fv) \
+	X(glProgramUniformMatrix2fv) \
+	X(glProgramUniformMatrix3fv) \
+	X(glProgramUniformMatrix4fv) \
+	X(glUseProgramStages)
+#else
+#define JCLIB_OPENGL_RECORD_FUNCTIONS_4_1(X)
+#endif
+
+#if GL_VERSION_4_3
+#define JCLIB_OPENGL_RECORD_FUNCTIONS_4_3(X) \
+	X(glBindVertexBuffer) \
+	X(glCopyImageSubData) \
+	X(glDebugMessageCallback) \
+	X(glDebugMessageInsert) \
+	X(glDispatchCompute) \
+	X(glDispatchComputeIndirect) \
+	X(glDrawArraysIndirect) \
+	X(glDrawElementsIndirect) \
+	X(glGetProgramInterfaceiv) \
+	X(glGetProgramResourceIndex) \
+	X(glGetProgramResourceLocation) \
+	X(glGetProgramResourceName) \
+	X(glGetProgramResourceiv) \
+	X(glInvalidateFramebuffer) \
+	X(glInvalidateSubFramebuffer) \
+	X(glMemoryBarrier) \
+	X(glMultiDrawArraysIndirect) \
+	X(glMultiDrawElementsIndirect) \
+	X(glObjectLabel) \
+	X(glObjectPtrLabel) \
+	X(glPopDebugGroup) \
+	X(glPushDebugGroup) \
+	X(glShaderStorageBlockBinding) \
+	X(glTexStorage1D) \
+	X(glTexStorage2D) \
+	X(glTexStorage3D) \
+	X(glVertexAttribBinding) \
+	X(glVertexAttribFormat) \
+	X(glVertexBindingDivisor)
+#else
+#define JCLIB_OPENGL_RECORD_FUNCTIONS_4_3(X)
+#endif
+
+#if GL_VERSION_4_5
+#define JCLIB_OPENGL_RECORD_FUNCTIONS_4_5(X) \
+	X(glBindTextureUnit) \
+	X(glBlitNamedFramebuffer) \
+	X(glBufferStorage) \
+	X(glCheckNamedFramebufferStatus) \
+	X(glClearNamedFramebufferfv) \
+	X(glCopyNamedBufferSubData) \
+	X(glCreateBuffers) \
+	X(glCreateFramebuffers) \
+	X(glCreateProgramPipelines) \
+	X(glCreateRenderbuffers) \
+	X(glCreateTextures) \
+	X(glCreateVertexArrays) \
+	X(glDisableVertexArrayAttrib) \
+	X(glEnableVertexArrayAttrib) \
+	X(glFlushMappedNamedBufferRange) \
+	X(glGenerateTextureMipmap) \
+	X(glGetNamedBufferParameteriv) \
+	X(glGetNamedBufferSubData) \
+	X(glGetTextureLevelParameteriv) \
+	X(glGetTextureParameteriv) \
+	X(glInvalidateNamedFramebufferData) \
+	X(glInvalidateNamedFramebufferSubData) \
+	X(glMapNamedBufferRange) \
+	X(glMemoryBarrierByRegion) \
+	X(glNamedBufferData) \
+	X(glNamedBufferStorage) \
+	X(glNamedBufferSubData) \
+	X(glNamedFramebufferDrawBuffers) \
+	X(glNamedFramebufferReadBuffer) \
+	X(glNamedFramebufferRenderbuffer) \
+	X(glNamedFramebufferTexture) \
+	X(glNamedFramebufferTextureLayer) \
+	X(glNamedRenderbufferStorage) \
+	X(glNamedRenderbufferStorageMultisample) \
+	X(glTextureBuffer) \
+	X(glTextureParameteri) \
+	X(glTextureParameteriv) \
+	X(glTextureStorage1D) \
+	X(glTextureStorage2D) \
+	X(glTextureStorage3D) \
+	X(glTextureSubImage1D) \
+	X(glTextureSubImage2D) \
+	X(glTextureSubImage3D) \
+	X(glUnmapNamedBuffer) \
+	X(glVertexArrayAttribBinding) \
+	X(glVertexArrayAttribFormat) \
+	X(glVertexArrayBindingDivisor) \
+	X(glVertexArrayElementBuffer) \
+	X(glVertexArrayVertexBuffer)
+#else
+#define JCLIB_OPENGL_RECORD_FUNCTIONS_4_5(X)
+#endif
+
+/**
+ * @brief Every function replaced by the recording backend, X(name) per function.
+*/
+#define JCLIB_OPENGL_RECORD_FUNCTIONS(X) \
+	JCLIB_OPENGL_RECORD_FUNCTIONS_3_3(X) \
+	JCLIB_OPENGL_RECORD_FUNCTIONS_4_1(X) \
+	JCLIB_OPENGL_RECORD_FUNCTIONS_4_3(X) \
+	JCLIB_OPENGL_RECORD_FUNCTIONS_4_5(X)
+
+#pragma endregion
+
+#pragma region RECORD_ENTRY
+namespace jc::gl
+{
+	/**
+	 * @brief Identifies a recorded OpenGL entry point, named after the function.
+	*/
+	enum class record_entry : uint16_t
+	{
+#define JCLIB_OPENGL_RECORD_ENTRY(_name) _name,
+		JCLIB_OPENGL_RECORD_FUNCTIONS(JCLIB_OPENGL_RECORD_ENTRY)
+#undef JCLIB_OPENGL_RECORD_ENTRY
+
+		/**
+		 * @brief Number of entries, not a real entry point.
+		*/
+		count,
+	};
+
+	/**
+	 * @brief Number of recorded entry points.
+	*/
+	constexpr inline size_t record_entry_count = jc::to_underlying(record_entry::count);
+
+	/**
+	 * @brief Breaks an OpenGL function pointer type into its result and argument types.
+	*/
+	template <typename FnT>
+	struct record_signature;
+
+	template <typename RetT, typename... ArgTs>
+	struct record_signature<RetT(APIENTRY*)(ArgTs...)>
+	{
+		using result_type = RetT;
+		using args_type = std::tuple<ArgTs...>;
+
+		/**
+		 * @brief Size of the packed arguments in a record.
+		*/
+		constexpr static size_t arg_bytes = (size_t{ 0 } + ... + sizeof(ArgTs));
+	};
+
+	/**
+	 * @brief Compile time information about a recorded entry point.
+	 *
+	 * pointer() gives the glad function pointer currently installed for the entry point.
+	*/
+	template <record_entry Entry>
+	struct record_entry_traits;
+
+#define JCLIB_OPENGL_RECORD_ENTRY_TRAITS(_name) \
+	template <> \
+	struct record_entry_traits<record_entry::_name> \
+	{ \
+		using function_type = decltype(glad_##_name); \
+		using signature = record_signature<function_type>; \
+		constexpr static std::string_view name = #_name; \
+		static function_type& pointer() noexcept { return glad_##_name; } \
+	};
+	JCLIB_OPENGL_RECORD_FUNCTIONS(JCLIB_OPENGL_RECORD_ENTRY_TRAITS)
+#undef JCLIB_OPENGL_RECORD_ENTRY_TRAITS
+
+	namespace gl_impl
+	{
+		constexpr inline std::array<std::string_view, record_entry_count> record_entry_names
+		{
+#define JCLIB_OPENGL_RECORD_ENTRY_NAME(_name) std::string_view{ #_name },
+			JCLIB_OPENGL_RECORD_FUNCTIONS(JCLIB_OPENGL_RECORD_ENTRY_NAME)
+#undef JCLIB_OPENGL_RECORD_ENTRY_NAME
+		};
+
+		constexpr inline std::array<size_t, record_entry_count> record_entry_arg_bytes
+		{
+#define JCLIB_OPENGL_RECORD_ENTRY_ARG_BYTES(_name) record_signature<decltype(glad_##_name)>::arg_bytes,
+			JCLIB_OPENGL_RECORD_FUNCTIONS(JCLIB_OPENGL_RECORD_ENTRY_ARG_BYTES)
+#undef JCLIB_OPENGL_RECORD_ENTRY_ARG_BYTES
+		};
+
+		/**
+		 * @brief Mixes a value into a hash, used to compare multi argument binding state.
+		*/
+		constexpr inline uint64_t record_hash_combine(uint64_t _hash, uint64_t _value) noexcept
+		{
+			return (_hash ^ _value) * 0x100000001B3ull + 0x9E3779B97F4A7C15ull;
+		};
+	};
+
+	/**
+	 * @brief Gets the OpenGL function name of a recorded entry point.
+	*/
+	constexpr inline std::string_view to_string(record_entry _entry) noexcept
+	{
+		return (_entry < record_entry::count) ? gl_impl::record_entry_names[jc::to_underlying(_entry)] : "";
+	};
+
+	/**
+	 * @brief Gets the size of an entry point's packed arguments in a record.
+	*/
+	constexpr inline size_t record_arg_bytes(record_entry _entry) noexcept
+	{
+		return gl_impl::record_entry_arg_bytes[jc::to_underlying(_entry)];
+	};
+
+	/**
+	 * @brief One recorded call, the arguments are packed in declaration order without padding.
+	*/
+	struct record_view
+	{
+		record_entry entry;
+		std::span<const std::byte> args;
+	};
+
+	/**
+	 * @brief Unpacks the arguments of a recorded call.
+	 * @tparam Entry Entry point the record must be for.
+	 * @return The arguments as a tuple.
+	*/
+	template <record_entry Entry>
+	inline auto decode_args(const record_view& _record)
+	{
+		using args_type = typename record_entry_traits<Entry>::signature::args_type;
+		JCLIB_ASSERT(_record.entry == Entry);
+		JCLIB_ASSERT(_record.args.size() == record_arg_bytes(Entry));
+
+		args_type _args{};
+		size_t _offset = 0;
+		std::apply([&_record, &_offset](auto&... _arg)
+		{
+			((std::memcpy(&_arg, _record.args.data() + _offset, sizeof(_arg)), _offset += sizeof(_arg)), ...);
+		}, _args);
+		return _args;
+	};
+
+	/**
+	 * @brief Walks the records written by a recording_backend.
+	 *
+	 * Each record is a uint16_t entry id followed by the packed arguments.
+	*/
+	class record_reader
+	{
+	public:
+
+		/**
+		 * @brief Reads the next record.
+		 * @param _out Set to the record.
+		 * @return True if a record was read, false at the end of the data.
+		*/
+		bool next(record_view& _out)
+		{
+			if (this->data_.size() < sizeof(uint16_t))
+			{
+				return false;
+			};
+
+			uint16_t _id{};
+			std::memcpy(&_id, this->data_.data(), sizeof(_id));
+			JCLIB_ASSERT(_id < record_entry_count);
+
+			const auto _entry = static_cast<record_entry>(_id);
+			const auto _size = record_arg_bytes(_entry);
+			JCLIB_ASSERT(this->data_.size() >= sizeof(uint16_t) + _size);
+
+			_out = record_view{ _entry, this->data_.subspan(sizeof(uint16_t), _size) };
+			this->data_ = this->data_.subspan(sizeof(uint16_t) + _size);
+			return true;
+		};
+
+		explicit record_reader(std::span<const std::byte> _data) noexcept :
+			data_{ _data }
+		{};
+
+	private:
+		std::span<const std::byte> data_;
+	};
+
+};
+#pragma endregion
+
+#pragma region RECORDING_BACKEND
+namespace jc::gl
+{
+	/**
+	 * @brief Pieces of binding state tracked to detect redundant state changes.
+	*/
+	enum class record_state : uint8_t
+	{
+		buffer,
+		indexed_buffer,
+		vertex_buffer,
+		vao,
+		program,
+		program_pipeline,
+		active_texture,
+		texture,
+		texture_unit,
+		draw_framebuffer,
+		read_framebuffer,
+		renderbuffer,
+		capability,
+	};
+
+	/**
+	 * @brief Texture storage seen by a recording_backend, used to answer texture queries.
+	*/
+	struct record_texture
+	{
+		GLenum target = 0;
+		GLenum format = 0;
+		GLsizei levels = 0;
+		GLsizei width = 0;
+		GLsizei height = 0;
+		GLsizei depth = 0;
+
+		/**
+		 * @brief Gets a level's width, height or depth as GL_TEXTURE_WIDTH/HEIGHT/DEPTH would, 0 past the last level.
+		 * @param _axis 0 for width, 1 for height, 2 for depth.
+		*/
+		GLint level_size(GLint _level, int _axis) const noexcept
+		{
+			if (_level < 0 || _level >= this->levels)
+			{
+				return 0;
+			};
+
+			const auto _shrink = [_level](GLsizei _size) { return std::max<GLint>(_size >> _level, 1); };
+			switch (_axis)
+			{
+			case 0:
+				return _shrink(this->width);
+			case 1:
+				switch (this->target)
+				{
+				case GL_TEXTURE_1D:
+					return 1;
+				case GL_TEXTURE_1D_ARRAY:
+					// Array layers don't shrink
+					return this->height;
+				default:
+					return _shrink(this->height);
+				};
+			default:
+				switch (this->target)
+				{
+				case GL_TEXTURE_3D:
+					return _shrink(this->depth);
+				case GL_TEXTURE_2D_ARRAY: [[fallthrough]];
+				case GL_TEXTURE_CUBE_MAP_ARRAY:
+					return this->depth;
+				default:
+					return 1;
+				};
+			};
+		};
+	};
+
+	/**
+	 * @brief Replaces glad's function pointers with functions that record each call and return fake results.
+	 *
+	 * No driver or context is needed while installed. Every call appends a compact binary record
+	 * (see record_reader) and bumps a per entry point call count. Calls that set binding state to the
+	 * value it already has are counted as redundant, so tests can assert exact call counts and catch
+	 * redundant state changes made by higher level code.
+	 *
+	 * Fake results are plausible rather than meaningful: object names count up from 1, compile, link
+	 * and framebuffer status checks succeed, fences are always signaled, mapped ranges point at
+	 * scratch memory owned by the backend, integer and float queries return values set with set_integer()
+	 * and set_float() and texture queries describe the storage set with glTextureStorage*.
+	 *
+	 * Only one backend may be installed at a time, and it must only be called from one thread.
+	*/
+	class recording_backend
+	{
+	public:
+
+		/**
+		 * @brief Gets the installed backend, null if none is installed.
+		*/
+		static recording_backend* active() noexcept { return active_; };
+
+		/**
+		 * @brief Installs the backend, saving the current function pointers.
+		*/
+		void install();
+
+		/**
+		 * @brief Restores the function pointers saved by install().
+		*/
+		void uninstall();
+
+		/**
+		 * @brief Checks if this backend is installed.
+		*/
+		bool installed() const noexcept { return active_ == this; };
+
+		/**
+		 * @brief Gets the recorded calls, read them with record_reader.
+		*/
+		std::span<const std::byte> records() const noexcept { return this->records_; };
+
+		/**
+		 * @brief Sets whether calls are written to the record buffer, calls are counted either way.
+		*/
+		void set_recording(bool _enabled) noexcept { this->recording_ = _enabled; };
+
+		/**
+		 * @brief Gets the number of calls made to an entry point.
+		*/
+		size_t call_count(record_entry _entry) const noexcept
+		{
+			return this->calls_[jc::to_underlying(_entry)];
+		};
+
+		/**
+		 * @brief Gets the number of calls made to an entry point that set state to the value it already had.
+		*/
+		size_t redundant_count(record_entry _entry) const noexcept
+		{
+			return this->redundant_[jc::to_underlying(_entry)];
+		};
+
+		/**
+		 * @brief Gets the number of calls made to any entry point.
+		*/
+		size_t total_calls() const noexcept
+		{
+			size_t _total = 0;
+			for (auto& c : this->calls_)
+			{
+				_total += c;
+			};
+			return _total;
+		};
+
+		/**
+		 * @brief Gets the number of redundant state changes made through any entry point.
+		*/
+		size_t total_redundant() const noexcept
+		{
+			size_t _total = 0;
+			for (auto& c : this->redundant_)
+			{
+				_total += c;
+			};
+			return _total;
+		};
+
+		/**
+		 * @brief Clears the records and counts, tracked state and object names are kept.
+		*/
+		void clear() noexcept
+		{
+			this->records_.clear();
+			this->calls_.fill(0);
+			this->redundant_.fill(0);
+		};
+
+		/**
+		 * @brief Forgets all tracked binding state, as if on a fresh context.
+		*/
+		void reset_state() noexcept
+		{
+			this->state_.clear();
+		};
+
+		/**
+		 * @brief Sets the value glGetIntegerv and glGetInteger64v return for a parameter.
+		*/
+		void set_integer(GLenum _parameter, GLint64 _value)
+		{
+			this->integers_[_parameter] = _value;
+		};
+
+		/**
+		 * @brief Sets the value glGetIntegeri_v returns for one index of an indexed parameter.
+		*/
+		void set_integer(GLenum _parameter, GLuint _index, GLint64 _value)
+		{
+			this->indexed_integers_[indexed_key(_parameter, _index)] = _value;
+		};
+
+		/**
+		 * @brief Sets the value glGetFloatv returns for a parameter, parameters without one return their integer value.
+		*/
+		void set_float(GLenum _parameter, GLfloat _value)
+		{
+			this->floats_[_parameter] = _value;
+		};
+
+		/**
+		 * @brief Adds an extension reported through glGetStringi and GL_NUM_EXTENSIONS.
+		*/
+		void add_extension(std::string _name)
+		{
+			this->extensions_.push_back(std::move(_name));
+			this->integers_[GL_NUM_EXTENSIONS] = static_cast<GLint64>(this->extensions_.size());
+		};
+
+		/**
+		 * @brief Appends a record for a call, used by the installed functions.
+		*/
+		template <typename... ArgTs>
+		void append(record_entry _entry, const ArgTs&... _args)
+		{
+			++this->calls_[jc::to_underlying(_entry)];
+			if (!this->recording_)
+			{
+				return;
+			};
+
+			const auto _id = jc::to_underlying(_entry);
+			auto _offset = this->records_.size();
+			this->records_.resize(_offset + sizeof(_id) + (size_t{ 0 } + ... + sizeof(ArgTs)));
+
+			auto _out = this->records_.data() + _offset;
+			std::memcpy(_out, &_id, sizeof(_id));
+			_out += sizeof(_id);
+			((std::memcpy(_out, &_args, sizeof(_args)), _out += sizeof(_args)), ...);
+		};
+
+		/**
+		 * @brief Sets tracked state, counting the call as redundant if the state already had the value.
+		 * @return True if the call was redundant.
+		*/
+		bool track(record_entry _entry, record_state _state, uint64_t _key, uint64_t _value)
+		{
+			const auto [it, _inserted] = this->state_.try_emplace(state_key(_state, _key), _value);
+			if (!_inserted && it->second == _value)
+			{
+				++this->redundant_[jc::to_underlying(_entry)];
+				return true;
+			};
+			it->second = _value;
+			return false;
+		};
+
+		/**
+		 * @brief Sets tracked state without checking for redundancy.
+		*/
+		void set_state(record_state _state, uint64_t _key, uint64_t _value)
+		{
+			this->state_[state_key(_state, _key)] = _value;
+		};
+
+		/**
+		 * @brief Gets tracked state, 0 if never set.
+		*/
+		uint64_t get_state(record_state _state, uint64_t _key) const
+		{
+			const auto it = this->state_.find(state_key(_state, _key));
+			return (it != this->state_.end()) ? it->second : 0;
+		};
+
+		/**
+		 * @brief Hands out a new fake object name.
+		*/
+		GLuint new_name() noexcept
+		{
+			return this->next_name_++;
+		};
+
+		/**
+		 * @brief Fills an array with new fake object names.
+		*/
+		void new_names(GLsizei _count, GLuint* _names) noexcept
+		{
+			for (GLsizei n = 0; n != _count; ++n)
+			{
+				_names[n] = this->new_name();
+			};
+		};
+
+		/**
+		 * @brief Hands out a new fake sync object.
+		*/
+		GLsync new_sync() noexcept
+		{
+			return reinterpret_cast<GLsync>(static_cast<uintptr_t>(this->new_name()));
+		};
+
+		/**
+		 * @brief Gets the fake value of an integer parameter, 0 if never set.
+		*/
+		GLint64 integer(GLenum _parameter) const
+		{
+			const auto it = this->integers_.find(_parameter);
+			return (it != this->integers_.end()) ? it->second : 0;
+		};
+
+		/**
+		 * @brief Gets the fake value of one index of an indexed parameter, 0 if never set.
+		*/
+		GLint64 integer(GLenum _parameter, GLuint _index) const
+		{
+			const auto it = this->indexed_integers_.find(indexed_key(_parameter, _index));
+			return (it != this->indexed_integers_.end()) ? it->second : 0;
+		};
+
+		/**
+		 * @brief Gets the fake value of a float parameter, falling back to its integer value.
+		*/
+		GLfloat float_value(GLenum _parameter) const
+		{
+			const auto it = this->floats_.find(_parameter);
+			return (it != this->floats_.end()) ? it->second : static_cast<GLfloat>(this->integer(_parameter));
+		};
+
+		/**
+		 * @brief Gets a fake extension name, null if out of range.
+		*/
+		const GLubyte* extension(GLuint _index) const noexcept
+		{
+			return (_index < this->extensions_.size()) ?
+				reinterpret_cast<const GLubyte*>(this->extensions_[_index].c_str()) : nullptr;
+		};
+
+		/**
+		 * @brief Gets the tracked storage of a texture, created on first use.
+		*/
+		record_texture& texture(GLuint _texture)
+		{
+			return this->textures_[_texture];
+		};
+
+		/**
+		 * @brief Gets the tracked storage of a texture, null if the backend never saw it created.
+		*/
+		const record_texture* find_texture(GLuint _texture) const
+		{
+			const auto it = this->textures_.find(_texture);
+			return (it != this->textures_.end()) ? &it->second : nullptr;
+		};
+
+		/**
+		 * @brief Gets scratch memory standing in for a buffer's mapped storage.
+		 * @param _buffer Name of the mapped buffer.
+		 * @param _sizeBytes Minimum size of the scratch memory.
+		*/
+		std::byte* map(GLuint _buffer, size_t _sizeBytes)
+		{
+			auto& _memory = this->mappings_[_buffer];
+			if (_memory.size() < _sizeBytes)
+			{
+				_memory.resize(_sizeBytes);
+			};
+			return _memory.data();
+		};
+
+		recording_backend()
+		{
+			this->set_integer(GL_MAJOR_VERSION, 4);
+			this->set_integer(GL_MINOR_VERSION, 5);
+			this->set_integer(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, 256);
+			this->set_integer(GL_MAX_UNIFORM_BLOCK_SIZE, 65536);
+#if GL_VERSION_4_3
+			this->set_integer(GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT, 256);
+			this->set_integer(GL_MAX_SHADER_STORAGE_BLOCK_SIZE, 1 << 27);
+			this->set_integer(GL_MAX_COMPUTE_WORK_GROUP_INVOCATIONS, 1024);
+			for (GLuint n = 0; n != 3; ++n)
+			{
+				this->set_integer(GL_MAX_COMPUTE_WORK_GROUP_COUNT, n, 65535);
+				this->set_integer(GL_MAX_COMPUTE_WORK_GROUP_SIZE, n, (n == 2) ? 64 : 1024);
+			};
+#endif
+		};
+		~recording_backend()
+		{
+			this->uninstall();
+		};
+
+	private:
+
+		constexpr static uint64_t state_key(record_state _state, uint64_t _key) noexcept
+		{
+			return (static_cast<uint64_t>(_state) << 56) ^ _key;
+		};
+		constexpr static uint64_t indexed_key(GLenum _parameter, GLuint _index) noexcept
+		{
+			return (static_cast<uint64_t>(_parameter) << 32) | _index;
+		};
+
+#define JCLIB_OPENGL_RECORD_SAVED(_name) \
+		decltype(glad_##_name) _name##_ = nullptr;
+		JCLIB_OPENGL_RECORD_FUNCTIONS(JCLIB_OPENGL_RECORD_SAVED)
+#undef JCLIB_OPENGL_RECORD_SAVED
+
+		std::vector<std::byte> records_{};
+		std::array<size_t, record_entry_count> calls_{};
+		std::array<size_t, record_entry_count> redundant_{};
+		std::unordered_map<uint64_t, uint64_t> state_{};
+		std::unordered_map<GLenum, GLint64> integers_{};
+		std::unordered_map<uint64_t, GLint64> indexed_integers_{};
+		std::unordered_map<GLenum, GLfloat> floats_{};
+		std::unordered_map<GLuint, std::vector<std::byte>> mappings_{};
+		std::unordered_map<GLuint, record_texture> textures_{};
+		std::vector<std::string> extensions_{};
+		GLuint next_name_ = 1;
+		bool recording_ = true;
+
+		inline static recording_backend* active_ = nullptr;
+
+		recording_backend(const recording_backend&) = delete;
+		recording_backend& operator=(const recording_backend&) = delete;
+	};
+
+};
+#pragma endregion
+
+#pragma region RECORDING_HOOKS
+namespace jc::gl
+{
+	/**
+	 * @brief Customization point for the fake result and state tracking of an entry point.
+	 *
+	 * Specializations provide a static apply(recording_backend&, args...) returning the entry point's
+	 * result. Entry points without one return a value initialized result and leave out parameters alone.
+	*/
+	template <record_entry Entry>
+	struct recording_hook {};
+
+	namespace gl_impl
+	{
+		struct recording_hook_new_names
+		{
+			static void apply(recording_backend& _backend, GLsizei _count, GLuint* _names)
+			{
+				_backend.new_names(_count, _names);
+			};
+		};
+
+		struct recording_hook_new_name
+		{
+			static GLuint apply(recording_backend& _backend)
+			{
+				return _backend.new_name();
+			};
+		};
+
+		struct recording_hook_is
+		{
+			static GLboolean apply(recording_backend&, GLuint)
+			{
+				return GL_TRUE;
+			};
+		};
+
+		struct recording_hook_integer
+		{
+			template <typename T>
+			static void apply(recording_backend& _backend, GLenum _parameter, T* _out)
+			{
+				*_out = static_cast<T>(_backend.integer(_parameter));
+			};
+		};
+	};
+
+	template <> struct recording_hook<record_entry::glGenBuffers> : gl_impl::recording_hook_new_names {};
+	template <> struct recording_hook<record_entry::glGenFramebuffers> : gl_impl::recording_hook_new_names {};
+	template <> struct recording_hook<record_entry::glGenRenderbuffers> : gl_impl::recording_hook_new_names {};
+	template <> struct recording_hook<record_entry::glGenTextures> : gl_impl::recording_hook_new_names {};
+	template <> struct recording_hook<record_entry::glGenVertexArrays> : gl_impl::recording_hook_new_names {};
+	template <> struct recording_hook<record_entry::glCreateProgram> : gl_impl::recording_hook_new_name {};
+
+	template <> struct recording_hook<record_entry::glIsBuffer> : gl_impl::recording_hook_is {};
+	template <> struct recording_hook<record_entry::glIsFramebuffer> : gl_impl::recording_hook_is {};
+	template <> struct recording_hook<record_entry::glIsProgram> : gl_impl::recording_hook_is {};
+	template <> struct recording_hook<record_entry::glIsRenderbuffer> : gl_impl::recording_hook_is {};
+	template <> struct recording_hook<record_entry::glIsShader> : gl_impl::recording_hook_is {};
+	template <> struct recording_hook<record_entry::glIsTexture> : gl_impl::recording_hook_is {};
+	template <> struct recording_hook<record_entry::glIsVertexArray> : gl_impl::recording_hook_is {};
+
+	template <>
+	struct recording_hook<record_entry::glCreateShader>
+	{
+		static GLuint apply(recording_backend& _backend, GLenum)
+		{
+			return _backend.new_name();
+		};
+	};
+
+	template <>
+	struct recording_hook<record_entry::glIsSync>
+	{
+		static GLboolean apply(recording_backend&, GLsync _sync)
+		{
+			return (_sync) ? GL_TRUE : GL_FALSE;
+		};
+	};
+
+	template <>
+	struct recording_hook<record_entry::glGetIntegerv>
+	{
+		static void apply(recording_backend& _backend, GLenum _parameter, GLint* _out)
+		{
+			gl_impl::recording_hook_integer::apply(_backend, _parameter, _out);
+		};
+	};
+
+	template <>
+	struct recording_hook<record_entry::glGetInteger64v>
+	{
+		static void apply(recording_backend& _backend, GLenum _parameter, GLint64* _out)
+		{
+			gl_impl::recording_hook_integer::apply(_backend, _parameter, _out);
+		};
+	};
+
+	template <>
+	struct recording_hook<record_entry::glGetIntegeri_v>
+	{
+		static void apply(recording_backend& _backend, GLenum _parameter, GLuint _index, GLint* _out)
+		{
+			*_out = static_cast<GLint>(_backend.integer(_parameter, _index));
+		};
+	};
+
+	template <>
+	struct recording_hook<record_entry::glGetFloatv>
+	{
+		static void apply(recording_backend& _backend, GLenum _parameter, GLfloat* _out)
+		{
+			*_out = _backend.float_value(_parameter);
+		};
+	};
+
+	template <>
+	struct recording_hook<record_entry::glGetString>
+	{
+		static const GLubyte* apply(recording_backend&, GLenum _name)
+		{
+			switch (_name)
+			{
+			case GL_VENDOR:
+				return reinterpret_cast<const GLubyte*>("jclib");
+			case GL_RENDERER:
+				return reinterpret_cast<const GLubyte*>("jcopengl recording backend");
+			case GL_VERSION:
+				return reinterpret_cast<const GLubyte*>("4.5.0 Core Profile");
+			case GL_SHADING_LANGUAGE_VERSION:
+				return reinterpret_cast<const GLubyte*>("4.50");
+			default:
+				return nullptr;
+			};
+		};
+	};
+
+	template <>
+	struct recording_hook<record_entry::glGetStringi>
+	{
+		static const GLubyte* apply(recording_backend& _backend, GLenum _name, GLuint _index)
+		{
+			return (_name == GL_EXTENSIONS) ? _backend.extension(_index) : nullptr;
+		};
+	};
+
+	template <>
+	struct recording_hook<record_entry::glGetShaderiv>
+	{
+		static void apply(recording_backend&, GLuint, GLenum _parameter, GLint* _out)
+		{
+			*_out = (_parameter == GL_COMPILE_STATUS) ? GL_TRUE : 0;
+		};
+	};
+
+	template <>
+	struct recording_hook<record_entry::glGetProgramiv>
+	{
+		static void apply(recording_backend&, GLuint, GLenum _parameter, GLint* _out)
+		{
+			*_out = (_parameter == GL_LINK_STATUS || _parameter == GL_VALIDATE_STATUS) ? GL_TRUE : 0;
+		};
+	};
+
+	template <>
+	struct recording_hook<record_entry::glCheckFramebufferStatus>
+	{
+		static GLenum apply(recording_backend&, GLenum)
+		{
+			return GL_FRAMEBUFFER_COMPLETE;
+		};
+	};
+
+	template <>
+	struct recording_hook<record_entry::glFenceSync>
+	{
+		static GLsync apply(recording_backend& _backend, GLenum, GLbitfield)
+		{
+			return _backend.new_sync();
+		};
+	};
+
+	template <>
+	struct recording_hook<record_entry::glClientWaitSync>
+	{
+		static GLenum apply(recording_backend&, GLsync, GLbitfield, GLuint64)
+		{
+			return GL_ALREADY_SIGNALED;
+		};
+	};
+
+	template <>
+	struct recording_hook<record_entry::glGetSynciv>
+	{
+		static void apply(recording_backend&, GLsync, GLenum _parameter, GLsizei _count, GLsizei* _length, GLint* _values)
+		{
+			if (_count < 1)
+			{
+				return;
+			};
+			_values[0] = (_parameter == GL_SYNC_STATUS) ? GL_SIGNALED : 0;
+			if (_length)
+			{
+				*_length = 1;
+			};
+		};
+	};
+
+	template <>
+	struct recording_hook<record_entry::glMapBufferRange>
+	{
+		static void* apply(recording_backend& _backend, GLenum _target, GLintptr _offset, GLsizeiptr _length, GLbitfield)
+		{
+			const auto _buffer = static_cast<GLuint>(_backend.get_state(record_state::buffer, _target));
+			return _backend.map(_buffer, static_cast<size_t>(_offset + _length)) + _offset;
+		};
+	};
+
+	template <>
+	struct recording_hook<record_entry::glUnmapBuffer>
+	{
+		static GLboolean apply(recording_backend&, GLenum)
+		{
+			return GL_TRUE;
+		};
+	};
+
+	template <>
+	struct recording_hook<record_entry::glIsEnabled>
+	{
+		static GLboolean apply(recording_backend& _backend, GLenum _capability)
+		{
+			return (_backend.get_state(record_state::capability, _capability) != 0) ? GL_TRUE : GL_FALSE;
+		};
+	};
+
+	template <>
+	struct recording_hook<record_entry::glEnable>
+	{
+		static void apply(recording_backend& _backend, GLenum _capability)
+		{
+			_backend.track(record_entry::glEnable, record_state::capability, _capability, 1);
+		};
+	};
+
+	template <>
+	struct recording_hook<record_entry::glDisable>
+	{
+		static void apply(recording_backend& _backend, GLenum _capability)
+		{
+			_backend.track(record_entry::glDisable, record_state::capability, _capability, 0);
+		};
+	};
+
+	template <>
+	struct recording_hook<record_entry::glBindBuffer>
+	{
+		static void apply(recording_backend& _backend, GLenum _target, GLuint _buffer)
+		{
+			_backend.track(record_entry::glBindBuffer, record_state::buffer, _target, _buffer);
+		};
+	};
+
+	template <>
+	struct recording_hook<record_entry::glBindBufferBase>
+	{
+		static void apply(recording_backend& _backend, GLenum _target, GLuint _index, GLuint _buffer)
+		{
+			const auto _key = (static_cast<uint64_t>(_target) << 32) | _index;
+			_backend.track(record_entry::glBindBufferBase, record_state::indexed_buffer, _key,
+				gl_impl::record_hash_combine(_buffer, 0));
+			_backend.set_state(record_state::buffer, _target, _buffer);
+		};
+	};
+
+	template <>
+	struct recording_hook<record_entry::glBindBufferRange>
+	{
+		static void apply(recording_backend& _backend, GLenum _target, GLuint _index, GLuint _buffer,
+			GLintptr _offset, GLsizeiptr _size)
+		{
+			const auto _key = (static_cast<uint64_t>(_target) << 32) | _index;
+			auto _value = gl_impl::record_hash_combine(_buffer, static_cast<uint64_t>(_offset));
+			_value = gl_impl::record_hash_combine(_value, static_cast<uint64_t>(_size));
+			_backend.track(record_entry::glBindBufferRange, record_state::indexed_buffer, _key, _value);
+			_backend.set_state(record_state::buffer, _target, _buffer);
+		};
+	};
+
+	template <>
+	struct recording_hook<record_entry::glBindVertexArray>
+	{
+		static void apply(recording_backend& _backend, GLuint _vao)
+		{
+			_backend.track(record_entry::glBindVertexArray, record_state::vao, 0, _vao);
+		};
+	};
+
+	template <>
+	struct recording_hook<record_entry::glUseProgram>
+	{
+		static void apply(recording_backend& _backend, GLuint _program)
+		{
+			_backend.track(record_entry::glUseProgram, record_state::program, 0, _program);
+		};
+	};
+
+	template <>
+	struct recording_hook<record_entry::glActiveTexture>
+	{
+		static void apply(recording_backend& _backend, GLenum _unit)
+		{
+			_backend.track(record_entry::glActiveTexture, record_state::active_texture, 0, _unit - GL_TEXTURE0);
+		};
+	};
+
+	template <>
+	struct recording_hook<record_entry::glBindTexture>
+	{
+		static void apply(recording_backend& _backend, GLenum _target, GLuint _texture)
+		{
+			const auto _key = (_backend.get_state(record_state::active_texture, 0) << 32) | _target;
+			_backend.track(record_entry::glBindTexture, record_state::texture, _key, _texture);
+		};
+	};
+
+	template <>
+	struct recording_hook<record_entry::glBindRenderbuffer>
+	{
+		static void apply(recording_backend& _backend, GLenum _target, GLuint _renderbuffer)
+		{
+			_backend.track(record_entry::glBindRenderbuffer, record_state::renderbuffer, _target, _renderbuffer);
+		};
+	};
+
+	template <>
+	struct recording_hook<record_entry::glBindFramebuffer>
+	{
+		static void apply(recording_backend& _backend, GLenum _target, GLuint _framebuffer)
+		{
+			switch (_target)
+			{
+			case GL_DRAW_FRAMEBUFFER:
+				_backend.track(record_entry::glBindFramebuffer, record_state::draw_framebuffer, 0, _framebuffer);
+				break;
+			case GL_READ_FRAMEBUFFER:
+				_backend.track(record_entry::glBindFramebuffer, record_state::read_framebuffer, 0, _framebuffer);
+				break;
+			default:
+				// GL_FRAMEBUFFER binds both, only redundant if both already had it
+				if (_backend.get_state(record_state::read_framebuffer, 0) == _framebuffer)
+				{
+					_backend.track(record_entry::glBindFramebuffer, record_state::draw_framebuffer, 0, _framebuffer);
+				}
+				else
+				{
+					_backend.set_state(record_state::draw_framebuffer, 0, _framebuffer);
+				};
+				_backend.set_state(record_state::read_framebuffer, 0, _framebuffer);
+				break;
+			};
+		};
+	};
+
+#if GL_VERSION_4_1
+	template <>
+	struct recording_hook<record_entry::glBindProgramPipeline>
+	{
+		static void apply(recording_backend& _backend, GLuint _pipeline)
+		{
+			_backend.track(record_entry::glBindProgramPipeline, record_state::program_pipeline, 0, _pipeline);
+		};
+	};
+	template <> struct recording_hook<record_entry::glIsProgramPipeline> : gl_impl::recording_hook_is {};
+#endif
+
+#if GL_VERSION_4_3
+	template <>
+	struct recording_hook<record_entry::glBindVertexBuffer>
+	{
+		static void apply(recording_backend& _backend, GLuint _index, GLuint _buffer, GLintptr _offset, GLsizei _stride)
+		{
+			const auto _key = (_backend.get_state(record_state::vao, 0) << 32) | _index;
+			auto _value = gl_impl::record_hash_combine(_buffer, static_cast<uint64_t>(_offset));
+			_value = gl_impl::record_hash_combine(_value, static_cast<uint64_t>(_stride));
+			_backend.track(record_entry::glBindVertexBuffer, record_state::vertex_buffer, _key, _value);
+		};
+	};
+#endif
+
+#if GL_VERSION_4_5
+	template <> struct recording_hook<record_entry::glCreateBuffers> : gl_impl::recording_hook_new_names {};
+	template <> struct recording_hook<record_entry::glCreateFramebuffers> : gl_impl::recording_hook_new_names {};
+	template <> struct recording_hook<record_entry::glCreateProgramPipelines> : gl_impl::recording_hook_new_names {};
+	template <> struct recording_hook<record_entry::glCreateRenderbuffers> : gl_impl::recording_hook_new_names {};
+	template <> struct recording_hook<record_entry::glCreateVertexArrays> : gl_impl::recording_hook_new_names {};
+
+	template <>
+	struct recording_hook<record_entry::glCreateTextures>
+	{
+		static void apply(recording_backend& _backend, GLenum _target, GLsizei _count, GLuint* _names)
+		{
+			_backend.new_names(_count, _names);
+			for (GLsizei n = 0; n != _count; ++n)
+			{
+				_backend.texture(_names[n]).target = _target;
+			};
+		};
+	};
+
+	template <>
+	struct recording_hook<record_entry::glTextureStorage1D>
+	{
+		static void apply(recording_backend& _backend, GLuint _texture, GLsizei _levels, GLenum _format, GLsizei _width)
+		{
+			auto& _storage = _backend.texture(_texture);
+			_storage.format = _format;
+			_storage.levels = _levels;
+			_storage.width = _width;
+			_storage.height = 1;
+			_storage.depth = 1;
+		};
+	};
+
+	template <>
+	struct recording_hook<record_entry::glTextureStorage2D>
+	{
+		static void apply(recording_backend& _backend, GLuint _texture, GLsizei _levels, GLenum _format, GLsizei _width,
+			GLsizei _height)
+		{
+			auto& _storage = _backend.texture(_texture);
+			_storage.format = _format;
+			_storage.levels = _levels;
+			_storage.width = _width;
+			_storage.height = _height;
+			_storage.depth = 1;
+		};
+	};
+
+	template <>
+	struct recording_hook<record_entry::glTextureStorage3D>
+	{
+		static void apply(recording_backend& _backend, GLuint _texture, GLsizei _levels, GLenum _format, GLsizei _width,
+			GLsizei _height, GLsizei _depth)
+		{
+			auto& _storage = _backend.texture(_texture);
+			_storage.format = _format;
+			_storage.levels = _levels;
+			_storage.width = _width;
+			_storage.height = _height;
+			_storage.depth = _depth;
+		};
+	};
+
+	template <>
+	struct recording_hook<record_entry::glGetTextureParameteriv>
+	{
+		static void apply(recording_backend& _backend, GLuint _texture, GLenum _parameter, GLint* _out)
+		{
+			const auto _storage = _backend.find_texture(_texture);
+			if (!_storage)
+			{
+				return;
+			};
+			switch (_parameter)
+			{
+			case GL_TEXTURE_TARGET:
+				*_out = static_cast<GLint>(_storage->target);
+				break;
+			case GL_TEXTURE_IMMUTABLE_LEVELS:
+				*_out = _storage->levels;
+				break;
+			case GL_TEXTURE_IMMUTABLE_FORMAT:
+				*_out = (_storage->levels > 0) ? GL_TRUE : GL_FALSE;
+				break;
+			default:
+				break;
+			};
+		};
+	};
+
+	template <>
+	struct recording_hook<record_entry::glGetTextureLevelParameteriv>
+	{
+		static void apply(recording_backend& _backend, GLuint _texture, GLint _level, GLenum _parameter, GLint* _out)
+		{
+			const auto _storage = _backend.find_texture(_texture);
+			if (!_storage)
+			{
+				return;
+			};
+			switch (_parameter)
+			{
+			case GL_TEXTURE_WIDTH:
+				*_out = _storage->level_size(_level, 0);
+				break;
+			case GL_TEXTURE_HEIGHT:
+				*_out = _storage->level_size(_level, 1);
+				break;
+			case GL_TEXTURE_DEPTH:
+				*_out = _storage->level_size(_level, 2);
+				break;
+			case GL_TEXTURE_INTERNAL_FORMAT:
+				*_out = static_cast<GLint>(_storage->format);
+				break;
+			case GL_TEXTURE_COMPRESSED:
+				*_out = GL_FALSE;
+				break;
+			default:
+				break;
+			};
+		};
+	};
+
+	template <>
+	struct recording_hook<record_entry::glCheckNamedFramebufferStatus>
+	{
+		static GLenum apply(recording_backend&, GLuint, GLenum)
+		{
+			return GL_FRAMEBUFFER_COMPLETE;
+		};
+	};
+
+	template <>
+	struct recording_hook<record_entry::glMapNamedBufferRange>
+	{
+		static void* apply(recording_backend& _backend, GLuint _buffer, GLintptr _offset, GLsizeiptr _length, GLbitfield)
+		{
+			return _backend.map(_buffer, static_cast<size_t>(_offset + _length)) + _offset;
+		};
+	};
+
+	template <>
+	struct recording_hook<record_entry::glUnmapNamedBuffer>
+	{
+		static GLboolean apply(recording_backend&, GLuint)
+		{
+			return GL_TRUE;
+		};
+	};
+
+	template <>
+	struct recording_hook<record_entry::glBindTextureUnit>
+	{
+		static void apply(recording_backend& _backend, GLuint _unit, GLuint _texture)
+		{
+			_backend.track(record_entry::glBindTextureUnit, record_state::texture_unit, _unit, _texture);
+		};
+	};
+
+	template <>
+	struct recording_hook<record_entry::glVertexArrayVertexBuffer>
+	{
+		static void apply(recording_backend& _backend, GLuint _vao, GLuint _index, GLuint _buffer, GLintptr _offset, GLsizei _stride)
+		{
+			const auto _key = (static_cast<uint64_t>(_vao) << 32) | _index;
+			auto _value = gl_impl::record_hash_combine(_buffer, static_cast<uint64_t>(_offset));
+			_value = gl_impl::record_hash_combine(_value, static_cast<uint64_t>(_stride));
+			_backend.track(record_entry::glVertexArrayVertexBuffer, record_state::vertex_buffer, _key, _value);
+		};
+	};
+#endif
+
+	/**
+	 * @brief Generates the function installed by recording_backend for an entry point.
+	*/
+	template <record_entry Entry, typename FnT>
+	struct record_function;
+
+	template <record_entry Entry, typename RetT, typename... ArgTs>
+	struct record_function<Entry, RetT(APIENTRY*)(ArgTs...)>
+	{
+		static RetT APIENTRY invoke(ArgTs... _args)
+		{
+			auto _backend = recording_backend::active();
+			JCLIB_ASSERT(_backend);
+			_backend->append(Entry, _args...);
+
+			if constexpr (requires { recording_hook<Entry>::apply(*_backend, _args...); })
+			{
+				return recording_hook<Entry>::apply(*_backend, _args...);
+			}
+			else if constexpr (!std::is_void_v<RetT>)
+			{
+				return RetT{};
+			};
+		};
+	};
+
+	inline void recording_backend::install()
+	{
+		if (this->installed())
+		{
+			return;
+		};
+		JCLIB_ASSERT(!active_);
+
+#define JCLIB_OPENGL_RECORD_INSTALL(_name) \
+		this->_name##_ = glad_##_name; \
+		glad_##_name = &record_function<record_entry::_name, decltype(glad_##_name)>::invoke;
+		JCLIB_OPENGL_RECORD_FUNCTIONS(JCLIB_OPENGL_RECORD_INSTALL)
+#undef JCLIB_OPENGL_RECORD_INSTALL
+
+		active_ = this;
+	};
+
+	inline void recording_backend::uninstall()
+	{
+		if (!this->installed())
+		{
+			return;
+		};
+
+#define JCLIB_OPENGL_RECORD_UNINSTALL(_name) \
+		glad_##_name = this->_name##_;
+		JCLIB_OPENGL_RECORD_FUNCTIONS(JCLIB_OPENGL_RECORD_UNINSTALL)
+#undef JCLIB_OPENGL_RECORD_UNINSTALL
+
+		active_ = nullptr;
+	};
+
+};
+#pragma endregion
+
+#endif // JCLIB_OPENGL_GLRECORD_HPP
@@ -0,0 +1,485 @@
+#pragma once
+#ifndef JCLIB_OPENGL_GLRESIDENCY_HPP
+#define JCLIB_OPENGL_GLRESIDENCY_HPP
+
+/*
+	Budgeted least recently used cache keeping a working set of textures resident in video memory
+*/
+
+#include "gl.hpp"
+#include "glmemory.hpp"
+
+#include <jclib/type.h>
+
+#include <list>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <algorithm>
+#include <functional>
+#include <unordered_map>
+
+#define _JCLIB_OPENGL_GLRESIDENCY_
+
+#if GL_VERSION_4_5
+namespace jc::gl
+{
+	/**
+	 * @brief Settings for a texture_residency_cache.
+	*/
+	struct texture_residency_settings
+	{
+		/**
+		 * @brief Bytes the cache's textures may occupy.
+		*/
+		size_t budget_bytes = 256 * 1024 * 1024;
+
+		/**
+		 * @brief Most base levels dropped from a texture before it is evicted instead, 0 to only evict.
+		*/
+		uint32_t max_dropped_levels = 2;
+	};
+
+	/**
+	 * @brief Counters for a texture_residency_cache.
+	*/
+	struct texture_residency_stats
+	{
+		/**
+		 * @brief Acquires that found the texture resident at full resolution.
+		*/
+		size_t hits = 0;
+
+		/**
+		 * @brief Acquires that had to call the loader, including reloading textures with dropped levels.
+		*/
+		size_t misses = 0;
+
+		/**
+		 * @brief Textures deleted to get under budget.
+		*/
+		size_t evictions = 0;
+
+		/**
+		 * @brief Base levels dropped to get under budget.
+		*/
+		size_t dropped_levels = 0;
+
+		/**
+		 * @brief Textures currently resident.
+		*/
+		size_t resident = 0;
+
+		/**
+		 * @brief Bytes currently used by resident textures.
+		*/
+		size_t resident_bytes = 0;
+	};
+
+	namespace gl_impl
+	{
+		/**
+		 * @brief Computes the size of a texture's storage from its level parameters.
+		 *
+		 * Queried rather than taken from the memory accounting so the budget also holds with
+		 * JCLIB_OPENGL_MEMORY_TRACKING_V off. Mutable textures are walked up to their first missing level.
+		 *
+		 * @return Size in bytes, 0 if the texture has no storage.
+		*/
+		inline size_t texture_bytes(const texture_id& _texture)
+		{
+			GLint _target = 0;
+			GLint _levels = 0;
+			GLint _format = 0;
+			GLint _compressed = GL_FALSE;
+			glGetTextureParameteriv(_texture.get(), GL_TEXTURE_TARGET, &_target);
+			glGetTextureParameteriv(_texture.get(), GL_TEXTURE_IMMUTABLE_LEVELS, &_levels);
+			glGetTextureLevelParameteriv(_texture.get(), 0, GL_TEXTURE_INTERNAL_FORMAT, &_format);
+			glGetTextureLevelParameteriv(_texture.get(), 0, GL_TEXTURE_COMPRESSED, &_compressed);
+			if (_levels == 0)
+			{
+				GLint _maxLevel = 0;
+				glGetTextureParameteriv(_texture.get(), GL_TEXTURE_MAX_LEVEL, &_maxLevel);
+				_levels = _maxLevel + 1;
+			};
+
+			// Array layers are reported as height or depth, cube faces are not
+			const GLsizei _faces = (_target == GL_TEXTURE_CUBE_MAP) ? 6 : 1;
+			const auto _iformat = static_cast<internal_format>(_format);
+			size_t _bytes = 0;
+			for (GLint n = 0; n < _levels; ++n)
+			{
+				GLint _w = 0;
+				GLint _h = 0;
+				GLint _d = 0;
+				glGetTextureLevelParameteriv(_texture.get(), n, GL_TEXTURE_WIDTH, &_w);
+				if (_w == 0)
+				{
+					break;
+				};
+				if (_compressed)
+				{
+					GLint _size = 0;
+					glGetTextureLevelParameteriv(_texture.get(), n, GL_TEXTURE_COMPRESSED_IMAGE_SIZE, &_size);
+					_bytes += static_cast<size_t>(_size) * static_cast<size_t>(_faces);
+					continue;
+				};
+				glGetTextureLevelParameteriv(_texture.get(), n, GL_TEXTURE_HEIGHT, &_h);
+				glGetTextureLevelParameteriv(_texture.get(), n, GL_TEXTURE_DEPTH, &_d);
+				_bytes += texture_storage_bytes(_iformat, _w, std::max(_h, 1), std::max(_d, 1), _faces, 1);
+			};
+			return _bytes;
+		};
+
+		/**
+		 * @brief Creates a copy of a texture without its base level by copying the remaining levels on the GPU.
+		 * @return The smaller texture, or null if the texture has a single level or an unsupported target.
+		*/
+		inline unique_texture drop_base_level(const texture_id& _texture)
+		{
+			GLint _target = 0;
+			GLint _levels = 0;
+			GLint _format = 0;
+			glGetTextureParameteriv(_texture.get(), GL_TEXTURE_TARGET, &_target);
+			glGetTextureParameteriv(_texture.get(), GL_TEXTURE_IMMUTABLE_LEVELS, &_levels);
+			glGetTextureLevelParameteriv(_texture.get(), 0, GL_TEXTURE_INTERNAL_FORMAT, &_format);
+			if (_levels < 2)
+			{
+				return unique_texture{};
+			};
+
+			GLint _width = 0;
+			GLint _height = 0;
+			GLint _depth = 0;
+			glGetTextureLevelParameteriv(_texture.get(), 1, GL_TEXTURE_WIDTH, &_width);
+			glGetTextureLevelParameteriv(_texture.get(), 1, GL_TEXTURE_HEIGHT, &_height);
+			glGetTextureLevelParameteriv(_texture.get(), 1, GL_TEXTURE_DEPTH, &_depth);
+
+			const auto _iformat = static_cast<internal_format>(_format);
+			auto _out = new_texture(static_cast<texture_target>(_target));
+			GLint _copyDepth = _depth;
+			switch (_target)
+			{
+			case GL_TEXTURE_1D:
+				set_storage_1D(_out, _iformat, _width, _levels - 1);
+				break;
+			case GL_TEXTURE_2D: [[fallthrough]];
+			case GL_TEXTURE_1D_ARRAY:
+				set_storage_2D(_out, _iformat, _width, _height, _levels - 1);
+				break;
+			case GL_TEXTURE_CUBE_MAP:
+				set_storage_2D(_out, _iformat, _width, _height, _levels - 1);
+				_copyDepth = 6;
+				break;
+			case GL_TEXTURE_3D: [[fallthrough]];
+			case GL_TEXTURE_2D_ARRAY: [[fallthrough]];
+			case GL_TEXTURE_CUBE_MAP_ARRAY:
+				set_storage_3D(_out, _iformat, _width, _height, _depth, _levels - 1);
+				break;
+			default:
+				return unique_texture{};
+			};
+
+			for (GLint n = 1; n < _levels; ++n)
+			{
+				GLint _w = 0;
+				GLint _h = 0;
+				GLint _d = 0;
+				glGetTextureLevelParameteriv(_texture.get(), n, GL_TEXTURE_WIDTH, &_w);
+				glGetTextureLevelParameteriv(_texture.get(), n, GL_TEXTURE_HEIGHT, &_h);
+				glGetTextureLevelParameteriv(_texture.get(), n, GL_TEXTURE_DEPTH, &_d);
+				if (_target == GL_TEXTURE_CUBE_MAP)
+				{
+					_d = _copyDepth;
+				};
+				glCopyImageSubData(_texture.get(), static_cast<GLenum>(_target), n, 0, 0, 0,
+					_out.get(), static_cast<GLenum>(_target), n - 1, 0, 0, 0, _w, _h, _d);
+			};
+
+			// Carry over the sampling state a loader usually sets
+			constexpr GLenum _params[] =
+			{
+				GL_TEXTURE_MIN_FILTER, GL_TEXTURE_MAG_FILTER, GL_TEXTURE_WRAP_S, GL_TEXTURE_WRAP_T, GL_TEXTURE_WRAP_R
+			};
+			for (auto& _param : _params)
+			{
+				GLint _value = 0;
+				glGetTextureParameteriv(_texture.get(), _param, &_value);
+				glTextureParameteri(_out.get(), _param, _value);
+			};
+			return _out;
+		};
+	};
+
+	/**
+	 * @brief Keeps the most recently used textures of a larger asset set resident within a byte budget.
+	 *
+	 * acquire() returns a key's texture, calling the loader if it isn't resident. next_frame() advances the frame
+	 * counter and then brings the cache under budget. Textures not used in the current frame are first shrunk by
+	 * dropping their base level (copying the remaining levels into a smaller texture on the GPU), least recently
+	 * used first, up to max_dropped_levels each. If that isn't enough they are evicted, again least recently used
+	 * first. A texture with dropped levels is reloaded at full resolution the next time it is acquired.
+	 *
+	 * Texture sizes are queried from each texture's levels when it is loaded or shrunk, so the budget works
+	 * whether or not the memory accounting in glmemory.hpp is enabled.
+	 *
+	 * ```
+	 * gl::texture_residency_cache<std::string> _textures{ [](const std::string& _path) { return load_texture(_path); },
+	 *     { .budget_bytes = 512 * 1024 * 1024 } };
+	 *
+	 * glBindTextureUnit(0, _textures.acquire("rock_albedo.ktx").get());
+	 * ...
+	 * _textures.next_frame();
+	 * ```
+	 *
+	 * @tparam KeyT Type identifying a texture, must be hashable by HashT.
+	*/
+	template <typename KeyT, typename HashT = std::hash<KeyT>>
+	class texture_residency_cache
+	{
+	public:
+
+		using key_type = KeyT;
+
+		/**
+		 * @brief Creates a key's texture at full resolution, may return null on failure.
+		*/
+		using loader_fn = std::function<unique_texture(const key_type&)>;
+
+		/**
+		 * @brief Gets a key's texture, loading it if it isn't resident or had levels dropped.
+		 *
+		 * The texture stays resident for the rest of the frame, until the next call to next_frame().
+		 *
+		 * @param _key Texture to get.
+		 * @return The texture, null if the loader failed.
+		*/
+		texture_id acquire(const key_type& _key)
+		{
+			auto _it = this->index_.find(_key);
+			if (_it != this->index_.end())
+			{
+				auto _entry = _it->second;
+				this->lru_.splice(this->lru_.begin(), this->lru_, _entry);
+				_entry->last_frame = this->frame_;
+				if (_entry->dropped_levels == 0)
+				{
+					++this->stats_.hits;
+					return _entry->texture;
+				};
+
+				++this->stats_.misses;
+				auto _texture = this->loader_(_key);
+				if (_texture)
+				{
+					this->replace(*_entry, std::move(_texture));
+					_entry->dropped_levels = 0;
+				};
+				return _entry->texture;
+			};
+
+			++this->stats_.misses;
+			auto _texture = this->loader_(_key);
+			if (!_texture)
+			{
+				return texture_id{};
+			};
+
+			this->lru_.push_front(entry{ _key, unique_texture{}, 0, this->frame_, 0 });
+			this->index_.emplace(_key, this->lru_.begin());
+			this->replace(this->lru_.front(), std::move(_texture));
+			++this->stats_.resident;
+			return this->lru_.front().texture;
+		};
+
+		/**
+		 * @brief Checks if a key's texture is resident, without marking it used.
+		*/
+		bool contains(const key_type& _key) const
+		{
+			return this->index_.contains(_key);
+		};
+
+		/**
+		 * @brief Evicts a key's texture regardless of the budget.
+		*/
+		void erase(const key_type& _key)
+		{
+			auto _it = this->index_.find(_key);
+			if (_it != this->index_.end())
+			{
+				this->evict(_it->second);
+			};
+		};
+
+		/**
+		 * @brief Evicts every texture.
+		*/
+		void clear()
+		{
+			while (!this->lru_.empty())
+			{
+				this->evict(std::prev(this->lru_.end()));
+			};
+		};
+
+		/**
+		 * @brief Starts a new frame and brings the cache under budget.
+		*/
+		void next_frame()
+		{
+			++this->frame_;
+			this->enforce_budget();
+		};
+
+		/**
+		 * @brief Drops levels from and then evicts textures not used this frame until the cache is under budget.
+		*/
+		void enforce_budget()
+		{
+			if (this->stats_.resident_bytes <= this->settings_.budget_bytes)
+			{
+				return;
+			};
+
+			// Shrink before evicting, least recently used first
+			for (auto it = this->lru_.rbegin(); it != this->lru_.rend() && this->over_budget(); ++it)
+			{
+				if (it->last_frame == this->frame_)
+				{
+					break;
+				};
+				while (it->dropped_levels < this->settings_.max_dropped_levels && this->over_budget())
+				{
+					auto _smaller = gl_impl::drop_base_level(it->texture);
+					if (!_smaller)
+					{
+						break;
+					};
+					this->replace(*it, std::move(_smaller));
+					++it->dropped_levels;
+					++this->stats_.dropped_levels;
+				};
+			};
+
+			while (this->over_budget() && !this->lru_.empty())
+			{
+				const auto _oldest = std::prev(this->lru_.end());
+				if (_oldest->last_frame == this->frame_)
+				{
+					break;
+				};
+				this->evict(_oldest);
+				++this->stats_.evictions;
+			};
+		};
+
+		/**
+		 * @brief Changes the budget, taking effect on the next enforce_budget() or next_frame().
+		*/
+		void set_budget(size_t _bytes) noexcept
+		{
+			this->settings_.budget_bytes = _bytes;
+		};
+		size_t budget() const noexcept
+		{
+			return this->settings_.budget_bytes;
+		};
+
+		/**
+		 * @brief Gets the cache's counters.
+		*/
+		const texture_residency_stats& stats() const noexcept
+		{
+			return this->stats_;
+		};
+
+		/**
+		 * @brief Zeroes the hit, miss, eviction and dropped level counters.
+		*/
+		void reset_stats() noexcept
+		{
+			this->stats_.hits = 0;
+			this->stats_.misses = 0;
+			this->stats_.evictions = 0;
+			this->stats_.dropped_levels = 0;
+		};
+
+		/**
+		 * @brief Gets the number of calls to next_frame().
+		*/
+		uint64_t frame() const noexcept
+		{
+			return this->frame_;
+		};
+
+		/**
+		 * @param _loader Creates textures on demand, called on the GL thread from acquire().
+		 * @param _settings Budget and level dropping.
+		*/
+		explicit texture_residency_cache(loader_fn _loader, const texture_residency_settings& _settings = {}) :
+			loader_{ std::move(_loader) },
+			settings_{ _settings }
+		{
+			JCLIB_ASSERT(this->loader_);
+		};
+
+		texture_residency_cache(const texture_residency_cache&) = delete;
+		texture_residency_cache& operator=(const texture_residency_cache&) = delete;
+
+	private:
+
+		struct entry
+		{
+			key_type key;
+			unique_texture texture;
+			size_t bytes;
+			uint64_t last_frame;
+			uint32_t dropped_levels;
+		};
+
+		using entry_iterator = typename std::list<entry>::iterator;
+
+		bool over_budget() const noexcept
+		{
+			return this->stats_.resident_bytes > this->settings_.budget_bytes;
+		};
+
+		/**
+		 * @brief Swaps an entry's texture, keeping resident_bytes in step.
+		*/
+		void replace(entry& _entry, unique_texture _texture)
+		{
+			this->stats_.resident_bytes -= _entry.bytes;
+			_entry.texture = std::move(_texture);
+			_entry.bytes = (_entry.texture) ? gl_impl::texture_bytes(_entry.texture) : 0;
+			this->stats_.resident_bytes += _entry.bytes;
+
+			// A texture without storage would never count against the budget
+			JCLIB_ASSERT(!_entry.texture || _entry.bytes != 0);
+		};
+
+		void evict(entry_iterator _entry)
+		{
+			this->stats_.resident_bytes -= _entry->bytes;
+			--this->stats_.resident;
+			this->index_.erase(_entry->key);
+			this->lru_.erase(_entry);
+		};
+
+		loader_fn loader_;
+		texture_residency_settings settings_;
+
+		/**
+		 * @brief Most recently used first.
+		*/
+		std::list<entry> lru_{};
+		std::unordered_map<key_type, entry_iterator, HashT> index_{};
+
+		texture_residency_stats stats_{};
+		uint64_t frame_ = 0;
+	};
+};
+#endif
+
+#endif // JCLIB_OPENGL_GLRESIDENCY_HPP
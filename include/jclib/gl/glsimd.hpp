@@ -0,0 +1,54 @@
+#pragma once
+#ifndef JCLIB_OPENGL_GLSIMD_HPP
+#define JCLIB_OPENGL_GLSIMD_HPP
+
+/*
+	Instruction set detection for the CPU side mesh processing kernels.
+
+	Each JCLIB_OPENGL_*_V macro is true when the instruction set is enabled for the
+	translation unit (ie. -mavx2 or /arch:AVX2) and can be predefined to force a path off.
+*/
+
+#if !defined(JCLIB_OPENGL_SSE2_V)
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define JCLIB_OPENGL_SSE2_V true
+#else
+#define JCLIB_OPENGL_SSE2_V false
+#endif
+#endif
+
+#if !defined(JCLIB_OPENGL_F16C_V)
+#if defined(__F16C__) || (defined(_MSC_VER) && defined(__AVX2__))
+#define JCLIB_OPENGL_F16C_V true
+#else
+#define JCLIB_OPENGL_F16C_V false
+#endif
+#endif
+
+#if !defined(JCLIB_OPENGL_AVX2_V)
+#if defined(__AVX2__)
+#define JCLIB_OPENGL_AVX2_V true
+#else
+#define JCLIB_OPENGL_AVX2_V false
+#endif
+#endif
+
+#if !defined(JCLIB_OPENGL_AVX512_V)
+#if defined(__AVX512F__)
+#define JCLIB_OPENGL_AVX512_V true
+#else
+#define JCLIB_OPENGL_AVX512_V false
+#endif
+#endif
+
+#if JCLIB_OPENGL_SSE2_V
+#include <emmintrin.h>
+#endif
+
+#if JCLIB_OPENGL_F16C_V || JCLIB_OPENGL_AVX2_V || JCLIB_OPENGL_AVX512_V
+#include <immintrin.h>
+#endif
+
+#define _JCLIB_OPENGL_GLSIMD_
+
+#endif // JCLIB_OPENGL_GLSIMD_HPP
@@ -0,0 +1,167 @@
+#pragma once
+#ifndef JCLIB_OPENGL_GLTHREAD_HPP
+#define JCLIB_OPENGL_GLTHREAD_HPP
+
+/*
+	Worker thread pool used by the CPU side mesh processing functions
+*/
+
+#include <jclib/type.h>
+#include <jclib/concepts.h>
+
+#include <mutex>
+#include <deque>
+#include <latch>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <algorithm>
+#include <functional>
+#include <condition_variable>
+
+#define _JCLIB_OPENGL_GLTHREAD_
+
+namespace jc::gl
+{
+	/**
+	 * @brief Simple fixed size worker thread pool.
+	 *
+	 * None of the worker threads have an OpenGL context, only submit CPU work to this.
+	*/
+	class thread_pool
+	{
+	public:
+
+		/**
+		 * @brief Gets the number of worker threads.
+		 * @return Worker thread count.
+		*/
+		size_t size() const noexcept
+		{
+			return this->workers_.size();
+		};
+
+		/**
+		 * @brief Queues a job to be run on a worker thread.
+		 * @param _job Job to run.
+		*/
+		void push(std::function<void()> _job)
+		{
+			{
+				std::unique_lock _lock{ this->mtx_ };
+				this->jobs_.push_back(std::move(_job));
+			};
+			this->cv_.notify_one();
+		};
+
+		/**
+		 * @brief Invokes a function once for every index in [0, _count) and waits for all to finish.
+		 *
+		 * Indices are handed out one at a time so uneven work (ie. differently sized meshes) balances
+		 * itself. The calling thread also runs indices while waiting.
+		 *
+		 * @param _count Number of indices.
+		 * @param _fn Function to invoke with each index, must be safe to call concurrently.
+		*/
+		template <typename FnT>
+		void parallel_for(size_t _count, FnT&& _fn)
+		{
+			if (_count == 0)
+			{
+				return;
+			};
+
+			std::atomic<size_t> _next{ 0 };
+			const auto _run = [&_next, _count, &_fn]()
+			{
+				for (auto n = _next.fetch_add(1, std::memory_order_relaxed); n < _count;
+					n = _next.fetch_add(1, std::memory_order_relaxed))
+				{
+					_fn(n);
+				};
+			};
+
+			const auto _helpers = std::min(this->size(), _count - 1);
+			std::latch _done{ static_cast<std::ptrdiff_t>(_helpers) };
+			for (size_t n = 0; n != _helpers; ++n)
+			{
+				this->push([&_run, &_done]()
+				{
+					_run();
+					_done.count_down();
+				});
+			};
+
+			_run();
+			_done.wait();
+		};
+
+		/**
+		 * @brief Starts the worker threads.
+		 * @param _threadCount Number of workers, defaults to one less than the hardware concurrency.
+		*/
+		explicit thread_pool(size_t _threadCount = default_thread_count())
+		{
+			this->workers_.reserve(_threadCount);
+			for (size_t n = 0; n != _threadCount; ++n)
+			{
+				this->workers_.emplace_back([this](std::stop_token _stop) { this->work(_stop); });
+			};
+		};
+
+		/**
+		 * @brief Finishes the queued jobs then stops and joins the worker threads.
+		*/
+		~thread_pool()
+		{
+			for (auto& _worker : this->workers_)
+			{
+				_worker.request_stop();
+			};
+			this->cv_.notify_all();
+			this->workers_.clear();
+		};
+
+		thread_pool(const thread_pool&) = delete;
+		thread_pool& operator=(const thread_pool&) = delete;
+
+		/**
+		 * @brief Gets the default number of worker threads.
+		 * @return One less than the hardware concurrency, at least 1.
+		*/
+		static size_t default_thread_count() noexcept
+		{
+			const auto _hw = static_cast<size_t>(std::thread::hardware_concurrency());
+			return (_hw > 1) ? (_hw - 1) : 1;
+		};
+
+	private:
+
+		void work(std::stop_token _stop)
+		{
+			while (true)
+			{
+				std::function<void()> _job{};
+				{
+					std::unique_lock _lock{ this->mtx_ };
+					this->cv_.wait(_lock, _stop, [this]() { return !this->jobs_.empty(); });
+					if (this->jobs_.empty())
+					{
+						return;
+					};
+					_job = std::move(this->jobs_.front());
+					this->jobs_.pop_front();
+				};
+				_job();
+			};
+		};
+
+		std::mutex mtx_{};
+		std::condition_variable_any cv_{};
+		std::deque<std::function<void()>> jobs_{};
+		std::vector<std::jthread> workers_{};
+	};
+
+};
+
+#endif // JCLIB_OPENGL_GLTHREAD_HPP
@@ -0,0 +1,258 @@
+#pragma once
+#ifndef JCLIB_OPENGL_GLTRANSIENT_HPP
+#define JCLIB_OPENGL_GLTRANSIENT_HPP
+
+/*
+	Per-frame linear allocator for transient uniform data bound by range
+*/
+
+#include "gl.hpp"
+#include "glparam.hpp"
+
+#include <jclib/type.h>
+
+#include <span>
+#include <vector>
+#include <cstddef>
+#include <cstring>
+#include <algorithm>
+#include <type_traits>
+
+#define _JCLIB_OPENGL_GLTRANSIENT_
+
+#if GL_VERSION_4_5
+namespace jc::gl
+{
+	/**
+	 * @brief Range of a transient_uniform_allocator's buffer holding pushed data.
+	*/
+	struct transient_allocation
+	{
+		/**
+		 * @brief Offset in bytes from the start of the allocator's buffer.
+		*/
+		size_t offset = 0;
+
+		/**
+		 * @brief Size of the pushed data in bytes, 0 if the allocation failed.
+		*/
+		size_t size = 0;
+
+		/**
+		 * @brief Checks if the allocation succeeded.
+		*/
+		constexpr explicit operator bool() const noexcept { return this->size != 0; };
+	};
+
+	/**
+	 * @brief Linear bump allocator over one persistently mapped uniform buffer, reset every frame.
+	 *
+	 * The buffer is split into one region per frame in flight. push() copies data into the current frame's
+	 * region at the next offset aligned to GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, so per draw constants cost one
+	 * memcpy and one bind_buffer_range() instead of a set_uniform() call per value. next_frame() fences the
+	 * region just used and moves on to the oldest one, waiting for its fence if the GPU is still reading it.
+	 *
+	 * ```
+	 * gl::transient_uniform_allocator _uniforms{ 256 * 1024 };
+	 * for (auto& _draw : _draws)
+	 * {
+	 *     _uniforms.push(_objectBinding, _draw.constants);
+	 *     gl::draw_elements(...);
+	 * };
+	 * _uniforms.next_frame();
+	 * ```
+	*/
+	class transient_uniform_allocator
+	{
+	public:
+
+		/**
+		 * @brief Default number of frames the GPU may still be reading from.
+		*/
+		constexpr static size_t default_frames_in_flight = 3;
+
+		/**
+		 * @brief Copies data into the current frame's region.
+		 * @param _data Bytes to copy, must not be empty.
+		 * @return Where the data was written, empty if the frame's region is full.
+		*/
+		transient_allocation push(std::span<const std::byte> _data)
+		{
+			JCLIB_ASSERT(!_data.empty());
+			const auto _offset = this->align_up(this->head_);
+			if (_offset + _data.size() > this->frame_bytes_)
+			{
+				++this->failed_;
+				return transient_allocation{};
+			};
+
+			const auto _bufferOffset = this->frame_ * this->frame_bytes_ + _offset;
+			std::memcpy(this->mapped_.data() + _bufferOffset, _data.data(), _data.size());
+			this->head_ = _offset + _data.size();
+			this->peak_ = std::max(this->peak_, this->head_);
+			return transient_allocation{ _bufferOffset, _data.size() };
+		};
+
+		/**
+		 * @brief Copies a value into the current frame's region.
+		 * @param _value Value to copy, must match the std140 layout of the uniform block it is bound to.
+		 * @return Where the value was written, empty if the frame's region is full.
+		*/
+		template <typename T> requires std::is_trivially_copyable_v<T>
+		transient_allocation push(const T& _value)
+		{
+			return this->push(std::span<const std::byte>{ std::as_bytes(std::span<const T, 1>{ &_value, 1 }) });
+		};
+
+		/**
+		 * @brief Copies a value into the current frame's region and binds it to a uniform binding point.
+		 * @param _binding Binding point of the uniform block.
+		 * @param _value Value to copy.
+		 * @return Where the value was written, empty if the frame's region is full in which case nothing is bound.
+		*/
+		template <typename T> requires std::is_trivially_copyable_v<T>
+		transient_allocation push(const uniform_binding_point& _binding, const T& _value)
+		{
+			const auto _allocation = this->push(_value);
+			if (_allocation)
+			{
+				this->bind(_binding, _allocation);
+			};
+			return _allocation;
+		};
+
+		/**
+		 * @brief Binds an allocation to a uniform binding point.
+		*/
+		void bind(const uniform_binding_point& _binding, const transient_allocation& _allocation) const
+		{
+			JCLIB_ASSERT(_allocation);
+			bind_buffer_range(_binding, this->buffer_, _allocation.offset, _allocation.size);
+		};
+
+		/**
+		 * @brief Ends the current frame and resets the allocator onto the next frame's region.
+		 *
+		 * Fences the region just written and waits on the fence of the region being reused, which only blocks if
+		 * the GPU is more than frames_in_flight() frames behind.
+		*/
+		void next_frame()
+		{
+			this->fences_[this->frame_] = new_fence();
+			this->frame_ = (this->frame_ + 1) % this->fences_.size();
+			this->head_ = 0;
+
+			auto& _fence = this->fences_[this->frame_];
+			if (_fence)
+			{
+				if (wait_signaled(_fence).stalled())
+				{
+					++this->stalls_;
+				};
+				_fence.reset();
+			};
+		};
+
+		/**
+		 * @brief Gets the uniform buffer all allocations are made from.
+		*/
+		vbo_id buffer() const noexcept { return this->buffer_; };
+
+		/**
+		 * @brief Gets the offset alignment every allocation respects.
+		*/
+		size_t alignment() const noexcept { return this->alignment_; };
+
+		/**
+		 * @brief Gets the number of bytes available per frame.
+		*/
+		size_t capacity() const noexcept { return this->frame_bytes_; };
+
+		/**
+		 * @brief Gets the number of bytes used this frame, including alignment padding.
+		*/
+		size_t used() const noexcept { return this->head_; };
+
+		/**
+		 * @brief Gets the most bytes used by any frame so far.
+		*/
+		size_t peak() const noexcept { return this->peak_; };
+
+		/**
+		 * @brief Gets the number of pushes that failed because a frame's region was full.
+		*/
+		size_t failed() const noexcept { return this->failed_; };
+
+		/**
+		 * @brief Gets the number of times next_frame() had to wait for the GPU.
+		*/
+		size_t stalls() const noexcept { return this->stalls_; };
+
+		/**
+		 * @brief Gets the number of frame regions.
+		*/
+		size_t frames_in_flight() const noexcept { return this->fences_.size(); };
+
+		/**
+		 * @brief Checks if the buffer was created and mapped.
+		*/
+		explicit operator bool() const noexcept { return !this->mapped_.empty(); };
+
+		/**
+		 * @brief Creates and persistently maps the buffer, the context must be current.
+		 * @param _frameBytes Bytes available per frame, rounded up to the offset alignment.
+		 * @param _framesInFlight Number of frame regions, at least 1.
+		*/
+		explicit transient_uniform_allocator(size_t _frameBytes, size_t _framesInFlight = default_frames_in_flight) :
+			alignment_{ static_cast<size_t>(std::max(get_uniform_buffer_offset_alignment(), GLint{ 1 })) },
+			buffer_{ new_vbo() },
+			fences_(std::max(_framesInFlight, size_t{ 1 }))
+		{
+			this->frame_bytes_ = this->align_up(_frameBytes);
+			const auto _total = this->frame_bytes_ * this->fences_.size();
+
+			constexpr auto _storage = buffer_storage_bit::map_write | buffer_storage_bit::map_persistent | buffer_storage_bit::map_coherent;
+			set_buffer_storage(this->buffer_, _total, _storage);
+			this->mapped_ = map_buffer_range(this->buffer_, 0, _total,
+				map_access_bit::write | map_access_bit::persistent | map_access_bit::coherent);
+		};
+
+		/**
+		 * @brief Unmaps and deletes the buffer, waiting for nothing. Make sure the GPU is done with it.
+		*/
+		~transient_uniform_allocator()
+		{
+			if (!this->mapped_.empty())
+			{
+				unmap_buffer(this->buffer_);
+			};
+		};
+
+		transient_uniform_allocator(const transient_uniform_allocator&) = delete;
+		transient_uniform_allocator& operator=(const transient_uniform_allocator&) = delete;
+
+	private:
+
+		size_t align_up(size_t _bytes) const noexcept
+		{
+			return (_bytes + this->alignment_ - 1) / this->alignment_ * this->alignment_;
+		};
+
+		size_t alignment_;
+		unique_vbo buffer_;
+		std::span<std::byte> mapped_{};
+		std::vector<unique_sync> fences_;
+
+		size_t frame_bytes_ = 0;
+		size_t frame_ = 0;
+		size_t head_ = 0;
+
+		size_t peak_ = 0;
+		size_t failed_ = 0;
+		size_t stalls_ = 0;
+	};
+
+};
+#endif
+
+#endif // JCLIB_OPENGL_GLTRANSIENT_HPP
@@ -0,0 +1,419 @@
+#pragma once
+#ifndef JCLIB_OPENGL_GLUPLOAD_HPP
+#define JCLIB_OPENGL_GLUPLOAD_HPP
+
+/*
+	Background texture and buffer uploads through a second context sharing objects with the main one
+*/
+
+#include "gl.hpp"
+
+#include <jclib/type.h>
+
+#include <mutex>
+#include <latch>
+#include <deque>
+#include <vector>
+#include <thread>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <algorithm>
+#include <functional>
+#include <condition_variable>
+
+#define _JCLIB_OPENGL_GLUPLOAD_
+
+#if GL_VERSION_4_5
+namespace jc::gl
+{
+	/**
+	 * @brief Describes a 2D texture to create and fill on an upload_worker.
+	*/
+	struct texture_upload_2D
+	{
+		internal_format iformat;
+		format pixel_format;
+		pixel_typecode pixel_type;
+		GLsizei width = 0;
+		GLsizei height = 0;
+
+		/**
+		 * @brief Number of mipmap levels to allocate, only the base level is uploaded.
+		*/
+		GLsizei levels = 1;
+
+		/**
+		 * @brief Generates the remaining levels from the base level after uploading.
+		*/
+		bool generate_mipmaps = false;
+	};
+
+	/**
+	 * @brief Counters for an upload_worker.
+	*/
+	struct upload_worker_stats
+	{
+		size_t uploaded_jobs = 0;
+		size_t uploaded_bytes = 0;
+
+		/**
+		 * @brief Number of uploads handed to the main thread by poll().
+		*/
+		size_t delivered_jobs = 0;
+
+		/**
+		 * @brief Number of frames in which the worker stopped because the byte budget ran out.
+		*/
+		size_t budget_exhausted = 0;
+	};
+
+	/**
+	 * @brief Uploads textures and buffers on a background thread with its own context.
+	 *
+	 * The worker's context must share objects with the main context and is made current on the worker thread
+	 * by the function given on construction. Each upload is followed by a fence, and the finished object is
+	 * only handed to its callback once poll() on the main thread sees that fence signaled. Rebind delivered
+	 * objects before use so the main context picks up their new contents.
+	 *
+	 * Jobs run highest priority first, then in the order they were queued. The worker uploads at most
+	 * frame_budget() bytes between calls to poll(), one job larger than the budget still runs on its own so
+	 * nothing starves.
+	 *
+	 * ```
+	 * gl::headless_context _uploadContext{ { .make_current = false }, &_mainContext };
+	 * gl::upload_worker _uploader{ [&]() { return _uploadContext.make_current(); } };
+	 *
+	 * _uploader.upload_texture(_desc, std::move(_pixels), [&](gl::unique_texture _texture) { ... });
+	 *
+	 * // main thread, every frame
+	 * _uploader.poll();
+	 * ```
+	*/
+	class upload_worker
+	{
+	public:
+
+		using texture_callback = std::function<void(unique_texture)>;
+		using buffer_callback = std::function<void(unique_vbo)>;
+
+		/**
+		 * @brief Default number of bytes uploaded per frame.
+		*/
+		constexpr static size_t default_frame_budget = 8 * 1024 * 1024;
+
+		/**
+		 * @brief Queues a 2D texture upload, safe to call from any thread.
+		 * @param _desc Texture to create.
+		 * @param _pixels Tightly packed pixels of the base level.
+		 * @param _onReady Invoked on the main thread by poll() with the finished texture, may be empty.
+		 * @param _priority Higher priorities are uploaded first.
+		*/
+		void upload_texture(const texture_upload_2D& _desc, std::vector<std::byte> _pixels, texture_callback _onReady, int _priority = 0)
+		{
+			JCLIB_ASSERT(_desc.width > 0 && _desc.height > 0);
+			upload_job _job{};
+			_job.texture = _desc;
+			_job.is_texture = true;
+			_job.data = std::move(_pixels);
+			_job.on_texture = std::move(_onReady);
+			this->enqueue(std::move(_job), _priority);
+		};
+
+		/**
+		 * @brief Queues a buffer upload, safe to call from any thread.
+		 * @param _data Buffer contents.
+		 * @param _onReady Invoked on the main thread by poll() with the finished buffer, may be empty.
+		 * @param _priority Higher priorities are uploaded first.
+		 * @param _usage Buffer usage hint.
+		*/
+		void upload_buffer(std::vector<std::byte> _data, buffer_callback _onReady, int _priority = 0, vbo_usage _usage = vbo_usage::static_draw)
+		{
+			upload_job _job{};
+			_job.usage = _usage;
+			_job.data = std::move(_data);
+			_job.on_buffer = std::move(_onReady);
+			this->enqueue(std::move(_job), _priority);
+		};
+
+		/**
+		 * @brief Hands finished uploads to their callbacks and starts a new budget frame, only call from the main thread.
+		 *
+		 * Uploads are delivered in the order they finished, stopping at the first one whose fence hasn't signaled.
+		 *
+		 * @return Number of uploads delivered.
+		*/
+		size_t poll()
+		{
+			std::vector<finished_upload> _ready{};
+			{
+				std::unique_lock _lock{ this->mtx_ };
+				while (!this->finished_.empty() && is_signaled(this->finished_.front().fence))
+				{
+					_ready.push_back(std::move(this->finished_.front()));
+					this->finished_.pop_front();
+				};
+				if (this->frame_budget_ != 0 && this->budget_left_ == 0 && !this->jobs_.empty())
+				{
+					++this->stats_.budget_exhausted;
+				};
+				this->budget_left_ = this->frame_budget_;
+				this->stats_.delivered_jobs += _ready.size();
+			};
+			this->cv_.notify_one();
+
+			for (auto& _upload : _ready)
+			{
+				_upload.fence.reset();
+				// Uploads queued without a callback are still delivered, the object is just released here
+				if (_upload.texture)
+				{
+					if (_upload.on_texture)
+					{
+						_upload.on_texture(std::move(_upload.texture));
+					};
+				}
+				else if (_upload.on_buffer)
+				{
+					_upload.on_buffer(std::move(_upload.vbo));
+				};
+			};
+			return _ready.size();
+		};
+
+		/**
+		 * @brief Gets the number of jobs not yet uploaded.
+		*/
+		size_t pending() const
+		{
+			std::unique_lock _lock{ this->mtx_ };
+			return this->jobs_.size() + this->uploading_;
+		};
+
+		/**
+		 * @brief Gets the number of uploads waiting on their fence or on poll().
+		*/
+		size_t in_flight() const
+		{
+			std::unique_lock _lock{ this->mtx_ };
+			return this->finished_.size();
+		};
+
+		/**
+		 * @brief Gets the number of bytes uploaded per frame, 0 if unlimited.
+		*/
+		size_t frame_budget() const
+		{
+			std::unique_lock _lock{ this->mtx_ };
+			return this->frame_budget_;
+		};
+
+		/**
+		 * @brief Sets the number of bytes uploaded per frame, takes effect on the next poll().
+		 * @param _bytes Byte budget, 0 for unlimited.
+		*/
+		void set_frame_budget(size_t _bytes)
+		{
+			std::unique_lock _lock{ this->mtx_ };
+			this->frame_budget_ = _bytes;
+		};
+
+		/**
+		 * @brief Gets the worker's counters.
+		*/
+		upload_worker_stats stats() const
+		{
+			std::unique_lock _lock{ this->mtx_ };
+			return this->stats_;
+		};
+
+		/**
+		 * @brief Checks if the worker thread made its context current.
+		*/
+		explicit operator bool() const noexcept { return this->started_; };
+
+		/**
+		 * @brief Starts the worker thread and waits for it to make its context current.
+		 * @param _makeCurrent Makes the worker's context current on the calling thread, returns false on failure.
+		 * @param _release Releases the worker's context when the thread exits, may be empty.
+		 * @param _frameBudget Number of bytes uploaded per frame, 0 for unlimited.
+		*/
+		explicit upload_worker(std::function<bool()> _makeCurrent, std::function<void()> _release = {},
+			size_t _frameBudget = default_frame_budget) :
+			frame_budget_{ _frameBudget },
+			budget_left_{ _frameBudget }
+		{
+			std::latch _started{ 1 };
+			this->thread_ = std::jthread([this, &_started, _makeCurrent = std::move(_makeCurrent), _release = std::move(_release)](std::stop_token _stop)
+			{
+				this->started_ = _makeCurrent();
+				_started.count_down();
+				if (!this->started_)
+				{
+					return;
+				};
+
+				// Jobs hold tightly packed pixels
+				glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+				this->work(_stop);
+				glFinish();
+
+				if (_release)
+				{
+					_release();
+				};
+			});
+			_started.wait();
+		};
+
+		/**
+		 * @brief Stops the worker thread, dropping jobs that haven't started. Must be called on the main thread.
+		 *
+		 * Finished uploads that were never delivered are deleted along with their fences.
+		*/
+		~upload_worker()
+		{
+			this->thread_.request_stop();
+			this->cv_.notify_all();
+			if (this->thread_.joinable())
+			{
+				this->thread_.join();
+			};
+		};
+
+		upload_worker(const upload_worker&) = delete;
+		upload_worker& operator=(const upload_worker&) = delete;
+
+	private:
+
+		struct upload_job
+		{
+			int priority = 0;
+			uint64_t sequence = 0;
+			bool is_texture = false;
+			texture_upload_2D texture{};
+			vbo_usage usage = vbo_usage::static_draw;
+			std::vector<std::byte> data{};
+			texture_callback on_texture{};
+			buffer_callback on_buffer{};
+
+			/**
+			 * @brief Heap order, highest priority then lowest sequence on top.
+			*/
+			friend bool operator<(const upload_job& lhs, const upload_job& rhs) noexcept
+			{
+				return (lhs.priority != rhs.priority) ? (lhs.priority < rhs.priority) : (lhs.sequence > rhs.sequence);
+			};
+		};
+
+		struct finished_upload
+		{
+			unique_sync fence{};
+			unique_texture texture{};
+			unique_vbo vbo{};
+			texture_callback on_texture{};
+			buffer_callback on_buffer{};
+		};
+
+		void enqueue(upload_job _job, int _priority)
+		{
+			_job.priority = _priority;
+			{
+				std::unique_lock _lock{ this->mtx_ };
+				_job.sequence = this->next_sequence_++;
+				this->jobs_.push_back(std::move(_job));
+				std::push_heap(this->jobs_.begin(), this->jobs_.end());
+			};
+			this->cv_.notify_one();
+		};
+
+		/**
+		 * @brief Runs a job with the worker's context current.
+		*/
+		static finished_upload run(upload_job& _job)
+		{
+			finished_upload _out{};
+			if (_job.is_texture)
+			{
+				const auto& _desc = _job.texture;
+				_out.texture = new_texture(texture_target::tex2D);
+				set_storage_2D(_out.texture, _desc.iformat, _desc.width, _desc.height, _desc.levels);
+				if (!_job.data.empty())
+				{
+					set_subimage_2D(_out.texture, _desc.pixel_format, _desc.pixel_type, _job.data.data(), _desc.width, _desc.height);
+				};
+				if (_desc.generate_mipmaps && _desc.levels > 1)
+				{
+					glGenerateTextureMipmap(_out.texture.get());
+				};
+				_out.on_texture = std::move(_job.on_texture);
+			}
+			else
+			{
+				_out.vbo = new_vbo();
+				buffer_data(_out.vbo, _job.data, _job.usage);
+				_out.on_buffer = std::move(_job.on_buffer);
+			};
+
+			// The fence must reach the server before the main context can see it signal
+			_out.fence = new_fence();
+			glFlush();
+			return _out;
+		};
+
+		void work(std::stop_token _stop)
+		{
+			std::unique_lock _lock{ this->mtx_ };
+			while (true)
+			{
+				const bool _ready = this->cv_.wait(_lock, _stop, [this]()
+				{
+					return !this->jobs_.empty() && (this->frame_budget_ == 0 || this->budget_left_ != 0);
+				});
+				if (!_ready)
+				{
+					return;
+				};
+
+				std::pop_heap(this->jobs_.begin(), this->jobs_.end());
+				auto _job = std::move(this->jobs_.back());
+				this->jobs_.pop_back();
+
+				const auto _bytes = _job.data.size();
+				this->budget_left_ -= std::min(this->budget_left_, _bytes);
+				++this->uploading_;
+
+				_lock.unlock();
+				auto _finished = run(_job);
+				_lock.lock();
+
+				--this->uploading_;
+				++this->stats_.uploaded_jobs;
+				this->stats_.uploaded_bytes += _bytes;
+				this->finished_.push_back(std::move(_finished));
+			};
+		};
+
+		mutable std::mutex mtx_{};
+		std::condition_variable_any cv_{};
+
+		/**
+		 * @brief Max heap of queued jobs.
+		*/
+		std::vector<upload_job> jobs_{};
+		std::deque<finished_upload> finished_{};
+		uint64_t next_sequence_ = 0;
+		size_t uploading_ = 0;
+
+		size_t frame_budget_;
+		size_t budget_left_;
+		upload_worker_stats stats_{};
+
+		bool started_ = false;
+		std::jthread thread_{};
+	};
+
+};
+#endif
+
+#endif // JCLIB_OPENGL_GLUPLOAD_HPP
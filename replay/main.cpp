@@ -0,0 +1,448 @@
+/*
+	Replays a trace written by jclib/gl/glcapture.hpp on a headless context, timing each call and frame.
+
+	Each repetition replays the whole trace on a fresh context so objects created by the trace don't
+	pile up. glFinish is called at every frame marker so frame times include the GPU's work.
+
+	usage: jcopengl_replay TRACE [--repeat N] [--print] [--no-finish] [--json PATH]
+*/
+
+#include <jclib/gl/glenum.hpp>
+#include <jclib/gl/glcapture.hpp>
+#include <jclib/gl/glheadless.hpp>
+
+#include <array>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <numeric>
+#include <utility>
+#include <algorithm>
+#include <string_view>
+
+namespace gl = jc::gl;
+
+namespace
+{
+	struct options
+	{
+		std::string trace_path{};
+		std::string json_path{};
+		size_t repeat = 1;
+		bool print = false;
+		bool finish = true;
+	};
+
+	using clock_type = std::chrono::steady_clock;
+
+	/**
+	 * @brief Accumulated replay time of one entry point.
+	*/
+	struct entry_stats
+	{
+		size_t calls = 0;
+		uint64_t total_ns = 0;
+	};
+
+	/**
+	 * @brief Names values of one of the library's typed enums, see the to_string overloads in glenum.hpp.
+	*/
+	struct enum_namer
+	{
+		std::string_view type;
+		std::string_view(*name)(GLenum);
+	};
+
+#define JCLIB_OPENGL_REPLAY_ENUM(_type) \
+	enum_namer{ #_type, [](GLenum _value) { return gl::to_string(static_cast<gl::_type>(_value)); } }
+
+	/**
+	 * @brief Typed enums tried in order when naming an argument, values shared by several enums take the first name.
+	*/
+	constexpr std::array enum_namers
+	{
+		JCLIB_OPENGL_REPLAY_ENUM(vbo_target),
+		JCLIB_OPENGL_REPLAY_ENUM(vbo_usage),
+		JCLIB_OPENGL_REPLAY_ENUM(vbo_parameter),
+		JCLIB_OPENGL_REPLAY_ENUM(texture_target),
+		JCLIB_OPENGL_REPLAY_ENUM(texture_parameter),
+		JCLIB_OPENGL_REPLAY_ENUM(internal_format),
+		JCLIB_OPENGL_REPLAY_ENUM(format),
+		JCLIB_OPENGL_REPLAY_ENUM(typecode),
+		JCLIB_OPENGL_REPLAY_ENUM(pixel_typecode),
+		JCLIB_OPENGL_REPLAY_ENUM(primitive),
+		JCLIB_OPENGL_REPLAY_ENUM(shader_type),
+		JCLIB_OPENGL_REPLAY_ENUM(shader_parameter),
+		JCLIB_OPENGL_REPLAY_ENUM(program_parameter),
+		JCLIB_OPENGL_REPLAY_ENUM(program_interface),
+		JCLIB_OPENGL_REPLAY_ENUM(resource_type),
+		JCLIB_OPENGL_REPLAY_ENUM(resource_parameter),
+		JCLIB_OPENGL_REPLAY_ENUM(framebuffer_target),
+		JCLIB_OPENGL_REPLAY_ENUM(framebuffer_attachment),
+		JCLIB_OPENGL_REPLAY_ENUM(framebuffer_status),
+		JCLIB_OPENGL_REPLAY_ENUM(blit_filter),
+		JCLIB_OPENGL_REPLAY_ENUM(sync_status),
+		JCLIB_OPENGL_REPLAY_ENUM(object_type),
+	};
+#undef JCLIB_OPENGL_REPLAY_ENUM
+
+	/**
+	 * @brief Names a value as "type::enumerator", empty if none of the typed enums know it.
+	*/
+	std::string find_constant_name(GLenum _value)
+	{
+		// Small values are far more likely to be counts, indices or flags than enums
+		if (_value < 0x0200)
+		{
+			return {};
+		};
+		for (auto& e : enum_namers)
+		{
+			const auto _name = e.name(_value);
+			if (!_name.empty())
+			{
+				return std::string{ e.type }.append("::").append(_name);
+			};
+		};
+		return {};
+	};
+
+	std::string_view kind_name(gl::replay_arg _kind)
+	{
+		switch (_kind)
+		{
+		case gl::replay_arg::buffer: return "buffer";
+		case gl::replay_arg::vao: return "vao";
+		case gl::replay_arg::texture: return "texture";
+		case gl::replay_arg::framebuffer: return "framebuffer";
+		case gl::replay_arg::renderbuffer: return "renderbuffer";
+		case gl::replay_arg::program: return "program";
+		case gl::replay_arg::pipeline: return "pipeline";
+		case gl::replay_arg::sync: return "sync";
+		case gl::replay_arg::location: [[fallthrough]];
+		case gl::replay_arg::current_location: return "location";
+		default: return {};
+		};
+	};
+
+	template <typename T>
+	void print_arg(std::FILE* _file, const T& _value, gl::replay_arg _kind, const gl::trace& _trace,
+		const gl::trace_call& _call, size_t& _slot)
+	{
+		const auto _kindName = kind_name(_kind);
+		if constexpr (std::is_pointer_v<T>)
+		{
+			// Payload slots are filled in pointer argument order, outputs such as generated names included
+			if (_slot < _call.payload_count())
+			{
+				const auto _id = _call.payload(_slot++);
+				if (_id != gl::trace_null_payload && _id < _trace.payloads.size())
+				{
+					std::fprintf(_file, "payload#%u (%zu bytes)", _id, _trace.payloads[_id].size());
+					return;
+				};
+			};
+			std::fprintf(_file, "%p", reinterpret_cast<const void*>(_value));
+		}
+		else if constexpr (std::is_floating_point_v<T>)
+		{
+			std::fprintf(_file, "%g", static_cast<double>(_value));
+		}
+		else if constexpr (std::is_same_v<T, GLuint>)
+		{
+			const auto _name = find_constant_name(_value);
+			if (!_kindName.empty())
+			{
+				std::fprintf(_file, "%.*s %u", static_cast<int>(_kindName.size()), _kindName.data(), _value);
+			}
+			else if (!_name.empty())
+			{
+				std::fprintf(_file, "%s", _name.c_str());
+			}
+			else
+			{
+				std::fprintf(_file, "%u", _value);
+			};
+		}
+		else if constexpr (std::is_signed_v<T>)
+		{
+			if (!_kindName.empty())
+			{
+				std::fprintf(_file, "%.*s ", static_cast<int>(_kindName.size()), _kindName.data());
+			};
+			std::fprintf(_file, "%lld", static_cast<long long>(_value));
+		}
+		else
+		{
+			std::fprintf(_file, "%llu", static_cast<unsigned long long>(_value));
+		};
+	};
+
+	/**
+	 * @brief Prints a call as "glName(arg, arg, ...) = result".
+	*/
+	template <gl::record_entry Entry>
+	void print_call(std::FILE* _file, const gl::trace& _trace, const gl::trace_call& _call)
+	{
+		const auto _args = gl::decode_args<Entry>(gl::record_view{ Entry, _call.args });
+		const auto _name = gl::to_string(Entry);
+		std::fprintf(_file, "%.*s(", static_cast<int>(_name.size()), _name.data());
+
+		size_t _slot = 0;
+		[&]<size_t... Is>(std::index_sequence<Is...>)
+		{
+			((std::fputs((Is == 0) ? "" : ", ", _file),
+				print_arg(_file, std::get<Is>(_args), gl::replay_arg_of<Entry>(Is), _trace, _call, _slot)), ...);
+		}(std::make_index_sequence<std::tuple_size_v<std::remove_cvref_t<decltype(_args)>>>{});
+		std::fputs(")", _file);
+
+		using result_type = typename gl::record_entry_traits<Entry>::signature::result_type;
+		if constexpr (!std::is_void_v<result_type>)
+		{
+			result_type _result{};
+			std::memcpy(&_result, _call.result.data(), sizeof(_result));
+			std::fputs(" = ", _file);
+			size_t _none = 0;
+			print_arg(_file, _result, gl::replay_arg::value, _trace, _call, _none);
+		};
+		std::fputs("\n", _file);
+	};
+
+	using print_function_ptr = void(*)(std::FILE*, const gl::trace&, const gl::trace_call&);
+	constexpr std::array<print_function_ptr, gl::record_entry_count> print_functions
+	{
+#define JCLIB_OPENGL_REPLAY_PRINT_FUNCTION(_name) &print_call<gl::record_entry::_name>,
+		JCLIB_OPENGL_RECORD_FUNCTIONS(JCLIB_OPENGL_REPLAY_PRINT_FUNCTION)
+#undef JCLIB_OPENGL_REPLAY_PRINT_FUNCTION
+	};
+
+	void print_trace(std::FILE* _file, const gl::trace& _trace)
+	{
+		const gl::trace_replayer _lookup{ _trace };
+		gl::trace_reader _reader{ _trace };
+		gl::trace_call _call{};
+		size_t _frame = 0;
+		while (_reader.next(_call))
+		{
+			if (_call.is_frame_marker())
+			{
+				std::fprintf(_file, "-- end of frame %zu\n", _frame++);
+				continue;
+			};
+
+			const auto _entry = _lookup.entry(_call.id);
+			if (_entry == gl::record_entry::count)
+			{
+				std::fprintf(_file, "%s(?) unknown to this build\n", _trace.entries[_call.id].name.c_str());
+				continue;
+			};
+			print_functions[jc::to_underlying(_entry)](_file, _trace, _call);
+		};
+	};
+
+	/**
+	 * @brief Replays the trace once, adding to the per entry and per frame timings.
+	*/
+	void replay_once(const gl::trace& _trace, const options& _options, std::vector<entry_stats>& _entries,
+		std::vector<uint64_t>& _frames, size_t& _skipped)
+	{
+		gl::trace_replayer _replayer{ _trace };
+		gl::trace_reader _reader{ _trace };
+		gl::trace_call _call{};
+
+		auto _frameStart = clock_type::now();
+		while (_reader.next(_call))
+		{
+			if (_call.is_frame_marker())
+			{
+				if (_options.finish)
+				{
+					glFinish();
+				};
+				const auto _frameEnd = clock_type::now();
+				_frames.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(_frameEnd - _frameStart).count());
+				_frameStart = _frameEnd;
+				continue;
+			};
+
+			const auto _start = clock_type::now();
+			const auto _replayed = _replayer.replay(_call);
+			const auto _ns = std::chrono::duration_cast<std::chrono::nanoseconds>(clock_type::now() - _start).count();
+			if (_replayed)
+			{
+				auto& _stats = _entries[jc::to_underlying(_replayer.entry(_call.id))];
+				++_stats.calls;
+				_stats.total_ns += _ns;
+			};
+		};
+
+		_skipped += _replayer.skipped();
+	};
+
+	uint64_t percentile(std::vector<uint64_t> _values, double _at)
+	{
+		if (_values.empty())
+		{
+			return 0;
+		};
+		const auto _index = static_cast<size_t>(_at * static_cast<double>(_values.size() - 1));
+		std::ranges::nth_element(_values, _values.begin() + _index);
+		return _values[_index];
+	};
+
+	void write_json(std::ostream& _out, std::string_view _renderer, const std::vector<entry_stats>& _entries,
+		const std::vector<uint64_t>& _frames, size_t _skipped)
+	{
+		_out << "{\n\t\"renderer\": \"" << _renderer << "\",\n\t\"skipped\": " << _skipped << ",\n\t\"frames_ns\": [";
+		for (size_t n = 0; n != _frames.size(); ++n)
+		{
+			_out << ((n == 0) ? " " : ", ") << _frames[n];
+		};
+		_out << " ],\n\t\"entries\": [\n";
+
+		bool _first = true;
+		for (size_t n = 0; n != _entries.size(); ++n)
+		{
+			if (_entries[n].calls == 0)
+			{
+				continue;
+			};
+			_out << ((_first) ? "" : ",\n") << "\t\t{ \"name\": \"" << gl::to_string(static_cast<gl::record_entry>(n))
+				<< "\", \"calls\": " << _entries[n].calls << ", \"total_ns\": " << _entries[n].total_ns << " }";
+			_first = false;
+		};
+		_out << "\n\t]\n}\n";
+	};
+
+	bool parse_options(int _nargs, char* _vargs[], options& _options)
+	{
+		for (int n = 1; n < _nargs; ++n)
+		{
+			const auto _arg = std::string_view{ _vargs[n] };
+			const auto _value = (n + 1 < _nargs) ? std::string_view{ _vargs[n + 1] } : std::string_view{};
+			if (_arg == "--print")
+			{
+				_options.print = true;
+				continue;
+			}
+			else if (_arg == "--no-finish")
+			{
+				_options.finish = false;
+				continue;
+			}
+			else if (!_arg.starts_with("--"))
+			{
+				_options.trace_path = _arg;
+				continue;
+			};
+
+			if (_value.empty())
+			{
+				std::fprintf(stderr, "missing value for %s\n", _vargs[n]);
+				return false;
+			};
+			if (_arg == "--repeat")
+			{
+				_options.repeat = static_cast<size_t>(std::max(1, std::atoi(_value.data())));
+			}
+			else if (_arg == "--json")
+			{
+				_options.json_path = _value;
+			}
+			else
+			{
+				std::fprintf(stderr, "unknown argument %s\n", _vargs[n]);
+				return false;
+			};
+			++n;
+		};
+
+		if (_options.trace_path.empty())
+		{
+			std::fprintf(stderr, "usage: jcopengl_replay TRACE [--repeat N] [--print] [--no-finish] [--json PATH]\n");
+			return false;
+		};
+		return true;
+	};
+};
+
+int main(int _nargs, char* _vargs[])
+{
+	options _options{};
+	if (!parse_options(_nargs, _vargs, _options))
+	{
+		return 2;
+	};
+
+	auto _file = std::ifstream{ _options.trace_path, std::ios::binary };
+	const auto _trace = gl::read_trace(_file);
+	if (!_trace)
+	{
+		std::fprintf(stderr, "failed to read trace %s\n", _options.trace_path.c_str());
+		return 1;
+	};
+
+	size_t _payloadBytes = 0;
+	for (auto& p : _trace->payloads)
+	{
+		_payloadBytes += p.size();
+	};
+	std::fprintf(stderr, "trace: %zu bytes of calls, %zu payloads (%zu bytes)\n", _trace->calls.size(),
+		_trace->payloads.size(), _payloadBytes);
+
+	if (_options.print)
+	{
+		print_trace(stdout, *_trace);
+		std::fflush(stdout);
+	};
+
+	std::vector<entry_stats> _entries(gl::record_entry_count);
+	std::vector<uint64_t> _frames{};
+	size_t _skipped = 0;
+	std::string _renderer{};
+	for (size_t n = 0; n != _options.repeat; ++n)
+	{
+		// A fresh context per repetition releases everything the trace created
+		gl::headless_context _context{};
+		if (!_context)
+		{
+			std::fprintf(stderr, "failed to create headless context: %s\n", _context.error().c_str());
+			return 1;
+		};
+		const auto _rendererName = reinterpret_cast<const char*>(glGetString(GL_RENDERER));
+		_renderer = (_rendererName) ? _rendererName : "unknown";
+		replay_once(*_trace, _options, _entries, _frames, _skipped);
+	};
+	std::fprintf(stderr, "renderer: %s\n", _renderer.c_str());
+
+	std::printf("%zu frames, min %.3f ms, median %.3f ms, max %.3f ms, %zu calls skipped\n", _frames.size(),
+		static_cast<double>(percentile(_frames, 0.0)) / 1e6, static_cast<double>(percentile(_frames, 0.5)) / 1e6,
+		static_cast<double>(percentile(_frames, 1.0)) / 1e6, _skipped);
+
+	std::vector<size_t> _order(_entries.size());
+	std::iota(_order.begin(), _order.end(), size_t{ 0 });
+	std::ranges::sort(_order, [&_entries](size_t a, size_t b) { return _entries[a].total_ns > _entries[b].total_ns; });
+
+	std::printf("%-40s %10s %14s %12s\n", "entry", "calls", "total us", "mean ns");
+	for (auto n : _order)
+	{
+		const auto& e = _entries[n];
+		if (e.calls == 0)
+		{
+			break;
+		};
+		const auto _name = gl::to_string(static_cast<gl::record_entry>(n));
+		std::printf("%-40.*s %10zu %14.1f %12.0f\n", static_cast<int>(_name.size()), _name.data(), e.calls,
+			static_cast<double>(e.total_ns) / 1e3, static_cast<double>(e.total_ns) / static_cast<double>(e.calls));
+	};
+
+	if (!_options.json_path.empty())
+	{
+		auto _out = std::ofstream{ _options.json_path };
+		write_json(_out, _renderer, _entries, _frames, _skipped);
+	};
+	return 0;
+};